@@ -0,0 +1,219 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Compares the scalar and vectorized kernels for the activity computation and
+ * the propagation of rows in double precision on the rows of the given MPS
+ * files, e.g. the instances in check/instances/MIP. For every instance and
+ * instruction set supported by the CPU the time of the activity kernels and
+ * of propagate_row over all rows is reported, together with the fraction of
+ * nonzeros that the vectorized filter leaves to the scalar propagation. The
+ * activities and the bound changes of the vectorized kernels are checked to
+ * be bitwise identical to the scalar ones.
+ */
+
+#include "papilo/core/Problem.hpp"
+#include "papilo/core/SingleRow.hpp"
+#include "papilo/core/SingleRowSimd.hpp"
+#include "papilo/io/MpsParser.hpp"
+#include "papilo/misc/Timer.hpp"
+#include "papilo/misc/fmt.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+using namespace papilo;
+
+static constexpr int NUM_REPETITIONS = 200;
+
+static bool
+same_activity( const RowActivity<double>& a, const RowActivity<double>& b )
+{
+   return std::memcmp( &a.min, &b.min, sizeof( double ) ) == 0 &&
+          std::memcmp( &a.max, &b.max, sizeof( double ) ) == 0 &&
+          a.ninfmin == b.ninfmin && a.ninfmax == b.ninfmax;
+}
+
+int
+main( int argc, char* argv[] )
+{
+   if( argc < 2 )
+   {
+      fmt::print( "usage: {} <mps file>...\n", argv[0] );
+      return EXIT_FAILURE;
+   }
+
+   Vec<SimdLevel> levels{ SimdLevel::kScalar };
+   if( get_supported_simd_level() != SimdLevel::kScalar )
+      levels.push_back( SimdLevel::kAvx2 );
+   if( get_supported_simd_level() == SimdLevel::kAvx512 )
+      levels.push_back( SimdLevel::kAvx512 );
+
+   fmt::print( "{:<20} {:>8} {:>10} {:>8} {:>16} {:>17} {:>12}\n", "instance",
+               "rows", "nnz", "isa", "activity [ns/nz]", "propagate [ns/nz]",
+               "candidates" );
+
+   Num<double> num{};
+   bool identical = true;
+
+   for( int i = 1; i < argc; ++i )
+   {
+      boost::optional<Problem<double>> prob =
+          MpsParser<double>::loadProblem( argv[i] );
+      if( !prob )
+      {
+         fmt::print( "could not read {}\n", argv[i] );
+         return EXIT_FAILURE;
+      }
+
+      const ConstraintMatrix<double>& matrix = prob->getConstraintMatrix();
+      const VariableDomains<double>& domains = prob->getVariableDomains();
+      const int nrows = matrix.getNRows();
+      const int nnz = matrix.getNnz();
+      if( nnz == 0 )
+         continue;
+
+      std::string name = argv[i];
+      name = name.substr( name.find_last_of( '/' ) + 1 );
+
+      Vec<RowActivity<double>> reference( nrows );
+      Vec<double> reference_bounds;
+
+      for( SimdLevel level : levels )
+      {
+         set_simd_level( level );
+
+         Vec<RowActivity<double>> activities( nrows );
+         double activity_time = 0;
+         {
+            Timer timer( activity_time );
+            for( int r = 0; r != NUM_REPETITIONS; ++r )
+            {
+               for( int row = 0; row != nrows; ++row )
+               {
+                  auto rowvec = matrix.getRowCoefficients( row );
+                  simd::ActivitySums sums = simd::row_activity(
+                      level, rowvec.getValues(), rowvec.getIndices(),
+                      rowvec.getLength(), domains.lower_bounds.data(),
+                      domains.upper_bounds.data(), domains.flags.data() );
+                  activities[row].min = sums.min;
+                  activities[row].max = sums.max;
+                  activities[row].ninfmin = sums.ninfmin;
+                  activities[row].ninfmax = sums.ninfmax;
+               }
+            }
+         }
+
+         // the bound changes are not applied, every row is propagated on the
+         // original domains as in the first round of ConstraintPropagation
+         Vec<double> bounds;
+         double propagate_time = 0;
+         {
+            Timer timer( propagate_time );
+            for( int r = 0; r != NUM_REPETITIONS; ++r )
+            {
+               for( int row = 0; row != nrows; ++row )
+               {
+                  auto rowvec = matrix.getRowCoefficients( row );
+                  propagate_row(
+                      num, row, rowvec.getValues(), rowvec.getIndices(),
+                      rowvec.getLength(), activities[row],
+                      matrix.getLeftHandSides()[row],
+                      matrix.getRightHandSides()[row],
+                      matrix.getRowFlags()[row], domains.lower_bounds,
+                      domains.upper_bounds, domains.flags,
+                      [&]( BoundChange, int col, double val, int ) {
+                         if( r == 0 )
+                         {
+                            bounds.push_back( col );
+                            bounds.push_back( val );
+                         }
+                      } );
+               }
+            }
+         }
+
+         // entries left by the filter on the sides with finite activity
+         long long candidates = 0;
+         long long entries = 0;
+         for( int row = 0; row != nrows; ++row )
+         {
+            auto rowvec = matrix.getRowCoefficients( row );
+            for( bool lhs_side : { false, true } )
+            {
+               if( ( lhs_side ? activities[row].ninfmax
+                              : activities[row].ninfmin ) != 0 ||
+                   matrix.getRowFlags()[row].test( lhs_side ? RowFlag::kLhsInf
+                                                            : RowFlag::kRhsInf ) )
+                  continue;
+
+               for( int j = 0; j < rowvec.getLength(); j += 64 )
+               {
+                  int len = std::min( 64, rowvec.getLength() - j );
+                  std::uint64_t mask = propagation_candidates(
+                      lhs_side, rowvec.getValues() + j,
+                      rowvec.getIndices() + j, len, domains.lower_bounds,
+                      domains.upper_bounds, domains.flags,
+                      lhs_side ? activities[row].max : activities[row].min,
+                      lhs_side ? matrix.getLeftHandSides()[row]
+                               : matrix.getRightHandSides()[row] );
+                  entries += len;
+                  for( ; mask != 0; mask &= mask - 1 )
+                     ++candidates;
+               }
+            }
+         }
+
+         if( level == SimdLevel::kScalar )
+         {
+            reference = activities;
+            reference_bounds = bounds;
+         }
+         else
+         {
+            for( int row = 0; row != nrows; ++row )
+            {
+               if( !same_activity( activities[row], reference[row] ) )
+                  identical = false;
+            }
+            if( bounds.size() != reference_bounds.size() ||
+                std::memcmp( bounds.data(), reference_bounds.data(),
+                             bounds.size() * sizeof( double ) ) != 0 )
+               identical = false;
+         }
+
+         fmt::print( "{:<20} {:>8} {:>10} {:>8} {:>16.2f} {:>17.2f} {:>11.1f}%\n",
+                     name, nrows, nnz, get_simd_level_name( level ),
+                     activity_time * 1e9 / NUM_REPETITIONS / nnz,
+                     propagate_time * 1e9 / NUM_REPETITIONS / nnz,
+                     entries == 0 ? 100.0 : 100.0 * candidates / entries );
+      }
+   }
+
+   if( !identical )
+   {
+      fmt::print( "vectorized kernels differ from the scalar ones\n" );
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
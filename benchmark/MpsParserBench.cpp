@@ -0,0 +1,224 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/*
+ * Compares the stream reader of MpsParser with the memory mapped reader for
+ * the given MPS files or, with --random <rows> <cols> <nnz per col>, for a
+ * random problem that is written to mps_parser_bench.mps first. The mapped
+ * reader is run with an increasing number of threads and its problems are
+ * checked to be equal to the ones of the stream reader. The instances in
+ * check/instances have less than 100KB and fit into a single chunk.
+ */
+
+#include "papilo/core/Problem.hpp"
+#include "papilo/io/MpsParser.hpp"
+#include "papilo/misc/Timer.hpp"
+#include "papilo/misc/fmt.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace papilo;
+
+static constexpr int NUM_REPETITIONS = 5;
+static const int THREADS[] = { 1, 2, 4, 8, 16, 32 };
+
+static bool
+same_problem( const Problem<double>& a, const Problem<double>& b )
+{
+   if( a.getNRows() != b.getNRows() || a.getNCols() != b.getNCols() ||
+       a.getVariableNames() != b.getVariableNames() ||
+       a.getConstraintNames() != b.getConstraintNames() ||
+       a.getObjective().coefficients != b.getObjective().coefficients ||
+       a.getLowerBounds() != b.getLowerBounds() ||
+       a.getUpperBounds() != b.getUpperBounds() )
+      return false;
+
+   const ConstraintMatrix<double>& ma = a.getConstraintMatrix();
+   const ConstraintMatrix<double>& mb = b.getConstraintMatrix();
+   if( ma.getNnz() != mb.getNnz() ||
+       ma.getLeftHandSides() != mb.getLeftHandSides() ||
+       ma.getRightHandSides() != mb.getRightHandSides() )
+      return false;
+
+   for( int row = 0; row != a.getNRows(); ++row )
+   {
+      const SparseVectorView<double> ra = ma.getRowCoefficients( row );
+      const SparseVectorView<double> rb = mb.getRowCoefficients( row );
+      if( ra.getLength() != rb.getLength() ||
+          std::memcmp( ra.getIndices(), rb.getIndices(),
+                       sizeof( int ) * ra.getLength() ) != 0 ||
+          std::memcmp( ra.getValues(), rb.getValues(),
+                       sizeof( double ) * ra.getLength() ) != 0 )
+         return false;
+   }
+
+   return true;
+}
+
+static bool
+write_random_problem( const std::string& filename, int nrows, int ncols,
+                      int collength )
+{
+   uint64_t seed = 42;
+   auto random = [&seed]() {
+      seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+      return static_cast<int>( seed >> 33 );
+   };
+
+   std::FILE* file = std::fopen( filename.c_str(), "w" );
+   if( file == nullptr )
+      return false;
+
+   fmt::print( file, "NAME          RANDOM\nROWS\n N  obj\n" );
+   for( int r = 0; r != nrows; ++r )
+      fmt::print( file, " L  r{}\n", r );
+
+   fmt::print( file, "COLUMNS\n" );
+   const int maxgap = std::max( 1, 2 * nrows / std::max( collength, 1 ) );
+   for( int c = 0; c != ncols; ++c )
+   {
+      fmt::print( file, "    x{}  obj  {}\n", c, random() % 100 - 50 );
+      for( int r = random() % maxgap; r < nrows; r += 1 + random() % maxgap )
+         fmt::print( file, "    x{}  r{}  {}.{}\n", c, r, random() % 1000,
+                     random() % 1000 );
+   }
+
+   fmt::print( file, "RHS\n" );
+   for( int r = 0; r != nrows; ++r )
+      fmt::print( file, "    rhs  r{}  {}\n", r, random() % 10000 );
+
+   fmt::print( file, "BOUNDS\n" );
+   for( int c = 0; c != ncols; ++c )
+      fmt::print( file, " UP bnd  x{}  {}\n", c, 1 + random() % 100 );
+   fmt::print( file, "ENDATA\n" );
+
+   return std::fclose( file ) == 0;
+}
+
+static bool
+run( const std::string& filename )
+{
+   double streamed_time = 0;
+   boost::optional<Problem<double>> streamed;
+   for( int i = 0; i != NUM_REPETITIONS; ++i )
+   {
+      Timer timer( streamed_time );
+      streamed = MpsParser<double>::loadStreamedProblem( filename );
+   }
+   streamed_time /= NUM_REPETITIONS;
+
+   if( !streamed )
+   {
+      fmt::print( "could not read {}\n", filename );
+      return false;
+   }
+
+   std::string name = filename.substr( filename.find_last_of( '/' ) + 1 );
+   bool identical = true;
+
+   for( int nthreads : THREADS )
+   {
+      double mapped_time = 0;
+      boost::optional<Problem<double>> mapped;
+
+      auto measure = [&]() {
+         for( int i = 0; i != NUM_REPETITIONS; ++i )
+         {
+            Timer timer( mapped_time );
+            mapped = MpsParser<double>::loadMappedProblem( filename );
+         }
+      };
+
+#ifdef PAPILO_TBB
+      tbb::task_arena arena( nthreads );
+      arena.execute( measure );
+#else
+      if( nthreads != THREADS[0] )
+         break;
+      measure();
+#endif
+
+      mapped_time /= NUM_REPETITIONS;
+      if( !mapped || !same_problem( mapped.get(), streamed.get() ) )
+         identical = false;
+
+      fmt::print( "{:<20} {:>10} {:>8} {:>13.3f} {:>13.3f} {:>8.2f}\n", name,
+                  streamed->getConstraintMatrix().getNnz(), nthreads,
+                  streamed_time * 1e3, mapped_time * 1e3,
+                  streamed_time / mapped_time );
+   }
+
+   return identical;
+}
+
+int
+main( int argc, char* argv[] )
+{
+   if( argc < 2 )
+   {
+      fmt::print( "usage: {} <mps file>...\n"
+                  "       {} --random <rows> <cols> <nnz per col>\n",
+                  argv[0], argv[0] );
+      return EXIT_FAILURE;
+   }
+
+   fmt::print( "{:<20} {:>10} {:>8} {:>13} {:>13} {:>8}\n", "instance", "nnz",
+               "threads", "stream [ms]", "mapped [ms]", "speedup" );
+
+   bool identical = true;
+
+   if( std::strcmp( argv[1], "--random" ) == 0 )
+   {
+      if( argc != 5 )
+      {
+         fmt::print( "--random expects <rows> <cols> <nnz per col>\n" );
+         return EXIT_FAILURE;
+      }
+
+      const std::string filename = "mps_parser_bench.mps";
+      if( !write_random_problem( filename, std::atoi( argv[2] ),
+                                 std::atoi( argv[3] ), std::atoi( argv[4] ) ) )
+      {
+         fmt::print( "could not write {}\n", filename );
+         return EXIT_FAILURE;
+      }
+      identical = run( filename );
+   }
+   else
+   {
+      for( int i = 1; i < argc; ++i )
+         identical = run( argv[i] ) && identical;
+   }
+
+   if( !identical )
+   {
+      fmt::print( "the problems of the mapped reader differ\n" );
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
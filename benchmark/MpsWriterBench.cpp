@@ -0,0 +1,230 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/*
+ * Compares the stream writer of MpsWriter with the buffered writer. By
+ * default the largest MPS instances of check/instances are written, other
+ * files can be given on the command line. Every instance is written plain
+ * and gzip compressed, the buffered writer with an increasing number of
+ * threads, and the plain files of both writers are checked to be equal.
+ */
+
+#include "papilo/core/Problem.hpp"
+#include "papilo/io/MpsParser.hpp"
+#include "papilo/io/MpsWriter.hpp"
+#include "papilo/misc/Timer.hpp"
+#include "papilo/misc/fmt.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace papilo;
+
+static constexpr int NUM_REPETITIONS = 5;
+static constexpr int NUM_LARGEST = 5;
+static const int THREADS[] = { 1, 2, 4, 8, 16, 32 };
+
+struct Instance
+{
+   std::string filename;
+   Problem<double> problem;
+   Vec<int> row_mapping;
+   Vec<int> col_mapping;
+};
+
+/// MPS files of the instance sets in check/instances
+static std::vector<std::string>
+list_check_instances()
+{
+   std::vector<std::string> files;
+   for( const char* set : { "LP", "MIP" } )
+   {
+      const std::string directory =
+          std::string( PAPILO_CHECK_INSTANCES_DIR ) + "/" + set;
+      DIR* dir = opendir( directory.c_str() );
+      if( dir == nullptr )
+         continue;
+      while( dirent* entry = readdir( dir ) )
+      {
+         std::string name = entry->d_name;
+         if( name.find( ".mps" ) != std::string::npos )
+            files.push_back( directory + "/" + name );
+      }
+      closedir( dir );
+   }
+   std::sort( files.begin(), files.end() );
+   return files;
+}
+
+static std::string
+read_file( const std::string& filename )
+{
+   std::ifstream file( filename, std::ifstream::in | std::ifstream::binary );
+   return std::string( std::istreambuf_iterator<char>( file ),
+                       std::istreambuf_iterator<char>() );
+}
+
+template <typename Write>
+static double
+measure( Write&& write )
+{
+   double time = 0;
+   for( int i = 0; i != NUM_REPETITIONS; ++i )
+   {
+      Timer timer( time );
+      write();
+   }
+   return time / NUM_REPETITIONS;
+}
+
+static bool
+run( const Instance& instance, const char* extension )
+{
+   const std::string streamed = std::string( "mps_writer_bench_streamed" ) +
+                                extension;
+   const std::string buffered = std::string( "mps_writer_bench_buffered" ) +
+                                extension;
+   const double streamed_time = measure(
+       [&]()
+       {
+          MpsWriter<double>::writeStreamedProb( streamed, instance.problem,
+                                                instance.row_mapping,
+                                                instance.col_mapping );
+       } );
+
+   std::string name = instance.filename.substr(
+       instance.filename.find_last_of( '/' ) + 1 );
+   bool identical = true;
+
+   for( int nthreads : THREADS )
+   {
+      auto write = [&]()
+      {
+         MpsWriter<double>::writeBufferedProb( buffered, instance.problem,
+                                               instance.row_mapping,
+                                               instance.col_mapping );
+      };
+
+      double buffered_time;
+#ifdef PAPILO_TBB
+      tbb::task_arena arena( nthreads );
+      arena.execute( [&]() { buffered_time = measure( write ); } );
+#else
+      if( nthreads != THREADS[0] )
+         break;
+      buffered_time = measure( write );
+#endif
+
+      // gzip output depends on the buffer boundaries, only plain files are
+      // compared
+      if( std::strcmp( extension, ".mps" ) == 0 &&
+          read_file( streamed ) != read_file( buffered ) )
+         identical = false;
+
+      fmt::print( "{:<20} {:>5} {:>10} {:>8} {:>13.3f} {:>13.3f} {:>8.2f}\n",
+                  name, extension + 1,
+                  instance.problem.getConstraintMatrix().getNnz(), nthreads,
+                  streamed_time * 1e3, buffered_time * 1e3,
+                  streamed_time / buffered_time );
+   }
+
+   std::remove( streamed.c_str() );
+   std::remove( buffered.c_str() );
+   return identical;
+}
+
+int
+main( int argc, char* argv[] )
+{
+   std::vector<std::string> files;
+   for( int i = 1; i < argc; ++i )
+   {
+      if( argv[i][0] == '-' )
+      {
+         fmt::print( "usage: {} [<mps file>...]\n", argv[0] );
+         return EXIT_FAILURE;
+      }
+      files.push_back( argv[i] );
+   }
+   const bool largest_only = files.empty();
+   if( largest_only )
+      files = list_check_instances();
+
+   std::vector<Instance> instances;
+   for( const std::string& filename : files )
+   {
+      boost::optional<Problem<double>> problem =
+          MpsParser<double>::loadProblem( filename );
+      if( !problem )
+      {
+         fmt::print( "could not read {}, skipped\n", filename );
+         continue;
+      }
+
+      Instance instance{ filename, std::move( problem.get() ), {}, {} };
+      for( int i = 0; i != instance.problem.getNRows(); ++i )
+         instance.row_mapping.push_back( i );
+      for( int i = 0; i != instance.problem.getNCols(); ++i )
+         instance.col_mapping.push_back( i );
+      instances.push_back( std::move( instance ) );
+   }
+
+   if( largest_only )
+   {
+      std::sort( instances.begin(), instances.end(),
+                 []( const Instance& a, const Instance& b )
+                 {
+                    return a.problem.getConstraintMatrix().getNnz() >
+                           b.problem.getConstraintMatrix().getNnz();
+                 } );
+      if( instances.size() > NUM_LARGEST )
+         instances.resize( NUM_LARGEST );
+   }
+
+   fmt::print( "{:<20} {:>5} {:>10} {:>8} {:>13} {:>13} {:>8}\n", "instance",
+               "type", "nnz", "threads", "stream [ms]", "buffered [ms]",
+               "speedup" );
+
+   bool identical = true;
+   for( const Instance& instance : instances )
+   {
+      identical = run( instance, ".mps" ) && identical;
+#ifdef PAPILO_USE_BOOST_IOSTREAMS_WITH_ZLIB
+      identical = run( instance, ".mps.gz" ) && identical;
+#endif
+   }
+
+   if( !identical )
+   {
+      fmt::print( "the files of the buffered writer differ\n" );
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
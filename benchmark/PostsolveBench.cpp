@@ -0,0 +1,286 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Measures the heap traffic of repeated primal postsolves against one
+ * PostsolveStorage. The original problem grows from 10^3 to 10^6 columns while
+ * the reduction log stays the same, so the bytes allocated per call must stay
+ * constant (zero once the output solution is warmed up). Afterwards a pool of
+ * solutions is postsolved one by one and as a single batch, and a long
+ * reduction log is postsolved by decoding the log and by running the compiled
+ * PostsolveProgram.
+ */
+
+#include "papilo/core/postsolve/Postsolve.hpp"
+#include "papilo/core/ProblemBuilder.hpp"
+#include "papilo/core/postsolve/PostsolveProgram.hpp"
+#include "papilo/core/postsolve/PostsolveStorage.hpp"
+#include "papilo/misc/Timer.hpp"
+#include "papilo/misc/fmt.hpp"
+
+#include <atomic>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+static std::atomic<std::size_t> allocated_bytes{ 0 };
+static std::atomic<std::size_t> allocation_calls{ 0 };
+
+void*
+operator new( std::size_t size )
+{
+   allocated_bytes += size;
+   ++allocation_calls;
+   if( void* ptr = std::malloc( size == 0 ? 1 : size ) )
+      return ptr;
+   throw std::bad_alloc();
+}
+
+void
+operator delete( void* ptr ) noexcept
+{
+   std::free( ptr );
+}
+
+void
+operator delete( void* ptr, std::size_t ) noexcept
+{
+   std::free( ptr );
+}
+
+using namespace papilo;
+
+static constexpr int NUM_FIXED_COLS = 10;
+static constexpr int NUM_CALLS = 50;
+static constexpr int NUM_POOL_SOLUTIONS = 256;
+static constexpr int NUM_REPETITIONS = 5;
+
+/// chain problem x_i + x_{i+1} <= 1 with binary variables; the zero vector is
+/// feasible, hence every postsolved solution passes the validation
+static Problem<double>
+build_chain_problem( int ncols )
+{
+   int nrows = ncols - 1;
+   ProblemBuilder<double> builder;
+   builder.reserve( 2 * nrows, nrows, ncols );
+   builder.setNumCols( ncols );
+   builder.setNumRows( nrows );
+   for( int col = 0; col < ncols; ++col )
+   {
+      builder.setColLb( col, 0 );
+      builder.setColUb( col, 1 );
+      builder.setColIntegral( col, true );
+      builder.setObj( col, -1 );
+   }
+   for( int row = 0; row < nrows; ++row )
+   {
+      builder.addEntry( row, row, 1 );
+      builder.addEntry( row, row + 1, 1 );
+      builder.setRowLhsInf( row, true );
+      builder.setRowRhs( row, 1 );
+   }
+   return builder.build();
+}
+
+/// records NUM_FIXED_COLS fixings and removes the fixed columns from the
+/// mappings, i.e. the reduction log is independent of the problem size
+static PostsolveStorage<double>
+build_storage( const Problem<double>& problem, const Num<double>& num )
+{
+   PresolveOptions options;
+   PostsolveStorage<double> storage( problem, num, options );
+
+   const ConstraintMatrix<double>& matrix = problem.getConstraintMatrix();
+   for( int col = 0; col < NUM_FIXED_COLS; ++col )
+      storage.storeFixedCol( col, 0, matrix.getColumnCoefficients( col ),
+                             problem.getObjective().coefficients );
+
+   Vec<int> colmapping( problem.getNCols() );
+   for( int col = 0; col < problem.getNCols(); ++col )
+      colmapping[col] = col < NUM_FIXED_COLS ? -1 : col - NUM_FIXED_COLS;
+   Vec<int> rowmapping( problem.getNRows() );
+   for( int row = 0; row < problem.getNRows(); ++row )
+      rowmapping[row] = row;
+   storage.compress( rowmapping, colmapping );
+
+   return storage;
+}
+
+/// fixes every other column in a storage that keeps the dual information,
+/// i.e. the log is as long as the problem and every entry carries a payload
+static PostsolveStorage<double>
+build_long_storage( const Problem<double>& problem, const Num<double>& num )
+{
+   PresolveOptions options;
+   PostsolveStorage<double> storage( problem, num, options );
+   storage.postsolveType = PostsolveType::kFull;
+
+   const ConstraintMatrix<double>& matrix = problem.getConstraintMatrix();
+   Vec<int> colmapping( problem.getNCols() );
+   int ncols = 0;
+   for( int col = 0; col < problem.getNCols(); ++col )
+   {
+      if( col % 2 == 0 )
+      {
+         storage.storeFixedCol( col, 0, matrix.getColumnCoefficients( col ),
+                                problem.getObjective().coefficients );
+         colmapping[col] = -1;
+      }
+      else
+         colmapping[col] = ncols++;
+   }
+   Vec<int> rowmapping( problem.getNRows() );
+   for( int row = 0; row < problem.getNRows(); ++row )
+      rowmapping[row] = row;
+   storage.compress( rowmapping, colmapping );
+
+   return storage;
+}
+
+int
+main()
+{
+   Num<double> num;
+   Message msg;
+   msg.setVerbosityLevel( VerbosityLevel::kQuiet );
+   Postsolve<double> postsolve{ msg, num };
+
+   fmt::print( "{:>10} {:>10} {:>14} {:>14} {:>14} {:>12}\n", "cols", "nnz",
+               "storage [MB]", "bytes/call", "allocs/call", "time/call [us]" );
+
+   for( int ncols = 1000; ncols <= 1000000; ncols *= 10 )
+   {
+      Problem<double> problem = build_chain_problem( ncols );
+      PostsolveStorage<double> storage = build_storage( problem, num );
+
+      Solution<double> reduced{ Vec<double>( ncols - NUM_FIXED_COLS, 0.0 ) };
+      Solution<double> original;
+
+      // first call sizes the output vectors
+      if( postsolve.undo( reduced, original, storage ) != PostsolveStatus::kOk )
+      {
+         fmt::print( "postsolve failed for {} columns\n", ncols );
+         return EXIT_FAILURE;
+      }
+
+      std::size_t bytes_before = allocated_bytes;
+      std::size_t calls_before = allocation_calls;
+      double time = 0;
+      {
+         Timer timer( time );
+         for( int i = 0; i < NUM_CALLS; ++i )
+            postsolve.undo( reduced, original, storage );
+      }
+
+      double storage_mb =
+          ( problem.getConstraintMatrix().getNnz() * 2 *
+                ( sizeof( double ) + sizeof( int ) ) +
+            ncols * ( 3 * sizeof( double ) + sizeof( ColFlags ) ) ) /
+          ( 1024.0 * 1024.0 );
+      fmt::print( "{:>10} {:>10} {:>14.2f} {:>14} {:>14} {:>12.1f}\n", ncols,
+                  problem.getConstraintMatrix().getNnz(), storage_mb,
+                  ( allocated_bytes - bytes_before ) / NUM_CALLS,
+                  ( allocation_calls - calls_before ) / NUM_CALLS,
+                  time * 1e6 / NUM_CALLS );
+   }
+
+   // solution pool: NUM_POOL_SOLUTIONS solutions of a problem with 10^4 cols
+   int ncols = 10000;
+   Problem<double> problem = build_chain_problem( ncols );
+   PostsolveStorage<double> storage = build_storage( problem, num );
+   int nreduced = ncols - NUM_FIXED_COLS;
+
+   Solution<double> reduced{ Vec<double>( nreduced, 0.0 ) };
+   Solution<double> original;
+   Vec<double> reduced_pool( (std::size_t)nreduced * NUM_POOL_SOLUTIONS, 0.0 );
+   Vec<double> original_pool( (std::size_t)ncols * NUM_POOL_SOLUTIONS );
+
+   // take the best of a few repetitions to reduce the noise of the machine
+   double single_time = std::numeric_limits<double>::max();
+   double batch_time = std::numeric_limits<double>::max();
+   for( int repetition = 0; repetition < NUM_REPETITIONS; ++repetition )
+   {
+      double time = 0;
+      {
+         Timer timer( time );
+         for( int i = 0; i < NUM_POOL_SOLUTIONS; ++i )
+            postsolve.undo( reduced, original, storage );
+      }
+      single_time = std::min( single_time, time );
+
+      time = 0;
+      PostsolveStatus status;
+      {
+         Timer timer( time );
+         status = postsolve.undo_batch( reduced_pool.data(), NUM_POOL_SOLUTIONS,
+                                        original_pool.data(), storage );
+      }
+      batch_time = std::min( batch_time, time );
+      if( status != PostsolveStatus::kOk )
+      {
+         fmt::print( "batch postsolve failed\n" );
+         return EXIT_FAILURE;
+      }
+   }
+
+   fmt::print( "\n{} solutions with {} cols: {:.1f} us/solution one by one, "
+               "{:.1f} us/solution as batch\n",
+               NUM_POOL_SOLUTIONS, ncols,
+               single_time * 1e6 / NUM_POOL_SOLUTIONS,
+               batch_time * 1e6 / NUM_POOL_SOLUTIONS );
+
+   // long log: decoding the log against running the compiled program
+   Problem<double> long_problem = build_chain_problem( 100000 );
+   PostsolveStorage<double> long_storage =
+       build_long_storage( long_problem, num );
+   PostsolveProgram<double> program( long_storage );
+   Solution<double> long_reduced{ Vec<double>(
+       long_storage.origcol_mapping.size(), 0.0 ) };
+
+   double log_time = std::numeric_limits<double>::max();
+   double program_time = std::numeric_limits<double>::max();
+   for( int repetition = 0; repetition < NUM_REPETITIONS; ++repetition )
+   {
+      double time = 0;
+      {
+         Timer timer( time );
+         for( int i = 0; i < NUM_CALLS; ++i )
+            postsolve.undo( long_reduced, original, long_storage );
+      }
+      log_time = std::min( log_time, time );
+
+      time = 0;
+      {
+         Timer timer( time );
+         for( int i = 0; i < NUM_CALLS; ++i )
+            postsolve.undo( long_reduced, original, long_storage, program );
+      }
+      program_time = std::min( program_time, time );
+   }
+
+   fmt::print( "{} reductions: {:.1f} us/call decoding the log, {:.1f} "
+               "us/call with the compiled program ({} instructions)\n",
+               long_storage.types.size(), log_time * 1e6 / NUM_CALLS,
+               program_time * 1e6 / NUM_CALLS, program.instructions.size() );
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,467 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Presolves every instance in check/instances/{LP,MIP,IP} (or the given
+ * directories) with the default presolvers and writes the results as JSON:
+ * the median wall time over the repetitions, the rounds, the peak resident
+ * set size, the reduced problem size and the calls, time and transactions of
+ * every presolver. Given a baseline written by an earlier run, the instances
+ * whose median time grew by more than the tolerance or whose reduced problem
+ * differs are reported and the exit code is nonzero.
+ *
+ * usage: papilo_bench [--threads <n>] [--repetitions <n>] [--output <file>]
+ *                     [--baseline <file>] [--tolerance <fraction>]
+ *                     [--min-time <seconds>] [--filter <substring>]
+ *                     [--set <key>=<value>]... [<directory>...]
+ */
+
+#include "papilo/core/Presolve.hpp"
+#include "papilo/io/Parser.hpp"
+#include "papilo/misc/fmt.hpp"
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace papilo;
+
+struct BenchOptions
+{
+   int threads = 1;
+   int repetitions = 3;
+   std::string output;
+   std::string baseline;
+   double tolerance = 0.1;
+   /// time differences below this many seconds are never a regression
+   double min_time = 0.005;
+   std::string filter;
+   std::vector<std::pair<std::string, std::string>> params;
+   std::vector<std::string> directories;
+};
+
+struct PresolverResult
+{
+   std::string name;
+   int calls = 0;
+   int successful_calls = 0;
+   double time = 0;
+   int transactions = 0;
+   int applied = 0;
+};
+
+struct InstanceResult
+{
+   std::string name;
+   std::string status;
+   std::vector<double> times;
+   double time = 0;
+   int rounds = 0;
+   long peak_rss_kb = -1;
+   int rows = 0;
+   int cols = 0;
+   int nnz = 0;
+   int reduced_rows = 0;
+   int reduced_cols = 0;
+   int reduced_nnz = 0;
+   int tsx_applied = 0;
+   int tsx_conflicts = 0;
+   std::vector<PresolverResult> presolvers;
+};
+
+static const char*
+status_name( PresolveStatus status )
+{
+   switch( status )
+   {
+   case PresolveStatus::kUnchanged:
+      return "unchanged";
+   case PresolveStatus::kReduced:
+      return "reduced";
+   case PresolveStatus::kUnbndOrInfeas:
+      return "unbounded or infeasible";
+   case PresolveStatus::kUnbounded:
+      return "unbounded";
+   case PresolveStatus::kInfeasible:
+      return "infeasible";
+   }
+   return "unknown";
+}
+
+/// files of the directory with an extension the parser understands, sorted
+static std::vector<std::string>
+list_instances( const std::string& directory )
+{
+   std::vector<std::string> files;
+   DIR* dir = opendir( directory.c_str() );
+   if( dir == nullptr )
+      return files;
+
+   while( dirent* entry = readdir( dir ) )
+   {
+      std::string name = entry->d_name;
+      if( name.find( ".mps" ) != std::string::npos ||
+          name.find( ".opb" ) != std::string::npos )
+         files.push_back( directory + "/" + name );
+   }
+   closedir( dir );
+
+   std::sort( files.begin(), files.end() );
+   return files;
+}
+
+/// resets the peak resident set size of the process, returns false if the
+/// kernel does not support it
+static bool
+reset_peak_rss()
+{
+   std::ofstream clear_refs( "/proc/self/clear_refs" );
+   clear_refs << "5";
+   clear_refs.close();
+   return static_cast<bool>( clear_refs );
+}
+
+/// peak resident set size in KiB, -1 if it is not available
+static long
+peak_rss_kb()
+{
+   std::ifstream status( "/proc/self/status" );
+   for( std::string line; std::getline( status, line ); )
+   {
+      if( line.compare( 0, 6, "VmHWM:" ) == 0 )
+         return std::atol( line.c_str() + 6 );
+   }
+   return -1;
+}
+
+static bool
+presolve_instance( const BenchOptions& options, const std::string& filename,
+                   InstanceResult& result )
+{
+   bool rss_reset = false;
+
+   for( int rep = 0; rep != options.repetitions; ++rep )
+   {
+      boost::optional<Problem<double>> problem =
+          Parser<double>::loadProblem( filename );
+      if( !problem )
+         return false;
+
+      result.rows = problem->getNRows();
+      result.cols = problem->getNCols();
+      result.nnz = problem->getConstraintMatrix().getNnz();
+
+      Presolve<double> presolve;
+      presolve.addDefaultPresolvers();
+      presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+      presolve.getPresolveOptions().threads = options.threads;
+      ParameterSet paramSet = presolve.getParameters();
+      for( const auto& param : options.params )
+         paramSet.parseParameter( param.first.c_str(), param.second.c_str() );
+
+      if( rep == 0 )
+         rss_reset = reset_peak_rss();
+
+      auto start = std::chrono::steady_clock::now();
+      PresolveResult<double> presolved = presolve.apply( *problem );
+      std::chrono::duration<double> time =
+          std::chrono::steady_clock::now() - start;
+      result.times.push_back( time.count() );
+
+      if( rep == 0 && rss_reset )
+         result.peak_rss_kb = peak_rss_kb();
+
+      // the reduced problem is deterministic, hence the last repetition is
+      // reported
+      const Statistics& stats = presolve.getStatistics();
+      result.status = status_name( presolved.status );
+      result.rounds = stats.nrounds;
+      result.reduced_rows = problem->getNRows();
+      result.reduced_cols = problem->getNCols();
+      result.reduced_nnz = problem->getConstraintMatrix().getNnz();
+      result.tsx_applied = stats.ntsxapplied;
+      result.tsx_conflicts = stats.ntsxconflicts;
+
+      const auto& presolvers = presolve.getPresolvers();
+      const auto& presolverStats = presolve.getPresolverStats();
+      result.presolvers.resize( presolvers.size() );
+      for( std::size_t i = 0; i != presolvers.size(); ++i )
+      {
+         PresolverResult& presolver = result.presolvers[i];
+         presolver.name = presolvers[i]->getName();
+         presolver.calls = presolvers[i]->getNCalls();
+         presolver.successful_calls = presolvers[i]->getNSuccess();
+         presolver.time += presolvers[i]->getExecTime() / options.repetitions;
+         presolver.transactions = presolverStats[i].first;
+         presolver.applied = presolverStats[i].second;
+      }
+   }
+
+   std::vector<double> sorted = result.times;
+   std::sort( sorted.begin(), sorted.end() );
+   result.time = sorted[( sorted.size() - 1 ) / 2];
+   return true;
+}
+
+static void
+write_json( std::FILE* out, const BenchOptions& options,
+            const std::vector<InstanceResult>& results )
+{
+   fmt::print( out, "{{\n  \"threads\": {},\n  \"repetitions\": {},\n"
+                    "  \"instances\": [",
+               options.threads, options.repetitions );
+
+   for( std::size_t i = 0; i != results.size(); ++i )
+   {
+      const InstanceResult& result = results[i];
+      fmt::print( out, "{}\n    {{\n      \"name\": \"{}\",\n", i == 0 ? "" : ",",
+                  result.name );
+      fmt::print( out, "      \"status\": \"{}\",\n", result.status );
+      fmt::print( out, "      \"time\": {:.6f},\n      \"times\": [{:.6f}],\n",
+                  result.time, fmt::join( result.times, ", " ) );
+      fmt::print( out, "      \"rounds\": {},\n      \"peak_rss_kb\": {},\n",
+                  result.rounds, result.peak_rss_kb );
+      fmt::print( out,
+                  "      \"rows\": {},\n      \"cols\": {},\n"
+                  "      \"nnz\": {},\n",
+                  result.rows, result.cols, result.nnz );
+      fmt::print( out,
+                  "      \"reduced_rows\": {},\n      \"reduced_cols\": {},\n"
+                  "      \"reduced_nnz\": {},\n",
+                  result.reduced_rows, result.reduced_cols,
+                  result.reduced_nnz );
+      fmt::print( out,
+                  "      \"tsx_applied\": {},\n      \"tsx_conflicts\": {},\n",
+                  result.tsx_applied, result.tsx_conflicts );
+      fmt::print( out, "      \"presolvers\": [" );
+      for( std::size_t k = 0; k != result.presolvers.size(); ++k )
+      {
+         const PresolverResult& presolver = result.presolvers[k];
+         fmt::print( out,
+                     "{}\n        {{ \"name\": \"{}\", \"calls\": {}, "
+                     "\"successful_calls\": {}, \"time\": {:.6f}, "
+                     "\"transactions\": {}, \"applied\": {} }}",
+                     k == 0 ? "" : ",", presolver.name, presolver.calls,
+                     presolver.successful_calls, presolver.time,
+                     presolver.transactions, presolver.applied );
+      }
+      fmt::print( out, "\n      ]\n    }}" );
+   }
+
+   fmt::print( out, "\n  ]\n}}\n" );
+}
+
+/// returns the number of regressions against the baseline
+static int
+compare_with_baseline( const BenchOptions& options,
+                       const std::vector<InstanceResult>& results )
+{
+   boost::property_tree::ptree baseline;
+   boost::property_tree::read_json( options.baseline, baseline );
+
+   if( baseline.get<int>( "threads" ) != options.threads )
+      fmt::print( stderr, "warning: the baseline used {} threads\n",
+                  baseline.get<int>( "threads" ) );
+
+   std::map<std::string, const boost::property_tree::ptree*> instances;
+   for( const auto& child : baseline.get_child( "instances" ) )
+      instances[child.second.get<std::string>( "name" )] = &child.second;
+
+   int nregressions = 0;
+   fmt::print( stderr, "\n{:<28} {:>12} {:>12} {:>8}  {}\n", "instance",
+               "base [s]", "time [s]", "change", "result" );
+   for( const InstanceResult& result : results )
+   {
+      auto it = instances.find( result.name );
+      if( it == instances.end() )
+      {
+         fmt::print( stderr, "{:<28} {:>12} {:>12.4f} {:>8}  new\n",
+                     result.name, "-", result.time, "-" );
+         continue;
+      }
+
+      const boost::property_tree::ptree& base = *it->second;
+      const double base_time = base.get<double>( "time" );
+      const double change =
+          base_time > 0 ? result.time / base_time - 1.0 : 0.0;
+
+      const char* verdict = "ok";
+      if( base.get<std::string>( "status" ) != result.status ||
+          base.get<int>( "reduced_rows" ) != result.reduced_rows ||
+          base.get<int>( "reduced_cols" ) != result.reduced_cols ||
+          base.get<int>( "reduced_nnz" ) != result.reduced_nnz )
+         verdict = "REDUCED PROBLEM CHANGED";
+      else if( change > options.tolerance &&
+               result.time - base_time > options.min_time )
+         verdict = "SLOWER";
+      else if( change < -options.tolerance &&
+               base_time - result.time > options.min_time )
+         verdict = "faster";
+
+      if( verdict[0] != 'o' && verdict[0] != 'f' )
+         ++nregressions;
+
+      fmt::print( stderr, "{:<28} {:>12.4f} {:>12.4f} {:>7.1f}%  {}\n",
+                  result.name, base_time, result.time, 100.0 * change,
+                  verdict );
+   }
+
+   fmt::print( stderr, "\n{} regressions with a tolerance of {:.1f}%\n",
+               nregressions, 100.0 * options.tolerance );
+   return nregressions;
+}
+
+static bool
+parse_options( int argc, char* argv[], BenchOptions& options )
+{
+   for( int i = 1; i < argc; ++i )
+   {
+      const bool has_value = i + 1 < argc;
+      if( std::strcmp( argv[i], "--threads" ) == 0 && has_value )
+         options.threads = std::atoi( argv[++i] );
+      else if( std::strcmp( argv[i], "--repetitions" ) == 0 && has_value )
+         options.repetitions = std::max( 1, std::atoi( argv[++i] ) );
+      else if( std::strcmp( argv[i], "--output" ) == 0 && has_value )
+         options.output = argv[++i];
+      else if( std::strcmp( argv[i], "--baseline" ) == 0 && has_value )
+         options.baseline = argv[++i];
+      else if( std::strcmp( argv[i], "--tolerance" ) == 0 && has_value )
+         options.tolerance = std::atof( argv[++i] );
+      else if( std::strcmp( argv[i], "--min-time" ) == 0 && has_value )
+         options.min_time = std::atof( argv[++i] );
+      else if( std::strcmp( argv[i], "--filter" ) == 0 && has_value )
+         options.filter = argv[++i];
+      else if( std::strcmp( argv[i], "--set" ) == 0 && has_value )
+      {
+         std::string param = argv[++i];
+         std::size_t pos = param.find( '=' );
+         if( pos == std::string::npos )
+            return false;
+         options.params.emplace_back( param.substr( 0, pos ),
+                                      param.substr( pos + 1 ) );
+      }
+      else if( argv[i][0] == '-' )
+         return false;
+      else
+         options.directories.push_back( argv[i] );
+   }
+
+   if( options.directories.empty() )
+   {
+      for( const char* set : { "LP", "MIP", "IP" } )
+         options.directories.push_back(
+             std::string( PAPILO_CHECK_INSTANCES_DIR ) + "/" + set );
+   }
+   return true;
+}
+
+int
+main( int argc, char* argv[] )
+{
+   BenchOptions options;
+   if( !parse_options( argc, argv, options ) )
+   {
+      fmt::print( stderr,
+                  "usage: {} [--threads <n>] [--repetitions <n>] "
+                  "[--output <file>]\n"
+                  "       [--baseline <file>] [--tolerance <fraction>] "
+                  "[--min-time <seconds>]\n"
+                  "       [--filter <substring>] [--set <key>=<value>]... "
+                  "[<directory>...]\n",
+                  argv[0] );
+      return EXIT_FAILURE;
+   }
+
+   std::vector<InstanceResult> results;
+   for( const std::string& directory : options.directories )
+   {
+      // instances are named by their directory and file name
+      std::string set = directory.substr( directory.find_last_of( '/' ) + 1 );
+      for( const std::string& filename : list_instances( directory ) )
+      {
+         std::string name =
+             set + "/" + filename.substr( filename.find_last_of( '/' ) + 1 );
+         if( name.find( options.filter ) == std::string::npos )
+            continue;
+
+         InstanceResult result;
+         result.name = name;
+         try
+         {
+            if( !presolve_instance( options, filename, result ) )
+            {
+               fmt::print( stderr, "could not read {}\n", filename );
+               continue;
+            }
+         }
+         catch( const std::exception& e )
+         {
+            fmt::print( stderr, "{}: {}\n", name, e.what() );
+            return EXIT_FAILURE;
+         }
+
+         fmt::print( stderr, "{:<28} {:>10.4f} s {:>5} rounds  {}\n", name,
+                     result.time, result.rounds, result.status );
+         results.push_back( std::move( result ) );
+      }
+   }
+
+   if( options.output.empty() )
+      write_json( stdout, options, results );
+   else
+   {
+      std::FILE* out = std::fopen( options.output.c_str(), "w" );
+      if( out == nullptr )
+      {
+         fmt::print( stderr, "could not write {}\n", options.output );
+         return EXIT_FAILURE;
+      }
+      write_json( out, options, results );
+      std::fclose( out );
+   }
+
+   if( !options.baseline.empty() )
+   {
+      try
+      {
+         if( compare_with_baseline( options, results ) != 0 )
+            return EXIT_FAILURE;
+      }
+      catch( const std::exception& e )
+      {
+         fmt::print( stderr, "could not read the baseline {}: {}\n",
+                     options.baseline, e.what() );
+         return EXIT_FAILURE;
+      }
+   }
+
+   return EXIT_SUCCESS;
+}
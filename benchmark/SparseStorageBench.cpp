@@ -0,0 +1,290 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Measures how SparseStorage::getTranspose() and SparseStorage::compress()
+ * scale with the number of threads. The matrices are either the constraint
+ * matrices of the given MPS files or, with --random <rows> <cols> <nnz per
+ * row>, a random matrix. Only matrices with at least 100000 nonzeros are
+ * split into blocks, so the instances in check/instances are too small to
+ * show any speedup. For every thread count the transpose is computed and a
+ * copy of the matrix is compressed fully after deleting every third row. The
+ * results are checked to be identical for all thread counts.
+ *
+ * Afterwards the memory of the row and column major storage is reported for
+ * different settings of the spare space that is kept for fill-in, i.e. the
+ * parameters presolve.spareratio and presolve.minrowspace, together with the
+ * memory that is saved compared to the default. The compact setting is the
+ * one of the copy of the original problem that is kept for postsolve and of
+ * the reduced problem.
+ */
+
+#include "papilo/core/Problem.hpp"
+#include "papilo/core/SparseStorage.hpp"
+#include "papilo/io/MpsParser.hpp"
+#include "papilo/misc/Timer.hpp"
+#include "papilo/misc/fmt.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace papilo;
+
+static constexpr int NUM_REPETITIONS = 10;
+static const int THREADS[] = { 1, 2, 4, 8, 16, 32 };
+
+static bool
+same_storage( const SparseStorage<double>& a, const SparseStorage<double>& b )
+{
+   if( a.getNRows() != b.getNRows() || a.getNAlloc() != b.getNAlloc() )
+      return false;
+
+   for( int r = 0; r != a.getNRows(); ++r )
+   {
+      const IndexRange& ra = a.getRowRanges()[r];
+      const IndexRange& rb = b.getRowRanges()[r];
+      if( ra.start != rb.start || ra.end != rb.end )
+         return false;
+      if( std::memcmp( a.getColumns() + ra.start, b.getColumns() + ra.start,
+                       sizeof( int ) * ( ra.end - ra.start ) ) != 0 ||
+          std::memcmp( a.getValues() + ra.start, b.getValues() + ra.start,
+                       sizeof( double ) * ( ra.end - ra.start ) ) != 0 )
+         return false;
+   }
+
+   return true;
+}
+
+static SparseStorage<double>
+random_matrix( int nrows, int ncols, int rowlength )
+{
+   uint64_t seed = 42;
+   auto random = [&seed]() {
+      seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+      return static_cast<int>( seed >> 33 );
+   };
+
+   Vec<Triplet<double>> entries;
+   entries.reserve( size_t( nrows ) * rowlength );
+   const int maxgap = std::max( 1, 2 * ncols / std::max( rowlength, 1 ) );
+   for( int r = 0; r != nrows; ++r )
+   {
+      for( int c = random() % maxgap; c < ncols; c += 1 + random() % maxgap )
+         entries.emplace_back( r, c, 1.0 + random() % 100 );
+   }
+
+   return SparseStorage<double>{ entries, nrows, ncols, true };
+}
+
+struct SpareSpace
+{
+   const char* name;
+   double ratio;
+   int mininterrowspace;
+};
+
+static const SpareSpace SPARE_SPACES[] = {
+    { "default", SparseStorage<double>::DEFAULT_SPARE_RATIO,
+      SparseStorage<double>::DEFAULT_MIN_INTER_ROW_SPACE },
+    { "ratio 1.5", 1.5, SparseStorage<double>::DEFAULT_MIN_INTER_ROW_SPACE },
+    { "ratio 1.2", 1.2, 2 },
+    { "compact", 1.0, 0 } };
+
+static void
+report_memory( const std::string& name, const SparseStorage<double>& matrix )
+{
+   Vec<int> rowsize( matrix.getNRows() );
+   Vec<int> colsize( matrix.getNCols(), 0 );
+   for( int r = 0; r != matrix.getNRows(); ++r )
+      rowsize[r] = matrix.getRowRanges()[r].end - matrix.getRowRanges()[r].start;
+
+   std::size_t default_total = 0;
+   for( const SpareSpace& spare : SPARE_SPACES )
+   {
+      // the storage is built with the default spare space and shrinks to the
+      // configured one with the first compression
+      SparseStorage<double> rowmajor{ matrix };
+      rowmajor.setSpareSpace( spare.ratio, spare.mininterrowspace );
+      rowmajor.compress( rowsize, colsize );
+      const SparseStorage<double> colmajor = rowmajor.getTranspose();
+
+      const std::size_t total =
+          rowmajor.getMemoryUsage() + colmajor.getMemoryUsage();
+      if( default_total == 0 )
+         default_total = total;
+
+      fmt::print( "{:<20} {:>10} {:>10} {:>14.1f} {:>14.1f} {:>14.1f} "
+                  "{:>8.1f}\n",
+                  name, matrix.getNnz(), spare.name,
+                  rowmajor.getMemoryUsage() / 1024.0,
+                  colmajor.getMemoryUsage() / 1024.0, total / 1024.0,
+                  100.0 * ( 1.0 - double( total ) / default_total ) );
+   }
+}
+
+static bool
+run( const std::string& name, const SparseStorage<double>& matrix )
+{
+   // delete every third row, the columns are kept
+   Vec<int> rowsize( matrix.getNRows() );
+   Vec<int> colsize( matrix.getNCols(), 0 );
+   for( int r = 0; r != matrix.getNRows(); ++r )
+   {
+      const IndexRange& range = matrix.getRowRanges()[r];
+      rowsize[r] = r % 3 == 0 ? -1 : range.end - range.start;
+   }
+
+   SparseStorage<double> reference_transpose;
+   SparseStorage<double> reference_compressed;
+   double transpose_base = 0;
+   double compress_base = 0;
+   bool identical = true;
+
+   for( int nthreads : THREADS )
+   {
+      double transpose_time = 0;
+      double compress_time = 0;
+
+      auto measure = [&]() {
+         SparseStorage<double> transpose;
+         for( int i = 0; i != NUM_REPETITIONS; ++i )
+         {
+            Timer timer( transpose_time );
+            transpose = matrix.getTranspose();
+         }
+
+         SparseStorage<double> compressed;
+         for( int i = 0; i != NUM_REPETITIONS; ++i )
+         {
+            compressed = matrix;
+            Timer timer( compress_time );
+            compressed.compress( rowsize, colsize, true );
+         }
+
+         if( nthreads == THREADS[0] )
+         {
+            reference_transpose = std::move( transpose );
+            reference_compressed = std::move( compressed );
+         }
+         else if( !same_storage( transpose, reference_transpose ) ||
+                  !same_storage( compressed, reference_compressed ) )
+            identical = false;
+      };
+
+#ifdef PAPILO_TBB
+      tbb::task_arena arena( nthreads );
+      arena.execute( measure );
+#else
+      if( nthreads != THREADS[0] )
+         break;
+      measure();
+#endif
+
+      transpose_time /= NUM_REPETITIONS;
+      compress_time /= NUM_REPETITIONS;
+      if( nthreads == THREADS[0] )
+      {
+         transpose_base = transpose_time;
+         compress_base = compress_time;
+      }
+
+      fmt::print( "{:<20} {:>8} {:>10} {:>8} {:>14.3f} {:>8.2f} {:>14.3f} "
+                  "{:>8.2f}\n",
+                  name, matrix.getNRows(), matrix.getNnz(), nthreads,
+                  transpose_time * 1e3, transpose_base / transpose_time,
+                  compress_time * 1e3, compress_base / compress_time );
+   }
+
+   return identical;
+}
+
+int
+main( int argc, char* argv[] )
+{
+   if( argc < 2 )
+   {
+      fmt::print( "usage: {} <mps file>...\n"
+                  "       {} --random <rows> <cols> <nnz per row>\n",
+                  argv[0], argv[0] );
+      return EXIT_FAILURE;
+   }
+
+   fmt::print( "{:<20} {:>8} {:>10} {:>8} {:>14} {:>8} {:>14} {:>8}\n",
+               "instance", "rows", "nnz", "threads", "transpose [ms]",
+               "speedup", "compress [ms]", "speedup" );
+
+   bool identical = true;
+   Vec<std::pair<std::string, SparseStorage<double>>> matrices;
+
+   if( std::strcmp( argv[1], "--random" ) == 0 )
+   {
+      if( argc != 5 )
+      {
+         fmt::print( "--random expects <rows> <cols> <nnz per row>\n" );
+         return EXIT_FAILURE;
+      }
+
+      SparseStorage<double> matrix = random_matrix(
+          std::atoi( argv[2] ), std::atoi( argv[3] ), std::atoi( argv[4] ) );
+      identical = run( "random", matrix );
+      matrices.emplace_back( "random", std::move( matrix ) );
+   }
+   else
+   {
+      for( int i = 1; i < argc; ++i )
+      {
+         boost::optional<Problem<double>> prob =
+             MpsParser<double>::loadProblem( argv[i] );
+         if( !prob )
+         {
+            fmt::print( "could not read {}\n", argv[i] );
+            return EXIT_FAILURE;
+         }
+
+         std::string name = argv[i];
+         name = name.substr( name.find_last_of( '/' ) + 1 );
+
+         const SparseStorage<double>& matrix =
+             prob->getConstraintMatrix().getConstraintMatrix();
+         if( matrix.getNnz() == 0 )
+            continue;
+
+         identical = run( name, matrix ) && identical;
+         matrices.emplace_back( name, matrix );
+      }
+   }
+
+   fmt::print( "\n{:<20} {:>10} {:>10} {:>14} {:>14} {:>14} {:>8}\n",
+               "instance", "nnz", "spare", "rows [KiB]", "cols [KiB]",
+               "total [KiB]", "saved %" );
+   for( const auto& matrix : matrices )
+      report_memory( matrix.first, matrix.second );
+
+   if( !identical )
+   {
+      fmt::print( "results differ between the thread counts\n" );
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
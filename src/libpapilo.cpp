@@ -30,10 +30,13 @@
 #include "papilo/core/Reductions.hpp"
 #include "papilo/core/Solution.hpp"
 #include "papilo/core/Statistics.hpp"
+#include "papilo/core/postsolve/MappedPostsolveStorage.hpp"
 #include "papilo/core/postsolve/Postsolve.hpp"
+#include "papilo/core/postsolve/PostsolveProgram.hpp"
 #include "papilo/core/postsolve/PostsolveStatus.hpp"
 #include "papilo/core/postsolve/PostsolveStorage.hpp"
 #include "papilo/io/Message.hpp"
+#include "papilo/io/ProblemSnapshot.hpp"
 #include "papilo/misc/Num.hpp"
 #include "papilo/misc/Timer.hpp"
 #include "papilo/misc/Vec.hpp"
@@ -203,6 +206,23 @@ struct libpapilo_postsolve_t
    }
 };
 
+struct libpapilo_postsolve_program_t
+{
+   uint64_t magic_number = LIBPAPILO_MAGIC_NUMBER;
+   PostsolveProgram<double> program;
+
+   libpapilo_postsolve_program_t( const PostsolveStorage<double>& storage )
+       : program( storage )
+   {
+   }
+};
+
+struct libpapilo_mapped_postsolve_storage_t
+{
+   uint64_t magic_number = LIBPAPILO_MAGIC_NUMBER;
+   MappedPostsolveStorage<double> storage;
+};
+
 /** Custom assert also working on release build */
 void
 custom_assert( bool condition, const char* message )
@@ -382,6 +402,27 @@ check_postsolve_ptr( const libpapilo_postsolve_t* postsolve )
        "Invalid libpapilo_postsolve_t pointer (magic number mismatch)" );
 }
 
+static void
+check_postsolve_program_ptr( const libpapilo_postsolve_program_t* program )
+{
+   custom_assert( program != nullptr,
+                  "libpapilo_postsolve_program_t pointer is null" );
+   custom_assert( program->magic_number == LIBPAPILO_MAGIC_NUMBER,
+                  "Invalid libpapilo_postsolve_program_t pointer (magic "
+                  "number mismatch)" );
+}
+
+static void
+check_mapped_postsolve_storage_ptr(
+    const libpapilo_mapped_postsolve_storage_t* storage )
+{
+   custom_assert( storage != nullptr,
+                  "libpapilo_mapped_postsolve_storage_t pointer is null" );
+   custom_assert( storage->magic_number == LIBPAPILO_MAGIC_NUMBER,
+                  "Invalid libpapilo_mapped_postsolve_storage_t pointer "
+                  "(magic number mismatch)" );
+}
+
 template <typename Func>
 auto
 check_run( Func func, const char* message )
@@ -478,6 +519,35 @@ convert_postsolve_status( PostsolveStatus status )
    }
 }
 
+static libpapilo_problem_t*
+create_problem_from_compressed( int nrows, int ncols, const int* start,
+                                const int* indices, const double* vals,
+                                const double* obj, const double* lbs,
+                                const double* ubs, const double* lhs,
+                                const double* rhs, const uint8_t* is_integral,
+                                bool csc )
+{
+   libpapilo_problem_builder_t builder;
+   libpapilo_problem_builder_set_num_rows( &builder, nrows );
+   libpapilo_problem_builder_set_num_cols( &builder, ncols );
+   libpapilo_problem_builder_set_obj_all( &builder, obj );
+   libpapilo_problem_builder_set_col_lb_all( &builder, lbs );
+   libpapilo_problem_builder_set_col_ub_all( &builder, ubs );
+   libpapilo_problem_builder_set_row_lhs_all( &builder, lhs );
+   libpapilo_problem_builder_set_row_rhs_all( &builder, rhs );
+   if( is_integral != nullptr )
+      libpapilo_problem_builder_set_col_integral_all( &builder, is_integral );
+
+   if( csc )
+      libpapilo_problem_builder_set_matrix_csc( &builder, start, indices,
+                                                vals );
+   else
+      libpapilo_problem_builder_set_matrix_csr( &builder, start, indices,
+                                                vals );
+
+   return libpapilo_problem_builder_build( &builder );
+}
+
 extern "C"
 {
 
@@ -852,6 +922,54 @@ extern "C"
       }
    }
 
+   void
+   libpapilo_problem_builder_set_matrix_csr(
+       libpapilo_problem_builder_t* builder, const int* row_start,
+       const int* cols, const double* vals )
+   {
+      check_problem_builder_ptr( builder );
+      custom_assert( row_start != nullptr,
+                     "libpapilo_problem_builder_set_matrix_csr: row_start "
+                     "pointer is null" );
+      custom_assert(
+          cols != nullptr,
+          "libpapilo_problem_builder_set_matrix_csr: cols pointer is null" );
+      custom_assert(
+          vals != nullptr,
+          "libpapilo_problem_builder_set_matrix_csr: vals pointer is null" );
+      check_run(
+          [&]()
+          {
+             builder->builder.setMatrixCSR( row_start, cols, vals );
+             return 0;
+          },
+          "Failed to set matrix" );
+   }
+
+   void
+   libpapilo_problem_builder_set_matrix_csc(
+       libpapilo_problem_builder_t* builder, const int* col_start,
+       const int* rows, const double* vals )
+   {
+      check_problem_builder_ptr( builder );
+      custom_assert( col_start != nullptr,
+                     "libpapilo_problem_builder_set_matrix_csc: col_start "
+                     "pointer is null" );
+      custom_assert(
+          rows != nullptr,
+          "libpapilo_problem_builder_set_matrix_csc: rows pointer is null" );
+      custom_assert(
+          vals != nullptr,
+          "libpapilo_problem_builder_set_matrix_csc: vals pointer is null" );
+      check_run(
+          [&]()
+          {
+             builder->builder.setMatrixCSC( col_start, rows, vals );
+             return 0;
+          },
+          "Failed to set matrix" );
+   }
+
    void
    libpapilo_problem_builder_set_problem_name(
        libpapilo_problem_builder_t* builder, const char* name )
@@ -944,6 +1062,32 @@ extern "C"
           "Failed to build problem" );
    }
 
+   libpapilo_problem_t*
+   libpapilo_problem_create_from_csr( int nrows, int ncols,
+                                      const int* row_start, const int* cols,
+                                      const double* vals, const double* obj,
+                                      const double* lbs, const double* ubs,
+                                      const double* lhs, const double* rhs,
+                                      const uint8_t* is_integral )
+   {
+      return create_problem_from_compressed( nrows, ncols, row_start, cols,
+                                             vals, obj, lbs, ubs, lhs, rhs,
+                                             is_integral, false );
+   }
+
+   libpapilo_problem_t*
+   libpapilo_problem_create_from_csc( int nrows, int ncols,
+                                      const int* col_start, const int* rows,
+                                      const double* vals, const double* obj,
+                                      const double* lbs, const double* ubs,
+                                      const double* lhs, const double* rhs,
+                                      const uint8_t* is_integral )
+   {
+      return create_problem_from_compressed( nrows, ncols, col_start, rows,
+                                             vals, obj, lbs, ubs, lhs, rhs,
+                                             is_integral, true );
+   }
+
    void
    libpapilo_problem_free( libpapilo_problem_t* problem )
    {
@@ -1176,6 +1320,80 @@ extern "C"
       return flags[col].test( papilo::ColFlag::kSubstituted ) ? 1 : 0;
    }
 
+   size_t
+   libpapilo_problem_get_num_implications( const libpapilo_problem_t* problem )
+   {
+      check_problem_ptr( problem );
+      return problem->problem.getImplications().getNumImplications();
+   }
+
+   int
+   libpapilo_problem_get_implications( const libpapilo_problem_t* problem,
+                                       int col, int value, const int** cols,
+                                       const uint8_t** upper,
+                                       const double** bounds )
+   {
+      check_problem_ptr( problem );
+
+      if( col < 0 || col >= problem->problem.getNCols() )
+         return -1;
+
+      papilo::ImplicationView<double> view =
+          problem->problem.getImplications().getImplications( col,
+                                                              value != 0 );
+
+      if( cols != nullptr )
+         *cols = view.getColumns();
+      if( upper != nullptr )
+         *upper = view.getUpper();
+      if( bounds != nullptr )
+         *bounds = view.getBounds();
+
+      return view.getLength();
+   }
+
+   void
+   libpapilo_problem_add_implication( libpapilo_problem_t* problem,
+                                      int bincol, int value, int col,
+                                      int upper, double bound )
+   {
+      check_problem_ptr( problem );
+      const int ncols = problem->problem.getNCols();
+      custom_assert( bincol >= 0 && bincol < ncols,
+                     "binary column index out of range" );
+      custom_assert( col >= 0 && col < ncols && col != bincol,
+                     "column index out of range" );
+
+      auto& implications = problem->problem.getImplications();
+      implications.add( papilo::Implication<double>( bincol, value != 0, col,
+                                                     upper != 0, bound ) );
+      implications.flush( problem->problem.getVariableDomains() );
+   }
+
+   int
+   libpapilo_problem_get_components( const libpapilo_problem_t* problem,
+                                     int* col_component, int* row_component )
+   {
+      check_problem_ptr( problem );
+      const Problem<double>& prob = problem->problem;
+
+      ComponentTracker components;
+      components.rebuild( prob );
+
+      if( col_component != nullptr )
+      {
+         for( int col = 0; col != prob.getNCols(); ++col )
+            col_component[col] = components.getColComponent( col );
+      }
+      if( row_component != nullptr )
+      {
+         for( int row = 0; row != prob.getNRows(); ++row )
+            row_component[row] = components.getRowComponent( row );
+      }
+
+      return components.getNumComponents();
+   }
+
    double*
    libpapilo_problem_get_objective_coefficients_mutable(
        libpapilo_problem_t* problem, size_t* size )
@@ -1211,6 +1429,42 @@ extern "C"
       return rhs.data();
    }
 
+   void
+   libpapilo_problem_write_snapshot( const libpapilo_problem_t* problem,
+                                     const char* filename )
+   {
+      check_problem_ptr( problem );
+      custom_assert( filename != nullptr, "filename pointer is null" );
+
+      bool written = check_run(
+          [&]()
+          {
+             return ProblemSnapshot<double>::writeProb( filename,
+                                                        problem->problem );
+          },
+          "Failed to write problem snapshot" );
+      custom_assert( written, "Failed to write problem snapshot" );
+   }
+
+   libpapilo_problem_t*
+   libpapilo_problem_read_snapshot( const char* filename )
+   {
+      custom_assert( filename != nullptr, "filename pointer is null" );
+
+      return check_run(
+          [&]()
+          {
+             boost::optional<Problem<double>> snapshot =
+                 ProblemSnapshot<double>::loadProblem( filename );
+             if( !snapshot )
+                return static_cast<libpapilo_problem_t*>( nullptr );
+             auto* problem = new libpapilo_problem_t();
+             problem->problem = std::move( *snapshot );
+             return problem;
+          },
+          "Failed to read problem snapshot" );
+   }
+
    int
    libpapilo_problem_get_row_entries( const libpapilo_problem_t* problem,
                                       int row, const int** cols,
@@ -1320,6 +1574,22 @@ extern "C"
       return options->options.randomseed;
    }
 
+   void
+   libpapilo_presolve_options_set_trace_file(
+       libpapilo_presolve_options_t* options, const char* filename )
+   {
+      check_presolve_options_ptr( options );
+      options->options.trace_file = filename == nullptr ? "" : filename;
+   }
+
+   const char*
+   libpapilo_presolve_options_get_trace_file(
+       const libpapilo_presolve_options_t* options )
+   {
+      check_presolve_options_ptr( options );
+      return options->options.trace_file.c_str();
+   }
+
    /* Core Presolve API Implementation */
 
    libpapilo_presolve_t*
@@ -2110,6 +2380,64 @@ extern "C"
           "Failed to get single_matrix_coefficient_changes" );
    }
 
+   size_t
+   libpapilo_statistics_get_num_round_utilizations(
+       const libpapilo_statistics_t* statistics )
+   {
+      return check_run(
+          [&]()
+          {
+             check_statistics_ptr( statistics );
+             return statistics->statistics.round_utilization.size();
+          },
+          "Failed to get number of round utilizations" );
+   }
+
+   double
+   libpapilo_statistics_get_round_utilization(
+       const libpapilo_statistics_t* statistics, size_t round )
+   {
+      return check_run(
+          [&]()
+          {
+             check_statistics_ptr( statistics );
+             custom_assert(
+                 round < statistics->statistics.round_utilization.size(),
+                 "Round index out of range" );
+             return statistics->statistics.round_utilization[round];
+          },
+          "Failed to get round utilization" );
+   }
+
+   size_t
+   libpapilo_statistics_get_num_round_components(
+       const libpapilo_statistics_t* statistics )
+   {
+      return check_run(
+          [&]()
+          {
+             check_statistics_ptr( statistics );
+             return statistics->statistics.round_components.size();
+          },
+          "Failed to get number of round components" );
+   }
+
+   int
+   libpapilo_statistics_get_round_components(
+       const libpapilo_statistics_t* statistics, size_t round )
+   {
+      return check_run(
+          [&]()
+          {
+             check_statistics_ptr( statistics );
+             custom_assert(
+                 round < statistics->statistics.round_components.size(),
+                 "Round index out of range" );
+             return statistics->statistics.round_components[round];
+          },
+          "Failed to get round components" );
+   }
+
    /* Per-presolver Statistics API Implementation */
    size_t
    libpapilo_statistics_get_num_presolvers(
@@ -2696,6 +3024,98 @@ extern "C"
           "Failed to perform postsolve operation" );
    }
 
+   libpapilo_postsolve_status_t
+   libpapilo_postsolve_undo_batch( libpapilo_postsolve_t* postsolve,
+                                   const libpapilo_postsolve_storage_t* storage,
+                                   const double* reduced_solutions,
+                                   size_t num_solutions,
+                                   double* original_solutions,
+                                   libpapilo_postsolve_status_t* statuses )
+   {
+      check_postsolve_ptr( postsolve );
+      check_postsolve_storage_ptr( storage );
+      custom_assert( num_solutions <= (size_t)std::numeric_limits<int>::max(),
+                     "Too many solutions in one batch" );
+      if( num_solutions == 0 )
+         return LIBPAPILO_POSTSOLVE_STATUS_OK;
+      custom_assert( reduced_solutions != nullptr ||
+                         storage->postsolve.origcol_mapping.empty(),
+                     "reduced_solutions pointer is null" );
+      custom_assert( original_solutions != nullptr ||
+                         storage->postsolve.nColsOriginal == 0,
+                     "original_solutions pointer is null" );
+
+      return check_run(
+          [&]()
+          {
+             Vec<PostsolveStatus> status( num_solutions );
+             PostsolveStatus result = postsolve->postsolve.undo_batch(
+                 reduced_solutions, (int)num_solutions, original_solutions,
+                 storage->postsolve, status.data() );
+             if( statuses != nullptr )
+                for( size_t s = 0; s < num_solutions; ++s )
+                   statuses[s] = convert_postsolve_status( status[s] );
+             return convert_postsolve_status( result );
+          },
+          "Failed to perform batch postsolve operation" );
+   }
+
+   /* Compiled Postsolve Program API Implementation */
+
+   libpapilo_postsolve_program_t*
+   libpapilo_postsolve_program_create(
+       const libpapilo_postsolve_storage_t* storage )
+   {
+      check_postsolve_storage_ptr( storage );
+
+      return check_run(
+          [&]() { return new libpapilo_postsolve_program_t( storage->postsolve ); },
+          "Failed to compile postsolve program" );
+   }
+
+   void
+   libpapilo_postsolve_program_free( libpapilo_postsolve_program_t* program )
+   {
+      check_postsolve_program_ptr( program );
+      delete program;
+   }
+
+   size_t
+   libpapilo_postsolve_program_get_num_instructions(
+       const libpapilo_postsolve_program_t* program )
+   {
+      check_postsolve_program_ptr( program );
+      return program->program.instructions.size();
+   }
+
+   libpapilo_postsolve_status_t
+   libpapilo_postsolve_undo_program(
+       libpapilo_postsolve_t* postsolve,
+       const libpapilo_postsolve_program_t* program,
+       const libpapilo_solution_t* reduced_solution,
+       libpapilo_solution_t* original_solution,
+       const libpapilo_postsolve_storage_t* storage )
+   {
+      check_postsolve_ptr( postsolve );
+      check_postsolve_program_ptr( program );
+      check_solution_ptr( reduced_solution );
+      check_solution_ptr( original_solution );
+      check_postsolve_storage_ptr( storage );
+      custom_assert( program->program.nColsOriginal ==
+                         storage->postsolve.nColsOriginal,
+                     "Postsolve program does not belong to the storage" );
+
+      return check_run(
+          [&]()
+          {
+             PostsolveStatus status = postsolve->postsolve.undo(
+                 reduced_solution->solution, original_solution->solution,
+                 storage->postsolve, program->program );
+             return convert_postsolve_status( status );
+          },
+          "Failed to perform postsolve operation" );
+   }
+
    /* PostsolveStorage File I/O API Implementation */
 
    libpapilo_postsolve_storage_t*
@@ -2722,4 +3142,104 @@ extern "C"
           "Failed to load PostsolveStorage from file" );
    }
 
+   void
+   libpapilo_postsolve_storage_write_mapped(
+       const libpapilo_postsolve_storage_t* storage, const char* filename )
+   {
+      check_postsolve_storage_ptr( storage );
+      custom_assert( filename != nullptr, "filename pointer is null" );
+
+      bool written = check_run(
+          [&]()
+          {
+             return MappedPostsolveStorage<double>::write( storage->postsolve,
+                                                           filename );
+          },
+          "Failed to write mapped PostsolveStorage" );
+      custom_assert( written, "Failed to write mapped PostsolveStorage" );
+   }
+
+   libpapilo_mapped_postsolve_storage_t*
+   libpapilo_mapped_postsolve_storage_open( const char* filename )
+   {
+      custom_assert( filename != nullptr, "filename pointer is null" );
+
+      return check_run(
+          [&]()
+          {
+             libpapilo_mapped_postsolve_storage_t* storage =
+                 new libpapilo_mapped_postsolve_storage_t();
+             if( !storage->storage.open( filename ) )
+             {
+                delete storage;
+                return static_cast<libpapilo_mapped_postsolve_storage_t*>(
+                    nullptr );
+             }
+             return storage;
+          },
+          "Failed to map PostsolveStorage from file" );
+   }
+
+   void
+   libpapilo_mapped_postsolve_storage_free(
+       libpapilo_mapped_postsolve_storage_t* storage )
+   {
+      check_mapped_postsolve_storage_ptr( storage );
+      delete storage;
+   }
+
+   size_t
+   libpapilo_mapped_postsolve_storage_get_n_cols_original(
+       const libpapilo_mapped_postsolve_storage_t* storage )
+   {
+      check_mapped_postsolve_storage_ptr( storage );
+      return storage->storage.getNColsOriginal();
+   }
+
+   size_t
+   libpapilo_mapped_postsolve_storage_get_n_cols_reduced(
+       const libpapilo_mapped_postsolve_storage_t* storage )
+   {
+      check_mapped_postsolve_storage_ptr( storage );
+      return storage->storage.getSize( MappedSection::kOrigColMapping );
+   }
+
+   libpapilo_postsolve_storage_t*
+   libpapilo_mapped_postsolve_storage_load(
+       const libpapilo_mapped_postsolve_storage_t* storage )
+   {
+      check_mapped_postsolve_storage_ptr( storage );
+
+      return check_run(
+          [&]()
+          {
+             return new libpapilo_postsolve_storage_t(
+                 storage->storage.load() );
+          },
+          "Failed to load PostsolveStorage from mapping" );
+   }
+
+   libpapilo_postsolve_status_t
+   libpapilo_postsolve_undo_mapped(
+       libpapilo_postsolve_t* postsolve,
+       const libpapilo_mapped_postsolve_storage_t* storage,
+       const libpapilo_solution_t* reduced_solution,
+       libpapilo_solution_t* original_solution )
+   {
+      check_postsolve_ptr( postsolve );
+      check_mapped_postsolve_storage_ptr( storage );
+      check_solution_ptr( reduced_solution );
+      check_solution_ptr( original_solution );
+
+      return check_run(
+          [&]()
+          {
+             PostsolveStatus status = postsolve->postsolve.undo(
+                 reduced_solution->solution, original_solution->solution,
+                 storage->storage );
+             return convert_postsolve_status( status );
+          },
+          "Failed to perform postsolve operation" );
+   }
+
 } // extern "C"
@@ -306,6 +306,11 @@ extern "C"
    typedef struct libpapilo_solution_t libpapilo_solution_t;
    /** Opaque pointer for papilo::Postsolve<double> */
    typedef struct libpapilo_postsolve_t libpapilo_postsolve_t;
+   /** Opaque pointer for papilo::PostsolveProgram<double> */
+   typedef struct libpapilo_postsolve_program_t libpapilo_postsolve_program_t;
+   /** Opaque pointer for papilo::MappedPostsolveStorage<double> */
+   typedef struct libpapilo_mapped_postsolve_storage_t
+       libpapilo_mapped_postsolve_storage_t;
 
    /**
     * Get the version string of the libpapilo library.
@@ -439,6 +444,40 @@ extern "C"
        libpapilo_problem_builder_t* builder, int col, int len, const int* rows,
        const double* vals );
 
+   /**
+    * Set the whole constraint matrix from arrays in compressed sparse row
+    * format for the current number of rows and columns. The entries of row r
+    * are at the positions row_start[r] to row_start[r + 1] - 1 of cols and
+    * vals. The arrays are only read during the call.
+    *
+    * If the columns of every row are strictly increasing, the matrix is copied
+    * directly without going through the entry buffer of the builder.
+    * Otherwise the entries are sorted and duplicate entries are summed up.
+    *
+    * @param builder Problem builder
+    * @param row_start Array of size nrows + 1
+    * @param cols Array of size row_start[nrows] with the column indices
+    * @param vals Array of size row_start[nrows] with the coefficients
+    */
+   LIBPAPILO_EXPORT void
+   libpapilo_problem_builder_set_matrix_csr(
+       libpapilo_problem_builder_t* builder, const int* row_start,
+       const int* cols, const double* vals );
+
+   /**
+    * Set the whole constraint matrix from arrays in compressed sparse column
+    * format, see libpapilo_problem_builder_set_matrix_csr().
+    *
+    * @param builder Problem builder
+    * @param col_start Array of size ncols + 1
+    * @param rows Array of size col_start[ncols] with the row indices
+    * @param vals Array of size col_start[ncols] with the coefficients
+    */
+   LIBPAPILO_EXPORT void
+   libpapilo_problem_builder_set_matrix_csc(
+       libpapilo_problem_builder_t* builder, const int* col_start,
+       const int* rows, const double* vals );
+
    /* Names */
    LIBPAPILO_EXPORT void
    libpapilo_problem_builder_set_problem_name(
@@ -466,6 +505,50 @@ extern "C"
    libpapilo_problem_t*
    libpapilo_problem_builder_build( libpapilo_problem_builder_t* builder );
 
+   /**
+    * Create a problem directly from a constraint matrix in compressed sparse
+    * row format. Infinite bounds are given as -INFINITY and INFINITY.
+    *
+    * @param nrows Number of rows
+    * @param ncols Number of columns
+    * @param row_start Array of size nrows + 1, see
+    * libpapilo_problem_builder_set_matrix_csr()
+    * @param cols Array of size row_start[nrows] with the column indices
+    * @param vals Array of size row_start[nrows] with the coefficients
+    * @param obj Array of size ncols with the objective coefficients
+    * @param lbs Array of size ncols with the lower bounds
+    * @param ubs Array of size ncols with the upper bounds
+    * @param lhs Array of size nrows with the left hand sides
+    * @param rhs Array of size nrows with the right hand sides
+    * @param is_integral Array of size ncols, or NULL if all columns are
+    * continuous
+    * @return The problem, must be freed with libpapilo_problem_free()
+    */
+   LIBPAPILO_EXPORT
+   libpapilo_problem_t*
+   libpapilo_problem_create_from_csr( int nrows, int ncols,
+                                      const int* row_start, const int* cols,
+                                      const double* vals, const double* obj,
+                                      const double* lbs, const double* ubs,
+                                      const double* lhs, const double* rhs,
+                                      const uint8_t* is_integral );
+
+   /**
+    * Create a problem directly from a constraint matrix in compressed sparse
+    * column format, see libpapilo_problem_create_from_csr().
+    *
+    * @param col_start Array of size ncols + 1
+    * @param rows Array of size col_start[ncols] with the row indices
+    */
+   LIBPAPILO_EXPORT
+   libpapilo_problem_t*
+   libpapilo_problem_create_from_csc( int nrows, int ncols,
+                                      const int* col_start, const int* rows,
+                                      const double* vals, const double* obj,
+                                      const double* lbs, const double* ubs,
+                                      const double* lhs, const double* rhs,
+                                      const uint8_t* is_integral );
+
    /* Problem API */
    LIBPAPILO_EXPORT void
    libpapilo_problem_free( libpapilo_problem_t* problem );
@@ -563,6 +646,47 @@ extern "C"
    libpapilo_problem_is_col_substituted( const libpapilo_problem_t* problem,
                                          int col );
 
+   /* Implication API */
+
+   /** Get the number of implications stored in the problem. Presolve keeps
+    * the implications that probing finds for the binary columns of the
+    * reduced problem, so that a solver does not need to probe them again. */
+   LIBPAPILO_EXPORT size_t
+   libpapilo_problem_get_num_implications( const libpapilo_problem_t* problem );
+
+   /** Get the implications of fixing the binary column `col` to `value` (0 or
+    * 1). Implication k is the upper bound `bounds[k]` on column `cols[k]` if
+    * `upper[k]` is nonzero and the lower bound otherwise. The entries are
+    * sorted by column and stay valid until the problem is modified. Returns
+    * the number of implications, or -1 if `col` is out of range. */
+   LIBPAPILO_EXPORT int
+   libpapilo_problem_get_implications( const libpapilo_problem_t* problem,
+                                       int col, int value, const int** cols,
+                                       const uint8_t** upper,
+                                       const double** bounds );
+
+   /** Add the implication that fixing the binary column `bincol` to `value`
+    * (0 or 1) implies the bound `bound` on column `col`, an upper bound if
+    * `upper` is nonzero and a lower bound otherwise. The implication is
+    * merged with the stored ones right away and used by presolve. */
+   LIBPAPILO_EXPORT void
+   libpapilo_problem_add_implication( libpapilo_problem_t* problem,
+                                      int bincol, int value, int col,
+                                      int upper, double bound );
+
+   /* Component API */
+
+   /** Detect the connected components of the constraint matrix, two columns
+    * are in the same component if they share a row. The components are
+    * numbered by their first column. If `col_component` is not NULL it
+    * receives the component of every column, or -1 for inactive columns, and
+    * has to have size ncols. If `row_component` is not NULL it receives the
+    * component of every row, or -1 for empty and redundant rows, and has to
+    * have size nrows. Returns the number of components. */
+   LIBPAPILO_EXPORT int
+   libpapilo_problem_get_components( const libpapilo_problem_t* problem,
+                                     int* col_component, int* row_component );
+
    /* Additional Problem query APIs */
    LIBPAPILO_EXPORT double*
    libpapilo_problem_get_objective_coefficients_mutable(
@@ -576,6 +700,22 @@ extern "C"
    libpapilo_problem_get_row_right_hand_sides(
        const libpapilo_problem_t* problem, size_t* size );
 
+   /* Problem Snapshot API */
+
+   /** Write `problem` in PaPILO's native, versioned binary snapshot format.
+    * The file holds the constraint matrix in CSR format together with its
+    * transpose, the bounds, sides, flags, objective and names. */
+   LIBPAPILO_EXPORT void
+   libpapilo_problem_write_snapshot( const libpapilo_problem_t* problem,
+                                     const char* filename );
+
+   /** Read a file written by `libpapilo_problem_write_snapshot()`. The file
+    * is memory mapped and its arrays are copied without parsing or sorting.
+    * Returns NULL if the file cannot be mapped or was written by a different
+    * version or platform. Free the result with `libpapilo_problem_free()`. */
+   LIBPAPILO_EXPORT libpapilo_problem_t*
+   libpapilo_problem_read_snapshot( const char* filename );
+
    /* Phase 2: Presolve API */
 
    /* Core Presolve API */
@@ -728,6 +868,27 @@ extern "C"
    libpapilo_presolve_options_get_randomseed(
        const libpapilo_presolve_options_t* options );
 
+   /**
+    * Write a timeline of every presolve run to the given file in the Chrome
+    * trace event format, which can be opened in chrome://tracing or Perfetto.
+    * It shows the presolver runs with the thread they ran on, the application
+    * of their reductions and the updates of the problem, together with the
+    * number of transactions found, applied and rejected due to conflicts.
+    *
+    * @param options Presolve options
+    * @param filename Path of the trace file, NULL or an empty string disables
+    * the tracing (default)
+    */
+   LIBPAPILO_EXPORT void
+   libpapilo_presolve_options_set_trace_file(
+       libpapilo_presolve_options_t* options, const char* filename );
+
+   /** Get the path of the trace file, an empty string if tracing is disabled
+    */
+   LIBPAPILO_EXPORT const char*
+   libpapilo_presolve_options_get_trace_file(
+       const libpapilo_presolve_options_t* options );
+
    /* Reductions access API */
    LIBPAPILO_EXPORT libpapilo_reductions_t*
    libpapilo_reductions_create();
@@ -984,6 +1145,31 @@ extern "C"
    libpapilo_statistics_get_single_matrix_coefficient_changes(
        const libpapilo_statistics_t* statistics );
 
+   /** Get the number of presolving rounds with a recorded thread
+    * utilization. */
+   LIBPAPILO_EXPORT size_t
+   libpapilo_statistics_get_num_round_utilizations(
+       const libpapilo_statistics_t* statistics );
+
+   /** Get the share of the threads (between 0 and 1) that were busy running
+    * presolvers in the given round. */
+   LIBPAPILO_EXPORT double
+   libpapilo_statistics_get_round_utilization(
+       const libpapilo_statistics_t* statistics, size_t round );
+
+   /** Get the number of presolving rounds with a recorded number of
+    * connected components, only recorded with presolve.trackcomponents. */
+   LIBPAPILO_EXPORT size_t
+   libpapilo_statistics_get_num_round_components(
+       const libpapilo_statistics_t* statistics );
+
+   /** Get the number of connected components of the active problem after the
+    * given round. Between two rebuilds of the components it is a lower bound,
+    * since removed rows and columns can split components. */
+   LIBPAPILO_EXPORT int
+   libpapilo_statistics_get_round_components(
+       const libpapilo_statistics_t* statistics, size_t round );
+
    /* Per-presolver Statistics API */
 
    /** Get the number of presolvers. */
@@ -1186,16 +1372,118 @@ extern "C"
    LIBPAPILO_EXPORT void
    libpapilo_postsolve_free( libpapilo_postsolve_t* postsolve );
 
+   /** Transform a solution of the reduced problem back to the original space.
+    * The storage is only read, so it can be shared by concurrent calls with
+    * different solution objects. The buffers of `original_solution` are
+    * reused, hence postsolving many solutions with the same output object
+    * does not allocate memory proportional to the original problem. */
    LIBPAPILO_EXPORT libpapilo_postsolve_status_t
-   libpapilo_postsolve_undo( libpapilo_postsolve_t* postsolve,
+   libpapilo_postsolve_undo(libpapilo_postsolve_t* postsolve,
                              const libpapilo_solution_t* reduced_solution,
                              libpapilo_solution_t* original_solution,
                              const libpapilo_postsolve_storage_t* storage );
 
+   /** Transform `num_solutions` primal solutions of the reduced problem back to
+    * the original space with a single pass over the reduction log.
+    * Both buffers are column-major: the value of column `j` in solution `s`
+    * is at index `j * num_solutions + s`. `reduced_solutions` holds
+    * `libpapilo_postsolve_storage_get_orig_col_mapping()` many columns and
+    * `original_solutions` must provide room for
+    * `libpapilo_postsolve_storage_get_n_cols_original()` many columns.
+    * If `statuses` is not NULL, it receives the status of every solution.
+    * Returns LIBPAPILO_POSTSOLVE_STATUS_ERROR if any solution failed. */
+   LIBPAPILO_EXPORT libpapilo_postsolve_status_t
+   libpapilo_postsolve_undo_batch( libpapilo_postsolve_t* postsolve,
+                                   const libpapilo_postsolve_storage_t* storage,
+                                   const double* reduced_solutions,
+                                   size_t num_solutions,
+                                   double* original_solutions,
+                                   libpapilo_postsolve_status_t* statuses );
+
+   /* Compiled Postsolve Program API */
+
+   /** Compile the primal part of the reduction log of `storage` into a flat
+    * instruction stream. The program is independent of the storage and
+    * can be reused for any number of primal postsolves. Returns NULL on
+    * error. */
+   LIBPAPILO_EXPORT libpapilo_postsolve_program_t*
+   libpapilo_postsolve_program_create(
+       const libpapilo_postsolve_storage_t* storage );
+
+   LIBPAPILO_EXPORT void
+   libpapilo_postsolve_program_free( libpapilo_postsolve_program_t* program );
+
+   /** Get the number of instructions of the compiled program. */
+   LIBPAPILO_EXPORT size_t
+   libpapilo_postsolve_program_get_num_instructions(
+       const libpapilo_postsolve_program_t* program );
+
+   /** Same as `libpapilo_postsolve_undo()`, but runs the compiled program
+    * instead of decoding the reduction log. `storage` must be the storage
+    * the program was compiled from, it is used for validating the result.
+    * Primal-dual solutions are postsolved with the reduction log. */
+   LIBPAPILO_EXPORT libpapilo_postsolve_status_t
+   libpapilo_postsolve_undo_program(
+       libpapilo_postsolve_t* postsolve,
+       const libpapilo_postsolve_program_t* program,
+       const libpapilo_solution_t* reduced_solution,
+       libpapilo_solution_t* original_solution,
+       const libpapilo_postsolve_storage_t* storage );
+
    /* PostsolveStorage File I/O API */
    LIBPAPILO_EXPORT libpapilo_postsolve_storage_t*
    libpapilo_postsolve_storage_load_from_file( const char* filename );
 
+   /* Memory Mapped PostsolveStorage API */
+
+   /** Write `storage` in the flat, versioned little-endian format that is
+    * used in place after mapping the file with
+    * `libpapilo_mapped_postsolve_storage_open()`. The file holds the
+    * reduction log, the original problem in CSR format and the compiled
+    * postsolve program. */
+   LIBPAPILO_EXPORT void
+   libpapilo_postsolve_storage_write_mapped(
+       const libpapilo_postsolve_storage_t* storage, const char* filename );
+
+   /** Map a file written by `libpapilo_postsolve_storage_write_mapped()`
+    * without parsing or copying it. Returns NULL if the file cannot be
+    * mapped or was written by a different version or platform. */
+   LIBPAPILO_EXPORT libpapilo_mapped_postsolve_storage_t*
+   libpapilo_mapped_postsolve_storage_open( const char* filename );
+
+   LIBPAPILO_EXPORT void
+   libpapilo_mapped_postsolve_storage_free(
+       libpapilo_mapped_postsolve_storage_t* storage );
+
+   /** Get the original number of columns before presolving. */
+   LIBPAPILO_EXPORT size_t
+   libpapilo_mapped_postsolve_storage_get_n_cols_original(
+       const libpapilo_mapped_postsolve_storage_t* storage );
+
+   /** Get the number of columns of the reduced problem. */
+   LIBPAPILO_EXPORT size_t
+   libpapilo_mapped_postsolve_storage_get_n_cols_reduced(
+       const libpapilo_mapped_postsolve_storage_t* storage );
+
+   /** Copy the mapped data into a new PostsolveStorage, e.g. to use the
+    * accessors of the storage. The names of the original problem are not
+    * part of the mapped format. Free the result with
+    * `libpapilo_postsolve_storage_free()`. */
+   LIBPAPILO_EXPORT libpapilo_postsolve_storage_t*
+   libpapilo_mapped_postsolve_storage_load(
+       const libpapilo_mapped_postsolve_storage_t* storage );
+
+   /** Same as `libpapilo_postsolve_undo()`, but reads the mapped file in
+    * place. Primal solutions are postsolved with the compiled program of
+    * the file; primal-dual solutions load a full copy of the storage for
+    * every call. */
+   LIBPAPILO_EXPORT libpapilo_postsolve_status_t
+   libpapilo_postsolve_undo_mapped(
+       libpapilo_postsolve_t* postsolve,
+       const libpapilo_mapped_postsolve_storage_t* storage,
+       const libpapilo_solution_t* reduced_solution,
+       libpapilo_solution_t* original_solution );
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,160 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_CHANGE_LOG_HPP_
+#define _PAPILO_CORE_CHANGE_LOG_HPP_
+
+#include "papilo/misc/Vec.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace papilo
+{
+
+/// position in a ChangeLog; a presolver remembers the position at the start
+/// of a call and asks for the changes since then in its next call
+struct ChangeLogPosition
+{
+   std::uint64_t generation = 0;
+   int nrows = 0;
+   int ncols = 0;
+};
+
+/// append-only log of the rows and columns whose coefficients, sides, bounds
+/// or flags were modified by the ProblemUpdate. Compressing the problem
+/// renumbers the rows and columns and starts a new generation of the log,
+/// which invalidates all positions taken before. Generations are unique
+/// within the process, hence a position taken on another problem is never
+/// mistaken for a valid one. The log also starts a new generation when it
+/// holds more entries than a few passes over the problem, then recomputing
+/// everything is cheaper than reading the log.
+class ChangeLog
+{
+ public:
+   ChangeLog() = default;
+
+   ChangeLog( int nrows, int ncols ) { reset( nrows, ncols ); }
+
+   /// clears the log and starts a new generation for a problem of the given
+   /// size
+   void
+   reset( int nrows, int ncols )
+   {
+      generation = next_generation();
+      max_entries = MAX_PASSES * ( (std::size_t)nrows + ncols ) + 1024;
+      rows.clear();
+      cols.clear();
+   }
+
+   void
+   addRow( int row )
+   {
+      assert( row >= 0 );
+      rows.push_back( row );
+      check_size();
+   }
+
+   void
+   addCol( int col )
+   {
+      assert( col >= 0 );
+      cols.push_back( col );
+      check_size();
+   }
+
+   ChangeLogPosition
+   getPosition() const
+   {
+      ChangeLogPosition position;
+      position.generation = generation;
+      position.nrows = (int)rows.size();
+      position.ncols = (int)cols.size();
+      return position;
+   }
+
+   /// stores the sorted rows and columns that were logged after the given
+   /// position. Returns false if the position belongs to another generation,
+   /// then all rows and columns must be considered as changed.
+   bool
+   getChangesSince( const ChangeLogPosition& position, Vec<int>& changed_rows,
+                    Vec<int>& changed_cols ) const
+   {
+      if( position.generation != generation )
+         return false;
+
+      assert( position.nrows <= (int)rows.size() );
+      assert( position.ncols <= (int)cols.size() );
+
+      changed_rows.assign( rows.begin() + position.nrows, rows.end() );
+      std::sort( changed_rows.begin(), changed_rows.end() );
+      changed_rows.erase(
+          std::unique( changed_rows.begin(), changed_rows.end() ),
+          changed_rows.end() );
+
+      changed_cols.assign( cols.begin() + position.ncols, cols.end() );
+      std::sort( changed_cols.begin(), changed_cols.end() );
+      changed_cols.erase(
+          std::unique( changed_cols.begin(), changed_cols.end() ),
+          changed_cols.end() );
+
+      return true;
+   }
+
+   std::uint64_t
+   getGeneration() const
+   {
+      return generation;
+   }
+
+ private:
+   static constexpr std::size_t MAX_PASSES = 4;
+
+   static std::uint64_t
+   next_generation()
+   {
+      static std::atomic<std::uint64_t> counter{ 0 };
+      return ++counter;
+   }
+
+   void
+   check_size()
+   {
+      if( rows.size() + cols.size() > max_entries )
+      {
+         generation = next_generation();
+         rows.clear();
+         cols.clear();
+      }
+   }
+
+   std::uint64_t generation = 0;
+   std::size_t max_entries = 0;
+   Vec<int> rows;
+   Vec<int> cols;
+};
+
+} // namespace papilo
+
+#endif
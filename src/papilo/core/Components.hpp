@@ -25,15 +25,49 @@
 #ifndef _PAPILO_CORE_COMPONENTS_HPP_
 #define _PAPILO_CORE_COMPONENTS_HPP_
 
+#include "papilo/Config.hpp"
 #include "papilo/core/Problem.hpp"
 #include "papilo/external/pdqsort/pdqsort.h"
-#include "papilo/misc/Hash.hpp"
+#include "papilo/misc/ConcurrentUnionFind.hpp"
 #include "papilo/misc/Vec.hpp"
-#include <boost/pending/disjoint_sets.hpp>
+#include "papilo/misc/compress_vector.hpp"
+#ifdef PAPILO_TBB
+#include "papilo/misc/tbb.hpp"
+#endif
 
 namespace papilo
 {
 
+/// unites the columns of every row of the matrix, in parallel over the rows
+/// if PaPILO is built with TBB
+template <typename REAL>
+void
+uniteRowColumns( const ConstraintMatrix<REAL>& consMatrix,
+                 ConcurrentUnionFind& unionfind )
+{
+   const IndexRange* ranges;
+   int nrows;
+   std::tie( ranges, nrows ) = consMatrix.getRangeInfo();
+   const int* colinds = consMatrix.getColumns();
+
+   auto unite_rows = [&]( int first, int last ) {
+      for( int r = first; r != last; ++r )
+      {
+         for( int i = ranges[r].start + 1; i < ranges[r].end; ++i )
+            unionfind.unite( colinds[ranges[r].start], colinds[i] );
+      }
+   };
+
+#ifdef PAPILO_TBB
+   tbb::parallel_for( tbb::blocked_range<int>( 0, nrows, 256 ),
+                      [&]( const tbb::blocked_range<int>& r ) {
+                         unite_rows( r.begin(), r.end() );
+                      } );
+#else
+   unite_rows( 0, nrows );
+#endif
+}
+
 struct ComponentInfo
 {
    int componentid;
@@ -109,63 +143,37 @@ class Components
    detectComponents( const Problem<REAL>& problem )
    {
       const int ncols = problem.getNCols();
-      std::unique_ptr<int[]> rank{ new int[ncols] };
-      std::unique_ptr<int[]> parent{ new int[ncols] };
-      boost::disjoint_sets<int*, int*> djsets( rank.get(), parent.get() );
-
+      const int nrows = problem.getNRows();
+      ConcurrentUnionFind unionfind( ncols );
+      uniteRowColumns( problem.getConstraintMatrix(), unionfind );
+
+      // the root of a set is its smallest column, so numbering the roots in
+      // ascending order numbers the components by their first column
+      col2comp.resize( ncols );
+      int numcomponents = 0;
       for( int i = 0; i != ncols; ++i )
-         djsets.make_set( i );
-
-      const ConstraintMatrix<REAL>& consMatrix = problem.getConstraintMatrix();
-      const IndexRange* ranges;
-      int nrows;
-
-      std::tie( ranges, nrows ) = consMatrix.getRangeInfo();
-      const int* colinds = consMatrix.getColumns();
-
-      for( int r = 0; r != nrows; ++r )
       {
-         if( ranges[r].end - ranges[r].start <= 1 )
-            continue;
-
-         int firstcol = djsets.find_set( colinds[ranges[r].start] );
-
-         for( int i = ranges[r].start + 1; i != ranges[r].end; ++i )
-            djsets.union_set( firstcol, colinds[i] );
+         const int root = unionfind.find( i );
+         col2comp[i] = root == i ? numcomponents++ : col2comp[root];
       }
 
-      HashMap<int, int> componentmap;
-
-      for( int i = 0; i != ncols; ++i )
-      {
-         int nextid = static_cast<int>( componentmap.size() );
-         componentmap.insert( { djsets.find_set( i ), nextid } );
-      }
-
-      int numcomponents = static_cast<int>( componentmap.size() );
-
       if( numcomponents > 1 )
       {
-         col2comp.resize( ncols );
          compcols.resize( ncols );
 
          for( int i = 0; i != ncols; ++i )
-         {
-            col2comp[i] = componentmap[djsets.find_set( i )];
             compcols[i] = i;
-         }
 
          row2comp.resize( nrows );
          comprows.resize( nrows );
          for( int i = 0; i != nrows; ++i )
          {
-            assert( problem.getConstraintMatrix()
-                        .getRowCoefficients( i )
-                        .getLength() > 0 );
-            int col = problem.getConstraintMatrix()
-                          .getRowCoefficients( i )
-                          .getIndices()[0];
-            row2comp[i] = col2comp[col];
+            // empty rows are not connected to any column and are assigned
+            // to the first component
+            auto rowvec = problem.getConstraintMatrix().getRowCoefficients( i );
+            row2comp[i] = rowvec.getLength() == 0
+                              ? 0
+                              : col2comp[rowvec.getIndices()[0]];
             comprows[i] = i;
          }
 
@@ -261,6 +269,224 @@ class Components
    }
 };
 
+/// connected components of the active rows and columns that are kept up to
+/// date while presolve removes rows and columns. Removals can only split
+/// components, which the tracker does not detect, so between two rebuilds
+/// the components may be unions of the actual components and their number is
+/// a lower bound. The nonzeros of a component are reduced by the removed
+/// entries but do not include fill-in since the last rebuild.
+class ComponentTracker
+{
+ public:
+   /// fraction of the rows and columns of the last rebuild that can be
+   /// removed until the components are rebuilt
+   static constexpr double rebuildfrac = 0.1;
+
+   bool
+   isBuilt() const
+   {
+      return built;
+   }
+
+   /// true if enough rows and columns were removed since the last rebuild
+   /// that the components are likely to have split
+   bool
+   needsRebuild() const
+   {
+      return !built || nremoved > rebuildfrac * nactiveatrebuild;
+   }
+
+   /// number of components that contain an active column
+   int
+   getNumComponents() const
+   {
+      return nactivecomponents;
+   }
+
+   /// component of the given column, -1 if the column is not active
+   int
+   getColComponent( int col ) const
+   {
+      return col2comp[col];
+   }
+
+   /// component of the given row, -1 if the row is empty or was removed
+   int
+   getRowComponent( int row ) const
+   {
+      return row2comp[row];
+   }
+
+   /// sizes of the components indexed by their id, the rows of component c
+   /// are compnrows[c]
+   const Vec<ComponentInfo>&
+   getComponentInfo() const
+   {
+      return compinfo;
+   }
+
+   int
+   getComponentNumRows( int c ) const
+   {
+      return compnrows[c];
+   }
+
+   /// returns the id of the component with the most columns, -1 if there is
+   /// no active column
+   int
+   getLargestComponent() const
+   {
+      int largest = -1;
+      int largestcols = 0;
+      for( int c = 0; c != static_cast<int>( compinfo.size() ); ++c )
+      {
+         const int ncols = compinfo[c].nintegral + compinfo[c].ncontinuous;
+         if( ncols > largestcols )
+         {
+            largest = c;
+            largestcols = ncols;
+         }
+      }
+      return largest;
+   }
+
+   /// detects the components of the active rows and columns from scratch
+   template <typename REAL>
+   void
+   rebuild( const Problem<REAL>& problem )
+   {
+      const ConstraintMatrix<REAL>& consMatrix = problem.getConstraintMatrix();
+      const Vec<ColFlags>& cflags = problem.getColFlags();
+      const Vec<RowFlags>& rflags = problem.getRowFlags();
+      const Vec<int>& colsizes = problem.getColSizes();
+      const int ncols = problem.getNCols();
+      const int nrows = problem.getNRows();
+
+      ConcurrentUnionFind unionfind( ncols );
+      uniteRowColumns( consMatrix, unionfind );
+
+      // number the components by their first active column
+      Vec<int> rootcomp( ncols, -1 );
+      col2comp.assign( ncols, -1 );
+      compinfo.clear();
+      nactiveatrebuild = 0;
+      for( int col = 0; col != ncols; ++col )
+      {
+         if( cflags[col].test( ColFlag::kInactive ) )
+            continue;
+
+         const int root = unionfind.find( col );
+         if( rootcomp[root] == -1 )
+         {
+            rootcomp[root] = static_cast<int>( compinfo.size() );
+            compinfo.push_back(
+                ComponentInfo{ static_cast<int>( compinfo.size() ), 0, 0, 0 } );
+         }
+
+         const int c = rootcomp[root];
+         col2comp[col] = c;
+         if( cflags[col].test( ColFlag::kIntegral ) )
+            ++compinfo[c].nintegral;
+         else
+            ++compinfo[c].ncontinuous;
+         compinfo[c].nnonz += colsizes[col];
+         ++nactiveatrebuild;
+      }
+
+      row2comp.assign( nrows, -1 );
+      compnrows.assign( compinfo.size(), 0 );
+      for( int row = 0; row != nrows; ++row )
+      {
+         const auto rowvec = consMatrix.getRowCoefficients( row );
+         if( rflags[row].test( RowFlag::kRedundant ) ||
+             rowvec.getLength() == 0 )
+            continue;
+
+         row2comp[row] = col2comp[rowvec.getIndices()[0]];
+         if( row2comp[row] != -1 )
+         {
+            ++compnrows[row2comp[row]];
+            ++nactiveatrebuild;
+         }
+      }
+
+      nactivecomponents = static_cast<int>( compinfo.size() );
+      nremoved = 0;
+      built = true;
+   }
+
+   /// updates the components for rows and columns that are about to be
+   /// deleted from the matrix, their entries must still be stored
+   template <typename REAL>
+   void
+   removeRowsAndCols( const Problem<REAL>& problem, const Vec<int>& rows,
+                      const Vec<int>& cols )
+   {
+      if( !built )
+         return;
+
+      const ConstraintMatrix<REAL>& consMatrix = problem.getConstraintMatrix();
+      const Vec<ColFlags>& cflags = problem.getColFlags();
+
+      for( int row : rows )
+      {
+         const int c = row2comp[row];
+         if( c == -1 )
+            continue;
+
+         --compnrows[c];
+         compinfo[c].nnonz -= consMatrix.getRowCoefficients( row ).getLength();
+         row2comp[row] = -1;
+         ++nremoved;
+      }
+
+      for( int col : cols )
+      {
+         const int c = col2comp[col];
+         if( c == -1 )
+            continue;
+
+         // the entries in removed rows are already subtracted
+         const auto colvec = consMatrix.getColumnCoefficients( col );
+         for( int i = 0; i != colvec.getLength(); ++i )
+         {
+            if( row2comp[colvec.getIndices()[i]] != -1 )
+               --compinfo[c].nnonz;
+         }
+
+         if( cflags[col].test( ColFlag::kIntegral ) )
+            --compinfo[c].nintegral;
+         else
+            --compinfo[c].ncontinuous;
+         if( compinfo[c].nintegral + compinfo[c].ncontinuous == 0 )
+            --nactivecomponents;
+         col2comp[col] = -1;
+         ++nremoved;
+      }
+   }
+
+   /// applies the mappings of a compression of the problem
+   void
+   compress( const Vec<int>& rowmapping, const Vec<int>& colmapping )
+   {
+      if( !built )
+         return;
+
+      compress_vector( rowmapping, row2comp );
+      compress_vector( colmapping, col2comp );
+   }
+
+ private:
+   Vec<int> col2comp;
+   Vec<int> row2comp;
+   Vec<ComponentInfo> compinfo;
+   Vec<int> compnrows;
+   int nactivecomponents = 0;
+   int nactiveatrebuild = 0;
+   int nremoved = 0;
+   bool built = false;
+};
+
 } // namespace papilo
 
 #endif
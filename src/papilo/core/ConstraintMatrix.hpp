@@ -35,6 +35,7 @@
 #include "papilo/core/SingleRow.hpp"
 #include "papilo/core/SparseStorage.hpp"
 #include "papilo/core/VariableDomains.hpp"
+#include "papilo/core/VectorHashIndex.hpp"
 #include "papilo/misc/MultiPrecision.hpp"
 #include "papilo/misc/Num.hpp"
 #include "papilo/misc/Vec.hpp"
@@ -359,6 +360,54 @@ class ConstraintMatrix
    std::pair<Vec<int>, Vec<int>>
    compress( bool full = false );
 
+   /// the spare space that is kept behind every row and column for fill-in,
+   /// relative to its size
+   double
+   getSpareRatio() const
+   {
+      return cons_matrix.getSpareRatio();
+   }
+
+   int
+   getMinInterRowSpace() const
+   {
+      return cons_matrix.getMinInterRowSpace();
+   }
+
+   /// sets the spare space of the row and column major storage, it takes
+   /// effect with the next call of compress()
+   void
+   setSpareSpace( double spareRatio, int minInterRowSpace )
+   {
+      cons_matrix.setSpareSpace( spareRatio, minInterRowSpace );
+      cons_matrix_transp.setSpareSpace( spareRatio, minInterRowSpace );
+   }
+
+   /// number of bytes allocated by the row major storage
+   std::size_t
+   getRowMajorMemoryUsage() const
+   {
+      return cons_matrix.getMemoryUsage();
+   }
+
+   /// number of bytes allocated by the column major storage
+   std::size_t
+   getColMajorMemoryUsage() const
+   {
+      return cons_matrix_transp.getMemoryUsage();
+   }
+
+   /// number of bytes allocated by the storages and the vectors of the rows
+   /// and columns, not counting the hashes of the rows and columns
+   std::size_t
+   getMemoryUsage() const
+   {
+      return getRowMajorMemoryUsage() + getColMajorMemoryUsage() +
+             ( lhs_values.capacity() + rhs_values.capacity() ) * sizeof( REAL ) +
+             flags.capacity() * sizeof( RowFlags ) +
+             ( rowsize.capacity() + colsize.capacity() ) * sizeof( int );
+   }
+
    void
    deleteRowsAndCols( Vec<int>& deletedRows, Vec<int>& deletedCols,
                       Vec<RowActivity<REAL>>& activities,
@@ -424,6 +473,8 @@ class ConstraintMatrix
                     },
                     coeffChanged );
 
+                row_hashes.markDirty( row );
+
                 if( newsize != rowsize[row] )
                 {
                    switch( newsize )
@@ -469,6 +520,8 @@ class ConstraintMatrix
                     },
                     []( int, int, REAL, REAL ) {} );
 
+                col_hashes.markDirty( col );
+
                 if( newsize != colsize[col] )
                 {
                    switch( newsize )
@@ -555,11 +608,14 @@ class ConstraintMatrix
               Vec<int>& singletonRows, Vec<int>& singletonCols,
               Vec<int>& emptyCols, int presolveround );
 
+   /// adds a new entry to the matrix, the row and the column are shifted if
+   /// necessary and false is returned if that is not possible
    bool
    change_coefficient( const Num<REAL>& num, int row, int col, REAL val,
        const VariableDomains<REAL>& domains, Vec<int>& indbuffer,
        Vec<REAL>& valbuffer, Vec<int>& changedActivities,
-       Vec<RowActivity<REAL>>& activities, int presolveround );
+       Vec<RowActivity<REAL>>& activities, int presolveround,
+       int maxshiftperrow );
 
    const SparseStorage<REAL>&
    getMatrixTranspose() const
@@ -585,6 +641,24 @@ class ConstraintMatrix
       return cons_matrix;
    }
 
+   /// hashes of the rows, brought up to date with the changes since the
+   /// last query
+   const VectorHashIndex<REAL>&
+   getRowHashIndex() const
+   {
+      row_hashes.update( cons_matrix );
+      return row_hashes;
+   }
+
+   /// hashes of the columns, brought up to date with the changes since the
+   /// last query
+   const VectorHashIndex<REAL>&
+   getColHashIndex() const
+   {
+      col_hashes.update( cons_matrix_transp );
+      return col_hashes;
+   }
+
    template <typename Archive>
    void
    serialize( Archive& ar, const unsigned int version )
@@ -592,7 +666,11 @@ class ConstraintMatrix
       ar& cons_matrix;
 
       if( Archive::is_loading::value )
+      {
          cons_matrix_transp = cons_matrix.getTranspose();
+         row_hashes.clear();
+         col_hashes.clear();
+      }
 
       ar& lhs_values;
       ar& rhs_values;
@@ -626,6 +704,11 @@ class ConstraintMatrix
    /// additional vector storing the number of non-zeros
    /// within each column of the constraint matrix
    Vec<int> colsize;
+
+   /// hashes of the rows and columns for the detection of parallel rows and
+   /// columns, updated lazily for the rows and columns marked as dirty
+   VectorHashIndex<REAL> row_hashes;
+   VectorHashIndex<REAL> col_hashes;
 };
 
 #ifdef PAPILO_USE_EXTERN_TEMPLATES
@@ -699,6 +782,18 @@ ConstraintMatrix<REAL>::compress( bool full )
 
 #endif
 
+   // the support hashes of the rows refer to column indices and vice versa
+   auto renumbered = []( const Vec<int>& mapping ) {
+      for( int i = 0; i != (int)mapping.size(); ++i )
+      {
+         if( mapping[i] != i )
+            return true;
+      }
+      return false;
+   };
+   row_hashes.compress( mappings.first, renumbered( mappings.second ), full );
+   col_hashes.compress( mappings.second, renumbered( mappings.first ), full );
+
    return mappings;
 }
 
@@ -731,20 +826,28 @@ ConstraintMatrix<REAL>::deleteRowsAndCols( Vec<int>& deletedRows,
           {
              cons_matrix.getNnz() -= rowsize[row];
              rowsize[row] = -1;
+             row_hashes.markDirty( row );
           }
        },
        [this, &deletedCols]() {
           for( int col : deletedCols )
+          {
              colsize[col] = -1;
+             col_hashes.markDirty( col );
+          }
        } );
 #else
    for( int row : deletedRows )
    {
       cons_matrix.getNnz() -= rowsize[row];
       rowsize[row] = -1;
+      row_hashes.markDirty( row );
    }
    for( int col : deletedCols )
+   {
       colsize[col] = -1;
+      col_hashes.markDirty( col );
+   }
 #endif
 
    // delete rows from row storage and update column sizes
@@ -811,6 +914,8 @@ ConstraintMatrix<REAL>::deleteRowsAndCols( Vec<int>& deletedRows,
                  colsize[col] == colranges[col].end - colranges[col].start )
                 continue;
 
+             col_hashes.markDirty( col );
+
              // if the size is now 1, add to singleton column vector
              switch( colsize[col] )
              {
@@ -859,6 +964,8 @@ ConstraintMatrix<REAL>::deleteRowsAndCols( Vec<int>& deletedRows,
                  rowsize[row] == rowranges[row].end - rowranges[row].start )
                 continue;
 
+             row_hashes.markDirty( row );
+
              // if the size is now 1, add to singleton row vector
              switch( rowsize[row] )
              {
@@ -1130,6 +1237,7 @@ ConstraintMatrix<REAL>::sparsify(
    // part)
    if( fillincol != -1 )
    {
+      col_hashes.markDirty( fillincol );
 
       assert( colsize[fillincol] <
               colranges[fillincol + 1].start - colranges[fillincol].start );
@@ -1161,6 +1269,7 @@ ConstraintMatrix<REAL>::sparsify(
       {
          int col = rowcols[k];
          assert( col != fillincol );
+         col_hashes.markDirty( col );
 
          REAL newval = rowvals[k] + scale * rowvals[j];
 
@@ -1265,6 +1374,7 @@ ConstraintMatrix<REAL>::sparsify(
 
    assert( rowsize[targetrow] - ncancel == newsize );
    rowsize[targetrow] = newsize;
+   row_hashes.markDirty( targetrow );
 
    switch( rowsize[targetrow] )
    {
@@ -1290,7 +1400,7 @@ ConstraintMatrix<REAL>::change_coefficient(
     const Num<REAL>& num, int row, int col, REAL val,
     const VariableDomains<REAL>& domains, Vec<int>& indbuffer,
     Vec<REAL>& valbuffer, Vec<int>& changedActivities,
-    Vec<RowActivity<REAL>>& activities, int presolveround )
+    Vec<RowActivity<REAL>>& activities, int presolveround, int maxshiftperrow )
 {
    auto updateActivity = [presolveround, &changedActivities, &domains,
                           &activities, this, num](
@@ -1324,16 +1434,24 @@ ConstraintMatrix<REAL>::change_coefficient(
    auto mergeVal = [&]( const REAL& oldval, const REAL& newval )
    { return newval; };
 
-   if(cons_matrix.rowranges[row].end + 1 == cons_matrix.rowranges[row+1].start)
+   // keep at least one spare entry behind the row and the column
+   indbuffer.assign( 1, 2 );
+   if( cons_matrix.rowranges[row + 1].start - cons_matrix.rowranges[row].end <
+           2 &&
+       !cons_matrix.shiftRows( &row, 1, maxshiftperrow, indbuffer ) )
    {
-      //fmt::print("did not add col {} to clique {}\n", col, row);
+      indbuffer.clear();
       return false;
    }
-   if(cons_matrix_transp.rowranges[col].end + 1 == cons_matrix_transp.rowranges[col+1].start)
+   if( cons_matrix_transp.rowranges[col + 1].start -
+               cons_matrix_transp.rowranges[col].end <
+           2 &&
+       !cons_matrix_transp.shiftRows( &col, 1, maxshiftperrow, indbuffer ) )
    {
-      //fmt::print("did not add col {} to clique {}\n", col, row);
+      indbuffer.clear();
       return false;
    }
+   indbuffer.clear();
 
    int newsize = cons_matrix.changeRow(
        row, int{ 0 }, int{ 1 },
@@ -1348,6 +1466,8 @@ ConstraintMatrix<REAL>::change_coefficient(
              []( const REAL& oldval, const REAL& newval ) { return newval; },
              []( int, int, REAL, REAL ) {}, valbuffer, indbuffer );
    colsize[col] = newsize;
+   row_hashes.markDirty( row );
+   col_hashes.markDirty( col );
    return true;
 
 }
@@ -1450,6 +1570,7 @@ ConstraintMatrix<REAL>::aggregate(
             tripletbuffer.emplace_back( equalityindices[k], row, 0 );
 
          flags[row].set( RowFlag::kRedundant );
+         row_hashes.markDirty( row );
          cons_matrix.rowranges[row].start =
              cons_matrix.rowranges[row + 1].start;
          cons_matrix.rowranges[row].end = cons_matrix.rowranges[row + 1].start;
@@ -1461,6 +1582,7 @@ ConstraintMatrix<REAL>::aggregate(
       }
 
       REAL eqscale = eqbasescale * freecolcoef[i];
+      row_hashes.markDirty( row );
 
       int newsize = cons_matrix.changeRow(
           row, int{ 0 }, equalitylen,
@@ -1529,6 +1651,7 @@ ConstraintMatrix<REAL>::aggregate(
              [&]( int k ) { return std::get<2>( tripletbuffer[k] ); },
              []( const REAL& oldval, const REAL& newval ) { return newval; },
              []( int, int, REAL, REAL ) {}, valbuffer, indbuffer );
+         col_hashes.markDirty( col );
 
          if( newsize != colsize[col] )
          {
@@ -1566,6 +1689,7 @@ ConstraintMatrix<REAL>::aggregate(
    }
 
    // set column size to zero
+   col_hashes.markDirty( substituted_col );
    cons_matrix_transp.rowranges[substituted_col].start =
        cons_matrix_transp.rowranges[substituted_col + 1].start;
    cons_matrix_transp.rowranges[substituted_col].end =
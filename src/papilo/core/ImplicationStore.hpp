@@ -0,0 +1,414 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_IMPLICATION_STORE_HPP_
+#define _PAPILO_CORE_IMPLICATION_STORE_HPP_
+
+#include "papilo/core/VariableDomains.hpp"
+#include "papilo/external/pdqsort/pdqsort.h"
+#include "papilo/misc/Vec.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+namespace papilo
+{
+
+/// bound on column col that holds in every feasible solution with the binary
+/// column bincol fixed to value
+template <typename REAL>
+struct Implication
+{
+   REAL bound;
+   int bincol;
+   int col;
+   bool value;
+   bool upper;
+
+   Implication( int bincol_, bool value_, int col_, bool upper_,
+                const REAL& bound_ )
+       : bound( bound_ ), bincol( bincol_ ), col( col_ ), value( value_ ),
+         upper( upper_ )
+   {
+   }
+};
+
+/// view on the implications of one literal, sorted by column and with the
+/// implied lower bound before the implied upper bound of a column
+template <typename REAL>
+class ImplicationView
+{
+ public:
+   ImplicationView( const int* cols_, const uint8_t* upper_,
+                    const REAL* bounds_, int length_ )
+       : cols( cols_ ), upper( upper_ ), bounds( bounds_ ), length( length_ )
+   {
+   }
+
+   const int*
+   getColumns() const
+   {
+      return cols;
+   }
+
+   const uint8_t*
+   getUpper() const
+   {
+      return upper;
+   }
+
+   const REAL*
+   getBounds() const
+   {
+      return bounds;
+   }
+
+   int
+   getLength() const
+   {
+      return length;
+   }
+
+ private:
+   const int* cols;
+   const uint8_t* upper;
+   const REAL* bounds;
+   int length;
+};
+
+/// Implications of the form "binary column x fixed to 0 (1) implies a bound on
+/// column y", stored in CSR format with one row per literal 2 * x + value.
+/// Implications between two binary columns that forbid a pair of values are
+/// the edges of the conflict graph, i.e. the cliques of size two.
+///
+/// Presolvers may add implications concurrently during a round. They become
+/// visible to the queries after ProblemUpdate::flush() merged them, which
+/// keeps only the tightest bound for every literal and column. The store is
+/// renumbered together with the columns of the problem. Implications of and
+/// on columns that are substituted or whose meaning is changed by merging
+/// parallel columns are dropped, all other presolve reductions only remove
+/// solutions and leave the implications valid.
+template <typename REAL>
+class ImplicationStore
+{
+ public:
+   ImplicationStore() = default;
+
+   ImplicationStore( const ImplicationStore& other )
+       : start( other.start ), cols( other.cols ), upper( other.upper ),
+         bounds( other.bounds ), pending( other.pending ),
+         invalid( other.invalid )
+   {
+   }
+
+   ImplicationStore( ImplicationStore&& other ) noexcept
+       : start( std::move( other.start ) ), cols( std::move( other.cols ) ),
+         upper( std::move( other.upper ) ), bounds( std::move( other.bounds ) ),
+         pending( std::move( other.pending ) ),
+         invalid( std::move( other.invalid ) )
+   {
+   }
+
+   ImplicationStore&
+   operator=( const ImplicationStore& other )
+   {
+      start = other.start;
+      cols = other.cols;
+      upper = other.upper;
+      bounds = other.bounds;
+      pending = other.pending;
+      invalid = other.invalid;
+      return *this;
+   }
+
+   ImplicationStore&
+   operator=( ImplicationStore&& other ) noexcept
+   {
+      start = std::move( other.start );
+      cols = std::move( other.cols );
+      upper = std::move( other.upper );
+      bounds = std::move( other.bounds );
+      pending = std::move( other.pending );
+      invalid = std::move( other.invalid );
+      return *this;
+   }
+
+   /// adds an implication, can be called concurrently
+   void
+   add( const Implication<REAL>& implication )
+   {
+      assert( implication.bincol >= 0 && implication.col >= 0 );
+      assert( implication.bincol != implication.col );
+      std::lock_guard<std::mutex> lock( mutex );
+      pending.push_back( implication );
+   }
+
+   /// adds a batch of implications, can be called concurrently
+   void
+   add( const Vec<Implication<REAL>>& implications )
+   {
+      if( implications.empty() )
+         return;
+
+      std::lock_guard<std::mutex> lock( mutex );
+      pending.insert( pending.end(), implications.begin(),
+                      implications.end() );
+   }
+
+   /// drops the implications of and on the column at the next flush, used
+   /// when the column is merged with another column
+   void
+   invalidate( int col )
+   {
+      invalid.push_back( col );
+   }
+
+   /// merges the added implications and drops the invalidated ones
+   void
+   flush( const VariableDomains<REAL>& domains )
+   {
+      if( pending.empty() && invalid.empty() )
+         return;
+
+      const int ncols = static_cast<int>( domains.flags.size() );
+
+      Vec<uint8_t> dropped( ncols, 0 );
+      for( int col : invalid )
+         dropped[col] = 1;
+      for( int col = 0; col != ncols; ++col )
+      {
+         if( domains.flags[col].test( ColFlag::kSubstituted ) )
+            dropped[col] = 1;
+      }
+
+      Vec<Implication<REAL>> entries = extract();
+      entries.insert( entries.end(), pending.begin(), pending.end() );
+      pending.clear();
+      invalid.clear();
+
+      entries.erase( std::remove_if( entries.begin(), entries.end(),
+                                     [&]( const Implication<REAL>& impl ) {
+                                        return dropped[impl.bincol] ||
+                                               dropped[impl.col];
+                                     } ),
+                     entries.end() );
+
+      rebuild( entries, ncols );
+   }
+
+   /// renumbers the columns after the problem was compressed, the domains
+   /// are the ones of the compressed problem and are used to drop the
+   /// implications that are not tighter than the current bounds
+   void
+   compress( const Vec<int>& colmapping, const VariableDomains<REAL>& domains,
+             bool full = false )
+   {
+      Vec<uint8_t> dropped( colmapping.size(), 0 );
+      for( int col : invalid )
+         dropped[col] = 1;
+      invalid.clear();
+
+      Vec<Implication<REAL>> entries = extract();
+      entries.insert( entries.end(), pending.begin(), pending.end() );
+      pending.clear();
+
+      int nkept = 0;
+      for( Implication<REAL>& impl : entries )
+      {
+         if( dropped[impl.bincol] || dropped[impl.col] )
+            continue;
+
+         int bincol = colmapping[impl.bincol];
+         int col = colmapping[impl.col];
+
+         if( bincol == -1 || col == -1 || !domains.isBinary( bincol ) )
+            continue;
+
+         const Flags<ColFlag>& cflags = domains.flags[col];
+         if( impl.upper ? !cflags.test( ColFlag::kUbInf ) &&
+                              impl.bound >= domains.upper_bounds[col]
+                        : !cflags.test( ColFlag::kLbInf ) &&
+                              impl.bound <= domains.lower_bounds[col] )
+            continue;
+
+         impl.bincol = bincol;
+         impl.col = col;
+         entries[nkept++] = impl;
+      }
+      entries.erase( entries.begin() + nkept, entries.end() );
+
+      rebuild( entries, static_cast<int>( domains.flags.size() ) );
+
+      if( full )
+      {
+         start.shrink_to_fit();
+         cols.shrink_to_fit();
+         upper.shrink_to_fit();
+         bounds.shrink_to_fit();
+         pending.shrink_to_fit();
+      }
+   }
+
+   /// number of columns the store was last built for
+   int
+   getNCols() const
+   {
+      return start.empty() ? 0 : static_cast<int>( start.size() - 1 ) / 2;
+   }
+
+   /// number of merged implications
+   int
+   getNumImplications() const
+   {
+      return static_cast<int>( cols.size() );
+   }
+
+   ImplicationView<REAL>
+   getImplications( int bincol, bool value ) const
+   {
+      assert( bincol >= 0 );
+      if( bincol >= getNCols() )
+         return ImplicationView<REAL>( nullptr, nullptr, nullptr, 0 );
+
+      int literal = 2 * bincol + ( value ? 1 : 0 );
+      int first = start[literal];
+      return ImplicationView<REAL>( cols.data() + first, upper.data() + first,
+                                    bounds.data() + first,
+                                    start[literal + 1] - first );
+   }
+
+   /// the implied bound on col for bincol fixed to value, or nullptr if no
+   /// bound is stored
+   const REAL*
+   findBound( int bincol, bool value, int col, bool isupper ) const
+   {
+      ImplicationView<REAL> view = getImplications( bincol, value );
+      const int* colsbegin = view.getColumns();
+      const int* colsend = colsbegin + view.getLength();
+      const int* pos = std::lower_bound( colsbegin, colsend, col );
+
+      for( ; pos != colsend && *pos == col; ++pos )
+      {
+         int k = static_cast<int>( pos - colsbegin );
+         if( ( view.getUpper()[k] != 0 ) == isupper )
+            return view.getBounds() + k;
+      }
+
+      return nullptr;
+   }
+
+   /// whether the binary columns col1 and col2 cannot take the values val1
+   /// and val2 at the same time according to the stored implications
+   bool
+   isConflict( int col1, bool val1, int col2, bool val2 ) const
+   {
+      // col1 = val1 implies col2 <= 0 if val2 = 1 and col2 >= 1 if val2 = 0
+      const REAL* bound = findBound( col1, val1, col2, val2 );
+      if( bound != nullptr && ( val2 ? *bound <= 0 : *bound >= 1 ) )
+         return true;
+
+      bound = findBound( col2, val2, col1, val1 );
+      return bound != nullptr && ( val1 ? *bound <= 0 : *bound >= 1 );
+   }
+
+ private:
+   Vec<Implication<REAL>>
+   extract() const
+   {
+      Vec<Implication<REAL>> entries;
+      entries.reserve( cols.size() );
+
+      for( int literal = 0; literal + 1 < static_cast<int>( start.size() );
+           ++literal )
+      {
+         for( int k = start[literal]; k != start[literal + 1]; ++k )
+            entries.emplace_back( literal / 2, ( literal & 1 ) != 0, cols[k],
+                                  upper[k] != 0, bounds[k] );
+      }
+
+      return entries;
+   }
+
+   /// sorts the implications by literal and column and keeps the tightest
+   /// bound of duplicates
+   void
+   rebuild( Vec<Implication<REAL>>& entries, int ncols )
+   {
+      pdqsort( entries.begin(), entries.end(),
+               []( const Implication<REAL>& a, const Implication<REAL>& b ) {
+                  return std::make_tuple( a.bincol, a.value, a.col, a.upper ) <
+                         std::make_tuple( b.bincol, b.value, b.col, b.upper );
+               } );
+
+      start.assign( 2 * size_t( ncols ) + 1, 0 );
+      cols.clear();
+      upper.clear();
+      bounds.clear();
+      cols.reserve( entries.size() );
+      upper.reserve( entries.size() );
+      bounds.reserve( entries.size() );
+
+      for( std::size_t i = 0; i != entries.size(); ++i )
+      {
+         const Implication<REAL>& impl = entries[i];
+         assert( impl.bincol < ncols && impl.col < ncols );
+
+         if( i != 0 && entries[i - 1].bincol == impl.bincol &&
+             entries[i - 1].value == impl.value &&
+             entries[i - 1].col == impl.col &&
+             entries[i - 1].upper == impl.upper )
+         {
+            REAL& bound = bounds.back();
+            if( impl.upper ? impl.bound < bound : impl.bound > bound )
+               bound = impl.bound;
+            continue;
+         }
+
+         ++start[2 * impl.bincol + ( impl.value ? 1 : 0 ) + 1];
+         cols.push_back( impl.col );
+         upper.push_back( impl.upper ? 1 : 0 );
+         bounds.push_back( impl.bound );
+      }
+
+      for( std::size_t literal = 1; literal != start.size(); ++literal )
+         start[literal] += start[literal - 1];
+   }
+
+   // CSR arrays indexed by the literal 2 * bincol + value
+   Vec<int> start;
+   Vec<int> cols;
+   Vec<uint8_t> upper;
+   Vec<REAL> bounds;
+
+   // implications added since the last flush and columns to drop at the
+   // next flush
+   std::mutex mutex;
+   Vec<Implication<REAL>> pending;
+   Vec<int> invalid;
+};
+
+} // namespace papilo
+
+#endif
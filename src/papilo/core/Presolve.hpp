@@ -26,18 +26,24 @@
 #define _PAPILO_CORE_PRESOLVE_HPP_
 
 #include "papilo/Config.hpp"
+#include "papilo/core/Components.hpp"
 #include "papilo/core/PresolveMethod.hpp"
 #include "papilo/core/PresolveOptions.hpp"
 #include "papilo/core/Problem.hpp"
+#include "papilo/core/ProblemBuilder.hpp"
+#include "papilo/core/ProblemChanges.hpp"
 #include "papilo/core/ProblemUpdate.hpp"
 #include "papilo/core/Statistics.hpp"
+#include "papilo/core/TransactionLog.hpp"
 #include "papilo/core/postsolve/Postsolve.hpp"
 #include "papilo/core/postsolve/PostsolveStorage.hpp"
 #include "papilo/interfaces/SolverInterface.hpp"
 #include "papilo/io/Message.hpp"
 #include "papilo/misc/DependentRows.hpp"
+#include "papilo/misc/MemoryResource.hpp"
 #include "papilo/misc/ParameterSet.hpp"
 #include "papilo/misc/Timer.hpp"
+#include "papilo/misc/Trace.hpp"
 #ifdef PAPILO_TBB
 #include "papilo/misc/tbb.hpp"
 #endif
@@ -76,6 +82,9 @@ struct PresolveResult
 {
    PostsolveStorage<REAL> postsolve;
    PresolveStatus status;
+   /// applied transactions, only recorded if presolve.recordtransactions is
+   /// set, used to warm start the presolve of a modified problem
+   TransactionLog<REAL> transactions;
 };
 
 enum class Delegator
@@ -156,6 +165,27 @@ class Presolve
    PresolveResult<REAL>
    apply( Problem<REAL>& problem, bool store_dual_postsolve = true );
 
+   /**
+    * presolves a modification of the problem presolved by a previous run.
+    * The original problem stored in the postsolve information of the
+    * previous run is modified by the given changes. Then the transactions
+    * recorded by the previous run are replayed if the rows and columns they
+    * are based on did not change, see TransactionFingerprint, and the
+    * presolvers run on the result to find the remaining reductions. If the
+    * previous run did not record its transactions or replaying fails, the
+    * modified problem is presolved from scratch.
+    *
+    * @param problem: is set to the presolved modified problem
+    * @param previous: result of the previous presolve run
+    * @param changes: modifications of the original problem
+    * @return: PresolveResult of the modified problem, status kInfeasible if
+    * the changes are not valid for the original problem
+    */
+   PresolveResult<REAL>
+   applyWarmStart( Problem<REAL>& problem, const PresolveResult<REAL>& previous,
+                   const ProblemChanges<REAL>& changes,
+                   bool store_dual_postsolve = true );
+
    /// add presolve method to presolving
    void
    addPresolveMethod( std::unique_ptr<PresolveMethod<REAL>> presolveMethod )
@@ -278,6 +308,14 @@ class Presolve
       return presolverStats;
    }
 
+   /// events of the last presolve run, nullptr if presolve.tracefile is not
+   /// set
+   const Tracer*
+   getTracer() const
+   {
+      return tracer.get();
+   }
+
    std::pair<int, int>
    applyReductions( int p, const Reductions<REAL>& reductions_,
                     ProblemUpdate<REAL>& probUpdate );
@@ -308,6 +346,16 @@ class Presolve
    std::unique_ptr<SolverFactory<REAL>> satSolverFactory;
 
    Vec<std::pair<int, int>> presolverStats;
+   /// arena of every presolver, reset before the presolver runs again,
+   /// empty unless presolve.arenas is set
+   Vec<MonotonicArena> arenas;
+   /// timeline of the presolve run, only if presolve.tracefile is set
+   std::unique_ptr<Tracer> tracer;
+   /// rows and columns of the original problem that make up the problem of a
+   /// part presolved by presolve.splitcomponents, the postsolve information
+   /// of the part refers to them
+   const Vec<int>* part_rows = nullptr;
+   const Vec<int>* part_cols = nullptr;
    bool successful{};
    bool rundelayed{};
    bool reduced{};
@@ -393,11 +441,63 @@ class Presolve
                    const std::pair<int, int>& presolver_2_run,
                    ProblemUpdate<REAL>& probUpdate, bool& run_sequential, const Timer& timer );
 
+   PresolveStatus
+   run_presolver( int presolver, const Problem<REAL>& problem,
+                  ProblemUpdate<REAL>& probUpdate, const Timer& timer,
+                  int& cause );
+
+   double
+   get_execution_time( const std::pair<int, int>& presolver_2_run ) const;
+
+   void
+   record_round_utilization( const std::pair<int, int>& presolver_2_run,
+                             double exectime_before, double walltime );
+
    bool
    is_status_infeasible_or_unbounded( const PresolveStatus& status ) const;
 
    bool
    are_only_dual_postsolve_presolvers_enabled();
+
+   PresolveResult<REAL>
+   presolve( Problem<REAL>& problem, bool store_dual_postsolve,
+             const TransactionLog<REAL>* replay_log );
+
+   PresolveResult<REAL>
+   run_presolve( Problem<REAL>& problem, bool store_dual_postsolve,
+                 const TransactionLog<REAL>* replay_log );
+
+   bool
+   can_split_components( const Problem<REAL>& problem,
+                         bool store_dual_postsolve,
+                         const TransactionLog<REAL>* replay_log );
+
+   int
+   split_components( const Problem<REAL>& problem, Vec<Vec<int>>& partrows,
+                     Vec<Vec<int>>& partcols ) const;
+
+   PresolveResult<REAL>
+   presolve_parts( Problem<REAL>& problem, const Vec<Vec<int>>& partrows,
+                   const Vec<Vec<int>>& partcols );
+
+   static void
+   copy_part( const Problem<REAL>& problem, const Vec<int>& rows,
+              const Vec<int>& cols, const Vec<int>& colindex, int rowoffset,
+              int coloffset, ProblemBuilder<REAL>& builder,
+              Vec<int>& rowstart, Vec<int>& matcols, Vec<REAL>& matvals );
+
+   PresolveStatus
+   replay_transactions( const TransactionLog<REAL>& log,
+                        ProblemUpdate<REAL>& probUpdate );
+
+   bool
+   is_replayable( int presolver ) const;
+
+   MemoryResource*
+   get_arena( int presolver )
+   {
+      return arenas.empty() ? nullptr : arenas[presolver].getResource();
+   }
 };
 
 #ifdef PAPILO_USE_EXTERN_TEMPLATES
@@ -420,6 +520,82 @@ extern template class Presolve<Rational>;
 template <typename REAL>
 PresolveResult<REAL>
 Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
+{
+   return presolve( problem, store_dual_postsolve, nullptr );
+}
+
+template <typename REAL>
+PresolveResult<REAL>
+Presolve<REAL>::applyWarmStart( Problem<REAL>& problem,
+                                const PresolveResult<REAL>& previous,
+                                const ProblemChanges<REAL>& changes,
+                                bool store_dual_postsolve )
+{
+   problem = previous.postsolve.getOriginalProblem();
+   if( !changes.apply( problem, previous.postsolve.getNum() ) )
+   {
+      msg.error( "warm start: the changes do not fit the original problem\n" );
+      PresolveResult<REAL> result;
+      result.status = PresolveStatus::kInfeasible;
+      return result;
+   }
+
+   const TransactionLog<REAL>& log = previous.transactions;
+   if( log.empty() || log.getNRows() != problem.getNRows() ||
+       log.getNCols() != problem.getNCols() ||
+       is_status_infeasible_or_unbounded( previous.status ) ||
+       presolveOptions.verification_with_VeriPB )
+   {
+      msg.info( "warm start: no transactions to replay, presolving from "
+                "scratch\n" );
+      return presolve( problem, store_dual_postsolve, nullptr );
+   }
+
+   PresolveResult<REAL> result =
+       presolve( problem, store_dual_postsolve, &log );
+   if( !is_status_infeasible_or_unbounded( result.status ) ||
+       stats.ntsxreplayed == 0 )
+      return result;
+
+   // make sure that the status is not caused by a replayed transaction
+   msg.info( "warm start: presolving from scratch to confirm status\n" );
+   problem = previous.postsolve.getOriginalProblem();
+   changes.apply( problem, previous.postsolve.getNum() );
+   return presolve( problem, store_dual_postsolve, nullptr );
+}
+
+template <typename REAL>
+PresolveResult<REAL>
+Presolve<REAL>::presolve( Problem<REAL>& problem, bool store_dual_postsolve,
+                          const TransactionLog<REAL>* replay_log )
+{
+   tracer.reset( presolveOptions.trace_file.empty() ? nullptr : new Tracer() );
+
+   PresolveResult<REAL> result;
+   {
+      TraceScope trace( tracer.get(), "presolve", "presolve" );
+      Vec<Vec<int>> partrows;
+      Vec<Vec<int>> partcols;
+      if( can_split_components( problem, store_dual_postsolve, replay_log ) &&
+          split_components( problem, partrows, partcols ) > 1 )
+         result = presolve_parts( problem, partrows, partcols );
+      else
+         result = run_presolve( problem, store_dual_postsolve, replay_log );
+      trace.addArg( "status", static_cast<int>( result.status ) );
+   }
+
+   if( tracer != nullptr && !tracer->write( presolveOptions.trace_file ) )
+      msg.error( "could not write the trace to {}\n",
+                 presolveOptions.trace_file );
+
+   return result;
+}
+
+template <typename REAL>
+PresolveResult<REAL>
+Presolve<REAL>::run_presolve( Problem<REAL>& problem,
+                              bool store_dual_postsolve,
+                              const TransactionLog<REAL>* replay_log )
 {
 #ifdef PAPILO_TBB
    tbb::task_arena arena( presolveOptions.threads == 0
@@ -438,7 +614,8 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
       msg.error("\nRunning rational presolving with positive tolerances may give unexpected results. \n");
 
 #ifdef PAPILO_TBB
-   return arena.execute( [this, &problem, store_dual_postsolve]() {
+   return arena.execute( [this, &problem, store_dual_postsolve,
+                          replay_log]() {
 #endif
       stats = Statistics();
       num.setFeasTol( REAL{ presolveOptions.feastol } );
@@ -458,6 +635,23 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
 
       result.postsolve =
           PostsolveStorage<REAL>( problem, num, presolveOptions );
+      if( part_cols != nullptr )
+      {
+         // the reductions of a part are stored for the indices of the
+         // original problem so that the postsolve stacks can be concatenated
+         result.postsolve.origrow_mapping = *part_rows;
+         result.postsolve.origcol_mapping = *part_cols;
+      }
+
+      // release the spare space right away if less is configured than the
+      // matrix was built with
+      const bool lessSpareSpace =
+          presolveOptions.spareratio < constraintMatrix.getSpareRatio() ||
+          presolveOptions.minrowspace < constraintMatrix.getMinInterRowSpace();
+      constraintMatrix.setSpareSpace( presolveOptions.spareratio,
+                                      presolveOptions.minrowspace );
+      if( lessSpareSpace )
+         constraintMatrix.compress();
 
 #ifndef PAPILO_TBB
       if( presolveOptions.threads != 1 )
@@ -487,6 +681,12 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
              new VeriPb<REAL>{ problem, num, presolveOptions } );
          certificate_interface->print_header();
       }
+      else if( certificate_interface == nullptr )
+      {
+         // the interface was moved into the ProblemUpdate of a previous run
+         certificate_interface = std::unique_ptr<CertificateInterface<REAL>>(
+             new EmptyCertificate<REAL>() );
+      }
 
       msg.info( "\nstarting presolve of problem {} with dual-postsolve {}activated\n", problem.getName(), result.postsolve.postsolveType == PostsolveType::kFull?"":"de-" );
       msg.info( "  rows:     {}\n", problem.getNRows() );
@@ -533,13 +733,24 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
       reductions.resize( presolvers.size() );
       results.resize( presolvers.size() );
       presolverStats.resize( presolvers.size(), std::pair<int, int>( 0, 0 ) );
+      arenas.clear();
+      if( presolveOptions.arenas )
+         arenas.resize( presolvers.size() );
 
       ProblemUpdate<REAL> probUpdate( problem, result.postsolve, stats,
                                       presolveOptions, num, msg, certificate_interface
       );
 
+      if( presolveOptions.record_transactions )
+      {
+         result.transactions.reset( problem.getNRows(), problem.getNCols() );
+         probUpdate.setTransactionLog( &result.transactions );
+      }
+      probUpdate.setTracer( tracer.get() );
+
       for( int i = 0; i != npresolvers; ++i )
       {
+         presolvers[i]->resetSkipRounds();
          if( presolvers[i]->isEnabled() )
          {
             if( presolvers[i]->initialize( problem, presolveOptions ) )
@@ -561,6 +772,16 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
          }
       }
 
+      if( replay_log != nullptr )
+      {
+         TraceScope trace( tracer.get(), "phase", "replay transactions" );
+         result.status = replay_transactions( *replay_log, probUpdate );
+         trace.addArg( "replayed", stats.ntsxreplayed );
+         trace.addArg( "not replayed", stats.ntsxnotreplayed );
+         if( is_status_infeasible_or_unbounded( result.status ) )
+            return result;
+      }
+
       Statistics last_rounds_stats = stats;
       do
       {
@@ -577,6 +798,7 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
             }
 
             result.status = probUpdate.trivialPresolve();
+            probUpdate.logStep( TransactionStep::kTrivialPresolve );
 
             if( stats.nrounds == 0 )
                printRoundStats( "Trivial" );
@@ -602,30 +824,83 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
 
          bool was_executed_sequential = false;
 
+         std::pair<int, int> presolvers_of_round;
          switch( round_to_evaluate )
          {
          case Delegator::kFast:
-            run_presolvers( problem, fastPresolvers, probUpdate,
-                            was_executed_sequential, timer );
+            presolvers_of_round = fastPresolvers;
             break;
          case Delegator::kMedium:
-            run_presolvers( problem, mediumPresolvers, probUpdate,
-                            was_executed_sequential, timer );
+            presolvers_of_round = mediumPresolvers;
             break;
          case Delegator::kExhaustive:
-            run_presolvers( problem, exhaustivePresolvers, probUpdate,
-                            was_executed_sequential, timer );
+            presolvers_of_round = exhaustivePresolvers;
             break;
          default:
             assert( false );
          }
 
+         // the task graph overlaps the current tier with all higher tiers,
+         // they all read the same problem and their reductions are applied
+         // together with the usual conflict checks
+         bool overlap_tiers = presolveOptions.task_graph_scheduling &&
+                              !presolveOptions.runs_sequential();
+         if( overlap_tiers )
+            presolvers_of_round.second = exhaustivePresolvers.second;
+
+#ifdef PAPILO_RESOURCE_ALLOCATOR
+         uint64_t nsystemallocs =
+             MemoryResource::getCounters().nsystemallocs;
+#endif
+         TraceScope round_trace( tracer.get(), "round",
+                                 get_round_type( round_to_evaluate ).c_str() );
+         round_trace.addArg( "round", stats.nrounds );
+         double round_exectime = get_execution_time( presolvers_of_round );
+         double round_walltime = 0;
+         {
+            Timer round_timer( round_walltime );
+            run_presolvers( problem, presolvers_of_round, probUpdate,
+                            was_executed_sequential, timer );
+         }
+         record_round_utilization( presolvers_of_round, round_exectime,
+                                   round_walltime );
+
+         // the higher tiers already failed on this problem
+         if( overlap_tiers && evaluateResults() == PresolveStatus::kUnchanged )
+            round_to_evaluate = Delegator::kExhaustive;
+
          result.status = evaluate_and_apply( timer, problem, result, probUpdate,last_rounds_stats,
                was_executed_sequential );
 
          if( is_status_infeasible_or_unbounded( result.status ) )
             return result;
 
+         if( presolveOptions.track_components )
+         {
+            probUpdate.updateComponents();
+            stats.round_components.push_back(
+                probUpdate.getComponents().getNumComponents() );
+         }
+
+         if( tracer != nullptr )
+         {
+            tracer->addCounter( "active problem",
+                                { { "rows", probUpdate.getNActiveRows() },
+                                  { "cols", probUpdate.getNActiveCols() } } );
+            if( presolveOptions.track_components )
+               tracer->addCounter(
+                   "components",
+                   { { "components",
+                       probUpdate.getComponents().getNumComponents() } } );
+            tracer->addCounter( "transactions",
+                                { { "applied", stats.ntsxapplied },
+                                  { "conflicts", stats.ntsxconflicts } } );
+         }
+
+#ifdef PAPILO_RESOURCE_ALLOCATOR
+         stats.round_system_allocs.push_back(
+             MemoryResource::getCounters().nsystemallocs - nsystemallocs );
+#endif
          last_rounds_stats = stats;
       }
       while( true );
@@ -695,7 +970,10 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
                       equations.size() );
             {
                Timer t{ factorTime };
+               TraceScope trace( tracer.get(), "phase", "dependent rows" );
                dependentEqs = depRows.getDependentRows( msg, num );
+               trace.addArg( "equations", equations.size() );
+               trace.addArg( "dependent", dependentEqs.size() );
             }
             msg.info( "{} equations are redundant, factorization took {} "
                       "seconds\n",
@@ -750,7 +1028,11 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
 
                {
                   Timer t{ factorTime };
+                  TraceScope trace( tracer.get(), "phase",
+                                    "dependent free columns" );
                   dependentFreeCols = depRows.getDependentRows( msg, num );
+                  trace.addArg( "free columns", freeCols.size() );
+                  trace.addArg( "dependent", dependentFreeCols.size() );
                }
 
                msg.info( "{} free columns are redundant, factorization took {} "
@@ -805,9 +1087,11 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
                   && ( /* satSolverFactory != nullptr || */ problem.getNumIntegralCols() == 0 ) ) ) )
          {
             assert( problem.getNCols() != 0 && problem.getNRows() != 0 );
+            TraceScope components_trace( tracer.get(), "phase", "components" );
             Components components;
 
             int ncomponents = components.detectComponents( problem );
+            components_trace.addArg( "components", ncomponents );
 
             if( ncomponents > 1 )
             {
@@ -848,6 +1132,13 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
 
 #endif
                       {
+                         TraceScope trace( tracer.get(), "phase",
+                                           "solve component" );
+                         trace.addArg( "cols", compInfo[i].nintegral +
+                                                   compInfo[i].ncontinuous );
+                         trace.addArg( "int cols", compInfo[i].nintegral );
+                         trace.addArg( "nonzeros", compInfo[i].nnonz );
+
                          if( lpSolverFactory != nullptr
                             && compInfo[i].nintegral == 0 )
                          {
@@ -1024,6 +1315,429 @@ Presolve<REAL>::apply( Problem<REAL>& problem, bool store_dual_postsolve )
 #endif
 }
 
+template <typename REAL>
+bool
+Presolve<REAL>::can_split_components( const Problem<REAL>& problem,
+                                      bool store_dual_postsolve,
+                                      const TransactionLog<REAL>* replay_log )
+{
+   if( !presolveOptions.split_components || part_cols != nullptr ||
+       replay_log != nullptr || problem.getNCols() < 2 )
+      return false;
+
+   // the parts only store primal postsolve information
+   if( presolveOptions.record_transactions ||
+       presolveOptions.verification_with_VeriPB ||
+       ( store_dual_postsolve &&
+         problem.test_problem_type( ProblemFlag::kLinear ) &&
+         presolveOptions.componentsmaxint == -1 &&
+         presolveOptions.detectlindep == 0 &&
+         are_only_dual_postsolve_presolvers_enabled() ) )
+   {
+      msg.info( "presolve.splitcomponents is ignored for dual postsolve, "
+                "recorded transactions and certificates\n" );
+      return false;
+   }
+
+   // the parts are presolved with a copy of the default presolvers
+   Presolve<REAL> defaults;
+   defaults.addDefaultPresolvers();
+   Vec<String> names;
+   Vec<String> defaultnames;
+   for( const std::unique_ptr<PresolveMethod<REAL>>& presolver : presolvers )
+      names.push_back( presolver->getName() );
+   for( const std::unique_ptr<PresolveMethod<REAL>>& presolver :
+        defaults.presolvers )
+      defaultnames.push_back( presolver->getName() );
+   std::sort( names.begin(), names.end() );
+   std::sort( defaultnames.begin(), defaultnames.end() );
+
+   if( names != defaultnames )
+   {
+      msg.info( "presolve.splitcomponents is ignored since the presolvers "
+                "differ from the default presolvers\n" );
+      return false;
+   }
+
+   return true;
+}
+
+/// groups the disconnected components of the problem into parts of similar
+/// size and returns the number of parts, the rows and columns of every part
+/// are sorted
+template <typename REAL>
+int
+Presolve<REAL>::split_components( const Problem<REAL>& problem,
+                                  Vec<Vec<int>>& partrows,
+                                  Vec<Vec<int>>& partcols ) const
+{
+   TraceScope trace( tracer.get(), "phase", "split components" );
+   Components components;
+   const int ncomponents = components.detectComponents( problem );
+   trace.addArg( "components", ncomponents );
+   if( ncomponents <= 1 )
+      return ncomponents;
+
+   // the components are assigned to the parts in the order of their first
+   // column so that the parts do not depend on the number of threads
+   const int maxparts = 64;
+   const Vec<int>& colsize = problem.getColSizes();
+   const int64_t total =
+       problem.getNCols() + problem.getConstraintMatrix().getNnz();
+   const int64_t partsize = ( total + maxparts - 1 ) / maxparts;
+   int64_t size = 0;
+
+   for( int c = 0; c != ncomponents; ++c )
+   {
+      if( size == 0 )
+      {
+         partrows.emplace_back();
+         partcols.emplace_back();
+      }
+
+      const int* compcols = components.getComponentsCols( c );
+      const int numcompcols = components.getComponentsNumCols( c );
+      partcols.back().insert( partcols.back().end(), compcols,
+                              compcols + numcompcols );
+      for( int i = 0; i != numcompcols; ++i )
+         size += colsize[compcols[i]] + 1;
+
+      const int* comprows = components.getComponentsRows( c );
+      partrows.back().insert( partrows.back().end(), comprows,
+                              comprows + components.getComponentsNumRows( c ) );
+
+      if( size >= partsize )
+         size = 0;
+   }
+
+   for( std::size_t p = 0; p != partcols.size(); ++p )
+   {
+      std::sort( partrows[p].begin(), partrows[p].end() );
+      std::sort( partcols[p].begin(), partcols[p].end() );
+   }
+
+   trace.addArg( "parts", static_cast<int64_t>( partcols.size() ) );
+   return static_cast<int>( partcols.size() );
+}
+
+/// adds the given rows and columns of the problem behind the rows and columns
+/// that the builder already holds, colindex maps the columns of the problem to
+/// the columns of the builder and the matrix is collected in CSR format
+template <typename REAL>
+void
+Presolve<REAL>::copy_part( const Problem<REAL>& problem, const Vec<int>& rows,
+                           const Vec<int>& cols, const Vec<int>& colindex,
+                           int rowoffset, int coloffset,
+                           ProblemBuilder<REAL>& builder, Vec<int>& rowstart,
+                           Vec<int>& matcols, Vec<REAL>& matvals )
+{
+   const ConstraintMatrix<REAL>& consMatrix = problem.getConstraintMatrix();
+   const VariableDomains<REAL>& domains = problem.getVariableDomains();
+   const Vec<REAL>& obj = problem.getObjective().coefficients;
+   const Vec<REAL>& lhs = consMatrix.getLeftHandSides();
+   const Vec<REAL>& rhs = consMatrix.getRightHandSides();
+   const Vec<RowFlags>& rflags = consMatrix.getRowFlags();
+   const Vec<String>& colnames = problem.getVariableNames();
+   const Vec<String>& rownames = problem.getConstraintNames();
+
+   for( std::size_t k = 0; k != cols.size(); ++k )
+   {
+      const int col = cols[k];
+      const int newcol = coloffset + static_cast<int>( k );
+      builder.setObj( newcol, obj[col] );
+      builder.setColLb( newcol, domains.lower_bounds[col] );
+      builder.setColUb( newcol, domains.upper_bounds[col] );
+      builder.setColLbInf( newcol, domains.flags[col].test( ColFlag::kLbInf ) );
+      builder.setColUbInf( newcol, domains.flags[col].test( ColFlag::kUbInf ) );
+      builder.setColIntegral( newcol,
+                              domains.flags[col].test( ColFlag::kIntegral ) );
+      builder.setColImplInt( newcol,
+                             domains.flags[col].test( ColFlag::kImplInt ) );
+      if( !colnames.empty() )
+         builder.setColName( newcol, colnames[col] );
+   }
+
+   for( std::size_t k = 0; k != rows.size(); ++k )
+   {
+      const int row = rows[k];
+      const int newrow = rowoffset + static_cast<int>( k );
+      builder.setRowLhs( newrow, lhs[row] );
+      builder.setRowRhs( newrow, rhs[row] );
+      builder.setRowLhsInf( newrow, rflags[row].test( RowFlag::kLhsInf ) );
+      builder.setRowRhsInf( newrow, rflags[row].test( RowFlag::kRhsInf ) );
+      if( !rownames.empty() )
+         builder.setRowName( newrow, rownames[row] );
+
+      const SparseVectorView<REAL> rowvec = consMatrix.getRowCoefficients( row );
+      const int* rowcols = rowvec.getIndices();
+      const REAL* rowvals = rowvec.getValues();
+      for( int i = 0; i != rowvec.getLength(); ++i )
+      {
+         matcols.push_back( colindex[rowcols[i]] );
+         matvals.push_back( rowvals[i] );
+      }
+      rowstart.push_back( static_cast<int>( matcols.size() ) );
+   }
+}
+
+/// presolves the parts of the problem independently with their own presolve
+/// and merges the reduced problems and postsolve stacks afterwards
+template <typename REAL>
+PresolveResult<REAL>
+Presolve<REAL>::presolve_parts( Problem<REAL>& problem,
+                                const Vec<Vec<int>>& partrows,
+                                const Vec<Vec<int>>& partcols )
+{
+#ifdef PAPILO_TBB
+   tbb::task_arena arena( presolveOptions.threads == 0
+                              ? tbb::task_arena::automatic
+                              : presolveOptions.threads );
+
+   return arena.execute( [this, &problem, &partrows, &partcols]() {
+#endif
+      stats = Statistics();
+      num.setFeasTol( REAL{ presolveOptions.feastol } );
+      num.setEpsilon( REAL{ presolveOptions.epsilon } );
+      num.setHugeVal( REAL{ presolveOptions.hugeval } );
+      num.setUseAbsFeas( presolveOptions.useabsfeas );
+
+      Timer timer( stats.presolvetime );
+      const int nparts = static_cast<int>( partcols.size() );
+
+      PresolveResult<REAL> result;
+      result.postsolve =
+          PostsolveStorage<REAL>( problem, num, presolveOptions );
+      result.status = PresolveStatus::kUnchanged;
+
+      msg.info( "\nstarting presolve of problem {} split into {} parts of "
+                "disconnected components\n",
+                problem.getName(), nparts );
+      msg.info( "  rows:     {}\n", problem.getNRows() );
+      msg.info( "  columns:  {}\n", problem.getNCols() );
+      msg.info( "  int. columns:  {}\n", problem.getNumIntegralCols() );
+      msg.info( "  cont. columns:  {}\n", problem.getNumContinuousCols() );
+      msg.info( "  nonzeros: {}\n\n", problem.getConstraintMatrix().getNnz() );
+
+      Vec<int> localcol( problem.getNCols() );
+      for( int p = 0; p != nparts; ++p )
+      {
+         for( std::size_t k = 0; k != partcols[p].size(); ++k )
+            localcol[partcols[p][k]] = static_cast<int>( k );
+      }
+
+      ParameterSet parameters = getParameters();
+      Vec<Problem<REAL>> parts( nparts );
+      Vec<PresolveResult<REAL>> partresults( nparts );
+      Vec<Statistics> partstats( nparts );
+
+      auto presolve_part = [&]( int p ) {
+         TraceScope trace( tracer.get(), "phase", "presolve part" );
+         trace.addArg( "cols", static_cast<int64_t>( partcols[p].size() ) );
+         trace.addArg( "rows", static_cast<int64_t>( partrows[p].size() ) );
+
+         ProblemBuilder<REAL> builder;
+         Vec<int> rowstart{ 0 };
+         Vec<int> matcols;
+         Vec<REAL> matvals;
+         builder.setNumRows( static_cast<int>( partrows[p].size() ) );
+         builder.setNumCols( static_cast<int>( partcols[p].size() ) );
+         builder.setProblemName( problem.getName() );
+         // the objective offset is kept by the first part only
+         if( p == 0 )
+            builder.setObjOffset( problem.getObjective().offset );
+         copy_part( problem, partrows[p], partcols[p], localcol, 0, 0,
+                    builder, rowstart, matcols, matvals );
+         builder.setMatrixCSR( rowstart.data(), matcols.data(),
+                               matvals.data() );
+         parts[p] = builder.build();
+
+         Presolve<REAL> partpresolve;
+         partpresolve.addDefaultPresolvers();
+         partpresolve.getParameters().copyValues( parameters );
+         partpresolve.presolveOptions.split_components = false;
+         partpresolve.presolveOptions.componentsmaxint = -1;
+         partpresolve.presolveOptions.trace_file = "";
+         partpresolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+         partpresolve.part_rows = &partrows[p];
+         partpresolve.part_cols = &partcols[p];
+
+         partresults[p] = partpresolve.apply( parts[p], false );
+         partstats[p] = partpresolve.getStatistics();
+         trace.addArg( "status", static_cast<int>( partresults[p].status ) );
+      };
+
+#ifdef PAPILO_TBB
+      tbb::parallel_for(
+          tbb::blocked_range<int>( 0, nparts ),
+          [&]( const tbb::blocked_range<int>& r ) {
+             for( int p = r.begin(); p != r.end(); ++p )
+                presolve_part( p );
+          },
+          tbb::simple_partitioner() );
+#else
+      for( int p = 0; p != nparts; ++p )
+         presolve_part( p );
+#endif
+
+      for( int p = 0; p != nparts; ++p )
+      {
+         const Statistics& partstat = partstats[p];
+         stats.ntsxapplied += partstat.ntsxapplied;
+         stats.ntsxconflicts += partstat.ntsxconflicts;
+         stats.nboundchgs += partstat.nboundchgs;
+         stats.nsidechgs += partstat.nsidechgs;
+         stats.ncoefchgs += partstat.ncoefchgs;
+         stats.ndeletedcols += partstat.ndeletedcols;
+         stats.ndeletedrows += partstat.ndeletedrows;
+         stats.single_matrix_coefficient_changes +=
+             partstat.single_matrix_coefficient_changes;
+         stats.nrounds = std::max( stats.nrounds, partstat.nrounds );
+
+         // the status of the problem is the largest status of its parts
+         result.status = static_cast<PresolveStatus>(
+             std::max( static_cast<int>( result.status ),
+                       static_cast<int>( partresults[p].status ) ) );
+      }
+
+      if( is_status_infeasible_or_unbounded( result.status ) )
+      {
+         msg.info( "presolving detected an infeasible or unbounded part\n" );
+         return result;
+      }
+
+      // the original problem stays untouched if no part was reduced
+      if( result.status == PresolveStatus::kUnchanged )
+      {
+         msg.info( "presolving of {} parts finished, problem is unchanged\n",
+                   nparts );
+         return result;
+      }
+
+      // concatenate the postsolve stacks, their indices already refer to the
+      // original problem
+      PostsolveStorage<REAL>& postsolve = result.postsolve;
+      postsolve.origrow_mapping.clear();
+      postsolve.origcol_mapping.clear();
+      for( int p = 0; p != nparts; ++p )
+      {
+         const PostsolveStorage<REAL>& partpostsolve = partresults[p].postsolve;
+         const int offset = static_cast<int>( postsolve.values.size() );
+         postsolve.types.insert( postsolve.types.end(),
+                                 partpostsolve.types.begin(),
+                                 partpostsolve.types.end() );
+         postsolve.indices.insert( postsolve.indices.end(),
+                                   partpostsolve.indices.begin(),
+                                   partpostsolve.indices.end() );
+         postsolve.values.insert( postsolve.values.end(),
+                                  partpostsolve.values.begin(),
+                                  partpostsolve.values.end() );
+         for( std::size_t i = 1; i < partpostsolve.start.size(); ++i )
+            postsolve.start.push_back( partpostsolve.start[i] + offset );
+         postsolve.origrow_mapping.insert(
+             postsolve.origrow_mapping.end(),
+             partpostsolve.origrow_mapping.begin(),
+             partpostsolve.origrow_mapping.end() );
+         postsolve.origcol_mapping.insert(
+             postsolve.origcol_mapping.end(),
+             partpostsolve.origcol_mapping.begin(),
+             partpostsolve.origcol_mapping.end() );
+      }
+
+      // stack the reduced problems of the parts
+      ProblemBuilder<REAL> builder;
+      Vec<int> rowstart{ 0 };
+      Vec<int> matcols;
+      Vec<REAL> matvals;
+      int nnz = 0;
+      for( int p = 0; p != nparts; ++p )
+         nnz += parts[p].getConstraintMatrix().getNnz();
+      matcols.reserve( nnz );
+      matvals.reserve( nnz );
+      builder.setNumRows(
+          static_cast<int>( postsolve.origrow_mapping.size() ) );
+      builder.setNumCols(
+          static_cast<int>( postsolve.origcol_mapping.size() ) );
+      builder.setProblemName( problem.getName() );
+
+      REAL offset = 0;
+      int rowoffset = 0;
+      int coloffset = 0;
+      Vec<Symmetry> symmetries;
+      for( int p = 0; p != nparts; ++p )
+      {
+         const Problem<REAL>& part = parts[p];
+         Vec<int> rows( part.getNRows() );
+         Vec<int> cols( part.getNCols() );
+         Vec<int> colindex( part.getNCols() );
+         for( int row = 0; row != part.getNRows(); ++row )
+            rows[row] = row;
+         for( int col = 0; col != part.getNCols(); ++col )
+         {
+            cols[col] = col;
+            colindex[col] = coloffset + col;
+         }
+
+         copy_part( part, rows, cols, colindex, rowoffset, coloffset, builder,
+                    rowstart, matcols, matvals );
+
+         for( const Symmetry& symmetry : part.getSymmetries().symmetries )
+            symmetries.emplace_back( coloffset + symmetry.getDominatingCol(),
+                                     coloffset + symmetry.getDominatedCol(),
+                                     symmetry.getSymmetryType() );
+
+         offset += part.getObjective().offset;
+         rowoffset += part.getNRows();
+         coloffset += part.getNCols();
+      }
+      builder.setObjOffset( offset );
+      builder.setMatrixCSR( rowstart.data(), matcols.data(), matvals.data() );
+
+      Problem<REAL> reduced = builder.build();
+      for( ProblemFlag flag :
+           { ProblemFlag::kMixedInteger, ProblemFlag::kInteger,
+             ProblemFlag::kLinear, ProblemFlag::kBinary } )
+      {
+         if( problem.test_problem_type( flag ) )
+            reduced.set_problem_type( flag );
+      }
+      reduced.getSymmetries().symmetries = std::move( symmetries );
+      problem = std::move( reduced );
+
+      msg.info( "presolved {} parts in {:.3f} seconds: {} rounds, {} del "
+                "cols, {} del rows, {} chg bounds, {} chg sides, {} chg "
+                "coeffs, {} tsx applied, {} tsx conflicts\n",
+                nparts, timer.getTime(), stats.nrounds, stats.ndeletedcols,
+                stats.ndeletedrows, stats.nboundchgs, stats.nsidechgs,
+                stats.ncoefchgs, stats.ntsxapplied, stats.ntsxconflicts );
+      if( problem.getNCols() == 0 )
+      {
+         Solution<REAL> solution{};
+         Postsolve<REAL> postsolve{ msg, num };
+         postsolve.undo( Solution<REAL>{}, solution, result.postsolve );
+         const Problem<REAL>& origprob = result.postsolve.getOriginalProblem();
+         REAL origobj = origprob.computeSolObjective( solution.primal );
+         if( origprob.is_objective_negated() )
+            origobj *= -1;
+         msg.info( "problem is solved [optimal solution found] [objective "
+                   "value: {} (double precision)]\n",
+                   static_cast<double>( origobj ) );
+      }
+      msg.info( "reduced problem:\n" );
+      msg.info( "  reduced rows:     {}\n", problem.getNRows() );
+      msg.info( "  reduced columns:  {}\n", problem.getNCols() );
+      msg.info( "  reduced int. columns:  {}\n", problem.getNumIntegralCols() );
+      msg.info( "  reduced cont. columns:  {}\n",
+                problem.getNumContinuousCols() );
+      msg.info( "  reduced nonzeros: {}\n",
+                problem.getConstraintMatrix().getNnz() );
+
+      result.status = PresolveStatus::kReduced;
+      return result;
+#ifdef PAPILO_TBB
+   } );
+#endif
+}
+
 template <typename REAL>
 void
 Presolve<REAL>::run_presolvers( const Problem<REAL>& problem,
@@ -1034,23 +1748,57 @@ Presolve<REAL>::run_presolvers( const Problem<REAL>& problem,
 #ifndef PAPILO_TBB
    assert(presolveOptions.runs_sequential() == true);
 #endif
+   // the memory of the last run of the presolvers is reused unless it is
+   // still referenced
+   if( !arenas.empty() )
+   {
+      for( int i = presolver_2_run.first; i != presolver_2_run.second; ++i )
+         arenas[i].reset();
+   }
+
    if( presolveOptions.apply_results_immediately_if_run_sequentially && presolveOptions.runs_sequential() )
    {
       int cause = -1;
       probUpdate.setPostponeSubstitutions( false );
       for( int i = presolver_2_run.first; i != presolver_2_run.second; ++i )
       {
-         results[i] = presolvers[i]->run( problem, probUpdate, num, reductions[i], timer, cause );
+         results[i] = run_presolver( i, problem, probUpdate, timer, cause );
          assert( cause != -1 || results[i] != PresolveStatus::kInfeasible || presolvers[i]->getName() != "probing" );
          apply_result_sequential( i, probUpdate, run_sequential );
          if( is_status_infeasible_or_unbounded( results[i] ) )
             return;
          probUpdate.clearStates();
+         probUpdate.logStep( TransactionStep::kClearStates );
          if( probUpdate.getNActiveCols() == 0 || probUpdate.getNActiveRows() == 0 )
             return;
       }
    }
 #ifdef PAPILO_TBB
+   else if( presolveOptions.task_graph_scheduling )
+   {
+      // every presolver is a task of its own; the tiers are sorted by
+      // increasing cost, hence the expensive presolvers are spawned first
+      tbb::task_group tasks;
+      for( int i = presolver_2_run.second - 1; i >= presolver_2_run.first;
+           --i )
+      {
+         tasks.run(
+             [this, i, &problem, &probUpdate, &timer]()
+             {
+                int cause = -1;
+                results[i] =
+                    run_presolver( i, problem, probUpdate, timer, cause );
+                if( results[i] == PresolveStatus::kInfeasible &&
+                    presolvers[i]->getName() == "probing" )
+                {
+                   assert( cause != -1 );
+                   probUpdate.getCertificateInterface()->setInfeasibleCause(
+                       cause );
+                }
+             } );
+      }
+      tasks.wait();
+   }
    else
    {
       int cause = -1;
@@ -1060,8 +1808,8 @@ Presolve<REAL>::run_presolvers( const Problem<REAL>& problem,
           [&]( const tbb::blocked_range<int>& r ) {
              for( int i = r.begin(); i != r.end(); ++i )
              {
-                results[i] = presolvers[i]->run( problem, probUpdate, num,
-                                                 reductions[i], timer, cause );
+                results[i] =
+                    run_presolver( i, problem, probUpdate, timer, cause );
                 if(results[i] == PresolveStatus::kInfeasible && presolvers[i]->getName() == "probing")
                 {
                    assert(cause != -1);
@@ -1074,6 +1822,65 @@ Presolve<REAL>::run_presolvers( const Problem<REAL>& problem,
 #endif
 }
 
+template <typename REAL>
+PresolveStatus
+Presolve<REAL>::run_presolver( int presolver, const Problem<REAL>& problem,
+                               ProblemUpdate<REAL>& probUpdate,
+                               const Timer& timer, int& cause )
+{
+   // declared first so that the event is not stored in the arena
+   TraceScope trace( tracer.get(), "presolver",
+                     presolvers[presolver]->getName().c_str() );
+   PresolveStatus status;
+   {
+      ResourceScope scope( get_arena( presolver ) );
+      status = presolvers[presolver]->run( problem, probUpdate, num,
+                                           reductions[presolver], timer,
+                                           cause );
+   }
+
+   if( trace.isActive() )
+   {
+      // reductions outside of a transaction form a transaction of their own
+      const Reductions<REAL>& reds = reductions[presolver];
+      int64_t nfound = static_cast<int64_t>( reds.getReductions().size() );
+      for( const auto& transaction : reds.getTransactions() )
+         nfound -= transaction.end - transaction.start - 1;
+      trace.addArg( "status", static_cast<int>( status ) );
+      trace.addArg( "transactions", nfound );
+   }
+   return status;
+}
+
+template <typename REAL>
+double
+Presolve<REAL>::get_execution_time(
+    const std::pair<int, int>& presolver_2_run ) const
+{
+   double exectime = 0;
+   for( int i = presolver_2_run.first; i != presolver_2_run.second; ++i )
+      exectime += presolvers[i]->getExecTime();
+   return exectime;
+}
+
+template <typename REAL>
+void
+Presolve<REAL>::record_round_utilization(
+    const std::pair<int, int>& presolver_2_run, double exectime_before,
+    double walltime )
+{
+#ifdef PAPILO_TBB
+   int nthreads = presolveOptions.runs_sequential()
+                      ? 1
+                      : tbb::this_task_arena::max_concurrency();
+#else
+   int nthreads = 1;
+#endif
+   double busy = get_execution_time( presolver_2_run ) - exectime_before;
+   stats.round_utilization.push_back(
+       walltime > 0 ? std::min( 1.0, busy / ( walltime * nthreads ) ) : 0.0 );
+}
+
 template <typename REAL>
 void
 Presolve<REAL>::apply_result_sequential( int index_presolver,
@@ -1083,7 +1890,9 @@ Presolve<REAL>::apply_result_sequential( int index_presolver,
    run_sequential = true;
    apply_reduction_of_solver( probUpdate, index_presolver );
    probUpdate.flushChangedCoeffs();
+   probUpdate.logStep( TransactionStep::kFlushChangedCoeffs );
    PresolveStatus status = probUpdate.flush( false );
+   probUpdate.logStep( TransactionStep::kFlush );
    if( is_status_infeasible_or_unbounded( status ) )
       results[index_presolver] = status;
 }
@@ -1186,10 +1995,13 @@ Presolve<REAL>::apply_all_presolver_reductions(
       return status;
 
    probUpdate.flushChangedCoeffs();
+   probUpdate.logStep( TransactionStep::kFlushChangedCoeffs );
 
    applyPostponed( probUpdate, presolveTimer );
 
-   return probUpdate.flush( true );
+   PresolveStatus flushstatus = probUpdate.flush( true );
+   probUpdate.logStep( TransactionStep::kFlushResetActivities );
+   return flushstatus;
 }
 
 template <typename REAL>
@@ -1224,13 +2036,17 @@ Presolve<REAL>::applyReductions( int p, const Reductions<REAL>& reductions_,
    int k = 0;
    ApplyResult result;
    int nbtsxAppliedStart = stats.ntsxapplied;
+   int nbtsxConflictsStart = stats.ntsxconflicts;
    int nbtsxTotal = 0;
+   TraceScope trace( tracer.get(), "apply",
+                     presolvers[p]->getName().c_str() );
 
    const auto& reds = reductions_.getReductions();
 
    msg.detailed( "Presolver {} applying \n", presolvers[p]->getName() );
 
    auto argument = presolvers[p]->getArgument();
+   bool replayable = is_replayable( p );
    for( const auto& transaction : reductions_.getTransactions() )
    {
       int start = transaction.start;
@@ -1238,7 +2054,8 @@ Presolve<REAL>::applyReductions( int p, const Reductions<REAL>& reductions_,
 
       for( ; k != start; ++k )
       {
-         result = probUpdate.applyTransaction( &reds[k], &reds.data()[k + 1], argument );
+         result = probUpdate.applyTransaction( &reds[k], &reds.data()[k + 1],
+                                               argument, replayable );
          if( result == ApplyResult::kApplied )
             ++stats.ntsxapplied;
          else if( result == ApplyResult::kRejected )
@@ -1251,7 +2068,8 @@ Presolve<REAL>::applyReductions( int p, const Reductions<REAL>& reductions_,
          ++nbtsxTotal;
       }
 
-      result = probUpdate.applyTransaction( &reds[start], &reds.data()[end], argument );
+      result = probUpdate.applyTransaction( &reds[start], &reds.data()[end],
+                                            argument, replayable );
       if( result == ApplyResult::kApplied )
          ++stats.ntsxapplied;
       else if( result == ApplyResult::kRejected )
@@ -1267,7 +2085,8 @@ Presolve<REAL>::applyReductions( int p, const Reductions<REAL>& reductions_,
 
    for( ; k != static_cast<int>( reds.size() ); ++k )
    {
-      result = probUpdate.applyTransaction( &reds[k], &reds.data()[k + 1], argument );
+      result = probUpdate.applyTransaction( &reds[k], &reds.data()[k + 1],
+                                               argument, replayable );
       if( result == ApplyResult::kApplied )
          ++stats.ntsxapplied;
       else if( result == ApplyResult::kRejected )
@@ -1280,6 +2099,9 @@ Presolve<REAL>::applyReductions( int p, const Reductions<REAL>& reductions_,
       ++nbtsxTotal;
    }
 
+   trace.addArg( "found", nbtsxTotal );
+   trace.addArg( "applied", stats.ntsxapplied - nbtsxAppliedStart );
+   trace.addArg( "conflicts", stats.ntsxconflicts - nbtsxConflictsStart );
    return { nbtsxTotal, ( stats.ntsxapplied - nbtsxAppliedStart ) };
 }
 
@@ -1287,6 +2109,10 @@ template <typename REAL>
 void
 Presolve<REAL>::applyPostponed( ProblemUpdate<REAL>& probUpdate, const Timer& presolveTimer )
 {
+   TraceScope trace( tracer.get(), "apply", "postponed" );
+   trace.addArg( "found", static_cast<int64_t>( postponedReductions.size() ) );
+   const int nbtsxAppliedStart = stats.ntsxapplied;
+   const int nbtsxConflictsStart = stats.ntsxconflicts;
    probUpdate.setPostponeSubstitutions( false );
 
    for( int presolver = 0; presolver != (int) postponedReductionToPresolver.size() - 1; ++presolver )
@@ -1301,7 +2127,9 @@ Presolve<REAL>::applyPostponed( ProblemUpdate<REAL>& probUpdate, const Timer& pr
          const auto& ptrpair = postponedReductions[i];
 
          ApplyResult r = is_interrupted( presolveTimer ) ? ApplyResult::kRejected :
-             probUpdate.applyTransaction( ptrpair.first, ptrpair.second, ArgumentType::kPrimal );
+             probUpdate.applyTransaction( ptrpair.first, ptrpair.second,
+                                          ArgumentType::kPrimal,
+                                          is_replayable( presolver ) );
          if( r == ApplyResult::kApplied )
          {
             ++stats.ntsxapplied;
@@ -1312,15 +2140,92 @@ Presolve<REAL>::applyPostponed( ProblemUpdate<REAL>& probUpdate, const Timer& pr
       }
    }
 
+   trace.addArg( "applied", stats.ntsxapplied - nbtsxAppliedStart );
+   trace.addArg( "conflicts", stats.ntsxconflicts - nbtsxConflictsStart );
    postponedReductions.clear();
    postponedReductionToPresolver.clear();
 }
 
+template <typename REAL>
+PresolveStatus
+Presolve<REAL>::replay_transactions( const TransactionLog<REAL>& log,
+                                     ProblemUpdate<REAL>& probUpdate )
+{
+   // substitutions were recorded when they were applied, hence they are
+   // replayed in place
+   probUpdate.setPostponeSubstitutions( false );
+
+   PresolveStatus status = PresolveStatus::kUnchanged;
+   for( const auto& entry : log.getEntries() )
+   {
+      switch( entry.step )
+      {
+      case TransactionStep::kTransaction:
+      {
+         const Reduction<REAL>* first = log.getReductions( entry );
+         ApplyResult result = probUpdate.replayTransaction(
+             first, first + ( entry.end - entry.start ), entry.argument,
+             entry.fingerprint );
+         if( result == ApplyResult::kApplied )
+         {
+            ++stats.ntsxapplied;
+            ++stats.ntsxreplayed;
+         }
+         else if( result == ApplyResult::kInfeasible )
+            return PresolveStatus::kInfeasible;
+         else
+            ++stats.ntsxnotreplayed;
+         break;
+      }
+      case TransactionStep::kTrivialPresolve:
+         status = probUpdate.trivialPresolve();
+         break;
+      case TransactionStep::kFlushChangedCoeffs:
+         probUpdate.flushChangedCoeffs();
+         break;
+      case TransactionStep::kFlush:
+         status = probUpdate.flush( false );
+         break;
+      case TransactionStep::kFlushResetActivities:
+         status = probUpdate.flush( true );
+         break;
+      case TransactionStep::kClearStates:
+         probUpdate.clearStates();
+         break;
+      }
+
+      if( entry.step != TransactionStep::kTransaction )
+         probUpdate.logStep( entry.step );
+      if( is_status_infeasible_or_unbounded( status ) )
+         return status;
+   }
+
+   probUpdate.check_and_compress();
+
+   msg.info( "replayed {} of {} transactions of the previous presolve run\n",
+             stats.ntsxreplayed, stats.ntsxreplayed + stats.ntsxnotreplayed );
+
+   return status;
+}
+
+template <typename REAL>
+bool
+Presolve<REAL>::is_replayable( int presolver ) const
+{
+   // probing and dual inference propagate beyond the neighbourhood covered
+   // by the fingerprint, and the clique and dominance reductions may be
+   // based on implications found by probing
+   const std::string& name = presolvers[presolver]->getName();
+   return name != "probing" && name != "dualinfer" &&
+          name != "cliquemerging" && name != "domcol";
+}
+
 template <typename REAL>
 void
 Presolve<REAL>::finishRound( ProblemUpdate<REAL>& probUpdate )
 {
    probUpdate.clearStates();
+   probUpdate.logStep( TransactionStep::kClearStates );
    probUpdate.check_and_compress();
 
    for( auto& reduction : reductions )
@@ -1513,6 +2418,34 @@ Presolve<REAL>::printPresolversStats()
       presolvers[i]->printStats( msg, presolverStats[i] );
    }
 
+   if( !stats.round_utilization.empty() )
+   {
+      double utilization = 0;
+      for( double round : stats.round_utilization )
+         utilization += round;
+      msg.info( "\n average thread utilization of {} presolving rounds: "
+                "{:.1f}%\n",
+                stats.round_utilization.size(),
+                100.0 * utilization / stats.round_utilization.size() );
+   }
+
+   if( !stats.round_components.empty() )
+      msg.info( " connected components after {} presolving rounds: {} (first "
+                "round: {})\n",
+                stats.round_components.size(), stats.round_components.back(),
+                stats.round_components.front() );
+
+   if( !stats.round_system_allocs.empty() )
+   {
+      uint64_t nsystemallocs = 0;
+      for( uint64_t round : stats.round_system_allocs )
+         nsystemallocs += round;
+      msg.info( " system allocations of {} presolving rounds: {} (last "
+                "round: {})\n",
+                stats.round_system_allocs.size(), nsystemallocs,
+                stats.round_system_allocs.back() );
+   }
+
    msg.info( "\n" );
 }
 
@@ -1522,7 +2455,9 @@ Presolve<REAL>::logStatus( ProblemUpdate<REAL>& problem_update,
                            const PostsolveStorage<REAL>& postsolveStorage ) const
 {
    Problem<REAL>& problem = problem_update.getProblem();
-   if( problem.getNCols() == 0)
+   // the postsolve information of a part refers to the original problem and
+   // is only complete after the parts are merged
+   if( problem.getNCols() == 0 && part_cols == nullptr )
    {
       // the primal dual can be disabled therefore calculate only primal for obj
       Solution<REAL> solution{};
@@ -1552,6 +2487,10 @@ Presolve<REAL>::logStatus( ProblemUpdate<REAL>& problem_update,
    msg.info( "  reduced cont. columns:  {}\n", problem.getNumContinuousCols() );
    msg.info( "  reduced nonzeros: {}\n",
              problem.getConstraintMatrix().getNnz() );
+   msg.detailed( "  matrix memory: {} KiB row major, {} KiB column major\n",
+                 problem.getConstraintMatrix().getRowMajorMemoryUsage() / 1024,
+                 problem.getConstraintMatrix().getColMajorMemoryUsage() /
+                     1024 );
    if( problem.test_problem_type( ProblemFlag::kBinary ) )
       msg.info( "  found symmetries: {}\n",
                 problem.getSymmetries().symmetries.size() );
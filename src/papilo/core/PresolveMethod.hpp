@@ -271,6 +271,15 @@ class PresolveMethod
       this->delayed = value;
    }
 
+   /// forgets the rounds skipped because of unsuccessful calls in a previous
+   /// presolve run
+   void
+   resetSkipRounds()
+   {
+      this->skip = 0;
+      this->nconsecutiveUnsuccessCall = 0;
+   }
+
    void
    setEnabled( bool value )
    {
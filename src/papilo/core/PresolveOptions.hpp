@@ -60,6 +60,18 @@ struct PresolveOptions
 
    bool substitutebinarieswithints = true;
 
+   bool record_transactions = false;
+
+   bool arenas = false;
+
+   bool task_graph_scheduling = false;
+
+   bool split_components = false;
+
+   bool track_components = false;
+
+   bool deterministic = false;
+
    bool validation_after_every_postsolving_step = false;
 
 
@@ -73,6 +85,8 @@ struct PresolveOptions
 
    int maxshiftperrow = 10;
 
+   int minrowspace = 4;
+
    int max_consecutive_rounds_of_only_bound_changes = 500;
 
    int maxrounds = -1;
@@ -98,6 +112,10 @@ struct PresolveOptions
 
    double compressfac = 0.85;
 
+   double spareratio = 2.0;
+
+   double spareratiodecay = 1.0;
+
    double epsilon = 1e-9;
 
    double feastol = 1e-6;
@@ -119,6 +137,8 @@ struct PresolveOptions
 
    std::function<bool()> early_exit_callback = nullptr;
 
+   String trace_file;
+
    bool verification_with_VeriPB = false;
 
    void
@@ -189,6 +209,19 @@ struct PresolveOptions
                              "compress the problem if fewer than compressfac "
                              "times the number of rows or columns are active",
                              compressfac, 0.0, 1.0 );
+      paramSet.addParameter( "presolve.spareratio",
+                             "space kept behind every row and column of the "
+                             "matrix for fill-in relative to its size",
+                             spareratio, 1.0, 100.0 );
+      paramSet.addParameter( "presolve.minrowspace",
+                             "minimal number of entries kept behind every row "
+                             "and column of the matrix for fill-in",
+                             minrowspace, 0 );
+      paramSet.addParameter( "presolve.spareratiodecay",
+                             "factor by which the spare ratio beyond 1 is "
+                             "reduced with every compression of the problem "
+                             "(1: keep the spare ratio)",
+                             spareratiodecay, 0.0, 1.0 );
       paramSet.addParameter( "presolve.tlim", "time limit for presolve", tlim,
                              0.0 );
       paramSet.addParameter( "presolve.minabscoeff",
@@ -219,6 +252,43 @@ struct PresolveOptions
       paramSet.addParameter( "presolve.threads",
                              "maximal number of threads to use (0: automatic)",
                              threads, 0 );
+      paramSet.addParameter(
+          "presolve.deterministic",
+          "find the same reductions for every number of threads by using the "
+          "parallel code paths also with one thread and merging the results "
+          "of the threads in a fixed order",
+          deterministic );
+      paramSet.addParameter(
+          "presolve.arenas",
+          "run every presolver with a monotonic arena that is reset each "
+          "round (only if built with RESOURCE_ALLOCATOR)",
+          arenas );
+      paramSet.addParameter(
+          "presolve.recordtransactions",
+          "record the applied transactions in the presolve result to warm "
+          "start the presolve of a modified problem",
+          record_transactions );
+      paramSet.addParameter(
+          "presolve.taskgraph",
+          "run the presolvers of the current and all higher tiers as one task "
+          "graph on the same problem instead of separating the tiers by "
+          "rounds (only if more than one thread is used)",
+          task_graph_scheduling );
+      paramSet.addParameter(
+          "presolve.splitcomponents",
+          "presolve the disconnected components of the problem independently "
+          "and in parallel (only primal postsolve)",
+          split_components );
+      paramSet.addParameter(
+          "presolve.trackcomponents",
+          "keep track of the connected components of the problem during "
+          "presolve and record their number after every round",
+          track_components );
+      paramSet.addParameter(
+          "presolve.tracefile",
+          "write a timeline of the presolver runs and problem updates in the "
+          "Chrome trace format to this file (empty: disabled)",
+          trace_file );
       paramSet.addParameter(
           "presolve.apply_results_immediately_if_run_sequentially",
           "# if only one thread (presolve.threads = 1) is used, apply the "
@@ -285,7 +355,7 @@ struct PresolveOptions
    runs_sequential() const
    {
 #ifdef PAPILO_TBB
-      return threads == 1;
+      return threads == 1 && !deterministic;
 #else
       return true;
 #endif
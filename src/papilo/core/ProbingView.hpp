@@ -29,6 +29,7 @@
 #include "papilo/core/SingleRow.hpp"
 #include "papilo/io/Message.hpp"
 #include "papilo/misc/MultiPrecision.hpp"
+#include "papilo/misc/OverlayVec.hpp"
 #include "papilo/misc/Vec.hpp"
 #include <memory>
 
@@ -68,11 +69,37 @@ struct ProbingSubstitution
    }
 };
 
+/// results of probing a range of columns, so that the results of several
+/// probing views can be merged in a fixed order
+template <typename REAL>
+struct ProbingResults
+{
+   Vec<ProbingBoundChg<REAL>> boundChanges;
+   Vec<ProbingSubstitution<REAL>> substitutions;
+   Vec<Implication<REAL>> implications;
+   int64_t amountofwork = 0;
+
+   void
+   clear()
+   {
+      amountofwork = 0;
+      boundChanges.clear();
+      substitutions.clear();
+      implications.clear();
+   }
+};
+
+/// Bounds and activities of a problem while probing on a column. With
+/// sparse = true the view does not copy the bounds, column flags and row
+/// activities of the problem but only the entries changed by probing, so that
+/// its memory and the cost of reset() depend on the amount of propagation
+/// instead of the size of the problem.
 template <typename REAL>
 class ProbingView
 {
  public:
-   ProbingView( const Problem<REAL>& problem, const Num<REAL>& num );
+   ProbingView( const Problem<REAL>& problem, const Num<REAL>& num,
+                bool sparse = false );
 
    void
    setMinIntDomRed( const REAL& value )
@@ -86,6 +113,15 @@ class ProbingView
       this->mincontdomred = value;
    }
 
+   /// start the propagation from the implications of the probed value that
+   /// are stored in the problem, and collect the implications of both values
+   /// if probing neither fixes nor substitutes a column
+   void
+   setUseImplications( bool value )
+   {
+      this->useimplications = value;
+   }
+
    void
    reset();
 
@@ -101,6 +137,9 @@ class ProbingView
          changeLb( col, 1.0 );
       else
          changeUb( col, 0.0 );
+
+      if( useimplications )
+         applyStoredImplications();
    }
 
    void
@@ -158,39 +197,71 @@ class ProbingView
       return substitutions;
    }
 
+   const Vec<Implication<REAL>>&
+   getImplications() const
+   {
+      return implications;
+   }
+
    int64_t
    getAmountOfWork() const
    {
       return amountofwork;
    }
 
-   const Vec<REAL>&
+   const OverlayVec<REAL>&
    getProbingLowerBounds() const
    {
       return probing_lower_bounds;
    }
 
-   const Vec<REAL>&
+   const OverlayVec<REAL>&
    getProbingUpperBounds() const
    {
       return probing_upper_bounds;
    }
 
-   const Vec<ColFlags>&
+   const OverlayVec<ColFlags>&
    getProbingDomainFlags() const
    {
       return probing_domain_flags;
    }
 
+   const OverlayVec<RowActivity<REAL>>&
+   getProbingActivities() const
+   {
+      return probing_activities;
+   }
+
    void
    clearResults()
    {
       amountofwork = 0;
       boundChanges.clear();
       substitutions.clear();
+      implications.clear();
+   }
+
+   /// moves the results into the given empty results and clears them here
+   void
+   moveResults( ProbingResults<REAL>& results )
+   {
+      assert( results.boundChanges.empty() && results.substitutions.empty() &&
+              results.implications.empty() );
+      results.boundChanges.swap( boundChanges );
+      results.substitutions.swap( substitutions );
+      results.implications.swap( implications );
+      results.amountofwork = amountofwork;
+      amountofwork = 0;
    }
 
  private:
+   void
+   applyStoredImplications();
+
+   void
+   recordImplications();
+
    // reference to problem and numerics class
    const Problem<REAL>& problem;
    const Num<REAL>& num;
@@ -201,10 +272,10 @@ class ProbingView
    Vec<int> changed_lbs;
    Vec<int> changed_ubs;
    Vec<int> changed_activities;
-   Vec<REAL> probing_lower_bounds;
-   Vec<REAL> probing_upper_bounds;
-   Vec<ColFlags> probing_domain_flags;
-   Vec<RowActivity<REAL>> probing_activities;
+   OverlayVec<REAL> probing_lower_bounds;
+   OverlayVec<REAL> probing_upper_bounds;
+   OverlayVec<ColFlags> probing_domain_flags;
+   OverlayVec<RowActivity<REAL>> probing_activities;
 
    Vec<int> prop_activities;
    Vec<int> next_prop_activities;
@@ -221,6 +292,8 @@ class ProbingView
    // results of probing and statistics
    Vec<ProbingBoundChg<REAL>> boundChanges;
    Vec<ProbingSubstitution<REAL>> substitutions;
+   bool useimplications;
+   Vec<Implication<REAL>> implications;
 
    int64_t amountofwork;
 };
@@ -233,12 +306,12 @@ extern template class ProbingView<Rational>;
 
 template <typename REAL>
 ProbingView<REAL>::ProbingView( const Problem<REAL>& problem_,
-                                const Num<REAL>& num_ )
+                                const Num<REAL>& num_, bool sparse )
     : problem( problem_ ), num( num_ ),
-      probing_lower_bounds( problem_.getLowerBounds() ),
-      probing_upper_bounds( problem_.getUpperBounds() ),
-      probing_domain_flags( problem_.getColFlags() ),
-      probing_activities( problem_.getRowActivities() )
+      probing_lower_bounds( problem_.getLowerBounds(), sparse ),
+      probing_upper_bounds( problem_.getUpperBounds(), sparse ),
+      probing_domain_flags( problem_.getColFlags(), sparse ),
+      probing_activities( problem_.getRowActivities(), sparse )
 {
    round = -2;
    infeasible = false;
@@ -246,6 +319,7 @@ ProbingView<REAL>::ProbingView( const Problem<REAL>& problem_,
    probingCol = -1;
    probingValue = false;
    otherValueInfeasible = false;
+   useimplications = false;
    minintdomred = num.getFeasTol() * 1000;
    mincontdomred = 0.3;
 }
@@ -264,13 +338,13 @@ ProbingView<REAL>::reset()
          int c = -i - 1;
          assert( !probing_domain_flags[c].test( ColFlag::kLbUseless ) &&
                  problem.getColFlags()[c].test( ColFlag::kLbUseless ) );
-         probing_domain_flags[c].set( ColFlag::kLbUseless );
+         probing_domain_flags.modify( c ).set( ColFlag::kLbUseless );
 #ifndef NDEBUG
-         probing_lower_bounds[c] = orig_lbs[c];
+         probing_lower_bounds.modify( c ) = orig_lbs[c];
 #endif
       }
       else
-         probing_lower_bounds[i] = orig_lbs[i];
+         probing_lower_bounds.modify( i ) = orig_lbs[i];
    }
    changed_lbs.clear();
 
@@ -282,13 +356,13 @@ ProbingView<REAL>::reset()
          int c = -i - 1;
          assert( !probing_domain_flags[c].test( ColFlag::kUbUseless ) &&
                  problem.getColFlags()[c].test( ColFlag::kUbUseless ) );
-         probing_domain_flags[c].set( ColFlag::kUbUseless );
+         probing_domain_flags.modify( c ).set( ColFlag::kUbUseless );
 #ifndef NDEBUG
-         probing_upper_bounds[c] = orig_ubs[c];
+         probing_upper_bounds.modify( c ) = orig_ubs[c];
 #endif
       }
       else
-         probing_upper_bounds[i] = orig_ubs[i];
+         probing_upper_bounds.modify( i ) = orig_ubs[i];
    }
    changed_ubs.clear();
 
@@ -296,18 +370,28 @@ ProbingView<REAL>::reset()
    for( int i : changed_activities )
    {
       amountofwork += rowsize[i];
-      probing_activities[i] = orig_activities[i];
+      probing_activities.modify( i ) = orig_activities[i];
    }
    changed_activities.clear();
 
+   // in sparse mode the entries are dropped, which also removes entries that
+   // were copied without being changed
+   probing_lower_bounds.clear();
+   probing_upper_bounds.clear();
+   probing_domain_flags.clear();
+   probing_activities.clear();
+
    // reset should result in original domains and activities
-   assert( std::equal( orig_lbs.begin(), orig_lbs.end(),
-                       probing_lower_bounds.begin() ) );
-   assert( std::equal( orig_ubs.begin(), orig_ubs.end(),
-                       probing_upper_bounds.begin() ) );
-   assert( std::equal(
+   assert( probing_lower_bounds.isSparse() ||
+           std::equal( orig_lbs.begin(), orig_lbs.end(),
+                       probing_lower_bounds.data() ) );
+   assert( probing_upper_bounds.isSparse() ||
+           std::equal( orig_ubs.begin(), orig_ubs.end(),
+                       probing_upper_bounds.data() ) );
+   assert( probing_activities.isSparse() ||
+           std::equal(
        orig_activities.begin(), orig_activities.end(),
-       probing_activities.begin(),
+       probing_activities.data(),
        []( const RowActivity<REAL>& a, const RowActivity<REAL>& b ) {
           return a.ninfmax == b.ninfmax && a.ninfmin == b.ninfmin &&
                  a.min == b.min && a.max == b.max &&
@@ -420,7 +504,7 @@ ProbingView<REAL>::changeLb( int col, REAL newlb )
    {
       // bound was not altered yet, store the negative (index + 1) to
       // indicate that the infinity flag was altered
-      probing_domain_flags[col].unset( ColFlag::kLbUseless );
+      probing_domain_flags.modify( col ).unset( ColFlag::kLbUseless );
       changed_lbs.push_back( -col - 1 );
    }
    else if( probing_lower_bounds[col] == orig_lbs[col] &&
@@ -430,12 +514,12 @@ ProbingView<REAL>::changeLb( int col, REAL newlb )
 
    // change the bound in the domain vector
    REAL oldlb = probing_lower_bounds[col];
-   probing_lower_bounds[col] = newlb;
+   probing_lower_bounds.modify( col ) = newlb;
 
    // update the probing activities by using the column view
    update_activities_after_boundchange(
        colvec.getValues(), colvec.getIndices(), colvec.getLength(),
-       BoundChange::kLower, oldlb, newlb, lbinf, probing_activities,
+       BoundChange::kLower, oldlb, newlb, lbinf, probing_activities.writer(),
        [this]( ActivityChange actChange, int rowid,
                RowActivity<REAL>& activity ) {
           activityChanged( actChange, rowid, activity );
@@ -462,7 +546,7 @@ ProbingView<REAL>::changeUb( int col, REAL newub )
    {
       // bound was not altered yet, store the negative (index + 1) to
       // indicate that the infinity flag was altered
-      probing_domain_flags[col].unset( ColFlag::kUbUseless );
+      probing_domain_flags.modify( col ).unset( ColFlag::kUbUseless );
       changed_ubs.push_back( -col - 1 );
    }
    else if( probing_upper_bounds[col] == orig_ubs[col] &&
@@ -472,12 +556,12 @@ ProbingView<REAL>::changeUb( int col, REAL newub )
 
    // change the bound in the domain vector
    REAL oldub = probing_upper_bounds[col];
-   probing_upper_bounds[col] = newub;
+   probing_upper_bounds.modify( col ) = newub;
 
    // update the probing activities by using the column view
    update_activities_after_boundchange(
        colvec.getValues(), colvec.getIndices(), colvec.getLength(),
-       BoundChange::kUpper, oldub, newub, ubinf, probing_activities,
+       BoundChange::kUpper, oldub, newub, ubinf, probing_activities.writer(),
        [this]( ActivityChange actChange, int rowid,
                RowActivity<REAL>& activity ) {
           activityChanged( actChange, rowid, activity );
@@ -521,6 +605,104 @@ ProbingView<REAL>::storeImplications()
    }
 }
 
+template <typename REAL>
+void
+ProbingView<REAL>::applyStoredImplications()
+{
+   ImplicationView<REAL> stored =
+       problem.getImplications().getImplications( probingCol, probingValue );
+   const int* cols = stored.getColumns();
+   const uint8_t* upper = stored.getUpper();
+   const REAL* bounds = stored.getBounds();
+
+   for( int k = 0; k != stored.getLength(); ++k )
+   {
+      int col = cols[k];
+      Flags<ColFlag> flags = probing_domain_flags[col];
+      REAL bound = bounds[k];
+
+      if( flags.test( ColFlag::kInactive ) )
+         continue;
+
+      if( upper[k] )
+      {
+         if( !flags.test( ColFlag::kUbUseless ) &&
+             bound >= probing_upper_bounds[col] )
+            continue;
+
+         if( !flags.test( ColFlag::kLbInf ) &&
+             bound < probing_lower_bounds[col] )
+         {
+            if( num.isFeasLT( bound, probing_lower_bounds[col] ) )
+            {
+               infeasible = true;
+               return;
+            }
+
+            bound = probing_lower_bounds[col];
+            if( !flags.test( ColFlag::kUbUseless ) &&
+                bound == probing_upper_bounds[col] )
+               continue;
+         }
+
+         changeUb( col, bound );
+      }
+      else
+      {
+         if( !flags.test( ColFlag::kLbUseless ) &&
+             bound <= probing_lower_bounds[col] )
+            continue;
+
+         if( !flags.test( ColFlag::kUbInf ) &&
+             bound > probing_upper_bounds[col] )
+         {
+            if( num.isFeasGT( bound, probing_upper_bounds[col] ) )
+            {
+               infeasible = true;
+               return;
+            }
+
+            bound = probing_upper_bounds[col];
+            if( !flags.test( ColFlag::kLbUseless ) &&
+                bound == probing_lower_bounds[col] )
+               continue;
+         }
+
+         changeLb( col, bound );
+      }
+   }
+}
+
+template <typename REAL>
+void
+ProbingView<REAL>::recordImplications()
+{
+   // the other value was probed first, its bound changes were stored by
+   // storeImplications()
+   for( const ProbingBoundChg<REAL>& boundChg : otherValueImplications )
+      implications.emplace_back( probingCol, !probingValue,
+                                 static_cast<int>( boundChg.col ),
+                                 boundChg.upper != 0, boundChg.bound );
+
+   for( int c : changed_lbs )
+   {
+      int col = c < 0 ? -c - 1 : c;
+
+      if( col != probingCol )
+         implications.emplace_back( probingCol, probingValue, col, false,
+                                    probing_lower_bounds[col] );
+   }
+
+   for( int c : changed_ubs )
+   {
+      int col = c < 0 ? -c - 1 : c;
+
+      if( col != probingCol )
+         implications.emplace_back( probingCol, probingValue, col, true,
+                                    probing_upper_bounds[col] );
+   }
+}
+
 template <typename REAL>
 bool
 ProbingView<REAL>::analyzeImplications()
@@ -577,6 +759,10 @@ ProbingView<REAL>::analyzeImplications()
       return false;
    }
 
+   // implications of a column that is not fixed by probing
+   if( useimplications && !infeasible )
+      recordImplications();
+
    boundChanges.reserve( boundChanges.size() + otherValueImplications.size() +
                          1 );
 
@@ -695,6 +881,10 @@ ProbingView<REAL>::propagateDomains()
    const auto& rhs = consMatrix.getRightHandSides();
    const auto& rflags = consMatrix.getRowFlags();
 
+   // the stored implications can render the probed value infeasible
+   if( infeasible )
+      return;
+
    using std::swap;
 
    swap( prop_activities, next_prop_activities );
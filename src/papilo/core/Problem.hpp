@@ -27,6 +27,7 @@
 
 #include "papilo/Config.hpp"
 #include "papilo/core/ConstraintMatrix.hpp"
+#include "papilo/core/ImplicationStore.hpp"
 #include "papilo/core/Objective.hpp"
 #include "papilo/core/ProblemFlag.hpp"
 #include "papilo/core/SingleRow.hpp"
@@ -121,7 +122,7 @@ class Problem
    void
    setConstraintMatrix( ConstraintMatrix<REAL>&& cons_matrix )
    {
-      constraintMatrix = cons_matrix;
+      constraintMatrix = std::move( cons_matrix );
    }
 
    /// set domains of variables
@@ -393,14 +394,38 @@ class Problem
       return symmetries;
    }
 
+   /// implications of binary columns that were found during presolve
+   const ImplicationStore<REAL>&
+   getImplications() const
+   {
+      return implications;
+   }
+
+   ImplicationStore<REAL>&
+   getImplications()
+   {
+      return implications;
+   }
+
    bool
    is_clique( const ConstraintMatrix<REAL>& matrix, int row, const Num<REAL>& num ) const
+   {
+      bool equation;
+      return is_clique( matrix, row, num, equation ) && !equation;
+   }
+
+   /// checks whether at most one of the columns of the row can be nonzero,
+   /// equation is set if the other side of the row also forces one of them
+   /// to be nonzero, e.g. for set partitioning rows
+   bool
+   is_clique( const ConstraintMatrix<REAL>& matrix, int row, const Num<REAL>& num,
+              bool& equation ) const
    {
       RowFlags rowFlag = matrix.getRowFlags()[row];
       bool rhsClique = true;
       bool lhsClique = true;
       bool SOS1 = false;
-      bool equation = false;
+      equation = false;
       if( rowFlag.test( RowFlag::kRhsInf ) )
          rhsClique = false;
       if( rowFlag.test( RowFlag::kLhsInf ) )
@@ -452,7 +477,7 @@ class Problem
       }
       if( (rhsClique && num.isGT(matrix.getLeftHandSides()[row],0.0)) || (lhsClique && num.isLT(matrix.getRightHandSides()[row],0.0)) )
          equation = true;
-      return !equation && !SOS1 ;
+      return !SOS1;
    }
 
    /// substitute a variable in the objective using an equality constraint
@@ -635,6 +660,9 @@ class Problem
       }
 #endif
 
+      // the implications are filtered by the compressed domains
+      implications.compress( mappings.second, variableDomains, full );
+
       // compress row activities
       return mappings;
    }
@@ -848,6 +876,8 @@ class Problem
    Vec<Locks> locks;
 
    SymmetryStorage symmetries;
+
+   ImplicationStore<REAL> implications;
 };
 
 template <typename REAL>
@@ -363,6 +363,32 @@ class ProblemBuilder
       }
    }
 
+   /// sets the matrix from arrays in compressed sparse row format for the
+   /// current number of rows and columns, the entries of row r are at the
+   /// positions rowstart[r] to rowstart[r + 1] - 1 of cols and vals. If the
+   /// columns of every row are strictly increasing the storage is copied
+   /// directly, otherwise the entries are sorted and duplicates are summed.
+   /// Zero values are dropped.
+   void
+   setMatrixCSR( const int* rowstart, const int* cols, const REAL* vals )
+   {
+      matrix = compressedStorage( getNumRows(), getNumCols(), rowstart, cols,
+                                  vals );
+      matrix_is_csc = false;
+      has_matrix = true;
+   }
+
+   /// sets the matrix from arrays in compressed sparse column format, see
+   /// setMatrixCSR()
+   void
+   setMatrixCSC( const int* colstart, const int* rows, const REAL* vals )
+   {
+      matrix = compressedStorage( getNumCols(), getNumRows(), colstart, rows,
+                                  vals );
+      matrix_is_csc = true;
+      has_matrix = true;
+   }
+
    Problem<REAL>
    build()
    {
@@ -373,12 +399,51 @@ class ProblemBuilder
 
       problem.setName( std::move( probname ) );
 
-      problem.setConstraintMatrix( ConstraintMatrix<REAL>{
-          matrix_buffer.buildCSR( nRows, nColumns ),
-          matrix_buffer.buildCSC( nRows, nColumns ), std::move( lhs ),
-          std::move( rhs ), std::move( rflags ) } );
+      if( has_matrix && !matrix_buffer.empty() )
+      {
+         // entries were also added one by one, so all of them go through the
+         // matrix buffer
+         for( int i = 0; i != matrix.getNRows(); ++i )
+         {
+            const IndexRange& range = matrix.getRowRanges()[i];
+            for( int j = range.start; j != range.end; ++j )
+            {
+               if( matrix_is_csc )
+                  matrix_buffer.addEntry( matrix.getColumns()[j], i,
+                                          matrix.getValues()[j] );
+               else
+                  matrix_buffer.addEntry( i, matrix.getColumns()[j],
+                                          matrix.getValues()[j] );
+            }
+         }
+         has_matrix = false;
+      }
+
+      if( has_matrix )
+      {
+         assert( matrix.getNRows() == ( matrix_is_csc ? nColumns : nRows ) );
+         assert( matrix.getNCols() == ( matrix_is_csc ? nRows : nColumns ) );
+
+         SparseStorage<REAL> transpose = matrix.getTranspose();
+         if( matrix_is_csc )
+            std::swap( matrix, transpose );
+
+         problem.setConstraintMatrix( ConstraintMatrix<REAL>{
+             std::move( matrix ), std::move( transpose ), std::move( lhs ),
+             std::move( rhs ), std::move( rflags ) } );
+
+         matrix = SparseStorage<REAL>{};
+         has_matrix = false;
+      }
+      else
+      {
+         problem.setConstraintMatrix( ConstraintMatrix<REAL>{
+             matrix_buffer.buildCSR( nRows, nColumns ),
+             matrix_buffer.buildCSC( nRows, nColumns ), std::move( lhs ),
+             std::move( rhs ), std::move( rflags ) } );
 
-      matrix_buffer.clear();
+         matrix_buffer.clear();
+      }
 
       problem.setObjective( std::move( obj ) );
       problem.setVariableDomains( std::move( domains ) );
@@ -413,7 +478,48 @@ class ProblemBuilder
 
 
  private:
+   static SparseStorage<REAL>
+   compressedStorage( int nmajor, int nminor, const int* start,
+                      const int* indices, const REAL* vals )
+   {
+      const int nnz = start[nmajor];
+
+      if( SparseStorage<REAL>::isSortedAndUnique( start, indices, nmajor,
+                                                  nminor ) )
+         return SparseStorage<REAL>{ vals, start, indices, nmajor, nminor, nnz };
+
+      Vec<Triplet<REAL>> entries;
+      entries.reserve( nnz );
+      for( int i = 0; i != nmajor; ++i )
+      {
+         for( int j = start[i]; j != start[i + 1]; ++j )
+         {
+            assert( indices[j] >= 0 && indices[j] < nminor );
+            entries.emplace_back( i, indices[j], vals[j] );
+         }
+      }
+      pdqsort( entries.begin(), entries.end() );
+
+      // sum up duplicate entries, the storage drops zeros
+      std::size_t k = 0;
+      for( std::size_t i = 0; i != entries.size(); ++i )
+      {
+         if( k != 0 &&
+             std::get<0>( entries[k - 1] ) == std::get<0>( entries[i] ) &&
+             std::get<1>( entries[k - 1] ) == std::get<1>( entries[i] ) )
+            std::get<2>( entries[k - 1] ) += std::get<2>( entries[i] );
+         else
+            entries[k++] = std::move( entries[i] );
+      }
+      entries.resize( k );
+
+      return SparseStorage<REAL>{ std::move( entries ), nmajor, nminor, true };
+   }
+
    MatrixBuffer<REAL> matrix_buffer;
+   SparseStorage<REAL> matrix;
+   bool matrix_is_csc = false;
+   bool has_matrix = false;
    Objective<REAL> obj;
    VariableDomains<REAL> domains;
    Vec<REAL> lhs;
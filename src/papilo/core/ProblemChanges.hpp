@@ -0,0 +1,188 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_PROBLEM_CHANGES_HPP_
+#define _PAPILO_CORE_PROBLEM_CHANGES_HPP_
+
+#include "papilo/core/Problem.hpp"
+#include "papilo/misc/Num.hpp"
+#include "papilo/misc/Vec.hpp"
+
+namespace papilo
+{
+
+/// changes of the column bounds, the objective and the row sides of a
+/// problem, the rows, columns and coefficients stay the same. Changes are
+/// applied in the order in which they were added.
+template <typename REAL>
+class ProblemChanges
+{
+ public:
+   void
+   changeColLb( int col, const REAL& val )
+   {
+      changes.push_back( { Type::kColLb, col, false, val } );
+   }
+
+   void
+   changeColLbInf( int col )
+   {
+      changes.push_back( { Type::kColLb, col, true, REAL{ 0 } } );
+   }
+
+   void
+   changeColUb( int col, const REAL& val )
+   {
+      changes.push_back( { Type::kColUb, col, false, val } );
+   }
+
+   void
+   changeColUbInf( int col )
+   {
+      changes.push_back( { Type::kColUb, col, true, REAL{ 0 } } );
+   }
+
+   void
+   changeObj( int col, const REAL& val )
+   {
+      changes.push_back( { Type::kObj, col, false, val } );
+   }
+
+   void
+   changeRowLhs( int row, const REAL& val )
+   {
+      changes.push_back( { Type::kRowLhs, row, false, val } );
+   }
+
+   void
+   changeRowLhsInf( int row )
+   {
+      changes.push_back( { Type::kRowLhs, row, true, REAL{ 0 } } );
+   }
+
+   void
+   changeRowRhs( int row, const REAL& val )
+   {
+      changes.push_back( { Type::kRowRhs, row, false, val } );
+   }
+
+   void
+   changeRowRhsInf( int row )
+   {
+      changes.push_back( { Type::kRowRhs, row, true, REAL{ 0 } } );
+   }
+
+   std::size_t
+   size() const
+   {
+      return changes.size();
+   }
+
+   void
+   clear()
+   {
+      changes.clear();
+   }
+
+   /// returns false without changing the problem if an index is out of range
+   bool
+   apply( Problem<REAL>& problem, const Num<REAL>& num ) const
+   {
+      for( const Change& change : changes )
+      {
+         const int size = change.type == Type::kRowLhs ||
+                                  change.type == Type::kRowRhs
+                              ? problem.getNRows()
+                              : problem.getNCols();
+         if( change.index < 0 || change.index >= size )
+            return false;
+      }
+
+      ConstraintMatrix<REAL>& consMatrix = problem.getConstraintMatrix();
+      Vec<ColFlags>& cflags = problem.getColFlags();
+
+      for( const Change& change : changes )
+      {
+         switch( change.type )
+         {
+         case Type::kColLb:
+            cflags[change.index].unset( ColFlag::kLbInf, ColFlag::kLbHuge );
+            if( change.infinite )
+               cflags[change.index].set( ColFlag::kLbInf );
+            else
+               problem.getLowerBounds()[change.index] = change.value;
+            break;
+         case Type::kColUb:
+            cflags[change.index].unset( ColFlag::kUbInf, ColFlag::kUbHuge );
+            if( change.infinite )
+               cflags[change.index].set( ColFlag::kUbInf );
+            else
+               problem.getUpperBounds()[change.index] = change.value;
+            break;
+         case Type::kObj:
+            problem.getObjective().coefficients[change.index] = change.value;
+            break;
+         case Type::kRowLhs:
+            if( change.infinite )
+               consMatrix.template modifyLeftHandSide<true>( change.index,
+                                                             num );
+            else
+               consMatrix.modifyLeftHandSide( change.index, num,
+                                              change.value );
+            break;
+         case Type::kRowRhs:
+            if( change.infinite )
+               consMatrix.template modifyRightHandSide<true>( change.index,
+                                                              num );
+            else
+               consMatrix.modifyRightHandSide( change.index, num,
+                                               change.value );
+            break;
+         }
+      }
+
+      return true;
+   }
+
+ private:
+   enum class Type : uint8_t
+   {
+      kColLb,
+      kColUb,
+      kObj,
+      kRowLhs,
+      kRowRhs,
+   };
+
+   struct Change
+   {
+      Type type;
+      int index;
+      bool infinite;
+      REAL value;
+   };
+
+   Vec<Change> changes;
+};
+
+} // namespace papilo
+
+#endif
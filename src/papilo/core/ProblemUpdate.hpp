@@ -27,6 +27,8 @@
 
 #include "boost/random.hpp"
 #include "papilo/Config.hpp"
+#include "papilo/core/ChangeLog.hpp"
+#include "papilo/core/Components.hpp"
 #include "papilo/core/MatrixBuffer.hpp"
 #include "papilo/core/PresolveMethod.hpp"
 #include "papilo/core/PresolveOptions.hpp"
@@ -35,10 +37,12 @@
 #include "papilo/core/SingleRow.hpp"
 #include "papilo/core/Statistics.hpp"
 #include "papilo/core/SymmetryStorage.hpp"
+#include "papilo/core/TransactionLog.hpp"
 #include "papilo/core/postsolve/PostsolveStorage.hpp"
 #include "papilo/misc/Flags.hpp"
 #include "papilo/misc/MultiPrecision.hpp"
 #include "papilo/misc/Num.hpp"
+#include "papilo/misc/Trace.hpp"
 #include "papilo/verification/EmptyCertificate.hpp"
 #include "papilo/verification/VeriPb.hpp"
 #include <cstdint>
@@ -110,7 +114,16 @@ class ProblemUpdate
 
    Vec<Flags<State>> row_state;
    Vec<Flags<State>> col_state;
+   /* rows and columns modified since the start or the last compress */
+   ChangeLog change_log;
    std::unique_ptr<CertificateInterface<REAL>> certificate_interface;
+   /* log of the applied transactions for warm starts, if recorded */
+   TransactionLog<REAL>* transaction_log = nullptr;
+   TransactionFingerprint<REAL> fingerprint;
+   /* records the flushes, compressions and trivial presolves, if tracing */
+   Tracer* tracer = nullptr;
+   /* components of the active problem, only with presolve.trackcomponents */
+   ComponentTracker components;
 
  public:
 
@@ -129,6 +142,7 @@ class ProblemUpdate
 
       if( col_state[col].equal( State::kUnmodified ) )
          dirty_col_states.push_back( col );
+      change_log.addCol( col );
 
       col_state[col].set( flags... );
    }
@@ -155,6 +169,7 @@ class ProblemUpdate
 
       if( row_state[row].equal( State::kUnmodified ) )
          dirty_row_states.push_back( row );
+      change_log.addRow( row );
 
       row_state[row].set( flags... );
    }
@@ -230,6 +245,7 @@ class ProblemUpdate
       if( !rflags.test( RowFlag::kRedundant ) )
       {
          redundant_rows.push_back( row );
+         change_log.addRow( row );
          ++stats.ndeletedrows;
          rflags.set( RowFlag::kRedundant );
       }
@@ -250,6 +266,7 @@ class ProblemUpdate
       assert( !cflags.test( ColFlag::kInactive ) );
       cflags.set( ColFlag::kFixed );
       deleted_cols.push_back( col );
+      change_log.addCol( col );
       ++stats.ndeletedcols;
 
       if( cflags.test( ColFlag::kIntegral ) )
@@ -358,6 +375,45 @@ class ProblemUpdate
       return last_changed_activities;
    }
 
+   /// log of the rows and columns whose coefficients, sides, bounds or flags
+   /// changed, used by the presolvers to update their data incrementally
+   const ChangeLog&
+   getChangeLog() const
+   {
+      return change_log;
+   }
+
+   /// records the transactions applied from now on and the steps logged by
+   /// logStep() in the given log, nullptr stops the recording
+   void
+   setTransactionLog( TransactionLog<REAL>* log )
+   {
+      transaction_log = log;
+   }
+
+   /// records flush(), compress() and trivialPresolve() in the given tracer,
+   /// nullptr stops the tracing
+   void
+   setTracer( Tracer* tracer_ )
+   {
+      tracer = tracer_;
+   }
+
+   void
+   logStep( TransactionStep step )
+   {
+      if( transaction_log != nullptr )
+         transaction_log->addStep( step );
+   }
+
+   /// implications of the problem, presolvers may add implications
+   /// concurrently during a round, they are merged by flush()
+   ImplicationStore<REAL>&
+   getImplications() const
+   {
+      return problem.getImplications();
+   }
+
    const Vec<int>&
    getSingletonCols() const
    {
@@ -431,6 +487,22 @@ class ProblemUpdate
       return presolveOptions;
    }
 
+   /// rebuilds the tracked components of the active problem if they are
+   /// missing or too many rows and columns were removed since the last
+   /// rebuild, only if presolve.trackcomponents is set
+   void
+   updateComponents()
+   {
+      if( presolveOptions.track_components && components.needsRebuild() )
+         components.rebuild( problem );
+   }
+
+   const ComponentTracker&
+   getComponents() const
+   {
+      return components;
+   }
+
 
    std::pair<int, int>
    removeRedundantBounds()
@@ -445,10 +517,23 @@ class ProblemUpdate
    checkTransactionConflicts( const Reduction<REAL>* first,
                               const Reduction<REAL>* last );
 
-   /// returns true if the given transaction was applied and false otherwise
+   /// returns true if the given transaction was applied and false otherwise.
+   /// Applied transactions are recorded in the transaction log unless they
+   /// are not replayable, i.e. their presolver may have used data beyond the
+   /// rows and columns covered by the fingerprint.
    ApplyResult
    applyTransaction( const Reduction<REAL>* first,
-                     const Reduction<REAL>* last, ArgumentType argument );
+                     const Reduction<REAL>* last, ArgumentType argument,
+                     bool replayable = true );
+
+   /// applies a transaction of a previous presolve run if its fingerprint
+   /// still matches, and rejects it otherwise. The indices of the transaction
+   /// belong to the original problem, hence the problem must not have been
+   /// compressed.
+   ApplyResult
+   replayTransaction( const Reduction<REAL>* first,
+                      const Reduction<REAL>* last, ArgumentType argument,
+                      uint64_t expected_fingerprint );
 
    void
    roundIntegralColumns( Vec<REAL>& lbs, Vec<REAL>& ubs, int col,
@@ -474,6 +559,11 @@ class ProblemUpdate
 
    void
    shuffle( std::ranlux24& random_generator, Vec<int>& array );
+
+ private:
+   ApplyResult
+   apply_transaction( const Reduction<REAL>* first,
+                      const Reduction<REAL>* last, ArgumentType argument );
 };
 
 #ifdef PAPILO_USE_EXTERN_TEMPLATES
@@ -499,6 +589,7 @@ ProblemUpdate<REAL>::ProblemUpdate(
            new EmptyCertificate<REAL>() );
    lastcompress_ndelcols = 0;
    lastcompress_ndelrows = 0;
+   change_log.reset( _problem.getNRows(), _problem.getNCols() );
 
 
 
@@ -531,6 +622,7 @@ ProblemUpdate<REAL>::ProblemUpdate(
 
    lastcompress_ndelcols = 0;
    lastcompress_ndelrows = 0;
+   change_log.reset( _problem.getNRows(), _problem.getNCols() );
 
    std::ranlux24 randgen( _presolveOptions.randomseed );
    random_col_perm.resize( _problem.getNCols() );
@@ -922,13 +1014,28 @@ ProblemUpdate<REAL>::compress( bool full )
        problem.getNRows() == getNActiveRows() && !full )
       return;
 
+   TraceScope trace( tracer, "update", "compress" );
+   trace.addArg( "rows", getNActiveRows() );
+   trace.addArg( "cols", getNActiveCols() );
+
    Message::debug( this,
                    "compressing problem ({} rows, {} cols) to active problem "
                    "({} rows, {} cols)\n",
                    problem.getNRows(), problem.getNCols(), getNActiveRows(),
                    getNActiveCols() );
 
+   // the matrix receives less fill-in the longer presolve runs, hence less
+   // spare space is kept with every compression
+   ConstraintMatrix<REAL>& consMatrix = problem.getConstraintMatrix();
+   if( !full && presolveOptions.spareratiodecay != 1.0 )
+      consMatrix.setSpareSpace(
+          1.0 + ( consMatrix.getSpareRatio() - 1.0 ) *
+                    presolveOptions.spareratiodecay,
+          consMatrix.getMinInterRowSpace() );
+
    std::pair<Vec<int>, Vec<int>> mappings = problem.compress( full );
+   trace.addArg( "matrixbytes",
+                 static_cast<int64_t>( consMatrix.getMemoryUsage() ) );
    assert( redundant_rows.empty() );
    assert( deleted_cols.empty() );
    assert( dirty_col_states.empty() );
@@ -953,6 +1060,9 @@ ProblemUpdate<REAL>::compress( bool full )
        [this, &mappings, full]() {
           postsolve.compress( mappings.first, mappings.second, full );
        },
+       [this, &mappings]() {
+          components.compress( mappings.first, mappings.second );
+       },
        [this, &mappings, full]() {
           // update last row index sets
           compress_index_vector( mappings.first, last_changed_activities );
@@ -998,6 +1108,7 @@ ProblemUpdate<REAL>::compress( bool full )
    compress_index_vector( mappings.first, random_row_perm );
    compress_index_vector( mappings.second, random_col_perm );
    postsolve.compress( mappings.first, mappings.second, full );
+   components.compress( mappings.first, mappings.second );
    certificate_interface->compress( mappings.first, mappings.second, full );
    compress_index_vector( mappings.first, last_changed_activities );
    compress_index_vector( mappings.first, current_changed_activities );
@@ -1025,6 +1136,10 @@ ProblemUpdate<REAL>::compress( bool full )
       observer->compress( mappings.first, mappings.second );
 #endif
 
+   // the rows and columns are renumbered, hence all data that the presolvers
+   // derived from the change log needs to be recomputed
+   change_log.reset( problem.getNRows(), problem.getNCols() );
+
    lastcompress_ndelrows = stats.ndeletedrows;
    lastcompress_ndelcols = stats.ndeletedcols;
 }
@@ -1101,6 +1216,8 @@ ProblemUpdate<REAL>::flushChangedCoeffs()
              [this, row]( ActivityChange actChange,
                           RowActivity<REAL>& activity )
              { update_activity( actChange, row, activity ); } );
+         change_log.addRow( row );
+         change_log.addCol( col );
          ++stats.ncoefchgs;
          // TODO: update up/down-locks -> so that i.e. DualFix can use it
       };
@@ -1117,6 +1234,7 @@ template <typename REAL>
 PresolveStatus
 ProblemUpdate<REAL>::flush( bool reset_changed_activities )
 {
+   TraceScope trace( tracer, "update", "flush" );
    Vec<RowFlags>& rflags = problem.getRowFlags();
    Vec<RowActivity<REAL>>& activities = problem.getRowActivities();
    ConstraintMatrix<REAL>& consMatrix = problem.getConstraintMatrix();
@@ -1161,12 +1279,32 @@ ProblemUpdate<REAL>::flush( bool reset_changed_activities )
    // remove constants of fixed columns
    removeFixedCols();
 
+   // deleting the fixed columns and redundant rows changes the rows and
+   // columns they intersect
+   for( int row : redundant_rows )
+   {
+      auto rowvec = consMatrix.getRowCoefficients( row );
+      for( int i = 0; i != rowvec.getLength(); ++i )
+         change_log.addCol( rowvec.getIndices()[i] );
+   }
+   for( int col : deleted_cols )
+   {
+      auto colvec = consMatrix.getColumnCoefficients( col );
+      for( int i = 0; i != colvec.getLength(); ++i )
+         change_log.addRow( colvec.getIndices()[i] );
+   }
+
+   components.removeRowsAndCols( problem, redundant_rows, deleted_cols );
+
    // delete fixed columns and redundant rows form the matrix
    // TODO update locks in delete rows and cols function
    consMatrix.deleteRowsAndCols( redundant_rows, deleted_cols, activities,
                                  singletonRows, singletonColumns,
                                  emptyColumns );
 
+   // merge the implications found in this round
+   problem.getImplications().flush( problem.getVariableDomains() );
+
    // remove singleton columns from list of singleton columns if they are not
    // singletons anymore
    if( !singletonColumns.empty() )
@@ -1515,6 +1653,7 @@ ProblemUpdate<REAL>::roundIntegralColumns( Vec<REAL>& lbs, Vec<REAL>& ubs,
          {
             ++stats.nboundchgs;
             lbs[col] = ceillb;
+            change_log.addCol( col );
             status = PresolveStatus::kReduced;
          }
       }
@@ -1526,6 +1665,7 @@ ProblemUpdate<REAL>::roundIntegralColumns( Vec<REAL>& lbs, Vec<REAL>& ubs,
          {
             ++stats.nboundchgs;
             ubs[col] = floorub;
+            change_log.addCol( col );
             status = PresolveStatus::kReduced;
          }
       }
@@ -1599,6 +1739,7 @@ ProblemUpdate<REAL>::trivialRowPresolve()
                 consMatrix.getRowFlags()[row].test( RowFlag::kLhsInf ) );
             certificate_interface->change_lhs_inf(row);
             consMatrix.template modifyLeftHandSide<true>( row, num );
+            change_log.addRow( row );
             status = PresolveStatus::kReduced;
             cleanupSmallCoefficients( row );
             break;
@@ -1608,6 +1749,7 @@ ProblemUpdate<REAL>::trivialRowPresolve()
                 consMatrix.getRowFlags()[row].test( RowFlag::kRhsInf ) );
             certificate_interface->change_rhs_inf(row);
             consMatrix.template modifyRightHandSide<true>( row, num );
+            change_log.addRow( row );
             status = PresolveStatus::kReduced;
             cleanupSmallCoefficients( row );
             break;
@@ -1622,7 +1764,10 @@ ProblemUpdate<REAL>::trivialRowPresolve()
                assert( !rflags[row].test( RowFlag::kLhsInf ) );
                assert( !rflags[row].test( RowFlag::kEquation ) );
                if( lhs[row] == rhs[row] )
+               {
                   rflags[row].set( RowFlag::kEquation );
+                  change_log.addRow( row );
+               }
             }
             cleanupSmallCoefficients( row );
          }
@@ -1649,6 +1794,7 @@ template <typename REAL>
 PresolveStatus
 ProblemUpdate<REAL>::trivialPresolve()
 {
+   TraceScope trace( tracer, "update", "trivial presolve" );
    if( presolveOptions.dualreds != 0 )
       problem.recomputeLocks();
 
@@ -1665,6 +1811,7 @@ ProblemUpdate<REAL>::trivialPresolve()
 
    removeFixedCols();
 
+   components.removeRowsAndCols( problem, redundant_rows, deleted_cols );
    problem.getConstraintMatrix().deleteRowsAndCols(
        redundant_rows, deleted_cols, problem.getRowActivities(), singletonRows,
        singletonColumns, emptyColumns );
@@ -1867,6 +2014,7 @@ ProblemUpdate<REAL>::cleanupSmallCoefficients( int row )
             if( lbs[col] != 0 )
             {
                REAL sidechange = values[i] * lbs[col];
+               change_log.addRow( row );
                if( !rowf.test( RowFlag::kRhsInf ) )
                {
                   rhs -= sidechange;
@@ -2097,11 +2245,56 @@ ProblemUpdate<REAL>::checkTransactionConflicts( const Reduction<REAL>* first,
    return ConflictType::kNoConflict;
 }
 
-/// returns true if the given transaction was applied and false otherwise
 template <typename REAL>
 ApplyResult
 ProblemUpdate<REAL>::applyTransaction( const Reduction<REAL>* first,
-                                       const Reduction<REAL>* last, ArgumentType argument )
+                                       const Reduction<REAL>* last,
+                                       ArgumentType argument, bool replayable )
+{
+   if( transaction_log == nullptr || !replayable )
+      return apply_transaction( first, last, argument );
+
+   // the data must be hashed before the transaction changes it
+   uint64_t hash = fingerprint.compute( problem, first, last,
+                                        postsolve.origrow_mapping,
+                                        postsolve.origcol_mapping );
+   ApplyResult result = apply_transaction( first, last, argument );
+   if( result == ApplyResult::kApplied && hash != 0 )
+      transaction_log->addTransaction( first, last, argument, hash,
+                                       postsolve.origrow_mapping,
+                                       postsolve.origcol_mapping );
+   return result;
+}
+
+template <typename REAL>
+ApplyResult
+ProblemUpdate<REAL>::replayTransaction( const Reduction<REAL>* first,
+                                        const Reduction<REAL>* last,
+                                        ArgumentType argument,
+                                        uint64_t expected_fingerprint )
+{
+   assert( problem.getNRows() == (int)postsolve.nRowsOriginal );
+   assert( problem.getNCols() == (int)postsolve.nColsOriginal );
+
+   uint64_t hash = fingerprint.compute( problem, first, last,
+                                        postsolve.origrow_mapping,
+                                        postsolve.origcol_mapping );
+   if( hash != expected_fingerprint )
+      return ApplyResult::kRejected;
+
+   ApplyResult result = apply_transaction( first, last, argument );
+   if( result == ApplyResult::kApplied && transaction_log != nullptr )
+      transaction_log->addTransaction( first, last, argument, hash,
+                                       postsolve.origrow_mapping,
+                                       postsolve.origcol_mapping );
+   return result;
+}
+
+template <typename REAL>
+ApplyResult
+ProblemUpdate<REAL>::apply_transaction( const Reduction<REAL>* first,
+                                        const Reduction<REAL>* last,
+                                        ArgumentType argument )
 {
 
    Objective<REAL>& objective = problem.getObjective();
@@ -2140,10 +2333,6 @@ ProblemUpdate<REAL>::applyTransaction( const Reduction<REAL>* first,
          setRowState( reduction.row, State::kModified );
          setColState( reduction.col, State::kModified );
 
-         postsolve.storeCoefficientChange( reduction.row, reduction.col,
-                                           reduction.newval );
-         ++stats.single_matrix_coefficient_changes;
-
          bool contains  = false;
          auto data = constraintMatrix.getRowCoefficients(reduction.row);
          for( int i = 0; i < data.getLength(); i++)
@@ -2160,11 +2349,15 @@ ProblemUpdate<REAL>::applyTransaction( const Reduction<REAL>* first,
                 num, reduction.row, reduction.col, reduction.newval,
                 problem.getVariableDomains(), intbuffer, realbuffer,
                 last_changed_activities, problem.getRowActivities(),
-                stats.nrounds );
+                stats.nrounds, presolveOptions.maxshiftperrow );
             if( !successful )
                return ApplyResult::kRejected ;
          }
 
+         postsolve.storeCoefficientChange( reduction.row, reduction.col,
+                                           reduction.newval );
+         ++stats.single_matrix_coefficient_changes;
+
          auto& next_reduction = *(iter+1);
          bool next_matrix_change = (iter+1 < last) && next_reduction.row >= 0 && next_reduction.col >= 0;
          certificate_interface->change_matrix_entry(
@@ -3210,6 +3403,9 @@ ProblemUpdate<REAL>::merge_parallel_columns(
    setColState( col1, State::kModified );
    deleted_cols.push_back( col1 );
 
+   // column 2 now represents the sum of both columns
+   problem.getImplications().invalidate( col2 );
+
    // the domains of column 2 are now set column 2 bounds are set to
    // new bound values
    lbs[col2] = newlb;
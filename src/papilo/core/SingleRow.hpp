@@ -26,10 +26,14 @@
 #define _PAPILO_CORE_SINGLE_ROW_HPP_
 
 #include "papilo/core/RowFlags.hpp"
+#include "papilo/core/SingleRowSimd.hpp"
 #include "papilo/core/VariableDomains.hpp"
 #include "papilo/misc/Flags.hpp"
 #include "papilo/misc/Num.hpp"
+#include "papilo/misc/OverlayVec.hpp"
 #include "papilo/misc/Vec.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <tuple>
 
 namespace papilo
@@ -170,12 +174,12 @@ count_locks( const REAL& val, RowFlags rflags, int& ndownlocks, int& nuplocks )
    }
 }
 
-template <typename REAL>
+template <typename REAL, typename BOUNDS = Vec<REAL>,
+          typename FLAGS = Vec<ColFlags>>
 RowActivity<REAL>
 compute_row_activity( const REAL* rowvals, const int* colindices, int rowlen,
-                      const Vec<REAL>& lower_bounds,
-                      const Vec<REAL>& upper_bounds, const Vec<ColFlags>& flags,
-                      int presolveround = -1 )
+                      const BOUNDS& lower_bounds, const BOUNDS& upper_bounds,
+                      const FLAGS& flags, int presolveround = -1 )
 {
    RowActivity<REAL> activity;
 
@@ -403,13 +407,13 @@ update_activities_remove_finite_bound( const int* colinds, const REAL* colvals,
 /// changed. The last argument must be callable with arguments (ActivityChange,
 /// rowid, RowActivity) and is called to inform about row activities that
 /// changed
-template <typename REAL, typename ACTIVITYCHANGE>
+template <typename REAL, typename ACTIVITYCHANGE, typename ACTIVITIES>
 void
 update_activities_after_boundchange( const REAL* colvals, const int* colrows,
                                      int collen, BoundChange type,
                                      REAL oldbound, REAL newbound,
                                      bool oldbound_inf,
-                                     Vec<RowActivity<REAL>>& activities,
+                                     ACTIVITIES&& activities,
                                      ACTIVITYCHANGE&& activityChange,
                                      bool watchInfiniteActivities = false )
 {
@@ -617,21 +621,92 @@ update_activity_after_coeffchange( REAL collb, REAL colub, ColFlags cflags,
    }
 }
 
+/// bitmask of the entries of a block of at most 64 nonzeros whose bound may be
+/// tightened by propagate_row for a row side whose activity has no infinite
+/// contributions. Without a vectorized kernel all entries are returned.
+template <typename REAL, typename BOUNDS, typename FLAGS>
+std::uint64_t
+propagation_candidates( bool lhs_side, const REAL* rowvals,
+                        const int* colindices, int len,
+                        const BOUNDS& lower_bounds, const BOUNDS& upper_bounds,
+                        const FLAGS& domainFlags, const REAL& activity,
+                        const REAL& side )
+{
+   assert( len > 0 && len <= 64 );
+   return ~std::uint64_t{ 0 } >> ( 64 - len );
+}
+
+#ifdef PAPILO_SIMD_X86
+
+template <>
+inline std::uint64_t
+propagation_candidates<double, Vec<double>, Vec<ColFlags>>(
+                                bool lhs_side, const double* rowvals,
+                                const int* colindices, int len,
+                                const Vec<double>& lower_bounds,
+                                const Vec<double>& upper_bounds,
+                                const Vec<ColFlags>& domainFlags,
+                                const double& activity, const double& side )
+{
+   return simd::propagation_candidates(
+       get_simd_level(), lhs_side, rowvals, colindices, len,
+       lower_bounds.data(), upper_bounds.data(), domainFlags.data(), activity,
+       side );
+}
+
+/// the vectorized kernel needs the bounds in contiguous arrays, so only dense
+/// overlays are filtered
+template <>
+inline std::uint64_t
+propagation_candidates<double, OverlayVec<double>, OverlayVec<ColFlags>>(
+                                bool lhs_side, const double* rowvals,
+                                const int* colindices, int len,
+                                const OverlayVec<double>& lower_bounds,
+                                const OverlayVec<double>& upper_bounds,
+                                const OverlayVec<ColFlags>& domainFlags,
+                                const double& activity, const double& side )
+{
+   if( lower_bounds.isSparse() )
+      return ~std::uint64_t{ 0 } >> ( 64 - len );
+
+   return simd::propagation_candidates(
+       get_simd_level(), lhs_side, rowvals, colindices, len,
+       lower_bounds.data(), upper_bounds.data(), domainFlags.data(), activity,
+       side );
+}
+
+#endif
+
 /// propagate domains of variables using the given a row and its activity. The
 /// last argument must be callable with arguments (BoundChange, colid, newbound, row)
 /// and is called to inform about column bounds that changed.
-template <typename REAL, typename BOUNDCHANGE>
+template <typename REAL, typename BOUNDCHANGE, typename BOUNDS = Vec<REAL>,
+          typename FLAGS = Vec<ColFlags>>
 void
 propagate_row( const Num<REAL>& num, int row, const REAL* rowvals, const int* colindices, int rowlen,
                const RowActivity<REAL>& activity, REAL lhs, REAL rhs,
-               RowFlags rflags, const Vec<REAL>& lower_bounds,
-               const Vec<REAL>& upper_bounds, const Vec<ColFlags>& domainFlags,
+               RowFlags rflags, const BOUNDS& lower_bounds,
+               const BOUNDS& upper_bounds, const FLAGS& domainFlags,
                BOUNDCHANGE&& boundchange )
 {
    if( !rflags.test( RowFlag::kRhsInf ) && activity.ninfmin <= 1 && ( activity.ninfmax >= 1 || num.isGT(activity.max, rhs) ) )
    {
+      std::uint64_t candidates = 0;
       for( int j = 0; j < rowlen; ++j )
       {
+         // skip the entries whose bound cannot change, these are determined
+         // for blocks of 64 entries at once
+         if( ( j & 63 ) == 0 )
+            candidates = activity.ninfmin == 0
+                             ? propagation_candidates(
+                                   false, rowvals + j, colindices + j,
+                                   std::min( 64, rowlen - j ), lower_bounds,
+                                   upper_bounds, domainFlags, activity.min,
+                                   rhs )
+                             : ~std::uint64_t{ 0 };
+         if( !( ( candidates >> ( j & 63 ) ) & 1 ) )
+            continue;
+
          int col = colindices[j];
          REAL lb = lower_bounds[col];
          REAL ub = upper_bounds[col];
@@ -691,8 +766,20 @@ propagate_row( const Num<REAL>& num, int row, const REAL* rowvals, const int* co
 
    if( !rflags.test( RowFlag::kLhsInf ) && activity.ninfmax <= 1 && ( activity.ninfmin >= 1 || num.isLT(activity.min, lhs) ) )
    {
+      std::uint64_t candidates = 0;
       for( int j = 0; j < rowlen; ++j )
       {
+         if( ( j & 63 ) == 0 )
+            candidates = activity.ninfmax == 0
+                             ? propagation_candidates(
+                                   true, rowvals + j, colindices + j,
+                                   std::min( 64, rowlen - j ), lower_bounds,
+                                   upper_bounds, domainFlags, activity.max,
+                                   lhs )
+                             : ~std::uint64_t{ 0 };
+         if( !( ( candidates >> ( j & 63 ) ) & 1 ) )
+            continue;
+
          int col = colindices[j];
          REAL lb = lower_bounds[col];
          REAL ub = upper_bounds[col];
@@ -0,0 +1,500 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_SINGLE_ROW_SIMD_HPP_
+#define _PAPILO_CORE_SINGLE_ROW_SIMD_HPP_
+
+#include "papilo/Config.hpp"
+#include "papilo/core/VariableDomains.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+
+// the kernels are compiled for AVX2 and AVX-512 via target attributes and
+// selected at runtime, hence no special compiler flags are required
+#if !defined( PAPILO_NO_SIMD ) && defined( __x86_64__ ) &&                   \
+    ( defined( __GNUC__ ) || defined( __clang__ ) )
+#define PAPILO_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace papilo
+{
+
+/// instruction sets of the kernels for activity computation and propagation
+/// in double precision
+enum class SimdLevel
+{
+   kScalar,
+   kAvx2,
+   kAvx512,
+};
+
+/// best instruction set supported by the CPU, detected once
+inline SimdLevel
+get_supported_simd_level()
+{
+#ifdef PAPILO_SIMD_X86
+   static const SimdLevel level = []() {
+      __builtin_cpu_init();
+      if( __builtin_cpu_supports( "avx512f" ) )
+         return SimdLevel::kAvx512;
+      if( __builtin_cpu_supports( "avx2" ) )
+         return SimdLevel::kAvx2;
+      return SimdLevel::kScalar;
+   }();
+   return level;
+#else
+   return SimdLevel::kScalar;
+#endif
+}
+
+namespace simd
+{
+
+inline std::atomic<int>&
+active_level()
+{
+   static std::atomic<int> level{ (int)get_supported_simd_level() };
+   return level;
+}
+
+} // namespace simd
+
+/// instruction set used by the kernels, the best supported one by default
+inline SimdLevel
+get_simd_level()
+{
+   return (SimdLevel)simd::active_level().load( std::memory_order_relaxed );
+}
+
+/// restricts the kernels to the given instruction set, levels that the CPU
+/// does not support fall back to the best supported one
+inline void
+set_simd_level( SimdLevel level )
+{
+   simd::active_level().store(
+       (int)std::min( level, get_supported_simd_level() ),
+       std::memory_order_relaxed );
+}
+
+inline const char*
+get_simd_level_name( SimdLevel level )
+{
+   switch( level )
+   {
+   case SimdLevel::kAvx2:
+      return "avx2";
+   case SimdLevel::kAvx512:
+      return "avx512";
+   case SimdLevel::kScalar:
+      break;
+   }
+   return "scalar";
+}
+
+namespace simd
+{
+
+/// sums of the finite bound contributions of a row and counts of the
+/// infinite ones; the fields mirror RowActivity
+struct ActivitySums
+{
+   double min;
+   double max;
+   int ninfmin;
+   int ninfmax;
+};
+
+/// flags of the given columns packed into the bytes of an integer, byte k
+/// holds the flags of column cols[k]
+template <int N>
+inline std::uint64_t
+pack_flags( const ColFlags* flags, const int* cols )
+{
+   static_assert( sizeof( ColFlags ) == 1, "flags are expected to be bytes" );
+   const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>( flags );
+
+   std::uint64_t packed = 0;
+   for( int k = 0; k != N; ++k )
+      packed |= std::uint64_t{ bytes[cols[k]] } << ( 8 * k );
+   return packed;
+}
+
+/// adds the contributions of the entries [start, len) one at a time, this is
+/// the reference for the vectorized loops
+inline void
+row_activity_scalar( const double* vals, const int* cols, int start, int len,
+                     const double* lbs, const double* ubs,
+                     const ColFlags* flags, ActivitySums& sums )
+{
+   for( int j = start; j < len; ++j )
+   {
+      int col = cols[j];
+      if( !flags[col].test( ColFlag::kUbUseless ) )
+      {
+         if( vals[j] < 0 )
+            sums.min += vals[j] * ubs[col];
+         else
+            sums.max += vals[j] * ubs[col];
+      }
+      else
+      {
+         if( vals[j] < 0 )
+            ++sums.ninfmin;
+         else
+            ++sums.ninfmax;
+      }
+
+      if( !flags[col].test( ColFlag::kLbUseless ) )
+      {
+         if( vals[j] < 0 )
+            sums.max += vals[j] * lbs[col];
+         else
+            sums.min += vals[j] * lbs[col];
+      }
+      else
+      {
+         if( vals[j] < 0 )
+            ++sums.ninfmax;
+         else
+            ++sums.ninfmin;
+      }
+   }
+}
+
+#ifdef PAPILO_SIMD_X86
+
+// Each nonzero adds exactly one product to the minimal and one to the maximal
+// activity. The products are computed lane-wise and summed in the order of
+// the row with the infinite ones replaced by zero, hence the results are
+// bitwise identical to the scalar loop. The in-order sum is the bottleneck of
+// both, so compute_row_activity keeps the scalar loop, which measured faster
+// on the rows of the test instances (see benchmark/ActivityBench.cpp).
+
+__attribute__( ( target( "avx2,popcnt" ) ) ) inline void
+row_activity_avx2( const double* vals, const int* cols, int len,
+                   const double* lbs, const double* ubs, const ColFlags* flags,
+                   ActivitySums& sums )
+{
+   const __m256d zero = _mm256_setzero_pd();
+   const __m256d all = _mm256_castsi256_pd( _mm256_set1_epi64x( -1 ) );
+   const __m256i lbuseless = _mm256_set1_epi64x(
+       static_cast<std::uint8_t>( ColFlag::kLbUseless ) );
+   const __m256i ubuseless = _mm256_set1_epi64x(
+       static_cast<std::uint8_t>( ColFlag::kUbUseless ) );
+
+   int j = 0;
+   for( ; j + 4 <= len; j += 4 )
+   {
+      const __m256d v = _mm256_loadu_pd( vals + j );
+      const __m128i idx =
+          _mm_loadu_si128( reinterpret_cast<const __m128i*>( cols + j ) );
+      const __m256d lb = _mm256_mask_i32gather_pd( zero, lbs, idx, all, 8 );
+      const __m256d ub = _mm256_mask_i32gather_pd( zero, ubs, idx, all, 8 );
+
+      const __m256i colflags = _mm256_cvtepu8_epi64( _mm_cvtsi32_si128(
+          (int)pack_flags<4>( flags, cols + j ) ) );
+      const __m256d lbfinite = _mm256_castsi256_pd( _mm256_cmpeq_epi64(
+          _mm256_and_si256( colflags, lbuseless ), _mm256_setzero_si256() ) );
+      const __m256d ubfinite = _mm256_castsi256_pd( _mm256_cmpeq_epi64(
+          _mm256_and_si256( colflags, ubuseless ), _mm256_setzero_si256() ) );
+
+      // negative coefficients take the upper bound for the minimal activity
+      const __m256d neg = _mm256_cmp_pd( v, zero, _CMP_LT_OQ );
+      const __m256d minbound = _mm256_blendv_pd( lb, ub, neg );
+      const __m256d maxbound = _mm256_blendv_pd( ub, lb, neg );
+      const __m256d minfinite = _mm256_blendv_pd( lbfinite, ubfinite, neg );
+      const __m256d maxfinite = _mm256_blendv_pd( ubfinite, lbfinite, neg );
+
+      sums.ninfmin += 4 - _mm_popcnt_u32( _mm256_movemask_pd( minfinite ) );
+      sums.ninfmax += 4 - _mm_popcnt_u32( _mm256_movemask_pd( maxfinite ) );
+
+      const __m256d minterms =
+          _mm256_and_pd( minfinite, _mm256_mul_pd( v, minbound ) );
+      const __m256d maxterms =
+          _mm256_and_pd( maxfinite, _mm256_mul_pd( v, maxbound ) );
+
+      const __m128d minlow = _mm256_castpd256_pd128( minterms );
+      const __m128d minhigh = _mm256_extractf128_pd( minterms, 1 );
+      const __m128d maxlow = _mm256_castpd256_pd128( maxterms );
+      const __m128d maxhigh = _mm256_extractf128_pd( maxterms, 1 );
+
+      sums.min += _mm_cvtsd_f64( minlow );
+      sums.max += _mm_cvtsd_f64( maxlow );
+      sums.min += _mm_cvtsd_f64( _mm_unpackhi_pd( minlow, minlow ) );
+      sums.max += _mm_cvtsd_f64( _mm_unpackhi_pd( maxlow, maxlow ) );
+      sums.min += _mm_cvtsd_f64( minhigh );
+      sums.max += _mm_cvtsd_f64( maxhigh );
+      sums.min += _mm_cvtsd_f64( _mm_unpackhi_pd( minhigh, minhigh ) );
+      sums.max += _mm_cvtsd_f64( _mm_unpackhi_pd( maxhigh, maxhigh ) );
+   }
+
+   row_activity_scalar( vals, cols, j, len, lbs, ubs, flags, sums );
+}
+
+__attribute__( ( target( "avx512f,popcnt" ) ) ) inline void
+row_activity_avx512( const double* vals, const int* cols, int len,
+                     const double* lbs, const double* ubs,
+                     const ColFlags* flags, ActivitySums& sums )
+{
+   const __m512d zero = _mm512_setzero_pd();
+   const __m512i lbuseless = _mm512_set1_epi64(
+       static_cast<std::uint8_t>( ColFlag::kLbUseless ) );
+   const __m512i ubuseless = _mm512_set1_epi64(
+       static_cast<std::uint8_t>( ColFlag::kUbUseless ) );
+   alignas( 64 ) double minterms[8];
+   alignas( 64 ) double maxterms[8];
+
+   int j = 0;
+   for( ; j + 8 <= len; j += 8 )
+   {
+      const __m512d v = _mm512_loadu_pd( vals + j );
+      const __m256i idx =
+          _mm256_loadu_si256( reinterpret_cast<const __m256i*>( cols + j ) );
+      const __m512d lb = _mm512_mask_i32gather_pd( zero, 0xff, idx, lbs, 8 );
+      const __m512d ub = _mm512_mask_i32gather_pd( zero, 0xff, idx, ubs, 8 );
+
+      const __m512i colflags = _mm512_maskz_cvtepu8_epi64( 0xff, _mm_cvtsi64_si128(
+          (long long)pack_flags<8>( flags, cols + j ) ) );
+      const __mmask8 lbfinite = _mm512_testn_epi64_mask( colflags, lbuseless );
+      const __mmask8 ubfinite = _mm512_testn_epi64_mask( colflags, ubuseless );
+
+      // negative coefficients take the upper bound for the minimal activity
+      const __mmask8 neg = _mm512_cmp_pd_mask( v, zero, _CMP_LT_OQ );
+      const __m512d minbound = _mm512_mask_blend_pd( neg, lb, ub );
+      const __m512d maxbound = _mm512_mask_blend_pd( neg, ub, lb );
+      const __mmask8 minfinite = ( neg & ubfinite ) | ( ~neg & lbfinite );
+      const __mmask8 maxfinite = ( neg & lbfinite ) | ( ~neg & ubfinite );
+
+      sums.ninfmin += 8 - _mm_popcnt_u32( minfinite );
+      sums.ninfmax += 8 - _mm_popcnt_u32( maxfinite );
+
+      _mm512_store_pd( minterms, _mm512_maskz_mul_pd( minfinite, v, minbound ) );
+      _mm512_store_pd( maxterms, _mm512_maskz_mul_pd( maxfinite, v, maxbound ) );
+
+      for( int k = 0; k != 8; ++k )
+      {
+         sums.min += minterms[k];
+         sums.max += maxterms[k];
+      }
+   }
+
+   row_activity_scalar( vals, cols, j, len, lbs, ubs, flags, sums );
+}
+
+// The propagation of a row divides for every nonzero, but only a few of the
+// resulting bounds are tighter than the current ones. The kernels below
+// compute the bounds of a block of nonzeros lane-wise and return the entries
+// whose bound may change. The test keeps a margin of 2 so that the rounding
+// of integral bounds can never turn a filtered entry into a bound change,
+// the selected entries are then propagated by the scalar code.
+
+__attribute__( ( target( "avx2" ) ) ) inline std::uint64_t
+propagation_candidates_avx2( bool lhs_side, const double* vals,
+                             const int* cols, int len, const double* lbs,
+                             const double* ubs, const ColFlags* flags,
+                             double activity, double side )
+{
+   const __m256d zero = _mm256_setzero_pd();
+   const __m256d margin = _mm256_set1_pd( 2.0 );
+   const __m256d act = _mm256_set1_pd( activity );
+   const __m256d sidev = _mm256_set1_pd( side );
+   // on the lhs side positive coefficients tighten the lower bound
+   const __m256d all = _mm256_castsi256_pd( _mm256_set1_epi64x( -1 ) );
+   const __m256d flip = lhs_side ? all : zero;
+   const __m256i lbinfflag =
+       _mm256_set1_epi64x( static_cast<std::uint8_t>( ColFlag::kLbInf ) );
+   const __m256i ubinfflag =
+       _mm256_set1_epi64x( static_cast<std::uint8_t>( ColFlag::kUbInf ) );
+
+   std::uint64_t candidates = 0;
+   int j = 0;
+   for( ; j + 4 <= len; j += 4 )
+   {
+      const __m256d v = _mm256_loadu_pd( vals + j );
+      const __m128i idx =
+          _mm_loadu_si128( reinterpret_cast<const __m128i*>( cols + j ) );
+      const __m256d lb = _mm256_mask_i32gather_pd( zero, lbs, idx, all, 8 );
+      const __m256d ub = _mm256_mask_i32gather_pd( zero, ubs, idx, all, 8 );
+
+      // lanes that compute a new lower bound and use the upper bound in the
+      // residual activity
+      const __m256d lbtest =
+          _mm256_xor_pd( _mm256_cmp_pd( v, zero, _CMP_LT_OQ ), flip );
+      const __m256d resbound = _mm256_blendv_pd( lb, ub, lbtest );
+
+      const __m256d residual = _mm256_sub_pd( act, _mm256_mul_pd( v, resbound ) );
+      const __m256d bound =
+          _mm256_div_pd( _mm256_sub_pd( sidev, residual ), v );
+
+      // unordered comparisons keep NaN as candidates
+      const unsigned int lbmaybe = (unsigned int)_mm256_movemask_pd(
+          _mm256_cmp_pd( bound, _mm256_sub_pd( lb, margin ), _CMP_NLT_UQ ) );
+      const unsigned int ubmaybe = (unsigned int)_mm256_movemask_pd(
+          _mm256_cmp_pd( bound, _mm256_add_pd( ub, margin ), _CMP_NGT_UQ ) );
+      const unsigned int lbmask = (unsigned int)_mm256_movemask_pd( lbtest );
+
+      const __m256i colflags = _mm256_cvtepu8_epi64( _mm_cvtsi32_si128(
+          (int)pack_flags<4>( flags, cols + j ) ) );
+      const unsigned int lbinf =
+          (unsigned int)_mm256_movemask_pd( _mm256_castsi256_pd(
+              _mm256_cmpeq_epi64( _mm256_and_si256( colflags, lbinfflag ),
+                                  lbinfflag ) ) );
+      const unsigned int ubinf =
+          (unsigned int)_mm256_movemask_pd( _mm256_castsi256_pd(
+              _mm256_cmpeq_epi64( _mm256_and_si256( colflags, ubinfflag ),
+                                  ubinfflag ) ) );
+
+      const unsigned int mask = ( lbmask & ( lbmaybe | lbinf ) ) |
+                                ( ~lbmask & ( ubmaybe | ubinf ) );
+      candidates |= (std::uint64_t)( mask & 0xf ) << j;
+   }
+
+   if( j < len )
+      candidates |= ( ~std::uint64_t{ 0 } >> ( 64 - ( len - j ) ) ) << j;
+
+   return candidates;
+}
+
+__attribute__( ( target( "avx512f" ) ) ) inline std::uint64_t
+propagation_candidates_avx512( bool lhs_side, const double* vals,
+                               const int* cols, int len, const double* lbs,
+                               const double* ubs, const ColFlags* flags,
+                               double activity, double side )
+{
+   const __m512d zero = _mm512_setzero_pd();
+   const __m512d margin = _mm512_set1_pd( 2.0 );
+   const __m512d act = _mm512_set1_pd( activity );
+   const __m512d sidev = _mm512_set1_pd( side );
+   // on the lhs side positive coefficients tighten the lower bound
+   const __mmask8 flip = lhs_side ? 0xff : 0;
+   const __m512i lbinfflag =
+       _mm512_set1_epi64( static_cast<std::uint8_t>( ColFlag::kLbInf ) );
+   const __m512i ubinfflag =
+       _mm512_set1_epi64( static_cast<std::uint8_t>( ColFlag::kUbInf ) );
+
+   std::uint64_t candidates = 0;
+   int j = 0;
+   for( ; j + 8 <= len; j += 8 )
+   {
+      const __m512d v = _mm512_loadu_pd( vals + j );
+      const __m256i idx =
+          _mm256_loadu_si256( reinterpret_cast<const __m256i*>( cols + j ) );
+      const __m512d lb = _mm512_mask_i32gather_pd( zero, 0xff, idx, lbs, 8 );
+      const __m512d ub = _mm512_mask_i32gather_pd( zero, 0xff, idx, ubs, 8 );
+
+      // lanes that compute a new lower bound and use the upper bound in the
+      // residual activity
+      const __mmask8 lbtest =
+          _mm512_cmp_pd_mask( v, zero, _CMP_LT_OQ ) ^ flip;
+      const __m512d resbound = _mm512_mask_blend_pd( lbtest, lb, ub );
+
+      const __m512d residual = _mm512_sub_pd( act, _mm512_mul_pd( v, resbound ) );
+      const __m512d bound =
+          _mm512_div_pd( _mm512_sub_pd( sidev, residual ), v );
+
+      // unordered comparisons keep NaN as candidates
+      const unsigned int lbmaybe = _mm512_cmp_pd_mask(
+          bound, _mm512_sub_pd( lb, margin ), _CMP_NLT_UQ );
+      const unsigned int ubmaybe = _mm512_cmp_pd_mask(
+          bound, _mm512_add_pd( ub, margin ), _CMP_NGT_UQ );
+      const unsigned int lbmask = lbtest;
+
+      const __m512i colflags = _mm512_maskz_cvtepu8_epi64( 0xff, _mm_cvtsi64_si128(
+          (long long)pack_flags<8>( flags, cols + j ) ) );
+      const unsigned int lbinf = _mm512_test_epi64_mask( colflags, lbinfflag );
+      const unsigned int ubinf = _mm512_test_epi64_mask( colflags, ubinfflag );
+
+      const unsigned int mask = ( lbmask & ( lbmaybe | lbinf ) ) |
+                                ( ~lbmask & ( ubmaybe | ubinf ) );
+      candidates |= (std::uint64_t)( mask & 0xff ) << j;
+   }
+
+   if( j < len )
+      candidates |= ( ~std::uint64_t{ 0 } >> ( 64 - ( len - j ) ) ) << j;
+
+   return candidates;
+}
+
+#endif
+
+/// activity sums of a row using the given instruction set
+inline ActivitySums
+row_activity( SimdLevel level, const double* vals, const int* cols, int len,
+              const double* lbs, const double* ubs, const ColFlags* flags )
+{
+   ActivitySums sums{ 0.0, 0.0, 0, 0 };
+
+   switch( level )
+   {
+#ifdef PAPILO_SIMD_X86
+   case SimdLevel::kAvx512:
+      row_activity_avx512( vals, cols, len, lbs, ubs, flags, sums );
+      return sums;
+   case SimdLevel::kAvx2:
+      row_activity_avx2( vals, cols, len, lbs, ubs, flags, sums );
+      return sums;
+#endif
+   default:
+      row_activity_scalar( vals, cols, 0, len, lbs, ubs, flags, sums );
+      return sums;
+   }
+}
+
+/// bitmask of the entries of a block of at most 64 nonzeros whose bounds may
+/// be tightened by a row side whose activity has no infinite contributions.
+/// For lhs_side the activity is the maximal one and side the lhs, otherwise
+/// the minimal activity and the rhs.
+inline std::uint64_t
+propagation_candidates( SimdLevel level, bool lhs_side, const double* vals,
+                        const int* cols, int len, const double* lbs,
+                        const double* ubs, const ColFlags* flags,
+                        double activity, double side )
+{
+   assert( len > 0 && len <= 64 );
+
+   // on short blocks the gathers cost more than the divisions they save
+   if( len < 16 )
+      return ~std::uint64_t{ 0 } >> ( 64 - len );
+
+   switch( level )
+   {
+#ifdef PAPILO_SIMD_X86
+   case SimdLevel::kAvx512:
+      return propagation_candidates_avx512( lhs_side, vals, cols, len, lbs,
+                                            ubs, flags, activity, side );
+   case SimdLevel::kAvx2:
+      return propagation_candidates_avx2( lhs_side, vals, cols, len, lbs, ubs,
+                                          flags, activity, side );
+#endif
+   default:
+      return ~std::uint64_t{ 0 } >> ( 64 - len );
+   }
+}
+
+} // namespace simd
+
+} // namespace papilo
+
+#endif
@@ -25,10 +25,15 @@
 #ifndef _PAPILO_CORE_SPARSE_STORAGE_HPP_
 #define _PAPILO_CORE_SPARSE_STORAGE_HPP_
 
+#include "papilo/Config.hpp"
 #include "papilo/external/pdqsort/pdqsort.h"
 #include "papilo/misc/MultiPrecision.hpp"
 #include "papilo/misc/Vec.hpp"
+#ifdef PAPILO_TBB
+#include "papilo/misc/tbb.hpp"
+#endif
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <cstring>
@@ -78,8 +83,12 @@ class SparseStorage
    SparseStorage( Vec<Triplet<REAL>> entries, int nRows_in, int nCols_in,
                   bool sorted = false, double spareRatio = DEFAULT_SPARE_RATIO,
                   int minInterRowSpace = DEFAULT_MIN_INTER_ROW_SPACE );
-   SparseStorage( REAL* values_in, int* rowstart_in, int* columns_in,
-                  int nRows_in, int nCols_in, int nnz_in,
+   /// copies a matrix in compressed sparse row format, the entries of row r
+   /// are at the positions rowstart_in[r] to rowstart_in[r + 1] - 1 and the
+   /// columns of each row must be strictly increasing. Zero values are
+   /// dropped.
+   SparseStorage( const REAL* values_in, const int* rowstart_in,
+                  const int* columns_in, int nRows_in, int nCols_in, int nnz_in,
                   double spareRatio = DEFAULT_SPARE_RATIO,
                   int minInterRowSpace = DEFAULT_MIN_INTER_ROW_SPACE );
    SparseStorage( int nRows_in, int nCols_in, int nnz_in, double spareRatio,
@@ -88,6 +97,12 @@ class SparseStorage
    SparseStorage<REAL>
    getTranspose() const;
 
+   /// checks whether the columns of every row of a matrix in compressed sparse
+   /// row format are strictly increasing and within [0, nCols_in)
+   static bool
+   isSortedAndUnique( const int* rowstart_in, const int* columns_in,
+                      int nRows_in, int nCols_in );
+
    Vec<int>
    compress( const Vec<int>& rowsize, const Vec<int>& colsize,
              bool full = false );
@@ -126,6 +141,43 @@ class SparseStorage
       return nAlloc;
    }
 
+   double
+   getSpareRatio() const
+   {
+      return spareRatio;
+   }
+
+   int
+   getMinInterRowSpace() const
+   {
+      return minInterRowSpace;
+   }
+
+   /// sets the space that compress() leaves behind every row for fill-in.
+   /// Rows are only ever moved to the left, so more space than a row
+   /// currently has is only obtained from deleted rows in front of it. If the
+   /// space is reduced, the next compress() releases the excess memory.
+   void
+   setSpareSpace( double spareRatio_, int minInterRowSpace_ )
+   {
+      assert( spareRatio_ >= 1.0 );
+      assert( minInterRowSpace_ >= 0 );
+      if( spareRatio_ < spareRatio || minInterRowSpace_ < minInterRowSpace )
+         releaseMemory = true;
+      spareRatio = spareRatio_;
+      minInterRowSpace = minInterRowSpace_;
+   }
+
+   /// number of bytes allocated by the storage, not counting memory that is
+   /// owned by the values themselves, e.g. the limbs of a Rational
+   std::size_t
+   getMemoryUsage() const
+   {
+      return values.capacity() * sizeof( REAL ) +
+             columns.capacity() * sizeof( int ) +
+             rowranges.capacity() * sizeof( IndexRange );
+   }
+
    const REAL*
    getValues() const
    {
@@ -411,6 +463,8 @@ class SparseStorage
    int nAlloc = -1;
    double spareRatio = 0.0;
    int minInterRowSpace = 0;
+   /// whether the spare space was reduced since the last compression
+   bool releaseMemory = false;
 };
 
 #ifdef PAPILO_USE_EXTERN_TEMPLATES
@@ -526,70 +580,261 @@ SparseStorage<REAL>::SparseStorage( int nRows_in, int nCols_in, int nnz_in,
 }
 
 template <typename REAL>
-SparseStorage<REAL>
-SparseStorage<REAL>::getTranspose() const
+SparseStorage<REAL>::SparseStorage( const REAL* values_in,
+                                    const int* rowstart_in,
+                                    const int* columns_in, int nRows_in,
+                                    int nCols_in, int nnz_in,
+                                    double spareRatio_, int minInterRowSpace_ )
+    : nRows( nRows_in ), nCols( nCols_in ), spareRatio( spareRatio_ ),
+      minInterRowSpace( minInterRowSpace_ )
 {
-//   if( nCols <= 0 )
-//      return SparseStorage<REAL>{};
+   assert( spareRatio_ >= 1.0 );
+   assert( rowstart_in[0] == 0 && rowstart_in[nRows] == nnz_in );
+   assert( isSortedAndUnique( rowstart_in, columns_in, nRows, nCols ) );
+
+   // count the nonzero values of each row, the explicit zeros are dropped
+   Vec<int> rowsize( static_cast<size_t>( nRows ) );
+
+   auto countRows = [&]( int first, int last ) {
+      for( int r = first; r != last; ++r )
+      {
+         int size = 0;
+         for( int j = rowstart_in[r]; j != rowstart_in[r + 1]; ++j )
+            size += values_in[j] != 0;
+         rowsize[r] = size;
+      }
+   };
+
+#ifdef PAPILO_TBB
+   tbb::parallel_for( tbb::blocked_range<int>( 0, nRows ),
+                      [&]( const tbb::blocked_range<int>& r ) {
+                         countRows( r.begin(), r.end() );
+                      } );
+#else
+   countRows( 0, nRows );
+#endif
 
-   // compute nnz of each row of At (column of A)
+   nnz = 0;
+   for( int r = 0; r != nRows; ++r )
+      nnz += rowsize[r];
+   assert( nnz <= nnz_in );
+
+   nAlloc = computeNAlloc();
 
-   Vec<int> w( size_t( nCols ), 0 );
+   rowranges.resize( nRows + 1 );
+   values.resize( nAlloc );
+   columns.resize( nAlloc );
 
-   for( int r = 0; r < nRows; r++ )
+   int start = 0;
+   for( int r = 0; r != nRows; ++r )
    {
-      const int start = rowranges[r].start;
-      const int end = rowranges[r].end;
+      rowranges[r].start = start;
+      rowranges[r].end = start + rowsize[r];
+      start += computeRowAlloc( rowsize[r] );
+   }
+   assert( start <= nAlloc );
 
-      for( int j = start; j < end; j++ )
+   rowranges[nRows].start = nAlloc;
+   rowranges[nRows].end = nAlloc;
+
+   auto copyRows = [&]( int first, int last ) {
+      for( int r = first; r != last; ++r )
       {
-         assert( values[j] != REAL{ 0.0 } );
-         w[columns[j]]++;
+         int idx = rowranges[r].start;
+         for( int j = rowstart_in[r]; j != rowstart_in[r + 1]; ++j )
+         {
+            if( values_in[j] == 0 )
+               continue;
+
+            values[idx] = values_in[j];
+            columns[idx++] = columns_in[j];
+         }
+         assert( idx == rowranges[r].end );
       }
-   }
+   };
+
+#ifdef PAPILO_TBB
+   tbb::parallel_for( tbb::blocked_range<int>( 0, nRows ),
+                      [&]( const tbb::blocked_range<int>& r ) {
+                         copyRows( r.begin(), r.end() );
+                      } );
+#else
+   copyRows( 0, nRows );
+#endif
+}
 
+template <typename REAL>
+bool
+SparseStorage<REAL>::isSortedAndUnique( const int* rowstart_in,
+                                        const int* columns_in, int nRows_in,
+                                        int nCols_in )
+{
+   auto checkRows = [&]( int first, int last ) {
+      for( int r = first; r != last; ++r )
+      {
+         if( rowstart_in[r + 1] < rowstart_in[r] )
+            return false;
+
+         int prevcol = -1;
+         for( int j = rowstart_in[r]; j != rowstart_in[r + 1]; ++j )
+         {
+            if( columns_in[j] <= prevcol || columns_in[j] >= nCols_in )
+               return false;
+            prevcol = columns_in[j];
+         }
+      }
+      return true;
+   };
+
+#ifdef PAPILO_TBB
+   std::atomic<bool> result{ true };
+   tbb::parallel_for( tbb::blocked_range<int>( 0, nRows_in ),
+                      [&]( const tbb::blocked_range<int>& r ) {
+                         if( result.load( std::memory_order_relaxed ) &&
+                             !checkRows( r.begin(), r.end() ) )
+                            result.store( false, std::memory_order_relaxed );
+                      } );
+   return result.load();
+#else
+   return checkRows( 0, nRows_in );
+#endif
+}
+
+template <typename REAL>
+SparseStorage<REAL>
+SparseStorage<REAL>::getTranspose() const
+{
    assert( spareRatio >= 1.0 );
 
    SparseStorage<REAL> transpose{ nCols, nRows, nnz, spareRatio,
                                   minInterRowSpace };
 
-   // set row ranges of transpose
-   transpose.rowranges[0].start = 0;
+   // The rows are split into blocks whose entries are counted per column. The
+   // entries of a column are then placed block after block, so each block can
+   // scatter its entries independently and the rows of the transpose are
+   // still sorted. The counts take nblocks * nCols integers which is kept
+   // below the number of nonzeros.
+   int nblocks = 1;
+#ifdef PAPILO_TBB
+   if( nnz >= 100000 )
+      nblocks = std::min( { tbb::this_task_arena::max_concurrency(),
+                            std::max( 1, nnz / std::max( nCols, 1 ) ),
+                            std::max( 1, nRows ) } );
+#endif
 
-   for( int i = 1; i <= nCols; i++ )
-   {
-      const int oldstart = transpose.rowranges[i - 1].start;
-      const int oldend = oldstart + w[i - 1];
-      assert( oldend >= oldstart );
+   auto blockStart = [&]( int block ) {
+      return static_cast<int>( int64_t( nRows ) * block / nblocks );
+   };
 
-      transpose.rowranges[i - 1].end = oldend;
-      transpose.rowranges[i].start =
-          oldstart + transpose.computeRowAlloc( w[i - 1] );
+   // w[block * nCols + col] is the number of entries of the column in the
+   // block, and afterwards the position of the next entry of the block
+   Vec<int> w( size_t( nblocks ) * size_t( nCols ), 0 );
 
-      w[i - 1] = oldstart;
-   }
+   auto countBlock = [&]( int block ) {
+      int* count = w.data() + size_t( block ) * nCols;
+      for( int r = blockStart( block ); r != blockStart( block + 1 ); r++ )
+      {
+         for( int j = rowranges[r].start; j < rowranges[r].end; j++ )
+         {
+            assert( values[j] != REAL{ 0.0 } );
+            count[columns[j]]++;
+         }
+      }
+   };
 
-   transpose.rowranges[nCols].start = transpose.nAlloc;
-   transpose.rowranges[nCols].end = transpose.nAlloc;
+   auto scatterBlock = [&]( int block ) {
+      int* next = w.data() + size_t( block ) * nCols;
+      for( int r = blockStart( block ); r != blockStart( block + 1 ); r++ )
+      {
+         for( int j = rowranges[r].start; j < rowranges[r].end; j++ )
+         {
+            const int idx = next[columns[j]]++;
 
-   // fill values and columns arrays of transpose
-   for( int r = 0; r < nRows; r++ )
-   {
-      const int start = rowranges[r].start;
-      const int end = rowranges[r].end;
+            assert( idx < transpose.nAlloc );
 
-      for( int j = start; j < end; j++ )
-      {
-         const int idx = w[columns[j]];
+            transpose.values[idx] = values[j];
+            transpose.columns[idx] = r;
+         }
+      }
+   };
 
-         assert( idx < transpose.nAlloc );
+#ifdef PAPILO_TBB
+   tbb::parallel_for( 0, nblocks, countBlock );
+#else
+   countBlock( 0 );
+#endif
 
-         transpose.values[idx] = values[j];
-         transpose.columns[idx] = r;
+   // turn the counts into the positions of the blocks relative to the start
+   // of the column and store the column sizes in the row ranges
+   auto sumColumns = [&]( int first, int last ) {
+      for( int col = first; col != last; ++col )
+      {
+         int colsize = 0;
+         for( int block = 0; block != nblocks; ++block )
+         {
+            int& count = w[size_t( block ) * nCols + col];
+            const int blocksize = count;
+            count = colsize;
+            colsize += blocksize;
+         }
+         transpose.rowranges[col].end = colsize;
+      }
+   };
 
-         w[columns[j]] = idx + 1;
+   auto shiftColumns = [&]( int first, int last ) {
+      for( int col = first; col != last; ++col )
+      {
+         const int colstart = transpose.rowranges[col].start;
+         for( int block = 0; block != nblocks; ++block )
+            w[size_t( block ) * nCols + col] += colstart;
       }
+   };
+
+#ifdef PAPILO_TBB
+   if( nblocks > 1 )
+      tbb::parallel_for( tbb::blocked_range<int>( 0, nCols ),
+                         [&]( const tbb::blocked_range<int>& r ) {
+                            sumColumns( r.begin(), r.end() );
+                         } );
+   else
+      sumColumns( 0, nCols );
+#else
+   sumColumns( 0, nCols );
+#endif
+
+   // set row ranges of transpose
+   int start = 0;
+   for( int col = 0; col < nCols; col++ )
+   {
+      const int colsize = transpose.rowranges[col].end;
+      transpose.rowranges[col].start = start;
+      transpose.rowranges[col].end = start + colsize;
+      start += transpose.computeRowAlloc( colsize );
    }
+   assert( start <= transpose.nAlloc );
+
+#ifdef PAPILO_TBB
+   if( nblocks > 1 )
+      tbb::parallel_for( tbb::blocked_range<int>( 0, nCols ),
+                         [&]( const tbb::blocked_range<int>& r ) {
+                            shiftColumns( r.begin(), r.end() );
+                         } );
+   else
+      shiftColumns( 0, nCols );
+#else
+   shiftColumns( 0, nCols );
+#endif
+
+   transpose.rowranges[nCols].start = transpose.nAlloc;
+   transpose.rowranges[nCols].end = transpose.nAlloc;
+
+   // fill values and columns arrays of transpose
+#ifdef PAPILO_TBB
+   tbb::parallel_for( 0, nblocks, scatterBlock );
+#else
+   scatterBlock( 0 );
+#endif
+
    return transpose;
 }
 
@@ -623,79 +868,194 @@ SparseStorage<REAL>::compress( const Vec<int>& rowsize, const Vec<int>& colsize,
 
    if( nRows > 0 )
    {
-      int offset = 0;
-      int rowcount = 0;
-      for( int r = 0; r < nRows; r++ )
-      {
-         const int start = rowranges[r].start;
-         const int end = rowranges[r].end;
-         const int rowalloc = rowranges[r + 1].start - start;
+      // Every remaining row is moved to the left by the space in front of it
+      // that is not needed anymore. Deleted rows add their allocated space to
+      // this offset, the others their spare space beyond computeRowAlloc(),
+      // but the offset never becomes negative. Each row thus maps the offset
+      // x >= 0 to max(x + shift, floor), and a sequence of rows is again such
+      // a map. This allows to split the rows into blocks, compute the map of
+      // each block in parallel and obtain the offsets of the blocks by a
+      // prefix over the blocks.
+      int nblocks = 1;
+#ifdef PAPILO_TBB
+      if( nnz >= 100000 )
+         nblocks = std::min( tbb::this_task_arena::max_concurrency(), nRows );
+#endif
 
-         // empty row?
+      auto blockStart = [&]( int block ) {
+         return static_cast<int>( int64_t( nRows ) * block / nblocks );
+      };
+
+      auto rowShift = [&]( int r ) -> int64_t {
+         const int rowalloc = rowranges[r + 1].start - rowranges[r].start;
          if( rowsize[r] == -1 )
-            offset += rowalloc;
-         else
+            return rowalloc;
+         return rowalloc -
+                computeRowAlloc( rowranges[r].end - rowranges[r].start );
+      };
+
+      Vec<int64_t> blockshift( nblocks + 1, 0 );
+      Vec<int64_t> blockfloor( nblocks + 1, 0 );
+      Vec<int> blockrows( nblocks + 1, 0 );
+
+      auto scanBlock = [&]( int block ) {
+         int64_t shift = 0;
+         int64_t floor = 0;
+         int nkept = 0;
+         for( int r = blockStart( block ); r != blockStart( block + 1 ); ++r )
          {
-            rowranges[rowcount].start = start;
-            rowranges[rowcount].end = end;
-
-            if( offset > 0 )
+            const int64_t rowshift = rowShift( r );
+            shift += rowshift;
+            if( rowsize[r] != -1 )
             {
-               // move values and columns
-               assert( start >= offset );
+               floor = std::max( floor + rowshift, int64_t{ 0 } );
+               ++nkept;
+            }
+            else
+               floor += rowshift;
+         }
+         blockshift[block] = shift;
+         blockfloor[block] = floor;
+         blockrows[block] = nkept;
+      };
+
+#ifdef PAPILO_TBB
+      tbb::parallel_for( 0, nblocks, scanBlock );
+#else
+      scanBlock( 0 );
+#endif
 
-               std::move( values.data() + start, values.data() + end,
-                          values.data() + start - offset );
-               std::move( columns.data() + start, columns.data() + end,
-                          columns.data() + start - offset );
+      // replace the maps and counts by the offsets and the new indices of the
+      // first row of each block
+      int64_t offset = 0;
+      int rowcount = 0;
+      for( int block = 0; block != nblocks; ++block )
+      {
+         const int64_t nextoffset = std::max( offset + blockshift[block],
+                                              blockfloor[block] );
+         const int nextrowcount = rowcount + blockrows[block];
+         blockshift[block] = offset;
+         blockrows[block] = rowcount;
+         offset = nextoffset;
+         rowcount = nextrowcount;
+      }
+      assert( offset >= 0 && offset <= nAlloc );
+
+      Vec<IndexRange> newranges( rowcount + 1 );
+
+      // A row is never moved to the right, so a block only writes into the
+      // space of earlier blocks with the first rows whose new start lies in
+      // front of the block. Those rows are moved into a buffer before the
+      // others are compacted in place and are copied to their position after
+      // all blocks are done.
+      Vec<Vec<REAL>> spillvals( nblocks );
+      Vec<Vec<int>> spillcols( nblocks );
+      Vec<int> nspillrows( nblocks, 0 );
+
+      auto moveRows = [&]( int block ) {
+         const int blockbegin = rowranges[blockStart( block )].start;
+         int64_t rowoffset = blockshift[block];
+         int newrow = blockrows[block];
+         for( int r = blockStart( block ); r != blockStart( block + 1 ); ++r )
+         {
+            const int start = rowranges[r].start;
+            const int end = rowranges[r].end;
+            const int64_t rowshift = rowShift( r );
 
-               rowranges[rowcount].start -= offset;
-               rowranges[rowcount].end -= offset;
+            if( rowsize[r] == -1 )
+            {
+               rowoffset += rowshift;
+               continue;
             }
 
-            offset = std::max(
-                offset + rowalloc - computeRowAlloc( end - start ), 0 );
+            assert( start >= rowoffset );
+            const int newstart = static_cast<int>( start - rowoffset );
+            newranges[newrow].start = newstart;
+            newranges[newrow].end = newstart + end - start;
+            ++newrow;
+
+            if( newstart < blockbegin )
+            {
+               assert( nspillrows[block] == newrow - blockrows[block] - 1 );
+               spillvals[block].insert(
+                   spillvals[block].end(),
+                   std::make_move_iterator( values.data() + start ),
+                   std::make_move_iterator( values.data() + end ) );
+               for( int j = start; j != end; ++j )
+                  spillcols[block].push_back( colsmap[columns[j]] );
+               ++nspillrows[block];
+            }
+            else if( rowoffset > 0 )
+            {
+               for( int j = start; j != end; ++j )
+               {
+                  values[j - rowoffset] = std::move( values[j] );
+                  columns[j - rowoffset] = colsmap[columns[j]];
+               }
+            }
+            else
+            {
+               for( int j = start; j != end; ++j )
+                  columns[j] = colsmap[columns[j]];
+            }
 
-            ++rowcount;
+            rowoffset = std::max( rowoffset + rowshift, int64_t{ 0 } );
          }
+      };
 
-         assert( offset <= nAlloc );
-      }
+      auto moveSpilledRows = [&]( int block ) {
+         int k = 0;
+         for( int i = 0; i != nspillrows[block]; ++i )
+         {
+            const IndexRange& range = newranges[blockrows[block] + i];
+            for( int j = range.start; j != range.end; ++j, ++k )
+            {
+               values[j] = std::move( spillvals[block][k] );
+               columns[j] = spillcols[block][k];
+            }
+         }
+         assert( k == (int)spillvals[block].size() );
+      };
+
+#ifdef PAPILO_TBB
+      tbb::parallel_for( 0, nblocks, moveRows );
+      tbb::parallel_for( 0, nblocks, moveSpilledRows );
+#else
+      moveRows( 0 );
+      moveSpilledRows( 0 );
+#endif
 
-      rowranges[rowcount].start = rowranges[nRows].start - offset;
-      rowranges[rowcount].end = rowranges[nRows].end - offset;
+      newranges[rowcount].start =
+          static_cast<int>( rowranges[nRows].start - offset );
+      newranges[rowcount].end =
+          static_cast<int>( rowranges[nRows].end - offset );
 
       nRows = rowcount;
-      nAlloc = nAlloc - offset;
+      nAlloc = nAlloc - static_cast<int>( offset );
       assert( nAlloc >= 0 );
 
-      rowranges.resize( nRows + 1 );
+      rowranges = std::move( newranges );
       values.resize( nAlloc );
       columns.resize( nAlloc );
 
-      if( full )
+      if( full || releaseMemory )
       {
-         rowranges.shrink_to_fit();
          values.shrink_to_fit();
          columns.shrink_to_fit();
       }
 
+#ifndef NDEBUG
       for( int r = 0; r < nRows; r++ )
       {
-         const int start = rowranges[r].start;
-         const int end = rowranges[r].end;
-
-         for( int j = start; j < end; j++ )
-         {
-            assert( columns[j] >= 0 );
-            assert( columns[j] < static_cast<int>( colsmap.size() ) );
-            columns[j] = colsmap[columns[j]];
-            assert( columns[j] >= 0 );
-            assert( columns[j] < nCols );
-         }
+         assert( r == 0 || rowranges[r - 1].end <= rowranges[r].start );
+         for( int j = rowranges[r].start; j < rowranges[r].end; j++ )
+            assert( columns[j] >= 0 && columns[j] < nCols );
       }
+#endif
    }
 
+   releaseMemory = false;
+
    return colsmap;
 }
 
@@ -25,6 +25,9 @@
 #ifndef _PAPILO_CORE_STATISTICS_HPP_
 #define _PAPILO_CORE_STATISTICS_HPP_
 
+#include <cstdint>
+#include <vector>
+
 namespace papilo
 {
 
@@ -42,6 +45,21 @@ struct Statistics
    int consecutive_rounds_of_only_boundchanges;
    // variable substitutions and constraint deletions are excluded
    int single_matrix_coefficient_changes;
+   // share of the threads that were busy running presolvers, one entry for
+   // every run of a tier (or of the task graph) in a round
+   std::vector<double> round_utilization;
+   // calls to malloc of the memory resources during every run of a tier,
+   // only recorded with PAPILO_RESOURCE_ALLOCATOR, the counters are global
+   // for the process and include concurrent presolve runs
+   std::vector<uint64_t> round_system_allocs;
+   // connected components of the active problem after every round, only
+   // recorded with presolve.trackcomponents, a lower bound between two
+   // rebuilds of the components
+   std::vector<int> round_components;
+   // transactions of a previous presolve run that a warm start replayed or
+   // did not replay because the data they are based on changed
+   int ntsxreplayed = 0;
+   int ntsxnotreplayed = 0;
 
    Statistics( double _presolvetime, int _ntsxapplied, int _ntsxconflicts,
                int _nboundchgs, int _nsidechgs, int _ncoefchgs, int _nrounds,
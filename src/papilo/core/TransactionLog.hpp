@@ -0,0 +1,368 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_TRANSACTION_LOG_HPP_
+#define _PAPILO_CORE_TRANSACTION_LOG_HPP_
+
+#include "papilo/core/Problem.hpp"
+#include "papilo/core/Reductions.hpp"
+#include "papilo/misc/Hash.hpp"
+#include "papilo/misc/Vec.hpp"
+#include "papilo/verification/ArgumentType.hpp"
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+namespace papilo
+{
+
+/// steps of a presolve run that change the problem, in the order in which
+/// the presolve loop performs them
+enum class TransactionStep : uint8_t
+{
+   kTransaction,
+   kTrivialPresolve,
+   kFlushChangedCoeffs,
+   kFlush,
+   kFlushResetActivities,
+   kClearStates,
+};
+
+/// hash of the data a transaction is based on. It covers the rows and columns
+/// the reductions of the transaction refer to, the rows of these columns and
+/// the columns of all these rows: the sides, flags and coefficients of the
+/// rows and the bounds, flags and objective coefficients of the columns. The
+/// rows and columns are identified by their index in the original problem,
+/// hence the hash does not depend on when the problem was compressed.
+template <typename REAL>
+class TransactionFingerprint
+{
+ public:
+   /// returns 0 if the data is too large to be hashed, which marks the
+   /// transaction as not replayable
+   uint64_t
+   compute( const Problem<REAL>& problem, const Reduction<REAL>* first,
+            const Reduction<REAL>* last, const Vec<int>& origrow_mapping,
+            const Vec<int>& origcol_mapping )
+   {
+      const ConstraintMatrix<REAL>& consMatrix = problem.getConstraintMatrix();
+      rowmark.resize( problem.getNRows(), 0 );
+      colmark.resize( problem.getNCols(), 0 );
+      assert( rows.empty() && cols.empty() );
+
+      for( const Reduction<REAL>* reduction = first; reduction != last;
+           ++reduction )
+      {
+         if( reduction->row >= 0 )
+            markRow( reduction->row );
+         if( reduction->col >= 0 )
+            markCol( reduction->col );
+
+         switch( reduction->row )
+         {
+         case ColReduction::SUBSTITUTE:
+         case ColReduction::SUBSTITUTE_OBJ:
+            markRow( static_cast<int>( reduction->newval ) );
+            break;
+         case ColReduction::PARALLEL:
+         case ColReduction::CERTIFICATE_DOMINANCE:
+         case ColReduction::CERTIFICATE_PROBING_LOWER:
+         case ColReduction::CERTIFICATE_PROBING_UPPER:
+            markCol( static_cast<int>( reduction->newval ) );
+            break;
+         }
+
+         if( reduction->row >= 0 &&
+             reduction->col ==
+                 RowReduction::REASON_FOR_LESS_RESTRICTIVE_BOUND_CHANGE )
+            markRow( static_cast<int>( reduction->newval ) );
+      }
+
+      // the rows of the referenced columns and then the columns of all rows
+      std::size_t size = 0;
+      const int nreferenced = static_cast<int>( cols.size() );
+      for( int i = 0; i != nreferenced; ++i )
+      {
+         auto colvec = consMatrix.getColumnCoefficients( cols[i] );
+         size += colvec.getLength();
+         if( size > MAX_SIZE )
+            return clear( 0 );
+         for( int k = 0; k != colvec.getLength(); ++k )
+            markRow( colvec.getIndices()[k] );
+      }
+
+      for( int row : rows )
+      {
+         auto rowvec = consMatrix.getRowCoefficients( row );
+         size += rowvec.getLength();
+         if( size > MAX_SIZE )
+            return clear( 0 );
+         for( int k = 0; k != rowvec.getLength(); ++k )
+            markCol( rowvec.getIndices()[k] );
+      }
+
+      // the items are summed up so that the order in which they were found
+      // does not matter
+      uint64_t hash = 0;
+      const Vec<RowFlags>& rflags = consMatrix.getRowFlags();
+      const Vec<REAL>& lhs = consMatrix.getLeftHandSides();
+      const Vec<REAL>& rhs = consMatrix.getRightHandSides();
+      for( int row : rows )
+      {
+         Hasher<uint64_t> hasher( origrow_mapping[row] );
+         const RowFlags& flags = rflags[row];
+         hasher.addValue( flags.test( RowFlag::kLhsInf ) |
+                          flags.test( RowFlag::kRhsInf ) << 1 |
+                          flags.test( RowFlag::kEquation ) << 2 |
+                          flags.test( RowFlag::kIntegral ) << 3 |
+                          flags.test( RowFlag::kRedundant ) << 4 );
+         if( !flags.test( RowFlag::kLhsInf ) )
+            hasher.addValue( bits( lhs[row] ) );
+         if( !flags.test( RowFlag::kRhsInf ) )
+            hasher.addValue( bits( rhs[row] ) );
+
+         auto rowvec = consMatrix.getRowCoefficients( row );
+         hasher.addValue( rowvec.getLength() );
+         for( int k = 0; k != rowvec.getLength(); ++k )
+         {
+            hasher.addValue( origcol_mapping[rowvec.getIndices()[k]] );
+            hasher.addValue( bits( rowvec.getValues()[k] ) );
+         }
+
+         hash += hasher.getHash();
+      }
+
+      const Vec<ColFlags>& cflags = problem.getColFlags();
+      const Vec<REAL>& lbs = problem.getLowerBounds();
+      const Vec<REAL>& ubs = problem.getUpperBounds();
+      const Vec<REAL>& obj = problem.getObjective().coefficients;
+      for( int col : cols )
+      {
+         // columns and rows with equal index must give different hashes
+         Hasher<uint64_t> hasher( ~uint64_t( origcol_mapping[col] ) );
+         const ColFlags& flags = cflags[col];
+         hasher.addValue( flags.test( ColFlag::kLbInf ) |
+                          flags.test( ColFlag::kUbInf ) << 1 |
+                          flags.test( ColFlag::kIntegral ) << 2 |
+                          flags.test( ColFlag::kImplInt ) << 3 |
+                          flags.test( ColFlag::kFixed ) << 4 |
+                          flags.test( ColFlag::kSubstituted ) << 5 );
+         if( !flags.test( ColFlag::kLbInf ) )
+            hasher.addValue( bits( lbs[col] ) );
+         if( !flags.test( ColFlag::kUbInf ) )
+            hasher.addValue( bits( ubs[col] ) );
+         hasher.addValue( bits( obj[col] ) );
+
+         hash += hasher.getHash();
+      }
+
+      return clear( hash == 0 ? 1 : hash );
+   }
+
+ private:
+   /// larger neighbourhoods are not hashed, the transaction is not replayed
+   static constexpr std::size_t MAX_SIZE = 1 << 16;
+
+   static uint64_t
+   bits( const REAL& value )
+   {
+      double x = static_cast<double>( value );
+      // do not distinguish 0 and -0
+      if( x == 0 )
+         x = 0;
+      uint64_t result;
+      std::memcpy( &result, &x, sizeof( result ) );
+      return result;
+   }
+
+   void
+   markRow( int row )
+   {
+      if( !rowmark[row] )
+      {
+         rowmark[row] = 1;
+         rows.push_back( row );
+      }
+   }
+
+   void
+   markCol( int col )
+   {
+      if( !colmark[col] )
+      {
+         colmark[col] = 1;
+         cols.push_back( col );
+      }
+   }
+
+   uint64_t
+   clear( uint64_t hash )
+   {
+      for( int row : rows )
+         rowmark[row] = 0;
+      for( int col : cols )
+         colmark[col] = 0;
+      rows.clear();
+      cols.clear();
+      return hash;
+   }
+
+   Vec<uint8_t> rowmark;
+   Vec<uint8_t> colmark;
+   Vec<int> rows;
+   Vec<int> cols;
+};
+
+/// log of the transactions a presolve run applied and of the steps in
+/// between, with the indices of the original problem. A later presolve run
+/// of a modified problem replays the transactions whose fingerprint is
+/// unchanged, see Presolve::applyWarmStart().
+template <typename REAL>
+class TransactionLog
+{
+ public:
+   struct Entry
+   {
+      TransactionStep step;
+      ArgumentType argument;
+      /// range of the reductions of a transaction
+      int start;
+      int end;
+      uint64_t fingerprint;
+   };
+
+   void
+   reset( int nrows_, int ncols_ )
+   {
+      nrows = nrows_;
+      ncols = ncols_;
+      entries.clear();
+      reductions.clear();
+   }
+
+   /// number of rows of the original problem
+   int
+   getNRows() const
+   {
+      return nrows;
+   }
+
+   /// number of columns of the original problem
+   int
+   getNCols() const
+   {
+      return ncols;
+   }
+
+   bool
+   empty() const
+   {
+      return entries.empty();
+   }
+
+   void
+   addStep( TransactionStep step )
+   {
+      assert( step != TransactionStep::kTransaction );
+      const int size = static_cast<int>( reductions.size() );
+      entries.push_back( { step, ArgumentType::kPrimal, size, size, 0 } );
+   }
+
+   /// stores a transaction with indices of the current problem, which are
+   /// translated by the given mappings
+   void
+   addTransaction( const Reduction<REAL>* first, const Reduction<REAL>* last,
+                   ArgumentType argument, uint64_t fingerprint,
+                   const Vec<int>& origrow_mapping,
+                   const Vec<int>& origcol_mapping )
+   {
+      const int start = static_cast<int>( reductions.size() );
+
+      for( const Reduction<REAL>* reduction = first; reduction != last;
+           ++reduction )
+      {
+         Reduction<REAL> mapped = *reduction;
+         if( mapped.row >= 0 )
+            mapped.row = origrow_mapping[mapped.row];
+         if( mapped.col >= 0 )
+            mapped.col = origcol_mapping[mapped.col];
+
+         switch( reduction->row )
+         {
+         case ColReduction::SUBSTITUTE:
+         case ColReduction::SUBSTITUTE_OBJ:
+            mapped.newval = REAL(
+                origrow_mapping[static_cast<int>( reduction->newval )] );
+            break;
+         case ColReduction::PARALLEL:
+         case ColReduction::CERTIFICATE_DOMINANCE:
+         case ColReduction::CERTIFICATE_PROBING_LOWER:
+         case ColReduction::CERTIFICATE_PROBING_UPPER:
+            mapped.newval = REAL(
+                origcol_mapping[static_cast<int>( reduction->newval )] );
+            break;
+         }
+
+         if( reduction->row >= 0 &&
+             reduction->col ==
+                 RowReduction::REASON_FOR_LESS_RESTRICTIVE_BOUND_CHANGE )
+            mapped.newval = REAL(
+                origrow_mapping[static_cast<int>( reduction->newval )] );
+
+         reductions.push_back( mapped );
+      }
+
+      entries.push_back( { TransactionStep::kTransaction, argument, start,
+                           static_cast<int>( reductions.size() ),
+                           fingerprint } );
+   }
+
+   const Vec<Entry>&
+   getEntries() const
+   {
+      return entries;
+   }
+
+   const Reduction<REAL>*
+   getReductions( const Entry& entry ) const
+   {
+      return reductions.data() + entry.start;
+   }
+
+   int
+   getNumTransactions() const
+   {
+      int ntransactions = 0;
+      for( const Entry& entry : entries )
+         ntransactions += entry.step == TransactionStep::kTransaction;
+      return ntransactions;
+   }
+
+ private:
+   int nrows = 0;
+   int ncols = 0;
+   Vec<Entry> entries;
+   Vec<Reduction<REAL>> reductions;
+};
+
+} // namespace papilo
+
+#endif
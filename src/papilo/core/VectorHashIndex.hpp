@@ -0,0 +1,296 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_VECTOR_HASH_INDEX_HPP_
+#define _PAPILO_CORE_VECTOR_HASH_INDEX_HPP_
+
+#include "papilo/core/SparseStorage.hpp"
+#include "papilo/misc/Hash.hpp"
+#include "papilo/misc/Num.hpp"
+#include "papilo/misc/Vec.hpp"
+#include "papilo/misc/compress_vector.hpp"
+#ifdef PAPILO_TBB
+#include "papilo/misc/tbb.hpp"
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <utility>
+
+namespace papilo
+{
+
+/// hashes of the supports and of the scaled coefficients of the rows of a
+/// sparse storage (i.e. of the rows or, for the transpose, the columns of the
+/// constraint matrix), used to find parallel rows and columns. The owner
+/// marks the vectors it modifies as dirty and the hashes of dirty vectors are
+/// recomputed on the next query. Queries come from presolvers that run
+/// concurrently on a const problem, hence the update is guarded by a mutex.
+template <typename REAL>
+class VectorHashIndex
+{
+ public:
+   VectorHashIndex() = default;
+
+   VectorHashIndex( const VectorHashIndex& other )
+       : built( other.built ), supports_stale( other.supports_stale ),
+         supporthash( other.supporthash ), coefhash( other.coefhash ),
+         dirty( other.dirty ), dirty_vectors( other.dirty_vectors )
+   {
+   }
+
+   VectorHashIndex( VectorHashIndex&& other ) noexcept
+       : built( other.built ), supports_stale( other.supports_stale ),
+         supporthash( std::move( other.supporthash ) ),
+         coefhash( std::move( other.coefhash ) ),
+         dirty( std::move( other.dirty ) ),
+         dirty_vectors( std::move( other.dirty_vectors ) )
+   {
+   }
+
+   VectorHashIndex&
+   operator=( const VectorHashIndex& other )
+   {
+      built = other.built;
+      supports_stale = other.supports_stale;
+      supporthash = other.supporthash;
+      coefhash = other.coefhash;
+      dirty = other.dirty;
+      dirty_vectors = other.dirty_vectors;
+      return *this;
+   }
+
+   VectorHashIndex&
+   operator=( VectorHashIndex&& other ) noexcept
+   {
+      built = other.built;
+      supports_stale = other.supports_stale;
+      supporthash = std::move( other.supporthash );
+      coefhash = std::move( other.coefhash );
+      dirty = std::move( other.dirty );
+      dirty_vectors = std::move( other.dirty_vectors );
+      return *this;
+   }
+
+   /// the hashes of the vector are recomputed on the next query; does nothing
+   /// as long as the index was never queried
+   void
+   markDirty( int i )
+   {
+      if( !built || dirty[i] )
+         return;
+
+      dirty[i] = true;
+      dirty_vectors.push_back( i );
+   }
+
+   /// applies the mapping of a compress to the hashes. The coefficient
+   /// hashes stay valid, the support hashes are recomputed if the indices of
+   /// the other dimension were renumbered.
+   void
+   compress( const Vec<int>& mapping, bool indices_renumbered, bool full )
+   {
+      if( !built )
+         return;
+
+      for( int i : dirty_vectors )
+         dirty[i] = false;
+      // dirty vectors that survive the compress stay dirty
+      for( int& i : dirty_vectors )
+         i = mapping[i];
+      dirty_vectors.erase(
+          std::remove( dirty_vectors.begin(), dirty_vectors.end(), -1 ),
+          dirty_vectors.end() );
+
+      compress_vector( mapping, supporthash );
+      compress_vector( mapping, coefhash );
+      dirty.resize( coefhash.size() );
+      for( int i : dirty_vectors )
+         dirty[i] = true;
+
+      if( full )
+      {
+         supporthash.shrink_to_fit();
+         coefhash.shrink_to_fit();
+         dirty.shrink_to_fit();
+      }
+
+      supports_stale = supports_stale || indices_renumbered;
+   }
+
+   /// forgets all hashes, the next query recomputes them from scratch
+   void
+   clear()
+   {
+      built = false;
+      supports_stale = false;
+      supporthash.clear();
+      coefhash.clear();
+      dirty.clear();
+      dirty_vectors.clear();
+   }
+
+   /// brings the hashes up to date with the given storage
+   void
+   update( const SparseStorage<REAL>& storage ) const
+   {
+      std::lock_guard<std::mutex> lock( mutex );
+
+      const int nvectors = storage.getNRows();
+
+      if( !built || (int)coefhash.size() != nvectors )
+      {
+         supporthash.resize( nvectors );
+         coefhash.resize( nvectors );
+         dirty.assign( nvectors, false );
+         dirty_vectors.clear();
+#ifdef PAPILO_TBB
+         tbb::parallel_for( tbb::blocked_range<int>( 0, nvectors ),
+                            [&]( const tbb::blocked_range<int>& r ) {
+                               for( int i = r.begin(); i != r.end(); ++i )
+                                  computeHashes( storage, i );
+                            } );
+#else
+         for( int i = 0; i != nvectors; ++i )
+            computeHashes( storage, i );
+#endif
+         built = true;
+         supports_stale = false;
+         return;
+      }
+
+      if( supports_stale )
+      {
+#ifdef PAPILO_TBB
+         tbb::parallel_for( tbb::blocked_range<int>( 0, nvectors ),
+                            [&]( const tbb::blocked_range<int>& r ) {
+                               for( int i = r.begin(); i != r.end(); ++i )
+                                  computeSupportHash( storage, i );
+                            } );
+#else
+         for( int i = 0; i != nvectors; ++i )
+            computeSupportHash( storage, i );
+#endif
+         supports_stale = false;
+      }
+
+      for( int i : dirty_vectors )
+      {
+         computeHashes( storage, i );
+         dirty[i] = false;
+      }
+      dirty_vectors.clear();
+   }
+
+   /// hash of the indices of the nonzeros
+   const Vec<std::size_t>&
+   getSupportHashes() const
+   {
+      return supporthash;
+   }
+
+   /// hash of the coefficients scaled such that the first one is 1/golden
+   /// ratio, i.e. parallel vectors with the same support share the hash
+   const Vec<unsigned int>&
+   getCoefficientHashes() const
+   {
+      return coefhash;
+   }
+
+   /// factor that scales the first coefficient of the vector to the constant
+   /// of the coefficient hash
+   static REAL
+   getScale( const REAL& first_coefficient )
+   {
+      return REAL( 2.0 / ( 1.0 + sqrt( 5.0 ) ) ) / first_coefficient;
+   }
+
+   static std::size_t
+   hashSupport( int length, const int* support )
+   {
+      Hasher<std::size_t> hasher( length );
+
+      for( int i = 0; i != length; ++i )
+         hasher.addValue( support[i] );
+
+      return hasher.getHash();
+   }
+
+   static bool
+   equalSupport( int length1, const int* support1, int length2,
+                 const int* support2 )
+   {
+      if( length1 != length2 )
+         return false;
+
+      return std::memcmp( static_cast<const void*>( support1 ),
+                          static_cast<const void*>( support2 ),
+                          length1 * sizeof( int ) ) == 0;
+   }
+
+ private:
+   void
+   computeSupportHash( const SparseStorage<REAL>& storage, int i ) const
+   {
+      const IndexRange& range = storage.getRowRanges()[i];
+      supporthash[i] = hashSupport( range.end - range.start,
+                                    storage.getColumns() + range.start );
+   }
+
+   void
+   computeHashes( const SparseStorage<REAL>& storage, int i ) const
+   {
+      const IndexRange& range = storage.getRowRanges()[i];
+      const REAL* values = storage.getValues() + range.start;
+      const int len = range.end - range.start;
+
+      Hasher<unsigned int> hasher( len );
+      // only makes sense for vectors with at least two entries
+      if( len > 1 )
+      {
+         // the choice of the constant is arbitrary and is used to make cases
+         // where two coefficients that are equal within epsilon get different
+         // values more unlikely by choosing some irrational number
+         REAL scale = getScale( values[0] );
+
+         for( int j = 1; j != len; ++j )
+            hasher.addValue( Num<REAL>::hashCode( values[j] * scale ) );
+      }
+
+      coefhash[i] = hasher.getHash();
+      supporthash[i] =
+          hashSupport( len, storage.getColumns() + range.start );
+   }
+
+   mutable std::mutex mutex;
+   mutable bool built = false;
+   mutable bool supports_stale = false;
+   mutable Vec<std::size_t> supporthash;
+   mutable Vec<unsigned int> coefhash;
+   mutable Vec<uint8_t> dirty;
+   mutable Vec<int> dirty_vectors;
+};
+
+} // namespace papilo
+
+#endif
@@ -0,0 +1,617 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_POSTSOLVE_MAPPED_POSTSOLVE_STORAGE_HPP_
+#define _PAPILO_CORE_POSTSOLVE_MAPPED_POSTSOLVE_STORAGE_HPP_
+
+#include "papilo/core/SparseStorage.hpp"
+#include "papilo/core/postsolve/PostsolveProgram.hpp"
+#include "papilo/core/postsolve/PostsolveStorage.hpp"
+#include "papilo/misc/Vec.hpp"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <type_traits>
+
+namespace papilo
+{
+
+/// sections of the memory mapped postsolve format in file order, every
+/// section starts at an offset that is a multiple of 8
+enum class MappedSection : int
+{
+   kOrigColMapping = 0,
+   kOrigRowMapping = 1,
+   kTypes = 2,
+   kStart = 3,
+   kIndices = 4,
+   kValues = 5,
+   kInstructions = 6,
+   kPayloadIndices = 7,
+   kPayloadValues = 8,
+   kObjective = 9,
+   kLowerBounds = 10,
+   kUpperBounds = 11,
+   kColFlags = 12,
+   kLhs = 13,
+   kRhs = 14,
+   kRowFlags = 15,
+   kRowStart = 16,
+   kRowIndices = 17,
+   kRowValues = 18,
+   /// epsilon, feasibility tolerance, huge value and objective offset
+   kParameters = 19,
+};
+
+constexpr int NUM_MAPPED_SECTIONS = 20;
+
+/// file header of the memory mapped postsolve format. All fields are stored
+/// little-endian, the sizes count elements and not bytes.
+struct MappedPostsolveHeader
+{
+   char magic[8];
+   std::uint32_t version;
+   /// 0x01020304 as written by the host, rejects files of other byte orders
+   std::uint32_t byte_order;
+   std::uint32_t real_size;
+   std::uint32_t instruction_size;
+   std::uint32_t postsolve_type;
+   std::uint32_t ncols_original;
+   std::uint32_t nrows_original;
+   std::uint32_t flags;
+   std::uint64_t offset[NUM_MAPPED_SECTIONS];
+   std::uint64_t size[NUM_MAPPED_SECTIONS];
+};
+
+/// non-owning view on the original problem of a memory mapped storage, the
+/// constraint matrix is stored row-wise in CSR format
+template <typename REAL>
+struct MappedProblem
+{
+   int ncols;
+   int nrows;
+   const REAL* objective;
+   const REAL* lower_bounds;
+   const REAL* upper_bounds;
+   const ColFlags* col_flags;
+   const REAL* lhs;
+   const REAL* rhs;
+   const RowFlags* row_flags;
+   const int* row_start;
+   const int* row_indices;
+   const REAL* row_values;
+};
+
+/// PostsolveStorage in a flat, versioned on-disk layout that is used in place
+/// after mapping the file into memory. Besides the reduction log and the
+/// original problem the file holds the compiled PostsolveProgram, hence a
+/// primal postsolve neither parses nor copies the file and only the pages
+/// that are touched are loaded. Only the primal postsolve works on the
+/// mapping; load() materializes a PostsolveStorage for everything else.
+/// The content of the file is trusted just like a boost archive, open() only
+/// checks the header and the section bounds.
+template <typename REAL>
+class MappedPostsolveStorage
+{
+ public:
+   static constexpr std::uint32_t VERSION = 1;
+   static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+   static constexpr std::uint32_t USE_ABSOLUTE_FEASIBILITY = 1;
+   static constexpr std::uint32_t CALCULATE_BASIS_FOR_DUAL = 2;
+
+   /// writes the storage in the mapped format, returns false if the file
+   /// cannot be written or the host is not little-endian
+   static bool
+   write( const PostsolveStorage<REAL>& storage, const std::string& filename );
+
+   /// maps the file, returns false if it cannot be mapped or does not match
+   /// the format of this version
+   bool
+   open( const std::string& filename );
+
+   void
+   close()
+   {
+      if( file.is_open() )
+         file.close();
+      header = nullptr;
+   }
+
+   bool
+   is_open() const
+   {
+      return header != nullptr;
+   }
+
+   unsigned int
+   getNColsOriginal() const
+   {
+      return header->ncols_original;
+   }
+
+   unsigned int
+   getNRowsOriginal() const
+   {
+      return header->nrows_original;
+   }
+
+   PostsolveType
+   getPostsolveType() const
+   {
+      return static_cast<PostsolveType>( header->postsolve_type );
+   }
+
+   std::size_t
+   getSize( MappedSection section ) const
+   {
+      return header->size[static_cast<int>( section )];
+   }
+
+   const int*
+   getOrigColMapping() const
+   {
+      return getSection<int>( MappedSection::kOrigColMapping );
+   }
+
+   const int*
+   getOrigRowMapping() const
+   {
+      return getSection<int>( MappedSection::kOrigRowMapping );
+   }
+
+   const ReductionType*
+   getTypes() const
+   {
+      return getSection<ReductionType>( MappedSection::kTypes );
+   }
+
+   const int*
+   getStart() const
+   {
+      return getSection<int>( MappedSection::kStart );
+   }
+
+   const int*
+   getIndices() const
+   {
+      return getSection<int>( MappedSection::kIndices );
+   }
+
+   const REAL*
+   getValues() const
+   {
+      return getSection<REAL>( MappedSection::kValues );
+   }
+
+   Num<REAL>
+   getNum() const;
+
+   PostsolveProgramView<REAL>
+   getProgram() const;
+
+   MappedProblem<REAL>
+   getProblem() const;
+
+   /// copies the mapped data into a PostsolveStorage, e.g. for a dual
+   /// postsolve. The names of the original problem are not part of the
+   /// mapped format.
+   PostsolveStorage<REAL>
+   load() const;
+
+ private:
+   boost::iostreams::mapped_file_source file;
+   const MappedPostsolveHeader* header = nullptr;
+
+   static constexpr char MAGIC[8] = { 'P', 'A', 'P', 'I', 'L', 'O', 'P', 'S' };
+
+   template <typename T>
+   const T*
+   getSection( MappedSection section ) const
+   {
+      return reinterpret_cast<const T*>(
+          file.data() + header->offset[static_cast<int>( section )] );
+   }
+
+   static std::size_t
+   getElementSize( MappedSection section );
+
+   static bool
+   isLittleEndian()
+   {
+      const std::uint32_t mark = BYTE_ORDER_MARK;
+      unsigned char first;
+      std::memcpy( &first, &mark, 1 );
+      return first == 0x04;
+   }
+
+   template <typename T>
+   static void
+   writeSection( std::ofstream& out, MappedPostsolveHeader& fileheader,
+                 MappedSection section, const T* data, std::size_t size );
+};
+
+#ifdef PAPILO_USE_EXTERN_TEMPLATES
+extern template class MappedPostsolveStorage<double>;
+#endif
+
+template <typename REAL>
+constexpr char MappedPostsolveStorage<REAL>::MAGIC[8];
+
+template <typename REAL>
+std::size_t
+MappedPostsolveStorage<REAL>::getElementSize( MappedSection section )
+{
+   switch( section )
+   {
+   case MappedSection::kOrigColMapping:
+   case MappedSection::kOrigRowMapping:
+   case MappedSection::kStart:
+   case MappedSection::kIndices:
+   case MappedSection::kPayloadIndices:
+   case MappedSection::kRowStart:
+   case MappedSection::kRowIndices:
+      return sizeof( int );
+   case MappedSection::kTypes:
+      return sizeof( ReductionType );
+   case MappedSection::kInstructions:
+      return sizeof( PostsolveInstruction<REAL> );
+   case MappedSection::kColFlags:
+      return sizeof( ColFlags );
+   case MappedSection::kRowFlags:
+      return sizeof( RowFlags );
+   case MappedSection::kValues:
+   case MappedSection::kPayloadValues:
+   case MappedSection::kObjective:
+   case MappedSection::kLowerBounds:
+   case MappedSection::kUpperBounds:
+   case MappedSection::kLhs:
+   case MappedSection::kRhs:
+   case MappedSection::kRowValues:
+   case MappedSection::kParameters:
+      return sizeof( REAL );
+   }
+   return 0;
+}
+
+template <typename REAL>
+template <typename T>
+void
+MappedPostsolveStorage<REAL>::writeSection( std::ofstream& out,
+                                            MappedPostsolveHeader& fileheader,
+                                            MappedSection section,
+                                            const T* data, std::size_t size )
+{
+   assert( sizeof( T ) == getElementSize( section ) );
+   const char padding[8] = {};
+   std::uint64_t offset = static_cast<std::uint64_t>( out.tellp() );
+   out.write( padding, ( 8 - offset % 8 ) % 8 );
+   offset += ( 8 - offset % 8 ) % 8;
+
+   fileheader.offset[static_cast<int>( section )] = offset;
+   fileheader.size[static_cast<int>( section )] = size;
+   if( size != 0 )
+      out.write( reinterpret_cast<const char*>( data ),
+                 static_cast<std::streamsize>( size * sizeof( T ) ) );
+}
+
+template <typename REAL>
+bool
+MappedPostsolveStorage<REAL>::write( const PostsolveStorage<REAL>& storage,
+                                     const std::string& filename )
+{
+   static_assert( std::is_trivially_copyable<REAL>::value,
+                  "the mapped format stores REAL values as raw bytes" );
+   static_assert( sizeof( ReductionType ) == sizeof( std::int32_t ) &&
+                      sizeof( ColFlags ) == 1 && sizeof( RowFlags ) == 1,
+                  "unexpected size of the stored enums and flags" );
+
+   if( !isLittleEndian() )
+      return false;
+
+   std::ofstream out( filename, std::ios_base::binary | std::ios_base::trunc );
+   if( !out.is_open() )
+      return false;
+
+   const Problem<REAL>& problem = storage.problem;
+   const ConstraintMatrix<REAL>& matrix = problem.getConstraintMatrix();
+   PostsolveProgram<REAL> program( storage );
+
+   // the rows of the original problem are copied without the spare space of
+   // the sparse storage
+   Vec<int> row_start;
+   Vec<int> row_indices;
+   Vec<REAL> row_values;
+   row_start.reserve( problem.getNRows() + 1 );
+   row_indices.reserve( matrix.getNnz() );
+   row_values.reserve( matrix.getNnz() );
+   row_start.push_back( 0 );
+   for( int row = 0; row < problem.getNRows(); ++row )
+   {
+      auto entries = matrix.getRowCoefficients( row );
+      row_indices.insert( row_indices.end(), entries.getIndices(),
+                          entries.getIndices() + entries.getLength() );
+      row_values.insert( row_values.end(), entries.getValues(),
+                         entries.getValues() + entries.getLength() );
+      row_start.push_back( (int)row_indices.size() );
+   }
+
+   const REAL parameters[4] = { storage.num.getEpsilon(),
+                                storage.num.getFeasTol(),
+                                storage.num.getHugeVal(),
+                                problem.getObjective().offset };
+
+   MappedPostsolveHeader fileheader{};
+   std::memcpy( fileheader.magic, MAGIC, sizeof( MAGIC ) );
+   fileheader.version = VERSION;
+   fileheader.byte_order = BYTE_ORDER_MARK;
+   fileheader.real_size = sizeof( REAL );
+   fileheader.instruction_size = sizeof( PostsolveInstruction<REAL> );
+   fileheader.postsolve_type = static_cast<std::uint32_t>( storage.postsolveType );
+   fileheader.ncols_original = storage.nColsOriginal;
+   fileheader.nrows_original = storage.nRowsOriginal;
+   if( storage.num.getUseAbsFeas() )
+      fileheader.flags |= USE_ABSOLUTE_FEASIBILITY;
+   if( storage.presolveOptions.calculate_basis_for_dual )
+      fileheader.flags |= CALCULATE_BASIS_FOR_DUAL;
+
+   // the header is written again once the offsets are known
+   out.write( reinterpret_cast<const char*>( &fileheader ),
+              sizeof( fileheader ) );
+
+   writeSection( out, fileheader, MappedSection::kOrigColMapping,
+                 storage.origcol_mapping.data(),
+                 storage.origcol_mapping.size() );
+   writeSection( out, fileheader, MappedSection::kOrigRowMapping,
+                 storage.origrow_mapping.data(),
+                 storage.origrow_mapping.size() );
+   writeSection( out, fileheader, MappedSection::kTypes, storage.types.data(),
+                 storage.types.size() );
+   writeSection( out, fileheader, MappedSection::kStart, storage.start.data(),
+                 storage.start.size() );
+   writeSection( out, fileheader, MappedSection::kIndices,
+                 storage.indices.data(), storage.indices.size() );
+   writeSection( out, fileheader, MappedSection::kValues,
+                 storage.values.data(), storage.values.size() );
+   writeSection( out, fileheader, MappedSection::kInstructions,
+                 program.instructions.data(), program.instructions.size() );
+   writeSection( out, fileheader, MappedSection::kPayloadIndices,
+                 program.payload_indices.data(),
+                 program.payload_indices.size() );
+   writeSection( out, fileheader, MappedSection::kPayloadValues,
+                 program.payload_values.data(),
+                 program.payload_values.size() );
+   writeSection( out, fileheader, MappedSection::kObjective,
+                 problem.getObjective().coefficients.data(),
+                 problem.getObjective().coefficients.size() );
+   writeSection( out, fileheader, MappedSection::kLowerBounds,
+                 problem.getLowerBounds().data(),
+                 problem.getLowerBounds().size() );
+   writeSection( out, fileheader, MappedSection::kUpperBounds,
+                 problem.getUpperBounds().data(),
+                 problem.getUpperBounds().size() );
+   writeSection( out, fileheader, MappedSection::kColFlags,
+                 problem.getColFlags().data(), problem.getColFlags().size() );
+   writeSection( out, fileheader, MappedSection::kLhs,
+                 matrix.getLeftHandSides().data(),
+                 matrix.getLeftHandSides().size() );
+   writeSection( out, fileheader, MappedSection::kRhs,
+                 matrix.getRightHandSides().data(),
+                 matrix.getRightHandSides().size() );
+   writeSection( out, fileheader, MappedSection::kRowFlags,
+                 problem.getRowFlags().data(), problem.getRowFlags().size() );
+   writeSection( out, fileheader, MappedSection::kRowStart, row_start.data(),
+                 row_start.size() );
+   writeSection( out, fileheader, MappedSection::kRowIndices,
+                 row_indices.data(), row_indices.size() );
+   writeSection( out, fileheader, MappedSection::kRowValues,
+                 row_values.data(), row_values.size() );
+   writeSection( out, fileheader, MappedSection::kParameters, parameters, 4 );
+
+   out.seekp( 0 );
+   out.write( reinterpret_cast<const char*>( &fileheader ),
+              sizeof( fileheader ) );
+   out.close();
+   return !out.fail();
+}
+
+template <typename REAL>
+bool
+MappedPostsolveStorage<REAL>::open( const std::string& filename )
+{
+   static_assert( std::is_trivially_copyable<REAL>::value,
+                  "the mapped format stores REAL values as raw bytes" );
+
+   close();
+   if( !isLittleEndian() )
+      return false;
+
+   try
+   {
+      file.open( filename );
+   }
+   catch( const std::exception& )
+   {
+      return false;
+   }
+   if( !file.is_open() || file.size() < sizeof( MappedPostsolveHeader ) )
+   {
+      close();
+      return false;
+   }
+
+   const MappedPostsolveHeader* fileheader =
+       reinterpret_cast<const MappedPostsolveHeader*>( file.data() );
+   bool valid = std::memcmp( fileheader->magic, MAGIC, sizeof( MAGIC ) ) == 0 &&
+                fileheader->version == VERSION &&
+                fileheader->byte_order == BYTE_ORDER_MARK &&
+                fileheader->real_size == sizeof( REAL ) &&
+                fileheader->instruction_size ==
+                    sizeof( PostsolveInstruction<REAL> );
+
+   for( int i = 0; valid && i < NUM_MAPPED_SECTIONS; ++i )
+   {
+      std::uint64_t offset = fileheader->offset[i];
+      std::uint64_t size = fileheader->size[i];
+      std::size_t element_size =
+          getElementSize( static_cast<MappedSection>( i ) );
+      valid = offset % 8 == 0 && offset <= file.size() &&
+              size <= ( file.size() - offset ) / element_size;
+   }
+   if( !valid )
+   {
+      close();
+      return false;
+   }
+   header = fileheader;
+
+   // the arrays must match the dimensions of the header
+   const std::size_t ncols = getNColsOriginal();
+   const std::size_t nrows = getNRowsOriginal();
+   valid = getSize( MappedSection::kStart ) ==
+               getSize( MappedSection::kTypes ) + 1 &&
+           getSize( MappedSection::kIndices ) ==
+               getSize( MappedSection::kValues ) &&
+           getSize( MappedSection::kOrigColMapping ) <= ncols &&
+           getSize( MappedSection::kOrigRowMapping ) <= nrows &&
+           getSize( MappedSection::kPayloadIndices ) ==
+               getSize( MappedSection::kPayloadValues ) &&
+           getSize( MappedSection::kObjective ) == ncols &&
+           getSize( MappedSection::kLowerBounds ) == ncols &&
+           getSize( MappedSection::kUpperBounds ) == ncols &&
+           getSize( MappedSection::kColFlags ) == ncols &&
+           getSize( MappedSection::kLhs ) == nrows &&
+           getSize( MappedSection::kRhs ) == nrows &&
+           getSize( MappedSection::kRowFlags ) == nrows &&
+           getSize( MappedSection::kRowStart ) == nrows + 1 &&
+           getSize( MappedSection::kRowIndices ) ==
+               getSize( MappedSection::kRowValues ) &&
+           getSize( MappedSection::kParameters ) == 4;
+   if( !valid )
+   {
+      close();
+      return false;
+   }
+   return true;
+}
+
+template <typename REAL>
+Num<REAL>
+MappedPostsolveStorage<REAL>::getNum() const
+{
+   const REAL* parameters = getSection<REAL>( MappedSection::kParameters );
+   Num<REAL> num;
+   num.setEpsilon( parameters[0] );
+   num.setFeasTol( parameters[1] );
+   num.setHugeVal( parameters[2] );
+   num.setUseAbsFeas( header->flags & USE_ABSOLUTE_FEASIBILITY );
+   return num;
+}
+
+template <typename REAL>
+PostsolveProgramView<REAL>
+MappedPostsolveStorage<REAL>::getProgram() const
+{
+   return PostsolveProgramView<REAL>{
+       getNColsOriginal(),
+       (int)getSize( MappedSection::kOrigColMapping ),
+       getOrigColMapping(),
+       (int)getSize( MappedSection::kInstructions ),
+       getSection<PostsolveInstruction<REAL>>( MappedSection::kInstructions ),
+       getSection<int>( MappedSection::kPayloadIndices ),
+       getSection<REAL>( MappedSection::kPayloadValues ) };
+}
+
+template <typename REAL>
+MappedProblem<REAL>
+MappedPostsolveStorage<REAL>::getProblem() const
+{
+   return MappedProblem<REAL>{
+       (int)getNColsOriginal(),
+       (int)getNRowsOriginal(),
+       getSection<REAL>( MappedSection::kObjective ),
+       getSection<REAL>( MappedSection::kLowerBounds ),
+       getSection<REAL>( MappedSection::kUpperBounds ),
+       getSection<ColFlags>( MappedSection::kColFlags ),
+       getSection<REAL>( MappedSection::kLhs ),
+       getSection<REAL>( MappedSection::kRhs ),
+       getSection<RowFlags>( MappedSection::kRowFlags ),
+       getSection<int>( MappedSection::kRowStart ),
+       getSection<int>( MappedSection::kRowIndices ),
+       getSection<REAL>( MappedSection::kRowValues ) };
+}
+
+template <typename REAL>
+PostsolveStorage<REAL>
+MappedPostsolveStorage<REAL>::load() const
+{
+   assert( is_open() );
+   const MappedProblem<REAL> mapped = getProblem();
+
+   PostsolveStorage<REAL> storage;
+   storage.nColsOriginal = getNColsOriginal();
+   storage.nRowsOriginal = getNRowsOriginal();
+   storage.postsolveType = getPostsolveType();
+   storage.num = getNum();
+   storage.presolveOptions.calculate_basis_for_dual =
+       header->flags & CALCULATE_BASIS_FOR_DUAL;
+
+   auto copy = []( auto& vector, const auto* data, std::size_t size )
+   { vector.assign( data, data + size ); };
+   copy( storage.origcol_mapping, getOrigColMapping(),
+         getSize( MappedSection::kOrigColMapping ) );
+   copy( storage.origrow_mapping, getOrigRowMapping(),
+         getSize( MappedSection::kOrigRowMapping ) );
+   copy( storage.types, getTypes(), getSize( MappedSection::kTypes ) );
+   copy( storage.start, getStart(), getSize( MappedSection::kStart ) );
+   copy( storage.indices, getIndices(), getSize( MappedSection::kIndices ) );
+   copy( storage.values, getValues(), getSize( MappedSection::kValues ) );
+
+   Vec<Triplet<REAL>> entries;
+   entries.reserve( getSize( MappedSection::kRowIndices ) );
+   for( int row = 0; row < mapped.nrows; ++row )
+      for( int j = mapped.row_start[row]; j < mapped.row_start[row + 1]; ++j )
+         entries.emplace_back( row, mapped.row_indices[j],
+                               mapped.row_values[j] );
+
+   Problem<REAL>& problem = storage.problem;
+   problem.setObjective(
+       Vec<REAL>( mapped.objective, mapped.objective + mapped.ncols ),
+       getSection<REAL>( MappedSection::kParameters )[3] );
+   problem.setVariableDomains(
+       Vec<REAL>( mapped.lower_bounds, mapped.lower_bounds + mapped.ncols ),
+       Vec<REAL>( mapped.upper_bounds, mapped.upper_bounds + mapped.ncols ),
+       Vec<ColFlags>( mapped.col_flags, mapped.col_flags + mapped.ncols ) );
+   problem.setConstraintMatrix(
+       SparseStorage<REAL>( std::move( entries ), mapped.nrows, mapped.ncols ),
+       Vec<REAL>( mapped.lhs, mapped.lhs + mapped.nrows ),
+       Vec<REAL>( mapped.rhs, mapped.rhs + mapped.nrows ),
+       Vec<RowFlags>( mapped.row_flags, mapped.row_flags + mapped.nrows ) );
+
+   return storage;
+}
+
+} // namespace papilo
+
+#endif
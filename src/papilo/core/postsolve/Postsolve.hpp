@@ -29,6 +29,8 @@
 #include "papilo/core/Problem.hpp"
 #include "papilo/core/ProblemUpdate.hpp"
 #include "papilo/core/postsolve/BoundStorage.hpp"
+#include "papilo/core/postsolve/MappedPostsolveStorage.hpp"
+#include "papilo/core/postsolve/PostsolveProgram.hpp"
 #include "papilo/core/postsolve/PostsolveStatus.hpp"
 #include "papilo/core/postsolve/PostsolveStorage.hpp"
 #include "papilo/core/postsolve/PostsolveType.hpp"
@@ -70,6 +72,7 @@ class Postsolve
    static constexpr int IS_INTEGRAL = static_cast<int>( ColFlag::kIntegral );
    static constexpr int IS_LBINF = static_cast<int>( ColFlag::kLbInf );
    static constexpr int IS_UBINF = static_cast<int>( ColFlag::kUbInf );
+   static constexpr int BATCH_BLOCK_SIZE = 64;
 
  public:
    Postsolve( const Message msg, const Num<REAL> n )
@@ -83,7 +86,72 @@ class Postsolve
          Solution<REAL>& originalSolution,
          const PostsolveStorage<REAL>& postsolveStorage, bool is_optimal = true ) const;
 
+   /// postsolves a primal solution by running the compiled program of the
+   /// storage instead of decoding the reduction log. Primal-dual solutions are
+   /// passed on to the log based undo.
+   PostsolveStatus
+   undo( const Solution<REAL>& reducedSolution,
+         Solution<REAL>& originalSolution,
+         const PostsolveStorage<REAL>& postsolveStorage,
+         const PostsolveProgram<REAL>& program ) const;
+
+   /// postsolves a primal solution in place on a memory mapped storage, i.e.
+   /// neither the reduction log nor the original problem are copied.
+   /// Primal-dual solutions need the full reduction log, they are postsolved
+   /// on a PostsolveStorage that is loaded from the mapping for every call.
+   PostsolveStatus
+   undo( const Solution<REAL>& reducedSolution,
+         Solution<REAL>& originalSolution,
+         const MappedPostsolveStorage<REAL>& postsolveStorage ) const;
+
+   /// postsolves the primal part of nsolutions reduced solutions with a single
+   /// replay of the reduction log. The solutions are stored column-major, i.e.
+   /// the value of column j in solution s is found at j * nsolutions + s, both
+   /// in reducedSolutions (reduced columns) and in originalSolutions (original
+   /// columns). If status is not null, it receives the validation result of
+   /// every solution. Returns kFailed if at least one solution failed.
+   PostsolveStatus
+   undo_batch( const REAL* reducedSolutions, int nsolutions,
+               REAL* originalSolutions,
+               const PostsolveStorage<REAL>& postsolveStorage,
+               PostsolveStatus* status = nullptr ) const;
+
  private:
+   void
+   undo_batch_range( const REAL* reducedSolutions, int nsolutions,
+                     REAL* originalSolutions,
+                     const PostsolveStorage<REAL>& postsolveStorage,
+                     int begin, int end, PostsolveStatus* status,
+                     Vec<REAL>& block, Vec<StableSum<REAL>>& sums ) const;
+
+   void
+   apply_substituted_column_to_batch( REAL* batch, std::size_t stride,
+                                      int nbatch, int col, REAL side,
+                                      const Vec<int>& indices,
+                                      const Vec<REAL>& values, int first,
+                                      int last,
+                                      Vec<StableSum<REAL>>& sums ) const;
+
+   void
+   apply_fix_infinity_variable_to_batch( REAL* batch, std::size_t stride,
+                                         int nbatch, const Vec<int>& indices,
+                                         const Vec<REAL>& values, int first,
+                                         const Problem<REAL>& problem,
+                                         Vec<StableSum<REAL>>& sums ) const;
+
+   void
+   calculate_parallel_col_values( const int* indices, const REAL* values,
+                                  int first, REAL solval, REAL& col1val,
+                                  REAL& col2val ) const;
+
+   void
+   run_program( const Vec<REAL>& reducedSolution, Vec<REAL>& primal,
+                const PostsolveProgramView<REAL>& program ) const;
+
+   bool
+   check_mapped_primal_solution( const Vec<REAL>& primal,
+                                 const MappedProblem<REAL>& problem ) const;
+
    REAL
    calculate_row_value_for_fixed_infinity_variable(
        REAL lhs, REAL rhs, int rowLength, int column, const int* row_indices,
@@ -107,8 +175,8 @@ class Postsolve
 
    int
    apply_fix_infinity_variable_in_original_solution(
-       Solution<REAL>& originalSolution, Vec<int>& indices, Vec<REAL>& values,
-       int first, const Problem<REAL>& problem,
+       Solution<REAL>& originalSolution, const Vec<int>& indices,
+       const Vec<REAL>& values, int first, const Problem<REAL>& problem,
        BoundStorage<REAL>& stored_bounds ) const;
 
    void
@@ -189,13 +257,13 @@ Postsolve<REAL>::undo( const Solution<REAL>& reducedSolution,
    copy_from_reduced_to_original( reducedSolution, originalSolution,
                                   postsolveStorage );
 
-   auto types = postsolveStorage.types;
-   auto start = postsolveStorage.start;
-   auto indices = postsolveStorage.indices;
-   auto values = postsolveStorage.values;
-   auto origcol_mapping = postsolveStorage.origcol_mapping;
-   auto origrow_mapping = postsolveStorage.origrow_mapping;
-   auto problem = postsolveStorage.problem;
+   // the storage is only read during postsolve, hence work on references
+   // instead of copying the reduction log and the original problem
+   const Vec<ReductionType>& types = postsolveStorage.types;
+   const Vec<int>& start = postsolveStorage.start;
+   const Vec<int>& indices = postsolveStorage.indices;
+   const Vec<REAL>& values = postsolveStorage.values;
+   const Problem<REAL>& problem = postsolveStorage.problem;
 
    // Will be used during dual postsolve for fast access to bound values.
    // TODO: rows bounds are currently not updated during
@@ -432,6 +500,418 @@ Postsolve<REAL>::undo( const Solution<REAL>& reducedSolution,
    return status;
 }
 
+template <typename REAL>
+PostsolveStatus
+Postsolve<REAL>::undo( const Solution<REAL>& reducedSolution,
+                       Solution<REAL>& originalSolution,
+                       const PostsolveStorage<REAL>& postsolveStorage,
+                       const PostsolveProgram<REAL>& program ) const
+{
+   if( reducedSolution.type == SolutionType::kPrimalDual )
+      return undo( reducedSolution, originalSolution, postsolveStorage );
+
+   assert( program.nColsOriginal == postsolveStorage.nColsOriginal );
+   run_program( reducedSolution.primal, originalSolution.primal,
+                program.getView() );
+
+   PrimalDualSolValidation<REAL> validation{ message, num };
+   PostsolveStatus status = validation.verifySolutionAndUpdateSlack(
+       originalSolution, postsolveStorage.problem );
+   if( status == PostsolveStatus::kFailed )
+      message.error( "Postsolving solution failed. Please use debug mode to "
+                     "obtain more information." );
+   return status;
+}
+
+template <typename REAL>
+PostsolveStatus
+Postsolve<REAL>::undo( const Solution<REAL>& reducedSolution,
+                       Solution<REAL>& originalSolution,
+                       const MappedPostsolveStorage<REAL>& postsolveStorage ) const
+{
+   if( reducedSolution.type == SolutionType::kPrimalDual )
+      return undo( reducedSolution, originalSolution,
+                   postsolveStorage.load() );
+
+   run_program( reducedSolution.primal, originalSolution.primal,
+                postsolveStorage.getProgram() );
+
+   if( check_mapped_primal_solution( originalSolution.primal,
+                                     postsolveStorage.getProblem() ) )
+   {
+      message.info( "Primal feasibility check FAILED.\n" );
+      message.error( "Postsolving solution failed. Please use debug mode to "
+                     "obtain more information." );
+      return PostsolveStatus::kFailed;
+   }
+   return PostsolveStatus::kOk;
+}
+
+template <typename REAL>
+void
+Postsolve<REAL>::run_program( const Vec<REAL>& reducedSolution,
+                              Vec<REAL>& primal,
+                              const PostsolveProgramView<REAL>& program ) const
+{
+   assert( (int)reducedSolution.size() == program.nColsReduced );
+
+   primal.clear();
+   primal.resize( program.nColsOriginal );
+   for( int k = 0; k < program.nColsReduced; ++k )
+      primal[program.origcol_mapping[k]] = reducedSolution[k];
+
+   const int* indices = program.payload_indices;
+   const REAL* values = program.payload_values;
+   for( int i = 0; i < program.ninstructions; ++i )
+   {
+      const PostsolveInstruction<REAL>& instruction = program.instructions[i];
+      switch( instruction.op )
+      {
+      case PostsolveOp::kFixCol:
+         primal[instruction.col] = instruction.value;
+         break;
+      case PostsolveOp::kSubstituteCol:
+      {
+         StableSum<REAL> sumcols;
+         for( int j = instruction.first; j < instruction.last; ++j )
+            sumcols.add( primal[indices[j]] * values[j] );
+         sumcols.add( -instruction.value );
+         if( num.isEq( sumcols.get(), 0 ) )
+            primal[instruction.col] = 0;
+         else
+            primal[instruction.col] = ( -sumcols.get() ) / instruction.coef;
+         break;
+      }
+      case PostsolveOp::kFixInfCol:
+      {
+         bool isNegativeInfinity =
+             instruction.flags & PostsolveProgram<REAL>::NEGATIVE_INFINITY;
+         REAL solution = instruction.value;
+         // every row starts with (number of entries, side) and (-1, coefficient
+         // of the column)
+         int row = instruction.first;
+         while( row < instruction.last )
+         {
+            int length = indices[row];
+            StableSum<REAL> stableSum;
+            for( int l = row + 2; l < row + 2 + length; ++l )
+               stableSum.add( -values[l] * primal[indices[l]] );
+            stableSum.add( values[row] );
+            REAL newValue = stableSum.get() / values[row + 1];
+            if( isNegativeInfinity ? num.isLT( newValue, solution )
+                                   : num.isGT( newValue, solution ) )
+               solution = newValue;
+            row += 2 + length;
+         }
+         if( instruction.flags & PostsolveProgram<REAL>::INTEGRAL )
+            solution = isNegativeInfinity ? num.epsFloor( solution )
+                                          : num.epsCeil( solution );
+         primal[instruction.col] = solution;
+         break;
+      }
+      case PostsolveOp::kParallelCol:
+         calculate_parallel_col_values( indices, values, instruction.first,
+                                        primal[instruction.col],
+                                        primal[instruction.arg],
+                                        primal[instruction.col] );
+         break;
+      }
+   }
+}
+
+template <typename REAL>
+bool
+Postsolve<REAL>::check_mapped_primal_solution(
+    const Vec<REAL>& primal, const MappedProblem<REAL>& problem ) const
+{
+   // same checks as PrimalDualSolValidation, on the arrays of the mapping
+   if( (int)primal.size() != problem.ncols )
+      return true;
+
+   for( int col = 0; col < problem.ncols; ++col )
+   {
+      const ColFlags& flags = problem.col_flags[col];
+      if( flags.test( ColFlag::kInactive ) )
+         continue;
+      if( ( !flags.test( ColFlag::kLbInf ) &&
+            num.isFeasLT( primal[col], problem.lower_bounds[col] ) ) ||
+          ( !flags.test( ColFlag::kUbInf ) &&
+            num.isFeasGT( primal[col], problem.upper_bounds[col] ) ) )
+      {
+         message.info( "Column {:<3} violates its bounds.\n", col );
+         return true;
+      }
+   }
+
+   for( int row = 0; row < problem.nrows; ++row )
+   {
+      const RowFlags& flags = problem.row_flags[row];
+      if( flags.test( RowFlag::kRedundant ) )
+         continue;
+
+      REAL activity = 0;
+      for( int j = problem.row_start[row]; j < problem.row_start[row + 1]; ++j )
+      {
+         int col = problem.row_indices[j];
+         if( !problem.col_flags[col].test( ColFlag::kInactive ) )
+            activity += problem.row_values[j] * primal[col];
+      }
+      if( ( !flags.test( RowFlag::kLhsInf ) &&
+            num.isFeasLT( activity, problem.lhs[row] ) ) ||
+          ( !flags.test( RowFlag::kRhsInf ) &&
+            num.isFeasGT( activity, problem.rhs[row] ) ) )
+      {
+         message.info( "Row {:<3} violates row bounds.\n", row );
+         return true;
+      }
+   }
+   return false;
+}
+
+template <typename REAL>
+PostsolveStatus
+Postsolve<REAL>::undo_batch( const REAL* reducedSolutions, int nsolutions,
+                             REAL* originalSolutions,
+                             const PostsolveStorage<REAL>& postsolveStorage,
+                             PostsolveStatus* status ) const
+{
+   Vec<PostsolveStatus> solution_status;
+   if( status == nullptr )
+   {
+      solution_status.resize( nsolutions );
+      status = solution_status.data();
+   }
+
+   // the solutions are independent of each other and the storage is only
+   // read, hence blocks of solutions can be postsolved concurrently
+   const int nblocks =
+       ( nsolutions + BATCH_BLOCK_SIZE - 1 ) / BATCH_BLOCK_SIZE;
+   auto undo_blocks = [&]( int first_block, int last_block )
+   {
+      Vec<REAL> block_solutions;
+      Vec<StableSum<REAL>> sums;
+      for( int block = first_block; block < last_block; ++block )
+         undo_batch_range(
+             reducedSolutions, nsolutions, originalSolutions, postsolveStorage,
+             block * BATCH_BLOCK_SIZE,
+             std::min( nsolutions, ( block + 1 ) * BATCH_BLOCK_SIZE ), status,
+             block_solutions, sums );
+   };
+#ifdef PAPILO_TBB
+   tbb::parallel_for( tbb::blocked_range<int>( 0, nblocks ),
+                      [&]( const tbb::blocked_range<int>& r )
+                      { undo_blocks( r.begin(), r.end() ); } );
+#else
+   undo_blocks( 0, nblocks );
+#endif
+
+   for( int s = 0; s < nsolutions; ++s )
+   {
+      if( status[s] == PostsolveStatus::kFailed )
+      {
+         message.error( "Postsolving solution {} of the batch failed. Please "
+                        "use debug mode to obtain more information.",
+                        s );
+         return PostsolveStatus::kFailed;
+      }
+   }
+   return PostsolveStatus::kOk;
+}
+
+template <typename REAL>
+void
+Postsolve<REAL>::undo_batch_range(
+    const REAL* reducedSolutions, int nsolutions, REAL* originalSolutions,
+    const PostsolveStorage<REAL>& postsolveStorage, int begin, int end,
+    PostsolveStatus* status, Vec<REAL>& block,
+    Vec<StableSum<REAL>>& sums ) const
+{
+   const Vec<ReductionType>& types = postsolveStorage.types;
+   const Vec<int>& start = postsolveStorage.start;
+   const Vec<int>& indices = postsolveStorage.indices;
+   const Vec<REAL>& values = postsolveStorage.values;
+   const Problem<REAL>& problem = postsolveStorage.problem;
+   const Vec<int>& origcol_mapping = postsolveStorage.origcol_mapping;
+   const int ncols = (int)postsolveStorage.nColsOriginal;
+
+   // the block is postsolved in a contiguous copy, i.e. the values of column
+   // col for the solutions [begin, end) are found at batch[col * stride], ...,
+   // batch[col * stride + nbatch - 1]. This keeps the pages touched by the
+   // replay independent of the total number of solutions.
+   const int nbatch = end - begin;
+   const std::size_t stride = nbatch;
+   block.assign( ncols * stride, REAL{ 0 } );
+   sums.resize( nbatch );
+   REAL* batch = block.data();
+
+   for( int k = 0; k < (int)origcol_mapping.size(); ++k )
+      std::copy_n( reducedSolutions + (std::size_t)k * nsolutions + begin,
+                   nbatch, batch + origcol_mapping[k] * stride );
+
+   // only the reductions that change the primal solution are replayed, the
+   // remaining ones carry dual information only
+   for( int i = (int)types.size() - 1; i >= 0; --i )
+   {
+      int first = start[i];
+      int last = start[i + 1];
+
+      switch( types[i] )
+      {
+      case ReductionType::kFixedCol:
+         std::fill_n( batch + indices[first] * stride, nbatch, values[first] );
+         break;
+      case ReductionType::kFixedInfCol:
+         apply_fix_infinity_variable_to_batch( batch, stride, nbatch, indices,
+                                               values, first, problem, sums );
+         break;
+      case ReductionType::kSubstitutedCol:
+         apply_substituted_column_to_batch( batch, stride, nbatch,
+                                            indices[first], values[first],
+                                            indices, values, first + 1, last,
+                                            sums );
+         break;
+      case ReductionType::kSubstitutedColWithDual:
+      {
+         int row_length = (int)values[first];
+         apply_substituted_column_to_batch(
+             batch, stride, nbatch, indices[first + 3 + row_length],
+             values[first + 1], indices, values, first + 3,
+             first + 3 + row_length, sums );
+         break;
+      }
+      case ReductionType::kParallelCol:
+      {
+         assert( last - first == 5 );
+         REAL* col1 = batch + indices[first] * stride;
+         REAL* col2 = batch + indices[first + 2] * stride;
+         for( int s = 0; s < nbatch; ++s )
+            calculate_parallel_col_values( indices.data(), values.data(),
+                                           first, col2[s], col1[s], col2[s] );
+         break;
+      }
+      case ReductionType::kColumnDualValue:
+      case ReductionType::kRowDualValue:
+      case ReductionType::kVarBoundChange:
+      case ReductionType::kRowBoundChangeForcedByRow:
+      case ReductionType::kRowBoundChange:
+      case ReductionType::kReducedBoundsCost:
+      case ReductionType::kCoefficientChange:
+      case ReductionType::kRedundantRow:
+      case ReductionType::kReasonForRowBoundChangeForcedByRow:
+      case ReductionType::kSaveRow:
+         break;
+      }
+   }
+
+   PrimalDualSolValidation<REAL> validation{ message, num };
+   validation.verifyPrimalSolutionBatch( batch, stride, nbatch, problem,
+                                         status + begin );
+
+   for( int col = 0; col < ncols; ++col )
+      std::copy_n( batch + col * stride, nbatch,
+                   originalSolutions + (std::size_t)col * nsolutions + begin );
+}
+
+template <typename REAL>
+void
+Postsolve<REAL>::apply_substituted_column_to_batch(
+    REAL* batch, std::size_t stride, int nbatch, int col, REAL side,
+    const Vec<int>& indices, const Vec<REAL>& values, int first, int last,
+    Vec<StableSum<REAL>>& sums ) const
+{
+   // same computation as for a single solution, but the entries of the
+   // equation are traversed once for all solutions of the batch
+   REAL colCoef = 0.0;
+   std::fill( sums.begin(), sums.begin() + nbatch, StableSum<REAL>() );
+   for( int j = first; j < last; ++j )
+   {
+      if( indices[j] == col )
+      {
+         colCoef = values[j];
+         continue;
+      }
+      const REAL* x = batch + indices[j] * stride;
+      const REAL& coef = values[j];
+      for( int s = 0; s < nbatch; ++s )
+         sums[s].add( x[s] * coef );
+   }
+   assert( colCoef != 0.0 );
+
+   REAL* x = batch + col * stride;
+   for( int s = 0; s < nbatch; ++s )
+   {
+      sums[s].add( -side );
+      if( num.isEq( sums[s].get(), 0 ) )
+         x[s] = 0;
+      else
+         x[s] = ( -sums[s].get() ) / colCoef;
+   }
+}
+
+template <typename REAL>
+void
+Postsolve<REAL>::apply_fix_infinity_variable_to_batch(
+    REAL* batch, std::size_t stride, int nbatch, const Vec<int>& indices,
+    const Vec<REAL>& values, int first, const Problem<REAL>& problem,
+    Vec<StableSum<REAL>>& sums ) const
+{
+   int col = indices[first];
+   int number_rows = indices[first + 1];
+   int bound_is_infinity = indices[first + 2];
+   bool isNegativeInfinity = values[first] < 0;
+   REAL* x = batch + col * stride;
+
+   if( number_rows == 0 && bound_is_infinity )
+      std::fill_n( x, nbatch, REAL{ 0 } );
+   else
+      std::fill_n( x, nbatch, values[first + 2] );
+
+   int current_counter = first + 3;
+   for( int row_counter = 0; row_counter < number_rows; ++row_counter )
+   {
+      int length = (int)values[current_counter];
+      const REAL& lhs = values[current_counter + 1];
+      const REAL& rhs = values[current_counter + 2];
+      const REAL* coefficients = &values[current_counter + 3];
+      const int* col_indices = &indices[current_counter + 3];
+
+      REAL coeff_of_column_in_row = 0;
+      std::fill( sums.begin(), sums.begin() + nbatch, StableSum<REAL>() );
+      for( int l = 0; l < length; ++l )
+      {
+         if( col_indices[l] == col )
+         {
+            coeff_of_column_in_row = coefficients[l];
+            continue;
+         }
+         const REAL* y = batch + col_indices[l] * stride;
+         const REAL& coef = coefficients[l];
+         for( int s = 0; s < nbatch; ++s )
+            sums[s].add( -coef * y[s] );
+      }
+      assert( coeff_of_column_in_row != 0 );
+
+      const REAL& side = ( coeff_of_column_in_row > 0 ) == isNegativeInfinity
+                             ? rhs
+                             : lhs;
+      for( int s = 0; s < nbatch; ++s )
+      {
+         sums[s].add( side );
+         REAL newValue = sums[s].get() / coeff_of_column_in_row;
+         if( isNegativeInfinity ? num.isLT( newValue, x[s] )
+                                : num.isGT( newValue, x[s] ) )
+            x[s] = newValue;
+      }
+      current_counter += 3 + length;
+   }
+
+   if( problem.getColFlags()[col].test( ColFlag::kIntegral ) )
+   {
+      for( int s = 0; s < nbatch; ++s )
+         x[s] = isNegativeInfinity ? num.epsFloor( x[s] ) : num.epsCeil( x[s] );
+   }
+}
+
 template <typename REAL>
 bool
 Postsolve<REAL>::skip_if_row_bound_belongs_to_substitution(
@@ -560,8 +1040,8 @@ Postsolve<REAL>::apply_fix_var_in_original_solution(
 template <typename REAL>
 int
 Postsolve<REAL>::apply_fix_infinity_variable_in_original_solution(
-    Solution<REAL>& originalSolution, Vec<int>& indices, Vec<REAL>& values,
-    int first, const Problem<REAL>& problem,
+    Solution<REAL>& originalSolution, const Vec<int>& indices,
+    const Vec<REAL>& values, int first, const Problem<REAL>& problem,
     BoundStorage<REAL>& stored_bounds ) const
 {
    // calculate the feasible (minimal) value for the infinity variable
@@ -574,8 +1054,8 @@ Postsolve<REAL>::apply_fix_infinity_variable_in_original_solution(
    int current_counter = first + 3;
 
    bool isNegativeInfinity = values[first] < 0;
-   int* row_indices = new int[number_rows];
-   REAL* col_coefficents = new REAL[number_rows];
+   Vec<int> row_indices( number_rows );
+   Vec<REAL> col_coefficents( number_rows );
 
    if( number_rows == 0 && bound_is_infinity )
       solution = 0;
@@ -1112,28 +1592,23 @@ Postsolve<REAL>::apply_var_bound_change_forced_by_column_in_original_solution(
 
 template <typename REAL>
 void
-Postsolve<REAL>::apply_parallel_col_to_original_solution(
-    Solution<REAL>& originalSolution, const Vec<int>& indices,
-    const Vec<REAL>& values, int first, int last,
-    BoundStorage<REAL>& stored ) const
+Postsolve<REAL>::calculate_parallel_col_values( const int* indices,
+                                               const REAL* values, int first,
+                                               REAL solval, REAL& col1val,
+                                               REAL& col2val ) const
 {
    // calculate values of the parallel cols such that at least one is at its
    // bounds
-   assert( last - first == 5 );
-
-   int col1 = indices[first];
    int col1boundFlags = indices[first + 1];
-   int col2 = indices[first + 2];
    int col2boundFlags = indices[first + 3];
    const REAL& col1lb = values[first];
    const REAL& col1ub = values[first + 1];
    const REAL& col2lb = values[first + 2];
    const REAL& col2ub = values[first + 3];
    const REAL& col2scale = values[first + 4];
-   const REAL& solval = originalSolution.primal[col2];
 
-   REAL col1val = 0;
-   REAL col2val = 0;
+   col1val = 0;
+   col2val = 0;
 
    if( col1boundFlags & IS_INTEGRAL )
    {
@@ -1229,6 +1704,32 @@ Postsolve<REAL>::apply_parallel_col_to_original_solution(
    assert( ( col2boundFlags & IS_UBINF ) || num.isFeasLE( col2val, col2ub ) );
    assert( !( col2boundFlags & IS_INTEGRAL ) || num.isFeasIntegral( col2val ) );
    assert( num.isFeasEq( solval, col2scale * col1val + col2val ) );
+}
+
+template <typename REAL>
+void
+Postsolve<REAL>::apply_parallel_col_to_original_solution(
+    Solution<REAL>& originalSolution, const Vec<int>& indices,
+    const Vec<REAL>& values, int first, int last,
+    BoundStorage<REAL>& stored ) const
+{
+   assert( last - first == 5 );
+
+   int col1 = indices[first];
+   int col1boundFlags = indices[first + 1];
+   int col2 = indices[first + 2];
+   int col2boundFlags = indices[first + 3];
+   const REAL& col1lb = values[first];
+   const REAL& col1ub = values[first + 1];
+   const REAL& col2lb = values[first + 2];
+   const REAL& col2ub = values[first + 3];
+   const REAL& col2scale = values[first + 4];
+
+   REAL col1val;
+   REAL col2val;
+   calculate_parallel_col_values( indices.data(), values.data(), first,
+                                  originalSolution.primal[col2], col1val,
+                                  col2val );
 
    originalSolution.primal[col1] = col1val;
    originalSolution.primal[col2] = col2val;
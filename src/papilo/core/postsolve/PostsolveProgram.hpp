@@ -0,0 +1,324 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_CORE_POSTSOLVE_PROGRAM_HPP_
+#define _PAPILO_CORE_POSTSOLVE_PROGRAM_HPP_
+
+#include "papilo/core/postsolve/PostsolveStorage.hpp"
+#include "papilo/core/postsolve/ReductionType.hpp"
+#include "papilo/misc/Vec.hpp"
+
+#include <cstdint>
+
+namespace papilo
+{
+
+/// operations of a compiled postsolve program; every operation computes the
+/// primal value of one (two for kParallelCol) original column
+enum class PostsolveOp : std::uint8_t
+{
+   /// col = value
+   kFixCol = 0,
+
+   /// col = ( value - sum of the payload entries ) / coef
+   kSubstituteCol = 1,
+
+   /// col = tightest value over the payload rows, starting from value
+   kFixInfCol = 2,
+
+   /// split the value of col over col and arg, the payload holds the
+   /// bounds, flags and scale exactly as stored in the reduction log
+   kParallelCol = 3,
+};
+
+/// fixed-size record of a compiled postsolve program, the variable length
+/// data lives in the payload arrays of the program in [first, last)
+template <typename REAL>
+struct PostsolveInstruction
+{
+   PostsolveOp op;
+   /// kFixInfCol: 1 if the column was fixed to negative infinity and 2 if the
+   /// column is integral (bitwise or)
+   std::uint8_t flags;
+   int col;
+   /// kParallelCol: the column merged into col
+   int arg;
+   int first;
+   int last;
+   REAL value;
+   REAL coef;
+
+   template <typename Archive>
+   void
+   serialize( Archive& ar, const unsigned int version )
+   {
+      ar& op;
+      ar& flags;
+      ar& col;
+      ar& arg;
+      ar& first;
+      ar& last;
+      ar& value;
+      ar& coef;
+   }
+};
+
+/// non-owning view on the arrays of a compiled program, either taken from a
+/// PostsolveProgram or from a memory mapped postsolve storage
+template <typename REAL>
+struct PostsolveProgramView
+{
+   unsigned int nColsOriginal;
+   int nColsReduced;
+   const int* origcol_mapping;
+   int ninstructions;
+   const PostsolveInstruction<REAL>* instructions;
+   const int* payload_indices;
+   const REAL* payload_values;
+};
+
+/// primal part of the reduction log of a PostsolveStorage, lowered once into
+/// a flat array of typed instructions in execution order. The reductions
+/// that only carry dual information are dropped, hence the program can only
+/// postsolve primal solutions. It does not reference the storage and can be
+/// cached (or serialized) together with the presolved model.
+template <typename REAL>
+class PostsolveProgram
+{
+ public:
+   static constexpr std::uint8_t NEGATIVE_INFINITY = 1;
+   static constexpr std::uint8_t INTEGRAL = 2;
+
+   unsigned int nColsOriginal = 0;
+   Vec<int> origcol_mapping;
+   Vec<PostsolveInstruction<REAL>> instructions;
+   Vec<int> payload_indices;
+   Vec<REAL> payload_values;
+
+   PostsolveProgram() = default;
+
+   explicit PostsolveProgram( const PostsolveStorage<REAL>& storage );
+
+   PostsolveProgramView<REAL>
+   getView() const
+   {
+      return PostsolveProgramView<REAL>{
+          nColsOriginal,         (int)origcol_mapping.size(),
+          origcol_mapping.data(), (int)instructions.size(),
+          instructions.data(),   payload_indices.data(),
+          payload_values.data() };
+   }
+
+   template <typename Archive>
+   void
+   serialize( Archive& ar, const unsigned int version )
+   {
+      ar& nColsOriginal;
+      ar& origcol_mapping;
+      ar& instructions;
+      ar& payload_indices;
+      ar& payload_values;
+   }
+
+ private:
+   void
+   compile_substitution( int col, REAL side, const Vec<int>& indices,
+                         const Vec<REAL>& values, int first, int last );
+
+   void
+   compile_fixed_infinity_col( const PostsolveStorage<REAL>& storage,
+                               int first );
+
+   void
+   add_instruction( PostsolveOp op, int col, int arg, int first, REAL value,
+                    REAL coef, std::uint8_t flags = 0 )
+   {
+      instructions.push_back( PostsolveInstruction<REAL>{
+          op, flags, col, arg, first, (int)payload_values.size(), value,
+          coef } );
+   }
+};
+
+#ifdef PAPILO_USE_EXTERN_TEMPLATES
+extern template class PostsolveProgram<double>;
+extern template class PostsolveProgram<Quad>;
+extern template class PostsolveProgram<Rational>;
+#endif
+
+template <typename REAL>
+PostsolveProgram<REAL>::PostsolveProgram( const PostsolveStorage<REAL>& storage )
+    : nColsOriginal( storage.nColsOriginal ),
+      origcol_mapping( storage.origcol_mapping )
+{
+   const Vec<ReductionType>& types = storage.types;
+   const Vec<int>& start = storage.start;
+   const Vec<int>& indices = storage.indices;
+   const Vec<REAL>& values = storage.values;
+
+   // the log is undone back to front, the program is executed front to back
+   for( int i = (int)types.size() - 1; i >= 0; --i )
+   {
+      int first = start[i];
+      int last = start[i + 1];
+
+      switch( types[i] )
+      {
+      case ReductionType::kFixedCol:
+         add_instruction( PostsolveOp::kFixCol, indices[first], -1,
+                          (int)payload_values.size(), values[first], 0 );
+         break;
+      case ReductionType::kSubstitutedCol:
+         compile_substitution( indices[first], values[first], indices, values,
+                               first + 1, last );
+         break;
+      case ReductionType::kSubstitutedColWithDual:
+      {
+         int row_length = (int)values[first];
+         compile_substitution( indices[first + 3 + row_length],
+                               values[first + 1], indices, values, first + 3,
+                               first + 3 + row_length );
+         break;
+      }
+      case ReductionType::kFixedInfCol:
+         compile_fixed_infinity_col( storage, first );
+         break;
+      case ReductionType::kParallelCol:
+      {
+         assert( last - first == 5 );
+         int payload_first = (int)payload_values.size();
+         for( int j = first; j < last; ++j )
+         {
+            payload_indices.push_back( indices[j] );
+            payload_values.push_back( values[j] );
+         }
+         add_instruction( PostsolveOp::kParallelCol, indices[first + 2],
+                          indices[first], payload_first, 0, 0 );
+         break;
+      }
+      case ReductionType::kColumnDualValue:
+      case ReductionType::kRowDualValue:
+      case ReductionType::kVarBoundChange:
+      case ReductionType::kRowBoundChangeForcedByRow:
+      case ReductionType::kRowBoundChange:
+      case ReductionType::kReducedBoundsCost:
+      case ReductionType::kCoefficientChange:
+      case ReductionType::kRedundantRow:
+      case ReductionType::kReasonForRowBoundChangeForcedByRow:
+      case ReductionType::kSaveRow:
+         break;
+      }
+   }
+
+   instructions.shrink_to_fit();
+   payload_indices.shrink_to_fit();
+   payload_values.shrink_to_fit();
+}
+
+template <typename REAL>
+void
+PostsolveProgram<REAL>::compile_substitution( int col, REAL side,
+                                              const Vec<int>& indices,
+                                              const Vec<REAL>& values,
+                                              int first, int last )
+{
+   // the coefficient of the substituted column is taken out of the equation,
+   // the remaining entries keep their order
+   int payload_first = (int)payload_values.size();
+   REAL colCoef = 0;
+   for( int j = first; j < last; ++j )
+   {
+      if( indices[j] == col )
+         colCoef = values[j];
+      else
+      {
+         payload_indices.push_back( indices[j] );
+         payload_values.push_back( values[j] );
+      }
+   }
+   assert( colCoef != 0 );
+   add_instruction( PostsolveOp::kSubstituteCol, col, -1, payload_first, side,
+                    colCoef );
+}
+
+template <typename REAL>
+void
+PostsolveProgram<REAL>::compile_fixed_infinity_col(
+    const PostsolveStorage<REAL>& storage, int first )
+{
+   const Vec<int>& indices = storage.indices;
+   const Vec<REAL>& values = storage.values;
+
+   int col = indices[first];
+   int number_rows = indices[first + 1];
+   bool bound_is_infinity = indices[first + 2];
+   bool isNegativeInfinity = values[first] < 0;
+   REAL initial = number_rows == 0 && bound_is_infinity ? REAL{ 0 }
+                                                        : values[first + 2];
+
+   std::uint8_t flags = 0;
+   if( isNegativeInfinity )
+      flags |= NEGATIVE_INFINITY;
+   if( storage.problem.getColFlags()[col].test( ColFlag::kIntegral ) )
+      flags |= INTEGRAL;
+
+   // every row becomes a header (number of entries, side) and (-1,
+   // coefficient of the column) followed by the entries without the column.
+   // The side is selected here, the postsolve only evaluates the rows.
+   int payload_first = (int)payload_values.size();
+   int current_counter = first + 3;
+   for( int row_counter = 0; row_counter < number_rows; ++row_counter )
+   {
+      int length = (int)values[current_counter];
+      const REAL& lhs = values[current_counter + 1];
+      const REAL& rhs = values[current_counter + 2];
+      const int* col_indices = &indices[current_counter + 3];
+      const REAL* coefficients = &values[current_counter + 3];
+
+      REAL coef = 0;
+      for( int l = 0; l < length; ++l )
+         if( col_indices[l] == col )
+            coef = coefficients[l];
+      assert( coef != 0 );
+
+      int header = (int)payload_values.size();
+      payload_indices.push_back( 0 );
+      payload_values.push_back(
+          ( coef > 0 ) == isNegativeInfinity ? rhs : lhs );
+      payload_indices.push_back( -1 );
+      payload_values.push_back( coef );
+      for( int l = 0; l < length; ++l )
+      {
+         if( col_indices[l] == col )
+            continue;
+         payload_indices.push_back( col_indices[l] );
+         payload_values.push_back( coefficients[l] );
+      }
+      payload_indices[header] = (int)payload_values.size() - header - 2;
+
+      current_counter += 3 + length;
+   }
+   add_instruction( PostsolveOp::kFixInfCol, col, number_rows, payload_first,
+                    initial, 0, flags );
+}
+
+} // namespace papilo
+
+#endif
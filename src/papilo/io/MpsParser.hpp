@@ -30,12 +30,19 @@
 #include "papilo/core/VariableDomains.hpp"
 #include "papilo/external/pdqsort/pdqsort.h"
 #include "papilo/io/BoundType.hpp"
+#include "papilo/io/NameIndexMap.hpp"
 #include "papilo/io/ParseKey.hpp"
 #include "papilo/misc/Flags.hpp"
 #include "papilo/misc/Hash.hpp"
+#include "papilo/misc/MappedFile.hpp"
 #include "papilo/misc/Num.hpp"
 #include "papilo/Config.hpp"
+#ifdef PAPILO_TBB
+#include "papilo/misc/tbb.hpp"
+#endif
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 #include <boost/spirit/include/qi.hpp>
@@ -61,37 +68,91 @@ template <typename REAL>
 class MpsParser
 {
  public:
+   static constexpr std::size_t DEFAULT_CHUNK_SIZE = std::size_t{ 1 } << 20;
+
+   /// reads uncompressed files through a memory map and falls back to the
+   /// stream reader for compressed files or if the mapped reader fails
    static boost::optional<Problem<REAL>>
    loadProblem( const std::string& filename )
    {
-      MpsParser parser;
+      if( !boost::algorithm::ends_with( filename, ".gz" ) &&
+          !boost::algorithm::ends_with( filename, ".bz2" ) )
+      {
+         boost::optional<Problem<REAL>> problem =
+             loadMappedProblem( filename );
+         if( problem )
+            return problem;
+      }
+      return loadStreamedProblem( filename );
+   }
 
-      Problem<REAL> problem;
+   /// reads the file line by line, decompressing it if necessary
+   static boost::optional<Problem<REAL>>
+   loadStreamedProblem( const std::string& filename )
+   {
+      MpsParser parser;
 
       if( !parser.parseFile( filename ) )
          return boost::none;
 
       assert( parser.nnz >= 0 );
 
-      Vec<REAL> obj_vec( static_cast<size_t>( parser.nCols ), REAL{ 0.0 } );
+      SparseStorage<REAL> transposed{ std::move( parser.entries ),
+                                      parser.nCols, parser.nRows, true };
+      return parser.buildProblem( filename, std::move( transposed ) );
+   }
+
+   /// memory maps the uncompressed file and parses the sections in chunks of
+   /// about chunk_size bytes in parallel. The columns are written directly in
+   /// compressed sparse column format. Returns boost::none without a message
+   /// if the file is not well formed or uses a feature the mapped reader does
+   /// not support, e.g. indented section keywords, so that the caller can
+   /// fall back to loadStreamedProblem.
+   static boost::optional<Problem<REAL>>
+   loadMappedProblem( const std::string& filename,
+                      std::size_t chunk_size = DEFAULT_CHUNK_SIZE )
+   {
+      MpsParser parser;
+
+      if( !parser.parseMappedFile( filename, chunk_size ) )
+         return boost::none;
+
+      if( parser.missing_objective )
+         std::cout << "WARNING: no objective row found" << std::endl;
 
-      for( auto i : parser.coeffobj )
-         obj_vec[i.first] = parser.is_objective_negated ? -i.second : i.second;
+      SparseStorage<REAL> transposed{
+          parser.cscvalues.data(), parser.cscstart.data(),
+          parser.cscrows.data(),   parser.nCols,
+          parser.nRows,            parser.nnz };
+      return parser.buildProblem( filename, std::move( transposed ) );
+   }
 
-      problem.setObjective( std::move( obj_vec ), parser.is_objective_negated ? -parser.objoffset : parser.objoffset );
+ private:
+   MpsParser() {}
 
-      problem.setConstraintMatrix(
-          SparseStorage<REAL>{ std::move( parser.entries ), parser.nCols,
-                               parser.nRows, true },
-          std::move( parser.rowlhs ), std::move( parser.rowrhs ),
-          std::move( parser.row_flags ), true );
-      problem.setVariableDomains( std::move( parser.lb4cols ),
-                                  std::move( parser.ub4cols ),
-                                  std::move( parser.col_flags ) );
-      problem.setVariableNames( std::move( parser.colnames ) );
-      problem.setName( std::move( filename ) );
-      problem.setConstraintNames( std::move( parser.rownames ) );
-      problem.set_objective_negated( parser.is_objective_negated );
+   /// the matrix is stored column wise, i.e. transposed
+   Problem<REAL>
+   buildProblem( const std::string& filename, SparseStorage<REAL> transposed )
+   {
+      Problem<REAL> problem;
+
+      Vec<REAL> obj_vec( static_cast<size_t>( nCols ), REAL{ 0.0 } );
+
+      for( auto i : coeffobj )
+         obj_vec[i.first] = is_objective_negated ? -i.second : i.second;
+
+      problem.setObjective( std::move( obj_vec ), is_objective_negated ? -objoffset : objoffset );
+
+      problem.setConstraintMatrix( std::move( transposed ),
+                                   std::move( rowlhs ), std::move( rowrhs ),
+                                   std::move( row_flags ), true );
+      problem.setVariableDomains( std::move( lb4cols ),
+                                  std::move( ub4cols ),
+                                  std::move( col_flags ) );
+      problem.setVariableNames( std::move( colnames ) );
+      problem.setName( filename );
+      problem.setConstraintNames( std::move( rownames ) );
+      problem.set_objective_negated( is_objective_negated );
 
       problem.set_problem_type( ProblemFlag::kMixedInteger );
       if(problem.getNumIntegralCols() == 0 )
@@ -104,9 +165,6 @@ class MpsParser
       return problem;
    }
 
- private:
-   MpsParser() {}
-
    /// load LP from MPS file as transposed triplet matrix
    bool
    parseFile( const std::string& filename );
@@ -117,6 +175,10 @@ class MpsParser
    bool
    parse( boost::iostreams::filtering_istream& file );
 
+   /// load LP from memory mapped MPS file as compressed sparse columns
+   bool
+   parseMappedFile( const std::string& filename, std::size_t chunk_size );
+
    static void
    printErrorMessage( const ParseKey keyword )
    {
@@ -172,6 +234,162 @@ class MpsParser
    int nRows = 0;
    int nnz = -1;
 
+   /*
+    * shared by the stream and the mapped reader
+    */
+
+   /// bound types of the BOUNDS section
+   struct BoundSpec
+   {
+      bool islb = false;
+      bool isub = false;
+      bool isintegral = false;
+      bool isdefaultbound = false;
+   };
+
+   /// returns kNone if the word is no section keyword
+   static ParseKey
+   sectionKey( boost::string_ref word );
+
+   /// adds a row of the type given by its first letter and returns false for
+   /// unknown types. The first 'N' row is the objective, for which no row is
+   /// added, further ones are free rows.
+   bool
+   addRow( char type, bool& hasobj, bool& isobj );
+
+   void
+   addColumn( std::string name, bool integral );
+
+   /// sets the side of the row or the objective offset for row -1
+   void
+   setRhs( int rowidx, const REAL& val );
+
+   void
+   setRange( int rowidx, const REAL& val );
+
+   /// returns false for unknown bound types
+   static bool
+   parseBoundType( boost::string_ref word, BoundSpec& spec );
+
+   /// sets the bounds of the types without value, i.e. MI, PL, BV and FR
+   void
+   setDefaultBound( const BoundSpec& spec, int colidx );
+
+   void
+   setBound( const BoundSpec& spec, int colidx, const REAL& val,
+             Vec<bool>& lb_is_default, Vec<bool>& ub_is_default );
+
+   /*
+    * mapped reader
+    */
+
+   static constexpr int MAX_TOKENS = 5;
+
+   /// a section of the mapped file, its data lines are in [begin, end)
+   struct Section
+   {
+      ParseKey key;
+      const char* header;
+      const char* begin;
+      const char* end;
+   };
+
+   /// the entries of consecutive lines of the same column in a chunk, or an
+   /// integrality marker
+   struct ColumnRun
+   {
+      boost::string_ref name;
+      /// 0 for entries, 1 for 'INTORG' and 2 for 'INTEND'
+      int marker;
+      /// entries of the chunk in [first, last)
+      int first;
+      int last;
+      /// the column and the position of the first entry within it
+      int col;
+      int offset;
+   };
+
+   struct ColumnChunk
+   {
+      Vec<ColumnRun> runs;
+      Vec<int> rows;
+      Vec<REAL> values;
+      /// run and coefficient of the objective entries
+      Vec<std::pair<int, REAL>> objective;
+   };
+
+   struct BoundEntry
+   {
+      BoundSpec spec;
+      int col;
+      REAL val;
+   };
+
+   // the names reference the mapped file and are only valid while it is
+   // parsed
+   NameIndexMap rowmap;
+   NameIndexMap colmap;
+
+   // columns of the matrix read by the mapped reader
+   Vec<int> cscstart;
+   Vec<int> cscrows;
+   Vec<REAL> cscvalues;
+   bool missing_objective = false;
+
+   static bool
+   isSpace( char c )
+   {
+      return c == ' ' || ( c >= '\t' && c <= '\r' );
+   }
+
+   /// the start of the line after the one containing it, or end
+   static const char*
+   nextLine( const char* it, const char* end );
+
+   /// splits the line at whitespace and returns the number of tokens, or
+   /// MAX_TOKENS + 1 if there are more than MAX_TOKENS
+   static int
+   tokenize( const char* begin, const char* end, boost::string_ref* tokens );
+
+   /// calls f( tokens, ntokens ) for the lines of [begin, end) that are
+   /// neither empty nor comments. Returns false if f returns false or a line
+   /// starts with an indented section keyword other than the one of the
+   /// section, which RHS and RANGES sections may use as vector name.
+   template <typename F>
+   static bool
+   forEachLine( const char* begin, const char* end, ParseKey section_key,
+                F&& f );
+
+   /// boundaries of chunks of about chunk_size bytes that start at lines
+   static Vec<const char*>
+   splitChunks( const char* begin, const char* end, std::size_t chunk_size );
+
+   /// calls f( i ) for 0 <= i < n, in parallel if TBB is available
+   template <typename F>
+   static void
+   parallelFor( int n, F&& f );
+
+   /// returns false if there is no ENDATA
+   static bool
+   splitSections( const char* begin, const char* end,
+                  Vec<Section>& sections );
+
+   bool
+   parseMappedObjSense( const Section& section );
+
+   bool
+   parseMappedRows( const Section& section );
+
+   bool
+   parseMappedCols( const Section& section, std::size_t chunk_size );
+
+   /// parses RHS and RANGES sections
+   bool
+   parseMappedSides( const Section& section, std::size_t chunk_size );
+
+   bool
+   parseMappedBounds( const Section& section, std::size_t chunk_size );
+
    /// checks first word of strline and wraps it by it_begin and it_end
    ParseKey
    checkFirstWord( std::string& strline, std::string::iterator& it,
@@ -181,8 +399,7 @@ class MpsParser
    parseDefault( boost::iostreams::filtering_istream& file );
 
    ParseKey
-   parseRows( boost::iostreams::filtering_istream& file,
-              Vec<BoundType>& rowtype );
+   parseRows( boost::iostreams::filtering_istream& file );
 
    ParseKey
    parseCols( boost::iostreams::filtering_istream& file,
@@ -218,7 +435,42 @@ MpsParser<REAL>::checkFirstWord( std::string& strline,
 
    word_ref = word;
 
-   if( word.front() == 'R' ) // todo
+   const ParseKey key = sectionKey( word );
+   if( key != kObjSense )
+      return key;
+
+   // Tokenize the line normally      // Tokenize the line normally
+   std::stringstream ss(strline);
+   std::string w1, w2;
+   ss >> w1 >> w2;
+
+   // Uppercase
+   std::transform(w1.begin(), w1.end(), w1.begin(), ::toupper);
+   std::transform(w2.begin(), w2.end(), w2.begin(), ::toupper);
+
+   if (w2.empty()) {
+      return kObjSense;   // nothing to do
+   }
+
+   // --- If line contains OBJSENSE MIN/MAX, re-parse ---
+   if (w1 == "OBJSENSE") {
+      if (w2 == "MAX" || w2 == "MIN") {
+         is_objective_negated = w2 == "MAX";
+      } else {
+         std::cerr << "Error: OBJSENSE must be followed by MAX or MIN. Received: " << w2 << std::endl;
+         return kFail;
+      }
+   }
+   return kObjSenseParsed;
+}
+
+template <typename REAL>
+ParseKey
+MpsParser<REAL>::sectionKey( boost::string_ref word )
+{
+   if( word.empty() )
+      return kNone;
+   if( word.front() == 'R' )
    {
       if( word == "ROWS" )
          return kRows;
@@ -234,33 +486,258 @@ MpsParser<REAL>::checkFirstWord( std::string& strline,
       return kBounds;
    if( word == "ENDATA" )
       return kEnd;
-   if( word == "OBJSENSE")
+   if( word == "OBJSENSE" )
+      return kObjSense;
+   return kNone;
+}
+
+template <typename REAL>
+bool
+MpsParser<REAL>::addRow( char type, bool& hasobj, bool& isobj )
+{
+   isobj = false;
+   if( type == 'G' )
    {
-      // Tokenize the line normally
-      std::stringstream ss(strline);
-      std::string w1, w2;
-      ss >> w1 >> w2;
+      rowlhs.push_back( REAL{ 0.0 } );
+      rowrhs.push_back( REAL{ 0.0 } );
+      row_flags.emplace_back( RowFlag::kRhsInf );
+      row_type.push_back( kGE );
+   }
+   else if( type == 'E' )
+   {
+      rowlhs.push_back( REAL{ 0.0 } );
+      rowrhs.push_back( REAL{ 0.0 } );
+      row_flags.emplace_back( RowFlag::kEquation );
+      row_type.push_back( BoundType::kEq );
+   }
+   else if( type == 'L' )
+   {
+      rowlhs.push_back( REAL{ 0.0 } );
+      rowrhs.push_back( REAL{ 0.0 } );
+      row_flags.emplace_back( RowFlag::kLhsInf );
+      row_type.push_back( BoundType::kLE );
+   }
+   // todo properly treat multiple free rows
+   else if( type == 'N' )
+   {
+      if( hasobj )
+      {
+         rowlhs.push_back( REAL{ 0.0 } );
+         rowrhs.push_back( REAL{ 0.0 } );
+         RowFlags rowf;
+         rowf.set( RowFlag::kLhsInf, RowFlag::kRhsInf );
+         row_flags.emplace_back( rowf );
+         row_type.push_back( BoundType::kLE );
+      }
+      else
+      {
+         isobj = true;
+         hasobj = true;
+      }
+   }
+   else
+      return false;
+   return true;
+}
+
+template <typename REAL>
+void
+MpsParser<REAL>::addColumn( std::string name, bool integral )
+{
+   colnames.push_back( std::move( name ) );
+
+   assert( lb4cols.size() == col_flags.size() );
+
+   col_flags.emplace_back( integral ? ColFlag::kIntegral : ColFlag::kNone );
+
+   // initialize with default bounds
+   if( integral )
+   {
+      lb4cols.push_back( REAL{ 0.0 } );
+      ub4cols.push_back( REAL{ 1.0 } );
+   }
+   else
+   {
+      lb4cols.push_back( REAL{ 0.0 } );
+      ub4cols.push_back( REAL{ 0.0 } );
+      col_flags.back().set( ColFlag::kUbInf );
+   }
+
+   assert( col_flags.size() == lb4cols.size() );
+}
 
-      // Uppercase
-      std::transform(w1.begin(), w1.end(), w1.begin(), ::toupper);
-      std::transform(w2.begin(), w2.end(), w2.begin(), ::toupper);
+template <typename REAL>
+void
+MpsParser<REAL>::setRhs( int rowidx, const REAL& val )
+{
+   assert( rowidx >= -1 );
+   assert( rowidx < static_cast<int>( rowrhs.size() ) );
+
+   if( rowidx == -1 )
+   {
+      objoffset = -REAL{ val };
+      return;
+   }
+   if( row_type[rowidx] == kEq || row_type[rowidx] == kLE )
+   {
+      rowrhs[rowidx] = REAL{ val };
+      row_flags[rowidx].unset( RowFlag::kRhsInf );
+   }
 
-      if (w2.empty()) {
-         return kObjSense;   // nothing to do
+   if( row_type[rowidx] == kEq || row_type[rowidx] == kGE )
+   {
+      rowlhs[rowidx] = REAL{ val };
+      row_flags[rowidx].unset( RowFlag::kLhsInf );
+   }
+}
+
+template <typename REAL>
+void
+MpsParser<REAL>::setRange( int rowidx, const REAL& val )
+{
+   assert( rowidx >= 0 );
+   assert( rowidx < static_cast<int>( rowrhs.size() ) );
+
+   if( row_type[rowidx] == kGE )
+   {
+      row_flags[rowidx].unset( RowFlag::kRhsInf );
+      rowrhs[rowidx] = rowlhs[rowidx] + REAL( abs( val ) );
+   }
+   else if( row_type[rowidx] == kLE )
+   {
+      row_flags[rowidx].unset( RowFlag::kLhsInf );
+      rowlhs[rowidx] = rowrhs[rowidx] - REAL( abs( val ) );
+   }
+   else
+   {
+      assert( row_type[rowidx] == BoundType::kEq );
+      assert( rowrhs[rowidx] == rowlhs[rowidx] );
+      assert( row_flags[rowidx].test( RowFlag::kEquation ) );
+
+      if( val > REAL{ 0.0 } )
+      {
+         row_flags[rowidx].unset( RowFlag::kEquation );
+         rowrhs[rowidx] = rowrhs[rowidx] + REAL( val );
+      }
+      else if( val < REAL{ 0.0 } )
+      {
+         rowlhs[rowidx] = rowlhs[rowidx] + REAL( val );
+         row_flags[rowidx].unset( RowFlag::kEquation );
       }
+   }
+}
 
-      // --- If line contains OBJSENSE MIN/MAX, re-parse ---
-      if (w1 == "OBJSENSE") {
-         if (w2 == "MAX" || w2 == "MIN") {
-            is_objective_negated = w2 == "MAX";
-         } else {
-            std::cerr << "Error: OBJSENSE must be followed by MAX or MIN. Received: " << w2 << std::endl;
-            return kFail;
-         }
+template <typename REAL>
+bool
+MpsParser<REAL>::parseBoundType( boost::string_ref word, BoundSpec& spec )
+{
+   spec = BoundSpec();
+
+   if( word == "UP" ) // upper bound
+      spec.isub = true;
+   else if( word == "LO" ) // lower bound
+      spec.islb = true;
+   else if( word == "FX" ) // fixed
+   {
+      spec.islb = true;
+      spec.isub = true;
+   }
+   else if( word == "MI" ) // infinite lower bound
+   {
+      spec.islb = true;
+      spec.isdefaultbound = true;
+   }
+   else if( word == "PL" ) // infinite upper bound (redundant)
+   {
+      spec.isub = true;
+      spec.isdefaultbound = true;
+   }
+   else if( word == "BV" ) // binary
+   {
+      spec.isintegral = true;
+      spec.isdefaultbound = true;
+      spec.islb = true;
+      spec.isub = true;
+   }
+   else if( word == "LI" ) // integer lower bound
+   {
+      spec.islb = true;
+      spec.isintegral = true;
+   }
+   else if( word == "UI" ) // integer upper bound
+   {
+      spec.isub = true;
+      spec.isintegral = true;
+   }
+   else if( word == "FR" ) // free variable
+   {
+      spec.islb = true;
+      spec.isub = true;
+      spec.isdefaultbound = true;
+   }
+   else
+      return false;
+   return true;
+}
+
+template <typename REAL>
+void
+MpsParser<REAL>::setDefaultBound( const BoundSpec& spec, int colidx )
+{
+   assert( spec.isdefaultbound );
+
+   if( spec.isintegral ) // binary
+   {
+      if( spec.islb )
+         lb4cols[colidx] = REAL{ 0.0 };
+      if( spec.isub )
+      {
+         col_flags[colidx].unset( ColFlag::kUbInf );
+         ub4cols[colidx] = REAL{ 1.0 };
       }
-      return kObjSenseParsed;
+      col_flags[colidx].set( ColFlag::kIntegral );
+   }
+   else
+   {
+      if( spec.islb )
+         col_flags[colidx].set( ColFlag::kLbInf );
+      if( spec.isub )
+         col_flags[colidx].set( ColFlag::kUbInf );
+   }
+}
+
+template <typename REAL>
+void
+MpsParser<REAL>::setBound( const BoundSpec& spec, int colidx, const REAL& val,
+                           Vec<bool>& lb_is_default,
+                           Vec<bool>& ub_is_default )
+{
+   assert( !spec.isdefaultbound );
+
+   if( spec.islb )
+   {
+      lb4cols[colidx] = REAL{ val };
+      lb_is_default[colidx] = false;
+      col_flags[colidx].unset( ColFlag::kLbInf );
+   }
+   if( spec.isub )
+   {
+      ub4cols[colidx] = REAL{ val };
+      ub_is_default[colidx] = false;
+      col_flags[colidx].unset( ColFlag::kUbInf );
+   }
+
+   if( spec.isintegral )
+      col_flags[colidx].set( ColFlag::kIntegral );
+
+   if( col_flags[colidx].test( ColFlag::kIntegral ) )
+   {
+      col_flags[colidx].set( ColFlag::kIntegral );
+      if( !spec.islb && lb_is_default[colidx] )
+         lb4cols[colidx] = REAL{ 0.0 };
+      if( !spec.isub && ub_is_default[colidx] )
+         col_flags[colidx].set( ColFlag::kUbInf );
    }
-   return kNone;
 }
 
 template <typename REAL>
@@ -277,8 +754,7 @@ MpsParser<REAL>::parseDefault( boost::iostreams::filtering_istream& file )
 
 template <typename REAL>
 ParseKey
-MpsParser<REAL>::parseRows( boost::iostreams::filtering_istream& file,
-                            Vec<BoundType>& rowtype )
+MpsParser<REAL>::parseRows( boost::iostreams::filtering_istream& file )
 {
    using namespace boost::spirit;
 
@@ -306,48 +782,10 @@ MpsParser<REAL>::parseRows( boost::iostreams::filtering_istream& file,
          return key;
       }
 
-      if( word_ref.front() == 'G' )
-      {
-         rowlhs.push_back( REAL{ 0.0 } );
-         rowrhs.push_back( REAL{ 0.0 } );
-         row_flags.emplace_back( RowFlag::kRhsInf );
-         rowtype.push_back( kGE );
-      }
-      else if( word_ref.front() == 'E' )
-      {
-         rowlhs.push_back( REAL{ 0.0 } );
-         rowrhs.push_back( REAL{ 0.0 } );
-         row_flags.emplace_back( RowFlag::kEquation );
-         rowtype.push_back( BoundType::kEq );
-      }
-      else if( word_ref.front() == 'L' )
-      {
-         rowlhs.push_back( REAL{ 0.0 } );
-         rowrhs.push_back( REAL{ 0.0 } );
-         row_flags.emplace_back( RowFlag::kLhsInf );
-         rowtype.push_back( BoundType::kLE );
-      }
-      // todo properly treat multiple free rows
-      else if( word_ref.front() == 'N' )
-      {
-         if( hasobj )
-         {
-            rowlhs.push_back( REAL{ 0.0 } );
-            rowrhs.push_back( REAL{ 0.0 } );
-            RowFlags rowf;
-            rowf.set( RowFlag::kLhsInf, RowFlag::kRhsInf );
-            row_flags.emplace_back( rowf );
-            rowtype.push_back( BoundType::kLE );
-         }
-         else
-         {
-            isobj = true;
-            hasobj = true;
-         }
-      }
-      else if( word_ref.empty() ) // empty line
+      if( word_ref.empty() ) // empty line
          continue;
-      else
+
+      if( !addRow( word_ref.front(), hasobj, isobj ) )
          return kFail;
 
       std::string rowname; // todo use ref
@@ -463,33 +901,13 @@ MpsParser<REAL>::parseCols( boost::iostreams::filtering_istream& file,
 
          colname = word_ref.to_string();
          auto ret = colname2idx.emplace( colname, ncols++ );
-         colnames.push_back( colname );
-
          if( !ret.second )
          {
             std::cerr << "duplicate column " << std::endl;
             return kFail;
          }
 
-         assert( lb4cols.size() == col_flags.size() );
-
-         col_flags.emplace_back( integral_cols ? ColFlag::kIntegral
-                                               : ColFlag::kNone );
-
-         // initialize with default bounds
-         if( integral_cols )
-         {
-            lb4cols.push_back( REAL{ 0.0 } );
-            ub4cols.push_back( REAL{ 1.0 } );
-         }
-         else
-         {
-            lb4cols.push_back( REAL{ 0.0 } );
-            ub4cols.push_back( REAL{ 0.0 } );
-            col_flags.back().set( ColFlag::kUbInf );
-         }
-
-         assert( col_flags.size() == lb4cols.size() );
+         addColumn( colname, integral_cols );
 
          if( ncols > 1 )
             pdqsort( entries.begin() + colstart, entries.end(),
@@ -560,36 +978,7 @@ MpsParser<REAL>::parseRanges( boost::iostreams::filtering_istream& file )
             fmt::print("Could not parse range {}\n", sval);
             exit(0);
          }
-         REAL val = result.second;
-         assert( static_cast<size_t>( rowidx ) < rowrhs.size() );
-
-         if( row_type[rowidx] == kGE )
-         {
-            row_flags[rowidx].unset( RowFlag::kRhsInf );
-            rowrhs[rowidx] = rowlhs[rowidx] + REAL(abs( val ));
-         }
-         else if( row_type[rowidx] == kLE )
-         {
-            row_flags[rowidx].unset( RowFlag::kLhsInf );
-            rowlhs[rowidx] = rowrhs[rowidx] - REAL(abs( val ));
-         }
-         else
-         {
-            assert( row_type[rowidx] == BoundType::kEq );
-            assert( rowrhs[rowidx] == rowlhs[rowidx] );
-            assert( row_flags[rowidx].test(RowFlag::kEquation) );
-
-            if( val > REAL{ 0.0 } )
-            {
-               row_flags[rowidx].unset( RowFlag::kEquation );
-               rowrhs[rowidx] = rowrhs[rowidx] + REAL( val );
-            }
-            else if( val < REAL{ 0.0 } )
-            {
-               rowlhs[rowidx] = rowlhs[rowidx] + REAL( val );
-               row_flags[rowidx].unset( RowFlag::kEquation );
-            }
-         }
+         setRange( rowidx, result.second );
       };
 
       std::istringstream is( strline );
@@ -650,27 +1039,7 @@ MpsParser<REAL>::parseRhs( boost::iostreams::filtering_istream& file )
             fmt::print("Could not parse side {}\n", sval);
             exit(0);
          }
-         REAL val = result.second;
-         if( rowidx == -1 )
-         {
-            objoffset = -REAL{ val };
-            return;
-         }
-         if( row_type[rowidx] == kEq ||
-             row_type[rowidx] == kLE )
-         {
-            assert( static_cast<size_t>( rowidx ) < rowrhs.size() );
-            rowrhs[rowidx] = REAL{ val };
-            row_flags[rowidx].unset( RowFlag::kRhsInf );
-         }
-
-         if( row_type[rowidx] == kEq ||
-             row_type[rowidx] == kGE )
-         {
-            assert( static_cast<size_t>( rowidx ) < rowlhs.size() );
-            rowlhs[rowidx] = REAL{ val };
-            row_flags[rowidx].unset( RowFlag::kLhsInf );
-         }
+         setRhs( rowidx, result.second );
       };
 
       std::istringstream is( strline );
@@ -715,54 +1084,8 @@ MpsParser<REAL>::parseBounds( boost::iostreams::filtering_istream& file )
       if( word_ref.empty() )
          continue;
 
-      bool islb = false;
-      bool isub = false;
-      bool isintegral = false;
-      bool isdefaultbound = false;
-
-      if( word_ref == "UP" ) // lower bound
-         isub = true;
-      else if( word_ref == "LO" ) // upper bound
-         islb = true;
-      else if( word_ref == "FX" ) // fixed
-      {
-         islb = true;
-         isub = true;
-      }
-      else if( word_ref == "MI" ) // infinite lower bound
-      {
-         islb = true;
-         isdefaultbound = true;
-      }
-      else if( word_ref == "PL" ) // infinite upper bound (redundant)
-      {
-         isub = true;
-         isdefaultbound = true;
-      }
-      else if( word_ref == "BV" ) // binary
-      {
-         isintegral = true;
-         isdefaultbound = true;
-         islb = true;
-         isub = true;
-      }
-      else if( word_ref == "LI" ) // integer lower bound
-      {
-         islb = true;
-         isintegral = true;
-      }
-      else if( word_ref == "UI" ) // integer upper bound
-      {
-         isub = true;
-         isintegral = true;
-      }
-      else if( word_ref == "FR" ) // free variable
-      {
-         islb = true;
-         isub = true;
-         isdefaultbound = true;
-      }
-      else
+      BoundSpec spec;
+      if( !parseBoundType( word_ref, spec ) )
       {
          if( word_ref == "INDICATORS" )
             std::cerr << "PaPILO does not support INDICATORS in the MPS file!!"<< std::endl;
@@ -783,7 +1106,7 @@ MpsParser<REAL>::parseBounds( boost::iostreams::filtering_istream& file )
          assert( colidx >= 0 );
       };
 
-      if( isdefaultbound )
+      if( spec.isdefaultbound )
       {
          if( !qi::phrase_parse(
                  it, strline.end(),
@@ -791,28 +1114,11 @@ MpsParser<REAL>::parseBounds( boost::iostreams::filtering_istream& file )
                  ascii::space ) )
             return ParseKey::kFail;
 
-         if( isintegral ) // binary
-         {
-            if( islb )
-               lb4cols[colidx] = REAL{ 0.0 };
-            if( isub )
-            {
-               col_flags[colidx].unset( ColFlag::kUbInf );
-               ub4cols[colidx] = REAL{ 1.0 };
-            }
-            col_flags[colidx].set( ColFlag::kIntegral );
-         }
-         else
-         {
-            if( islb )
-               col_flags[colidx].set( ColFlag::kLbInf );
-            if( isub )
-               col_flags[colidx].set( ColFlag::kUbInf );
-         }
+         setDefaultBound( spec, colidx );
          continue;
       }
 
-      auto adddomains = [&ub_is_default, &lb_is_default, &colidx, &islb, &isub, &isintegral, this]
+      auto adddomains = [&ub_is_default, &lb_is_default, &colidx, &spec, this]
           ( std::string sval )
       {
          auto result = parse_number<REAL>( sval );
@@ -821,31 +1127,7 @@ MpsParser<REAL>::parseBounds( boost::iostreams::filtering_istream& file )
             fmt::print("Could not parse bound {}\n", sval);
             exit(0);
          }
-         REAL val = result.second;
-         if( islb )
-         {
-            lb4cols[colidx] = REAL{ val };
-            lb_is_default[colidx] = false;
-            col_flags[colidx].unset( ColFlag::kLbInf );
-         }
-         if( isub )
-         {
-            ub4cols[colidx] = REAL{ val };
-            ub_is_default[colidx] = false;
-            col_flags[colidx].unset( ColFlag::kUbInf );
-         }
-
-         if( isintegral )
-            col_flags[colidx].set( ColFlag::kIntegral );
-
-         if( col_flags[colidx].test( ColFlag::kIntegral ) )
-         {
-            col_flags[colidx].set( ColFlag::kIntegral );
-            if( !islb && lb_is_default[colidx] )
-               lb4cols[colidx] = REAL{ 0.0 };
-            if( !isub && ub_is_default[colidx] )
-               col_flags[colidx].set( ColFlag::kUbInf );
-         }
+         setBound( spec, colidx, result.second, lb_is_default, ub_is_default );
       };
 
       std::istringstream is( strline );
@@ -926,7 +1208,7 @@ MpsParser<REAL>::parse( boost::iostreams::filtering_istream& file )
       switch( keyword )
       {
       case kRows:
-         keyword = parseRows( file, row_type );
+         keyword = parseRows( file );
          break;
       case kCols:
          keyword = parseCols( file, row_type );
@@ -968,6 +1250,532 @@ MpsParser<REAL>::parse( boost::iostreams::filtering_istream& file )
    return true;
 }
 
+template <typename REAL>
+const char*
+MpsParser<REAL>::nextLine( const char* it, const char* end )
+{
+   const void* newline =
+       std::memchr( it, '\n', static_cast<std::size_t>( end - it ) );
+   return newline == nullptr ? end : static_cast<const char*>( newline ) + 1;
+}
+
+template <typename REAL>
+int
+MpsParser<REAL>::tokenize( const char* begin, const char* end,
+                           boost::string_ref* tokens )
+{
+   int ntokens = 0;
+   const char* it = begin;
+   while( true )
+   {
+      while( it != end && isSpace( *it ) )
+         ++it;
+      if( it == end )
+         return ntokens;
+      if( ntokens == MAX_TOKENS )
+         return MAX_TOKENS + 1;
+
+      const char* start = it;
+      while( it != end && !isSpace( *it ) )
+         ++it;
+      tokens[ntokens++] =
+          boost::string_ref( start, static_cast<std::size_t>( it - start ) );
+   }
+}
+
+template <typename REAL>
+template <typename F>
+bool
+MpsParser<REAL>::forEachLine( const char* begin, const char* end,
+                              ParseKey section_key, F&& f )
+{
+   boost::string_ref tokens[MAX_TOKENS];
+   const char* next;
+   for( const char* it = begin; it != end; it = next )
+   {
+      next = nextLine( it, end );
+      if( *it == '*' )
+         continue;
+
+      const int ntokens = tokenize( it, next, tokens );
+      if( ntokens == 0 )
+         continue;
+
+      const ParseKey key = sectionKey( tokens[0] );
+      if( ( key != kNone && key != section_key ) || !f( tokens, ntokens ) )
+         return false;
+   }
+   return true;
+}
+
+template <typename REAL>
+Vec<const char*>
+MpsParser<REAL>::splitChunks( const char* begin, const char* end,
+                              std::size_t chunk_size )
+{
+   Vec<const char*> boundaries{ begin };
+   while( static_cast<std::size_t>( end - boundaries.back() ) > chunk_size )
+      boundaries.push_back( nextLine( boundaries.back() + chunk_size, end ) );
+   if( boundaries.back() != end )
+      boundaries.push_back( end );
+   return boundaries;
+}
+
+template <typename REAL>
+template <typename F>
+void
+MpsParser<REAL>::parallelFor( int n, F&& f )
+{
+#ifdef PAPILO_TBB
+   tbb::parallel_for( tbb::blocked_range<int>( 0, n ),
+                      [&]( const tbb::blocked_range<int>& r ) {
+                         for( int i = r.begin(); i != r.end(); ++i )
+                            f( i );
+                      } );
+#else
+   for( int i = 0; i != n; ++i )
+      f( i );
+#endif
+}
+
+template <typename REAL>
+bool
+MpsParser<REAL>::splitSections( const char* begin, const char* end,
+                                Vec<Section>& sections )
+{
+   for( const char* it = begin; it != end; )
+   {
+      const char* next = nextLine( it, end );
+
+      // section keywords start the line, lines before the first section,
+      // e.g. NAME, are skipped
+      if( !isSpace( *it ) && *it != '*' )
+      {
+         const char* word_end = it;
+         while( word_end != next && !isSpace( *word_end ) )
+            ++word_end;
+         const ParseKey key = sectionKey(
+             boost::string_ref( it, static_cast<std::size_t>( word_end - it ) ) );
+
+         // like the stream reader, RHS and RANGES sections continue at lines
+         // that start with their keyword as vector name
+         const bool continued = ( key == kRhs || key == kRanges ) &&
+                                !sections.empty() &&
+                                sections.back().key == key;
+
+         if( key != kNone && !continued )
+         {
+            if( !sections.empty() )
+               sections.back().end = it;
+            sections.push_back( Section{ key, it, next, end } );
+            if( key == kEnd )
+               return true;
+         }
+      }
+      it = next;
+   }
+
+   return false;
+}
+
+template <typename REAL>
+bool
+MpsParser<REAL>::parseMappedObjSense( const Section& section )
+{
+   boost::string_ref tokens[MAX_TOKENS];
+
+   // OBJSENSE MAX on one line
+   if( tokenize( section.header, section.begin, tokens ) >= 2 )
+   {
+      std::string sense = tokens[1].to_string();
+      std::transform( sense.begin(), sense.end(), sense.begin(), ::toupper );
+      if( sense != "MAX" && sense != "MIN" )
+         return false;
+      is_objective_negated = sense == "MAX";
+      return true;
+   }
+
+   // the sense is on the next line
+   if( section.begin == section.end ||
+       tokenize( section.begin, nextLine( section.begin, section.end ),
+                 tokens ) != 1 ||
+       ( tokens[0] != "MAX" && tokens[0] != "MIN" ) )
+      return false;
+   is_objective_negated = tokens[0] == "MAX";
+   return true;
+}
+
+template <typename REAL>
+bool
+MpsParser<REAL>::parseMappedRows( const Section& section )
+{
+   const std::size_t nlines = static_cast<std::size_t>(
+       std::count( section.begin, section.end, '\n' ) );
+   rowmap.reserve( nlines + 1 );
+
+   bool hasobj = false;
+   bool success = forEachLine(
+       section.begin, section.end, kNone,
+       [this, &hasobj]( const boost::string_ref* tokens, int ntokens ) {
+          bool isobj;
+          if( ntokens < 2 || !addRow( tokens[0].front(), hasobj, isobj ) )
+             return false;
+
+          const int rowidx = static_cast<int>( rownames.size() );
+          if( !rowmap.insert( tokens[1], isobj ? -1 : rowidx ) )
+             return false;
+          if( !isobj )
+             rownames.push_back( tokens[1].to_string() );
+          return true;
+       } );
+
+   if( success && !hasobj )
+   {
+      missing_objective = true;
+      rowmap.insert( "artificial_empty_objective", -1 );
+   }
+
+   return success;
+}
+
+template <typename REAL>
+bool
+MpsParser<REAL>::parseMappedCols( const Section& section,
+                                  std::size_t chunk_size )
+{
+   const Vec<const char*> boundaries =
+       splitChunks( section.begin, section.end, chunk_size );
+   const int nchunks = static_cast<int>( boundaries.size() ) - 1;
+   Vec<ColumnChunk> chunks( static_cast<std::size_t>( nchunks ) );
+   std::atomic<bool> failed{ false };
+
+   // tokenize the lines and look up the rows in parallel
+   parallelFor( nchunks, [&]( int c ) {
+      ColumnChunk& chunk = chunks[c];
+      auto parseLine = [this, &chunk]( const boost::string_ref* tokens,
+                                       int ntokens ) {
+         if( ntokens >= 2 && tokens[1] == "'MARKER'" )
+         {
+            if( ntokens < 3 ||
+                ( tokens[2] != "'INTORG'" && tokens[2] != "'INTEND'" ) )
+               return false;
+            const int marker = tokens[2] == "'INTORG'" ? 1 : 2;
+            chunk.runs.push_back( ColumnRun{ tokens[0], marker, 0, 0, -1, 0 } );
+            return true;
+         }
+
+         if( ntokens != 3 && ntokens != 5 )
+            return false;
+
+         const int nentries = static_cast<int>( chunk.rows.size() );
+         if( chunk.runs.empty() || chunk.runs.back().marker != 0 ||
+             chunk.runs.back().name != tokens[0] )
+            chunk.runs.push_back(
+                ColumnRun{ tokens[0], 0, nentries, nentries, -1, 0 } );
+
+         for( int k = 1; k < ntokens; k += 2 )
+         {
+            const int* rowidx = rowmap.find( tokens[k] );
+            REAL value;
+            if( rowidx == nullptr ||
+                parse_decimal( tokens[k + 1].data(),
+                               tokens[k + 1].data() + tokens[k + 1].size(),
+                               value ) )
+               return false;
+
+            if( *rowidx == -1 )
+               chunk.objective.emplace_back(
+                   static_cast<int>( chunk.runs.size() ) - 1, value );
+            else
+            {
+               chunk.rows.push_back( *rowidx );
+               chunk.values.push_back( value );
+            }
+         }
+         chunk.runs.back().last = static_cast<int>( chunk.rows.size() );
+         return true;
+      };
+
+      if( !forEachLine( boundaries[c], boundaries[c + 1], kNone,
+                        parseLine ) )
+         failed = true;
+   } );
+
+   if( failed )
+      return false;
+
+   std::size_t nruns = 0;
+   for( const ColumnChunk& chunk : chunks )
+      nruns += chunk.runs.size();
+   colmap.reserve( nruns );
+
+   // assign the runs to the columns in the order of the file, a column may
+   // continue in the next chunk
+   Vec<int> colsize;
+   bool integral_cols = false;
+   boost::string_ref colname;
+   for( ColumnChunk& chunk : chunks )
+   {
+      for( ColumnRun& run : chunk.runs )
+      {
+         if( run.marker != 0 )
+         {
+            if( run.marker != ( integral_cols ? 2 : 1 ) )
+               return false;
+            integral_cols = !integral_cols;
+            continue;
+         }
+
+         if( colsize.empty() || run.name != colname )
+         {
+            if( !colmap.insert( run.name, static_cast<int>( colsize.size() ) ) )
+               return false;
+            addColumn( run.name.to_string(), integral_cols );
+            colsize.push_back( 0 );
+            colname = run.name;
+         }
+
+         run.col = static_cast<int>( colsize.size() ) - 1;
+         run.offset = colsize[run.col];
+         colsize[run.col] += run.last - run.first;
+      }
+
+      for( const std::pair<int, REAL>& entry : chunk.objective )
+         coeffobj.emplace_back( chunk.runs[entry.first].col, entry.second );
+   }
+
+   const int ncols = static_cast<int>( colsize.size() );
+   cscstart.resize( static_cast<std::size_t>( ncols ) + 1 );
+   cscstart[0] = 0;
+   for( int col = 0; col != ncols; ++col )
+      cscstart[col + 1] = cscstart[col] + colsize[col];
+   nnz = cscstart[ncols];
+   cscrows.resize( static_cast<std::size_t>( nnz ) );
+   cscvalues.resize( static_cast<std::size_t>( nnz ) );
+
+   parallelFor( nchunks, [&]( int c ) {
+      const ColumnChunk& chunk = chunks[c];
+      for( const ColumnRun& run : chunk.runs )
+      {
+         if( run.marker != 0 )
+            continue;
+         const int dest = cscstart[run.col] + run.offset;
+         std::copy( chunk.rows.begin() + run.first,
+                    chunk.rows.begin() + run.last, cscrows.begin() + dest );
+         std::copy( chunk.values.begin() + run.first,
+                    chunk.values.begin() + run.last, cscvalues.begin() + dest );
+      }
+   } );
+
+   // sort the entries of each column by row, a row must not appear twice
+   parallelFor( ncols, [&]( int col ) {
+      int* rows = cscrows.data() + cscstart[col];
+      REAL* values = cscvalues.data() + cscstart[col];
+      const int size = colsize[col];
+
+      if( !std::is_sorted( rows, rows + size ) )
+      {
+         Vec<std::pair<int, REAL>> sorted( static_cast<std::size_t>( size ) );
+         for( int k = 0; k != size; ++k )
+            sorted[k] = std::make_pair( rows[k], values[k] );
+         pdqsort( sorted.begin(), sorted.end(),
+                  []( const std::pair<int, REAL>& a,
+                      const std::pair<int, REAL>& b ) {
+                     return a.first < b.first;
+                  } );
+         for( int k = 0; k != size; ++k )
+         {
+            rows[k] = sorted[k].first;
+            values[k] = sorted[k].second;
+         }
+      }
+
+      if( std::adjacent_find( rows, rows + size ) != rows + size )
+         failed = true;
+   } );
+
+   return !failed;
+}
+
+template <typename REAL>
+bool
+MpsParser<REAL>::parseMappedSides( const Section& section,
+                                   std::size_t chunk_size )
+{
+   const bool ranges = section.key == kRanges;
+   const Vec<const char*> boundaries =
+       splitChunks( section.begin, section.end, chunk_size );
+   const int nchunks = static_cast<int>( boundaries.size() ) - 1;
+   Vec<Vec<std::pair<int, REAL>>> sides( static_cast<std::size_t>( nchunks ) );
+   std::atomic<bool> failed{ false };
+
+   parallelFor( nchunks, [&]( int c ) {
+      auto parseLine = [&]( const boost::string_ref* tokens, int ntokens ) {
+         if( ntokens != 3 && ntokens != 5 )
+            return false;
+
+         for( int k = 1; k < ntokens; k += 2 )
+         {
+            const int* rowidx = rowmap.find( tokens[k] );
+            REAL value;
+            // the objective has no range
+            if( rowidx == nullptr || ( ranges && *rowidx == -1 ) ||
+                parse_decimal( tokens[k + 1].data(),
+                               tokens[k + 1].data() + tokens[k + 1].size(),
+                               value ) )
+               return false;
+            sides[c].emplace_back( *rowidx, value );
+         }
+         return true;
+      };
+
+      if( !forEachLine( boundaries[c], boundaries[c + 1], section.key,
+                        parseLine ) )
+         failed = true;
+   } );
+
+   if( failed )
+      return false;
+
+   // a range depends on the side, the sections are applied in file order
+   for( const Vec<std::pair<int, REAL>>& chunk : sides )
+   {
+      for( const std::pair<int, REAL>& side : chunk )
+      {
+         if( ranges )
+            setRange( side.first, side.second );
+         else
+            setRhs( side.first, side.second );
+      }
+   }
+
+   return true;
+}
+
+template <typename REAL>
+bool
+MpsParser<REAL>::parseMappedBounds( const Section& section,
+                                    std::size_t chunk_size )
+{
+   const Vec<const char*> boundaries =
+       splitChunks( section.begin, section.end, chunk_size );
+   const int nchunks = static_cast<int>( boundaries.size() ) - 1;
+   Vec<Vec<BoundEntry>> bounds( static_cast<std::size_t>( nchunks ) );
+   std::atomic<bool> failed{ false };
+
+   parallelFor( nchunks, [&]( int c ) {
+      auto parseLine = [&]( const boost::string_ref* tokens, int ntokens ) {
+         BoundEntry bound{ BoundSpec(), -1, REAL{ 0.0 } };
+         if( ntokens < 3 || !parseBoundType( tokens[0], bound.spec ) ||
+             ( !bound.spec.isdefaultbound && ntokens != 4 ) )
+            return false;
+
+         const int* colidx = colmap.find( tokens[2] );
+         if( colidx == nullptr )
+            return false;
+         bound.col = *colidx;
+
+         if( !bound.spec.isdefaultbound &&
+             parse_decimal( tokens[3].data(),
+                            tokens[3].data() + tokens[3].size(), bound.val ) )
+            return false;
+
+         bounds[c].push_back( bound );
+         return true;
+      };
+
+      if( !forEachLine( boundaries[c], boundaries[c + 1], kNone,
+                        parseLine ) )
+         failed = true;
+   } );
+
+   if( failed )
+      return false;
+
+   Vec<bool> ub_is_default( lb4cols.size(), true );
+   Vec<bool> lb_is_default( lb4cols.size(), true );
+
+   for( const Vec<BoundEntry>& chunk : bounds )
+   {
+      for( const BoundEntry& bound : chunk )
+      {
+         if( bound.spec.isdefaultbound )
+            setDefaultBound( bound.spec, bound.col );
+         else
+            setBound( bound.spec, bound.col, bound.val, lb_is_default,
+                      ub_is_default );
+      }
+   }
+
+   return true;
+}
+
+template <typename REAL>
+bool
+MpsParser<REAL>::parseMappedFile( const std::string& filename,
+                                  std::size_t chunk_size )
+{
+   MappedFile file( filename );
+   if( !file.isOpen() )
+      return false;
+
+   Vec<Section> sections;
+   if( !splitSections( file.data(), file.data() + file.size(), sections ) )
+      return false;
+
+   bool hasrows = false;
+   bool hascols = false;
+   for( const Section& section : sections )
+   {
+      bool success = true;
+      switch( section.key )
+      {
+      case kObjSense:
+         success = parseMappedObjSense( section );
+         break;
+      case kRows:
+         success = !hasrows && parseMappedRows( section );
+         hasrows = true;
+         break;
+      case kCols:
+         success = hasrows && !hascols &&
+                   parseMappedCols( section, chunk_size );
+         hascols = true;
+         break;
+      case kRhs:
+      case kRanges:
+         success = hasrows && parseMappedSides( section, chunk_size );
+         break;
+      case kBounds:
+         success = hascols && parseMappedBounds( section, chunk_size );
+         break;
+      default:
+         assert( section.key == kEnd );
+         break;
+      }
+      if( !success )
+         return false;
+   }
+
+   if( !hasrows )
+      return false;
+
+   if( !hascols )
+   {
+      cscstart.assign( 1, 0 );
+      nnz = 0;
+   }
+
+   nCols = static_cast<int>( colnames.size() );
+   nRows = static_cast<int>( rownames.size() );
+
+   // the names of the maps are invalidated with the file
+   rowmap = NameIndexMap();
+   colmap = NameIndexMap();
+
+   return true;
+}
+
 } // namespace papilo
 
 #endif /* _PAPILO_IO_MPS_PARSER_HPP_ */
@@ -31,9 +31,18 @@
 #include "papilo/misc/fmt.hpp"
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
+#include <algorithm>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#ifdef PAPILO_TBB
+#include "papilo/misc/tbb.hpp"
+#endif
 
 #ifdef PAPILO_USE_BOOST_IOSTREAMS_WITH_BZIP2
 #include <boost/iostreams/filter/bzip2.hpp>
@@ -45,13 +54,138 @@
 namespace papilo
 {
 
+/// writes buffers to a file in the order in which they are passed. A file
+/// ending in .gz is compressed by a separate thread, so that compressing
+/// overlaps with formatting the next buffers.
+class MpsOutputFile
+{
+ public:
+   explicit MpsOutputFile( const std::string& filename )
+       : file( filename, std::ofstream::out | std::ofstream::binary )
+   {
+#ifdef PAPILO_USE_BOOST_IOSTREAMS_WITH_ZLIB
+      if( boost::algorithm::ends_with( filename, ".gz" ) )
+         compressor = std::thread( [this]() { compress(); } );
+#endif
+   }
+
+   MpsOutputFile( const MpsOutputFile& ) = delete;
+
+   MpsOutputFile&
+   operator=( const MpsOutputFile& ) = delete;
+
+   ~MpsOutputFile() { close(); }
+
+   /// takes the contents of the buffer and leaves it empty
+   void
+   write( fmt::memory_buffer& buffer )
+   {
+      if( buffer.size() == 0 )
+         return;
+
+      if( !compressor.joinable() )
+         file.write( buffer.data(),
+                     static_cast<std::streamsize>( buffer.size() ) );
+      else
+      {
+         std::unique_lock<std::mutex> lock( mutex );
+         space.wait( lock, [this]() { return queue.size() < MAX_QUEUED; } );
+         queue.push_back( std::move( buffer ) );
+         filled.notify_one();
+      }
+      buffer.clear();
+   }
+
+   void
+   close()
+   {
+      if( compressor.joinable() )
+      {
+         {
+            std::lock_guard<std::mutex> lock( mutex );
+            finished = true;
+         }
+         filled.notify_one();
+         compressor.join();
+      }
+      if( file.is_open() )
+         file.close();
+   }
+
+ private:
+   /// number of buffers waiting for the compressor before write() blocks
+   static constexpr std::size_t MAX_QUEUED = 8;
+
+#ifdef PAPILO_USE_BOOST_IOSTREAMS_WITH_ZLIB
+   void
+   compress()
+   {
+      boost::iostreams::filtering_ostream out;
+      out.push( boost::iostreams::gzip_compressor() );
+      out.push( file );
+
+      while( true )
+      {
+         fmt::memory_buffer buffer;
+         {
+            std::unique_lock<std::mutex> lock( mutex );
+            filled.wait( lock,
+                         [this]() { return finished || !queue.empty(); } );
+            if( queue.empty() )
+               break;
+            buffer = std::move( queue.front() );
+            queue.pop_front();
+         }
+         space.notify_one();
+         out.write( buffer.data(),
+                    static_cast<std::streamsize>( buffer.size() ) );
+      }
+      out.reset();
+   }
+#endif
+
+   std::ofstream file;
+   std::thread compressor;
+   std::mutex mutex;
+   std::condition_variable filled;
+   std::condition_variable space;
+   std::deque<fmt::memory_buffer> queue;
+   bool finished = false;
+};
+
 /// Writer to write problem structures into an mps file
 template <typename REAL>
 struct MpsWriter
 {
+   /// number of nonzeros of the COLUMNS section that the buffered writer
+   /// formats in one task
+   static constexpr int DEFAULT_CHUNK_SIZE = 1 << 12;
+
+   /// writes the problem with writeBufferedProb(), only bzip2 compressed
+   /// files are written by the stream writer
    static void
    writeProb( const std::string& filename, const Problem<REAL>& prob,
               const Vec<int>& row_mapping, const Vec<int>& col_mapping )
+   {
+      if( boost::algorithm::ends_with( filename, ".bz2" ) )
+         writeStreamedProb( filename, prob, row_mapping, col_mapping );
+      else
+         writeBufferedProb( filename, prob, row_mapping, col_mapping );
+   }
+
+   /// writes the file with the same content as writeStreamedProb(). The
+   /// COLUMNS section is formatted in parallel chunks of about chunk_size
+   /// nonzeros into memory buffers that are written in order with large
+   /// writes.
+   static void
+   writeBufferedProb( const std::string& filename, const Problem<REAL>& prob,
+                      const Vec<int>& row_mapping, const Vec<int>& col_mapping,
+                      int chunk_size = DEFAULT_CHUNK_SIZE );
+
+   /// writes every line directly into the, possibly compressed, stream
+   static void
+   writeStreamedProb( const std::string& filename, const Problem<REAL>& prob,
+                      const Vec<int>& row_mapping, const Vec<int>& col_mapping )
    {
       const ConstraintMatrix<REAL>& consmatrix = prob.getConstraintMatrix();
       const Vec<std::string>& consnames = prob.getConstraintNames();
@@ -246,8 +380,279 @@ struct MpsWriter
       fmt::print( out, "ENDATA\n" );
       //TODO: add symmetries
    }
+
+ private:
+   /// number of chunks that are formatted before they are written
+   static constexpr int CHUNKS_PER_BATCH = 64;
+
+   /// size of the buffer of the other sections before it is written
+   static constexpr std::size_t FLUSH_SIZE = 1 << 20;
+
+   static void
+   formatColumns( fmt::memory_buffer& buffer, const Problem<REAL>& prob,
+                  const Vec<int>& row_mapping, const Vec<int>& col_mapping,
+                  const int* first, const int* last );
 };
 
+template <typename REAL>
+void
+MpsWriter<REAL>::formatColumns( fmt::memory_buffer& buffer,
+                                const Problem<REAL>& prob,
+                                const Vec<int>& row_mapping,
+                                const Vec<int>& col_mapping, const int* first,
+                                const int* last )
+{
+   const ConstraintMatrix<REAL>& consmatrix = prob.getConstraintMatrix();
+   const Vec<std::string>& consnames = prob.getConstraintNames();
+   const Vec<std::string>& varnames = prob.getVariableNames();
+   const Objective<REAL>& obj = prob.getObjective();
+   auto out = std::back_inserter( buffer );
+
+   for( const int* col = first; col != last; ++col )
+   {
+      const int i = *col;
+      if( obj.coefficients[i] != 0.0 )
+      {
+         auto coeff = prob.is_objective_negated() ? -obj.coefficients[i]
+                                                  : obj.coefficients[i];
+         fmt::format_to( out, "    {:<9} OBJ       {:}\n",
+                         varnames[col_mapping[i]], coeff );
+      }
+
+      SparseVectorView<REAL> column = consmatrix.getColumnCoefficients( i );
+
+      const int* rowinds = column.getIndices();
+      const REAL* colvals = column.getValues();
+      int len = column.getLength();
+
+      for( int j = 0; j < len; ++j )
+      {
+         int r = rowinds[j];
+
+         // discard redundant rows when writing problem
+         if( consmatrix.isRowRedundant( r ) )
+            continue;
+
+         fmt::format_to( out, "    {:<9} {:<9} {:}\n",
+                         varnames[col_mapping[i]], consnames[row_mapping[r]],
+                         colvals[j] );
+      }
+   }
+}
+
+template <typename REAL>
+void
+MpsWriter<REAL>::writeBufferedProb( const std::string& filename,
+                                    const Problem<REAL>& prob,
+                                    const Vec<int>& row_mapping,
+                                    const Vec<int>& col_mapping,
+                                    int chunk_size )
+{
+   const ConstraintMatrix<REAL>& consmatrix = prob.getConstraintMatrix();
+   const Vec<std::string>& consnames = prob.getConstraintNames();
+   const Vec<std::string>& varnames = prob.getVariableNames();
+   const Vec<REAL>& lhs = consmatrix.getLeftHandSides();
+   const Vec<REAL>& rhs = consmatrix.getRightHandSides();
+   const Objective<REAL>& obj = prob.getObjective();
+   const Vec<ColFlags>& col_flags = prob.getColFlags();
+   const Vec<RowFlags>& row_flags = prob.getRowFlags();
+
+   MpsOutputFile file( filename );
+   fmt::memory_buffer buffer;
+   auto out = std::back_inserter( buffer );
+   auto flush = [&]()
+   {
+      if( buffer.size() >= FLUSH_SIZE )
+         file.write( buffer );
+   };
+
+   fmt::format_to( out, "*ROWS:         {}\n", consmatrix.getNRows() );
+   fmt::format_to( out, "*COLUMNS:      {}\n", consmatrix.getNCols() );
+   fmt::format_to( out, "*INTEGER:      {}\n", prob.getNumIntegralCols() );
+   fmt::format_to( out, "*NONZERO:      {}\n*\n*\n", consmatrix.getNnz() );
+
+   fmt::format_to( out, "NAME          {}\n", prob.getName() );
+   fmt::format_to( out, "ROWS\n" );
+   fmt::format_to( out, " N  OBJ\n" );
+   bool hasRangedRow = false;
+   for( int i = 0; i < consmatrix.getNRows(); ++i )
+   {
+      assert( !consmatrix.isRowRedundant( i ) );
+      char type;
+
+      if( row_flags[i].test( RowFlag::kLhsInf ) &&
+          row_flags[i].test( RowFlag::kRhsInf ) )
+         type = 'N';
+      else if( row_flags[i].test( RowFlag::kRhsInf ) )
+         type = 'G';
+      else if( row_flags[i].test( RowFlag::kLhsInf ) )
+         type = 'L';
+      else
+      {
+         if( !row_flags[i].test( RowFlag::kEquation ) )
+            hasRangedRow = true;
+         type = 'E';
+      }
+
+      fmt::format_to( out, " {}  {}\n", type, consnames[row_mapping[i]] );
+      flush();
+   }
+
+   fmt::format_to( out, "COLUMNS\n" );
+
+   // the active columns in the order of the stream writer, the continuous
+   // columns come before the integral ones
+   Vec<int> columns[2];
+   for( int i = 0; i < consmatrix.getNCols(); ++i )
+   {
+      if( col_flags[i].test( ColFlag::kInactive ) )
+         continue;
+
+      assert( !col_flags[i].test( ColFlag::kFixed, ColFlag::kSubstituted ) );
+      columns[col_flags[i].test( ColFlag::kIntegral )].push_back( i );
+   }
+
+   int hasintegral = prob.getNumIntegralCols() != 0;
+
+   for( int integral = 0; integral <= hasintegral; ++integral )
+   {
+      if( integral )
+         fmt::format_to( out,
+                         "    MARK0000  'MARKER'                 'INTORG'\n" );
+      file.write( buffer );
+
+      // the columns are split into chunks of about chunk_size nonzeros
+      const Vec<int>& group = columns[integral];
+      Vec<int> chunk_start{ 0 };
+      int nnz = 0;
+      for( int k = 0; k < (int)group.size(); ++k )
+      {
+         nnz += consmatrix.getColumnCoefficients( group[k] ).getLength() + 1;
+         if( nnz >= chunk_size )
+         {
+            chunk_start.push_back( k + 1 );
+            nnz = 0;
+         }
+      }
+      if( chunk_start.back() != (int)group.size() )
+         chunk_start.push_back( (int)group.size() );
+
+      const int nchunks = (int)chunk_start.size() - 1;
+      Vec<fmt::memory_buffer> chunks( std::min( nchunks, CHUNKS_PER_BATCH ) );
+      for( int batch = 0; batch < nchunks; batch += CHUNKS_PER_BATCH )
+      {
+         const int batch_end = std::min( batch + CHUNKS_PER_BATCH, nchunks );
+         auto format = [&]( int first, int last )
+         {
+            for( int c = first; c != last; ++c )
+               formatColumns( chunks[c - batch], prob, row_mapping,
+                              col_mapping, group.data() + chunk_start[c],
+                              group.data() + chunk_start[c + 1] );
+         };
+#ifdef PAPILO_TBB
+         tbb::parallel_for( tbb::blocked_range<int>( batch, batch_end, 1 ),
+                            [&]( const tbb::blocked_range<int>& r )
+                            { format( r.begin(), r.end() ); } );
+#else
+         format( batch, batch_end );
+#endif
+         for( int c = batch; c != batch_end; ++c )
+            file.write( chunks[c - batch] );
+      }
+
+      if( integral )
+         fmt::format_to( out,
+                         "    MARK0000  'MARKER'                 'INTEND'\n" );
+   }
+
+   const Vec<REAL>& lower_bounds = prob.getLowerBounds();
+   const Vec<REAL>& upper_bounds = prob.getUpperBounds();
+
+   fmt::format_to( out, "RHS\n" );
+
+   if( obj.offset != REAL{ 0.0 } )
+      fmt::format_to( out, "    B         {:<9} {:}\n", "OBJ",
+                      prob.is_objective_negated() ? -obj.offset : obj.offset );
+
+   for( int i = 0; i < consmatrix.getNRows(); ++i )
+   {
+      // discard redundant rows when writing problem
+      if( consmatrix.isRowRedundant( i ) )
+         continue;
+
+      if( row_flags[i].test( RowFlag::kLhsInf ) &&
+          row_flags[i].test( RowFlag::kRhsInf ) )
+         continue;
+
+      if( row_flags[i].test( RowFlag::kLhsInf ) )
+      {
+         if( rhs[i] != REAL{ 0.0 } )
+            fmt::format_to( out, "    B         {:<9} {:}\n",
+                            consnames[row_mapping[i]], rhs[i] );
+      }
+      else
+      {
+         if( lhs[i] != REAL{ 0.0 } )
+            fmt::format_to( out, "    B         {:<9} {:}\n",
+                            consnames[row_mapping[i]], lhs[i] );
+      }
+      flush();
+   }
+
+   if( hasRangedRow )
+   {
+      fmt::format_to( out, "RANGES\n" );
+      for( int i = 0; i < consmatrix.getNRows(); ++i )
+      {
+         if( row_flags[i].test( RowFlag::kLhsInf, RowFlag::kRhsInf,
+                                RowFlag::kEquation, RowFlag::kRedundant ) )
+            continue;
+
+         REAL rangeval{ rhs[i] - lhs[i] };
+
+         if( rangeval != 0 )
+            fmt::format_to( out, "    B         {:<9} {:}\n",
+                            consnames[row_mapping[i]], rangeval );
+         flush();
+      }
+   }
+
+   fmt::format_to( out, "BOUNDS\n" );
+
+   for( int i = 0; i < consmatrix.getNCols(); ++i )
+   {
+      if( col_flags[i].test( ColFlag::kInactive ) )
+         continue;
+
+      const std::string& name = varnames[col_mapping[i]];
+      if( !col_flags[i].test( ColFlag::kLbInf ) &&
+          !col_flags[i].test( ColFlag::kUbInf ) &&
+          lower_bounds[i] == upper_bounds[i] )
+      {
+         fmt::format_to( out, " FX BND       {:<9} {:}\n", name,
+                         lower_bounds[i] );
+      }
+      else
+      {
+         if( col_flags[i].test( ColFlag::kLbInf ) )
+            fmt::format_to( out, " MI BND       {}\n", name );
+         else if( lower_bounds[i] != 0.0 )
+            fmt::format_to( out, " LO BND       {:<9} {:}\n", name,
+                            lower_bounds[i] );
+
+         if( !col_flags[i].test( ColFlag::kUbInf ) )
+            fmt::format_to( out, " UP BND       {:<9} {:}\n", name,
+                            upper_bounds[i] );
+         else
+            fmt::format_to( out, " PL BND       {:<9}\n", name );
+      }
+      flush();
+   }
+   fmt::format_to( out, "ENDATA\n" );
+   file.write( buffer );
+   file.close();
+}
+
 } // namespace papilo
 
 #endif
@@ -0,0 +1,141 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef _PAPILO_IO_NAME_INDEX_MAP_HPP_
+#define _PAPILO_IO_NAME_INDEX_MAP_HPP_
+
+#include "papilo/misc/Vec.hpp"
+#include <boost/utility/string_ref.hpp>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace papilo
+{
+
+/// maps names to indices with open addressing and linear probing. The map
+/// only references the characters of the names, which must outlive it. Sized
+/// in advance with the expected number of names it does not need to rehash.
+class NameIndexMap
+{
+ public:
+   explicit NameIndexMap( std::size_t expected_size = 0 )
+   {
+      reserve( expected_size );
+   }
+
+   void
+   reserve( std::size_t expected_size )
+   {
+      std::size_t capacity = 16;
+      while( capacity < 2 * expected_size )
+         capacity *= 2;
+      if( capacity <= slots.size() )
+         return;
+
+      slots.assign( capacity, Slot{ 0, -1 } );
+      mask = capacity - 1;
+      for( int k = 0; k != static_cast<int>( names.size() ); ++k )
+      {
+         const uint64_t h = hash( names[k] );
+         slots[findSlot( names[k], h )] = Slot{ h, k };
+      }
+      names.reserve( expected_size );
+      indices.reserve( expected_size );
+   }
+
+   /// returns false and leaves the map unchanged if the name is already
+   /// contained
+   bool
+   insert( boost::string_ref name, int index )
+   {
+      if( 2 * ( names.size() + 1 ) > slots.size() )
+         reserve( 2 * names.size() + 1 );
+
+      const uint64_t h = hash( name );
+      const std::size_t slot = findSlot( name, h );
+      if( slots[slot].entry != -1 )
+         return false;
+
+      slots[slot] = Slot{ h, static_cast<int>( names.size() ) };
+      names.push_back( name );
+      indices.push_back( index );
+      return true;
+   }
+
+   /// returns nullptr if the name is not contained
+   const int*
+   find( boost::string_ref name ) const
+   {
+      const std::size_t slot = findSlot( name, hash( name ) );
+      if( slots[slot].entry == -1 )
+         return nullptr;
+      return &indices[slots[slot].entry];
+   }
+
+   std::size_t
+   size() const
+   {
+      return names.size();
+   }
+
+ private:
+   struct Slot
+   {
+      uint64_t hash;
+      int entry;
+   };
+
+   /// FNV-1a
+   static uint64_t
+   hash( boost::string_ref name )
+   {
+      uint64_t h = UINT64_C( 14695981039346656037 );
+      for( char c : name )
+      {
+         h ^= static_cast<unsigned char>( c );
+         h *= UINT64_C( 1099511628211 );
+      }
+      return h;
+   }
+
+   /// the slot containing the name or the empty slot where it belongs
+   std::size_t
+   findSlot( boost::string_ref name, uint64_t h ) const
+   {
+      assert( names.size() < slots.size() );
+      std::size_t slot = static_cast<std::size_t>( h ^ ( h >> 32 ) ) & mask;
+      while( slots[slot].entry != -1 &&
+             ( slots[slot].hash != h || names[slots[slot].entry] != name ) )
+         slot = ( slot + 1 ) & mask;
+      return slot;
+   }
+
+   Vec<Slot> slots;
+   std::size_t mask = 0;
+   Vec<boost::string_ref> names;
+   Vec<int> indices;
+};
+
+} // namespace papilo
+
+#endif
@@ -28,6 +28,8 @@
 #include "papilo/Config.hpp"
 #include "papilo/io/MpsParser.hpp"
 #include "papilo/io/OpbParser.hpp"
+#include "papilo/io/ProblemSnapshot.hpp"
+#include <boost/algorithm/string/predicate.hpp>
 #ifdef PAPILO_USE_BOOST_IOSTREAMS_WITH_BZIP2
 #include <boost/iostreams/filter/bzip2.hpp>
 #endif
@@ -46,7 +48,9 @@ class Parser
    static boost::optional<Problem<REAL>>
    loadProblem( const std::string& filename )
    {
-      if( filename.find(".mps") != std::string::npos)
+      if( boost::algorithm::ends_with( filename, ".papilo" ) )
+         return ProblemSnapshot<REAL>::loadProblem( filename );
+      else if( filename.find(".mps") != std::string::npos)
          return MpsParser<REAL>::loadProblem( filename );
       else if( filename.find(".opb") != std::string::npos)
          return OpbParser<REAL>::loadProblem( filename );
@@ -0,0 +1,536 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef _PAPILO_IO_PROBLEM_SNAPSHOT_HPP_
+#define _PAPILO_IO_PROBLEM_SNAPSHOT_HPP_
+
+#include "papilo/core/ConstraintMatrix.hpp"
+#include "papilo/core/Problem.hpp"
+#include "papilo/core/SparseStorage.hpp"
+#include "papilo/misc/MappedFile.hpp"
+#include "papilo/misc/String.hpp"
+#include "papilo/misc/Vec.hpp"
+#include <boost/optional.hpp>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+
+namespace papilo
+{
+
+/// sections of the problem snapshot format in file order, every section
+/// starts at an offset that is a multiple of 8
+enum class SnapshotSection : int
+{
+   kObjective = 0,
+   kLowerBounds = 1,
+   kUpperBounds = 2,
+   kColFlags = 3,
+   kLhs = 4,
+   kRhs = 5,
+   kRowFlags = 6,
+   kRowStart = 7,
+   kRowIndices = 8,
+   kRowValues = 9,
+   /// the transposed matrix, empty if it was not written
+   kColStart = 10,
+   kColIndices = 11,
+   kColValues = 12,
+   /// objective offset
+   kParameters = 13,
+   /// string table holding the problem name followed by the column and the
+   /// row names, entry i is stored at [start[i], start[i + 1])
+   kNameStart = 14,
+   kNameData = 15,
+};
+
+constexpr int NUM_SNAPSHOT_SECTIONS = 16;
+
+/// file header of the problem snapshot format. All fields are stored
+/// little-endian, the sizes count elements and not bytes.
+struct ProblemSnapshotHeader
+{
+   char magic[8];
+   std::uint32_t version;
+   /// 0x01020304 as written by the host, rejects files of other byte orders
+   std::uint32_t byte_order;
+   std::uint32_t real_size;
+   std::uint32_t flags;
+   /// ProblemFlags of the problem
+   std::uint32_t problem_type;
+   std::uint32_t ncols;
+   std::uint32_t nrows;
+   std::uint32_t reserved;
+   std::uint64_t offset[NUM_SNAPSHOT_SECTIONS];
+   std::uint64_t size[NUM_SNAPSHOT_SECTIONS];
+};
+
+/// binary snapshot of a Problem in a flat, versioned layout. The constraint
+/// matrix is stored in CSR format together with its transpose, so loading a
+/// snapshot only copies the mapped arrays into the sparse storages without
+/// sorting or transposing. Symmetries and implications are not part of the
+/// format.
+template <typename REAL>
+class ProblemSnapshot
+{
+ public:
+   static constexpr std::uint32_t VERSION = 1;
+   static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+   static constexpr std::uint32_t HAS_TRANSPOSE = 1;
+   static constexpr std::uint32_t OBJECTIVE_NEGATED = 2;
+   static constexpr std::uint32_t HAS_COL_NAMES = 4;
+   static constexpr std::uint32_t HAS_ROW_NAMES = 8;
+
+   /// writes the problem, returns false if the file cannot be written or the
+   /// host is not little-endian. Without the transpose the file is smaller
+   /// but loading it has to transpose the matrix.
+   static bool
+   writeProb( const std::string& filename, const Problem<REAL>& prob,
+              bool with_transpose = true )
+   {
+      return write( filename, prob, nullptr, nullptr, with_transpose );
+   }
+
+   /// writes a reduced problem whose names are still indexed by the original
+   /// rows and columns, like MpsWriter::writeProb()
+   static bool
+   writeProb( const std::string& filename, const Problem<REAL>& prob,
+              const Vec<int>& row_mapping, const Vec<int>& col_mapping,
+              bool with_transpose = true )
+   {
+      return write( filename, prob, row_mapping.data(), col_mapping.data(),
+                    with_transpose );
+   }
+
+   /// maps the file and builds the problem from it, returns none if the file
+   /// cannot be mapped or does not match the format of this version
+   static boost::optional<Problem<REAL>>
+   loadProblem( const std::string& filename );
+
+ private:
+   static constexpr char MAGIC[8] = { 'P', 'A', 'P', 'I', 'L', 'O', 'P', 'B' };
+
+   static bool
+   isLittleEndian()
+   {
+      const std::uint32_t mark = BYTE_ORDER_MARK;
+      unsigned char first;
+      std::memcpy( &first, &mark, 1 );
+      return first == 0x04;
+   }
+
+   static std::size_t
+   getElementSize( SnapshotSection section );
+
+   static bool
+   write( const std::string& filename, const Problem<REAL>& prob,
+          const int* row_mapping, const int* col_mapping,
+          bool with_transpose );
+
+   template <typename T>
+   static const T*
+   getSection( const MappedFile& file, const ProblemSnapshotHeader& header,
+               SnapshotSection section )
+   {
+      return reinterpret_cast<const T*>(
+          file.data() + header.offset[static_cast<int>( section )] );
+   }
+
+   template <typename T>
+   static Vec<T>
+   copySection( const MappedFile& file, const ProblemSnapshotHeader& header,
+                SnapshotSection section )
+   {
+      const T* data = getSection<T>( file, header, section );
+      return Vec<T>( data, data + header.size[static_cast<int>( section )] );
+   }
+
+   template <typename T>
+   static void
+   writeSection( std::ofstream& out, ProblemSnapshotHeader& fileheader,
+                 SnapshotSection section, const T* data, std::size_t size );
+
+   /// checks a matrix in CSR format before it is copied without sorting
+   static bool
+   isValidMatrix( const int* start, const int* indices, std::size_t nnz,
+                  int nrows, int ncols )
+   {
+      return start[0] == 0 && static_cast<std::size_t>( start[nrows] ) == nnz &&
+             SparseStorage<REAL>::isSortedAndUnique( start, indices, nrows,
+                                                     ncols );
+   }
+};
+
+template <typename REAL>
+constexpr char ProblemSnapshot<REAL>::MAGIC[8];
+
+template <typename REAL>
+std::size_t
+ProblemSnapshot<REAL>::getElementSize( SnapshotSection section )
+{
+   switch( section )
+   {
+   case SnapshotSection::kRowStart:
+   case SnapshotSection::kRowIndices:
+   case SnapshotSection::kColStart:
+   case SnapshotSection::kColIndices:
+      return sizeof( int );
+   case SnapshotSection::kColFlags:
+      return sizeof( ColFlags );
+   case SnapshotSection::kRowFlags:
+      return sizeof( RowFlags );
+   case SnapshotSection::kNameStart:
+      return sizeof( std::uint64_t );
+   case SnapshotSection::kNameData:
+      return sizeof( char );
+   case SnapshotSection::kObjective:
+   case SnapshotSection::kLowerBounds:
+   case SnapshotSection::kUpperBounds:
+   case SnapshotSection::kLhs:
+   case SnapshotSection::kRhs:
+   case SnapshotSection::kRowValues:
+   case SnapshotSection::kColValues:
+   case SnapshotSection::kParameters:
+      return sizeof( REAL );
+   }
+   return 0;
+}
+
+template <typename REAL>
+template <typename T>
+void
+ProblemSnapshot<REAL>::writeSection( std::ofstream& out,
+                                     ProblemSnapshotHeader& fileheader,
+                                     SnapshotSection section, const T* data,
+                                     std::size_t size )
+{
+   assert( sizeof( T ) == getElementSize( section ) );
+   const char padding[8] = {};
+   std::uint64_t offset = static_cast<std::uint64_t>( out.tellp() );
+   out.write( padding, ( 8 - offset % 8 ) % 8 );
+   offset += ( 8 - offset % 8 ) % 8;
+
+   fileheader.offset[static_cast<int>( section )] = offset;
+   fileheader.size[static_cast<int>( section )] = size;
+   if( size != 0 )
+      out.write( reinterpret_cast<const char*>( data ),
+                 static_cast<std::streamsize>( size * sizeof( T ) ) );
+}
+
+template <typename REAL>
+bool
+ProblemSnapshot<REAL>::write( const std::string& filename,
+                              const Problem<REAL>& prob,
+                              const int* row_mapping, const int* col_mapping,
+                              bool with_transpose )
+{
+   static_assert( sizeof( ColFlags ) == 1 && sizeof( RowFlags ) == 1,
+                  "unexpected size of the stored flags" );
+
+   // REAL values are stored as raw bytes
+   if( !std::is_trivially_copyable<REAL>::value || !isLittleEndian() )
+      return false;
+
+   std::ofstream out( filename, std::ios_base::binary | std::ios_base::trunc );
+   if( !out.is_open() )
+      return false;
+
+   const ConstraintMatrix<REAL>& matrix = prob.getConstraintMatrix();
+   const int ncols = prob.getNCols();
+   const int nrows = prob.getNRows();
+
+   // the matrix is copied without the spare space of the sparse storage
+   auto compress = [&]( int nvectors, bool columns, Vec<int>& start,
+                        Vec<int>& indices, Vec<REAL>& values )
+   {
+      start.reserve( nvectors + 1 );
+      indices.reserve( matrix.getNnz() );
+      values.reserve( matrix.getNnz() );
+      start.push_back( 0 );
+      for( int i = 0; i < nvectors; ++i )
+      {
+         auto entries = columns ? matrix.getColumnCoefficients( i )
+                                : matrix.getRowCoefficients( i );
+         indices.insert( indices.end(), entries.getIndices(),
+                         entries.getIndices() + entries.getLength() );
+         values.insert( values.end(), entries.getValues(),
+                        entries.getValues() + entries.getLength() );
+         start.push_back( (int)indices.size() );
+      }
+   };
+
+   Vec<int> row_start;
+   Vec<int> row_indices;
+   Vec<REAL> row_values;
+   compress( nrows, false, row_start, row_indices, row_values );
+
+   Vec<int> col_start;
+   Vec<int> col_indices;
+   Vec<REAL> col_values;
+   if( with_transpose )
+      compress( ncols, true, col_start, col_indices, col_values );
+
+   ProblemSnapshotHeader fileheader{};
+   std::memcpy( fileheader.magic, MAGIC, sizeof( MAGIC ) );
+   fileheader.version = VERSION;
+   fileheader.byte_order = BYTE_ORDER_MARK;
+   fileheader.real_size = sizeof( REAL );
+   fileheader.ncols = ncols;
+   fileheader.nrows = nrows;
+   if( with_transpose )
+      fileheader.flags |= HAS_TRANSPOSE;
+   if( prob.is_objective_negated() )
+      fileheader.flags |= OBJECTIVE_NEGATED;
+   for( ProblemFlag flag : { ProblemFlag::kMixedInteger, ProblemFlag::kInteger,
+                             ProblemFlag::kLinear, ProblemFlag::kBinary } )
+   {
+      if( prob.test_problem_type( flag ) )
+         fileheader.problem_type |= static_cast<std::uint32_t>( flag );
+   }
+
+   // the names that are missing in the problem are written as empty strings
+   Vec<std::uint64_t> name_start{ 0 };
+   String name_data = prob.getName();
+   name_start.push_back( name_data.size() );
+   auto addNames = [&]( const Vec<String>& names, int n, const int* mapping )
+   {
+      for( int i = 0; i < n; ++i )
+      {
+         std::size_t index = mapping != nullptr ? mapping[i] : i;
+         if( index < names.size() )
+            name_data += names[index];
+         name_start.push_back( name_data.size() );
+      }
+   };
+   if( !prob.getVariableNames().empty() )
+   {
+      fileheader.flags |= HAS_COL_NAMES;
+      addNames( prob.getVariableNames(), ncols, col_mapping );
+   }
+   if( !prob.getConstraintNames().empty() )
+   {
+      fileheader.flags |= HAS_ROW_NAMES;
+      addNames( prob.getConstraintNames(), nrows, row_mapping );
+   }
+
+   const REAL parameters[1] = { prob.getObjective().offset };
+
+   // the header is written again once the offsets are known
+   out.write( reinterpret_cast<const char*>( &fileheader ),
+              sizeof( fileheader ) );
+
+   writeSection( out, fileheader, SnapshotSection::kObjective,
+                 prob.getObjective().coefficients.data(), ncols );
+   writeSection( out, fileheader, SnapshotSection::kLowerBounds,
+                 prob.getLowerBounds().data(), ncols );
+   writeSection( out, fileheader, SnapshotSection::kUpperBounds,
+                 prob.getUpperBounds().data(), ncols );
+   writeSection( out, fileheader, SnapshotSection::kColFlags,
+                 prob.getColFlags().data(), ncols );
+   writeSection( out, fileheader, SnapshotSection::kLhs,
+                 matrix.getLeftHandSides().data(), nrows );
+   writeSection( out, fileheader, SnapshotSection::kRhs,
+                 matrix.getRightHandSides().data(), nrows );
+   writeSection( out, fileheader, SnapshotSection::kRowFlags,
+                 prob.getRowFlags().data(), nrows );
+   writeSection( out, fileheader, SnapshotSection::kRowStart,
+                 row_start.data(), row_start.size() );
+   writeSection( out, fileheader, SnapshotSection::kRowIndices,
+                 row_indices.data(), row_indices.size() );
+   writeSection( out, fileheader, SnapshotSection::kRowValues,
+                 row_values.data(), row_values.size() );
+   writeSection( out, fileheader, SnapshotSection::kColStart,
+                 col_start.data(), col_start.size() );
+   writeSection( out, fileheader, SnapshotSection::kColIndices,
+                 col_indices.data(), col_indices.size() );
+   writeSection( out, fileheader, SnapshotSection::kColValues,
+                 col_values.data(), col_values.size() );
+   writeSection( out, fileheader, SnapshotSection::kParameters, parameters,
+                 1 );
+   writeSection( out, fileheader, SnapshotSection::kNameStart,
+                 name_start.data(), name_start.size() );
+   writeSection( out, fileheader, SnapshotSection::kNameData,
+                 name_data.data(), name_data.size() );
+
+   out.seekp( 0 );
+   out.write( reinterpret_cast<const char*>( &fileheader ),
+              sizeof( fileheader ) );
+   out.close();
+   return !out.fail();
+}
+
+template <typename REAL>
+boost::optional<Problem<REAL>>
+ProblemSnapshot<REAL>::loadProblem( const std::string& filename )
+{
+   if( !std::is_trivially_copyable<REAL>::value || !isLittleEndian() )
+      return boost::none;
+
+   MappedFile file( filename );
+   if( !file.isOpen() || file.size() < sizeof( ProblemSnapshotHeader ) )
+      return boost::none;
+
+   ProblemSnapshotHeader header;
+   std::memcpy( &header, file.data(), sizeof( header ) );
+   bool valid = std::memcmp( header.magic, MAGIC, sizeof( MAGIC ) ) == 0 &&
+                header.version == VERSION &&
+                header.byte_order == BYTE_ORDER_MARK &&
+                header.real_size == sizeof( REAL ) &&
+                header.ncols <= static_cast<std::uint32_t>( INT_MAX ) &&
+                header.nrows <= static_cast<std::uint32_t>( INT_MAX );
+
+   for( int i = 0; valid && i < NUM_SNAPSHOT_SECTIONS; ++i )
+   {
+      std::uint64_t offset = header.offset[i];
+      std::uint64_t size = header.size[i];
+      std::size_t element_size =
+          getElementSize( static_cast<SnapshotSection>( i ) );
+      valid = offset % 8 == 0 && offset <= file.size() &&
+              size <= ( file.size() - offset ) / element_size;
+   }
+   if( !valid )
+      return boost::none;
+
+   auto getSize = [&]( SnapshotSection section )
+   { return header.size[static_cast<int>( section )]; };
+
+   // the arrays must match the dimensions of the header
+   const int ncols = static_cast<int>( header.ncols );
+   const int nrows = static_cast<int>( header.nrows );
+   const bool transposed = header.flags & HAS_TRANSPOSE;
+   const std::size_t nnz = getSize( SnapshotSection::kRowIndices );
+   const std::size_t nnames = 1 +
+                              ( header.flags & HAS_COL_NAMES ? ncols : 0 ) +
+                              ( header.flags & HAS_ROW_NAMES ? nrows : 0 );
+   valid = getSize( SnapshotSection::kObjective ) == header.ncols &&
+           getSize( SnapshotSection::kLowerBounds ) == header.ncols &&
+           getSize( SnapshotSection::kUpperBounds ) == header.ncols &&
+           getSize( SnapshotSection::kColFlags ) == header.ncols &&
+           getSize( SnapshotSection::kLhs ) == header.nrows &&
+           getSize( SnapshotSection::kRhs ) == header.nrows &&
+           getSize( SnapshotSection::kRowFlags ) == header.nrows &&
+           getSize( SnapshotSection::kRowStart ) == header.nrows + 1u &&
+           getSize( SnapshotSection::kRowValues ) == nnz &&
+           nnz <= static_cast<std::size_t>( INT_MAX ) &&
+           getSize( SnapshotSection::kColStart ) ==
+               ( transposed ? header.ncols + 1u : 0 ) &&
+           getSize( SnapshotSection::kColIndices ) ==
+               ( transposed ? nnz : 0 ) &&
+           getSize( SnapshotSection::kColValues ) ==
+               ( transposed ? nnz : 0 ) &&
+           getSize( SnapshotSection::kParameters ) == 1 &&
+           getSize( SnapshotSection::kNameStart ) == nnames + 1;
+   if( !valid )
+      return boost::none;
+
+   const REAL* row_values =
+       getSection<REAL>( file, header, SnapshotSection::kRowValues );
+   const int* row_start =
+       getSection<int>( file, header, SnapshotSection::kRowStart );
+   const int* row_indices =
+       getSection<int>( file, header, SnapshotSection::kRowIndices );
+   const REAL* col_values =
+       getSection<REAL>( file, header, SnapshotSection::kColValues );
+   const int* col_start =
+       getSection<int>( file, header, SnapshotSection::kColStart );
+   const int* col_indices =
+       getSection<int>( file, header, SnapshotSection::kColIndices );
+   const std::uint64_t* name_start =
+       getSection<std::uint64_t>( file, header, SnapshotSection::kNameStart );
+   const char* name_data =
+       getSection<char>( file, header, SnapshotSection::kNameData );
+
+   // the sparse storage expects sorted vectors, they are checked instead of
+   // sorted since the writer stores them sorted
+   valid = isValidMatrix( row_start, row_indices, nnz, nrows, ncols ) &&
+           ( !transposed ||
+             isValidMatrix( col_start, col_indices, nnz, ncols, nrows ) ) &&
+           name_start[0] == 0 &&
+           name_start[nnames] == getSize( SnapshotSection::kNameData );
+   for( std::size_t i = 0; valid && i < nnames; ++i )
+      valid = name_start[i] <= name_start[i + 1];
+   if( !valid )
+      return boost::none;
+
+   auto getName = [&]( std::size_t i ) {
+      return String( name_data + name_start[i], name_data + name_start[i + 1] );
+   };
+
+   Problem<REAL> problem;
+   problem.setName( getName( 0 ) );
+   problem.setObjective(
+       copySection<REAL>( file, header, SnapshotSection::kObjective ),
+       getSection<REAL>( file, header, SnapshotSection::kParameters )[0] );
+   problem.set_objective_negated( header.flags & OBJECTIVE_NEGATED );
+   problem.setVariableDomains(
+       copySection<REAL>( file, header, SnapshotSection::kLowerBounds ),
+       copySection<REAL>( file, header, SnapshotSection::kUpperBounds ),
+       copySection<ColFlags>( file, header, SnapshotSection::kColFlags ) );
+
+   Vec<REAL> lhs = copySection<REAL>( file, header, SnapshotSection::kLhs );
+   Vec<REAL> rhs = copySection<REAL>( file, header, SnapshotSection::kRhs );
+   Vec<RowFlags> row_flags =
+       copySection<RowFlags>( file, header, SnapshotSection::kRowFlags );
+
+   SparseStorage<REAL> rows( row_values, row_start, row_indices, nrows, ncols,
+                             (int)nnz );
+   if( transposed )
+      problem.setConstraintMatrix( ConstraintMatrix<REAL>{
+          std::move( rows ),
+          SparseStorage<REAL>( col_values, col_start, col_indices, ncols,
+                               nrows, (int)nnz ),
+          std::move( lhs ), std::move( rhs ), std::move( row_flags ) } );
+   else
+      problem.setConstraintMatrix( std::move( rows ), std::move( lhs ),
+                                   std::move( rhs ), std::move( row_flags ) );
+
+   for( ProblemFlag flag : { ProblemFlag::kMixedInteger, ProblemFlag::kInteger,
+                             ProblemFlag::kLinear, ProblemFlag::kBinary } )
+   {
+      if( header.problem_type & static_cast<std::uint32_t>( flag ) )
+         problem.set_problem_type( flag );
+   }
+
+   std::size_t next = 1;
+   auto getNames = [&]( int n )
+   {
+      Vec<String> names;
+      names.reserve( n );
+      for( int i = 0; i < n; ++i )
+         names.push_back( getName( next++ ) );
+      return names;
+   };
+   if( header.flags & HAS_COL_NAMES )
+      problem.setVariableNames( getNames( ncols ) );
+   if( header.flags & HAS_ROW_NAMES )
+      problem.setConstraintNames( getNames( nrows ) );
+
+   return problem;
+}
+
+} // namespace papilo
+
+#endif
@@ -25,13 +25,31 @@
 #ifndef _PAPILO_MISC_ALLOC_HPP_
 #define _PAPILO_MISC_ALLOC_HPP_
 
+#include "papilo/Config.hpp"
 #include <memory>
 
+#ifdef PAPILO_RESOURCE_ALLOCATOR
+#include "papilo/misc/MemoryResource.hpp"
+#endif
+
 namespace papilo
 {
 
+/// with PAPILO_RESOURCE_ALLOCATOR the containers take their memory from the
+/// thread-local pools or the arena that is current, see MemoryResource.hpp
 template <typename T, int = 0>
 struct AllocatorTraits
+{
+#ifdef PAPILO_RESOURCE_ALLOCATOR
+   using type = ResourceAllocator<T>;
+#else
+   using type = std::allocator<T>;
+#endif
+};
+
+/// allocator of strings, see String.hpp
+template <typename T>
+struct AllocatorTraits<T, 1>
 {
    using type = std::allocator<T>;
 };
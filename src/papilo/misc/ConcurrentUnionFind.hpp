@@ -0,0 +1,110 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef _PAPILO_MISC_CONCURRENT_UNION_FIND_HPP_
+#define _PAPILO_MISC_CONCURRENT_UNION_FIND_HPP_
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace papilo
+{
+
+/// union-find over the elements 0 to n - 1 that several threads can update
+/// at the same time without locks. Roots are linked by compare-and-swap and
+/// always to the smaller root, hence the root of a set is its smallest
+/// element independent of the order of the unions. Finds shorten the paths
+/// by path halving.
+class ConcurrentUnionFind
+{
+ public:
+   explicit ConcurrentUnionFind( int n )
+       : nelements( n ), parent( new std::atomic<int>[n] )
+   {
+      for( int i = 0; i != n; ++i )
+         parent[i].store( i, std::memory_order_relaxed );
+   }
+
+   int
+   getSize() const
+   {
+      return nelements;
+   }
+
+   /// returns the root of the set of the given element
+   int
+   find( int x )
+   {
+      int p = parent[x].load( std::memory_order_relaxed );
+      while( p != x )
+      {
+         // parents only ever move to smaller ancestors, so if the exchange
+         // fails another thread already shortened the path
+         int gp = parent[p].load( std::memory_order_relaxed );
+         if( gp != p )
+         {
+            int expected = p;
+            parent[x].compare_exchange_weak( expected, gp,
+                                             std::memory_order_relaxed );
+         }
+         x = gp;
+         p = parent[x].load( std::memory_order_relaxed );
+      }
+      return x;
+   }
+
+   /// merges the sets of the two elements
+   void
+   unite( int x, int y )
+   {
+      while( true )
+      {
+         x = find( x );
+         y = find( y );
+         if( x == y )
+            return;
+
+         if( x < y )
+            std::swap( x, y );
+
+         // link the larger root x below y unless x stopped being a root
+         int expected = x;
+         if( parent[x].compare_exchange_strong( expected, y ) )
+            return;
+      }
+   }
+
+   bool
+   inSameSet( int x, int y )
+   {
+      return find( x ) == find( y );
+   }
+
+ private:
+   int nelements;
+   std::unique_ptr<std::atomic<int>[]> parent;
+};
+
+} // namespace papilo
+
+#endif
@@ -0,0 +1,135 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef _PAPILO_MISC_MAPPED_FILE_HPP_
+#define _PAPILO_MISC_MAPPED_FILE_HPP_
+
+#include "papilo/misc/Vec.hpp"
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define PAPILO_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace papilo
+{
+
+/// read-only view of the contents of a file. The file is memory mapped where
+/// the platform supports it and read into a buffer otherwise. The contents
+/// are not null terminated.
+class MappedFile
+{
+ public:
+   explicit MappedFile( const std::string& filename )
+   {
+#ifdef PAPILO_HAVE_MMAP
+      int fd = ::open( filename.c_str(), O_RDONLY );
+      if( fd == -1 )
+         return;
+      struct stat status;
+      if( ::fstat( fd, &status ) == 0 && S_ISREG( status.st_mode ) )
+      {
+         length = static_cast<std::size_t>( status.st_size );
+         if( length == 0 )
+            opened = true;
+         else
+         {
+            void* address =
+                ::mmap( nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0 );
+            if( address != MAP_FAILED )
+            {
+               // the file is usually read by several threads at once
+               ::madvise( address, length, MADV_WILLNEED );
+               mapping = static_cast<const char*>( address );
+               opened = true;
+            }
+            else
+               length = 0;
+         }
+      }
+      ::close( fd );
+#else
+      std::ifstream file( filename, std::ifstream::in | std::ifstream::binary );
+      if( !file )
+         return;
+      buffer.assign( std::istreambuf_iterator<char>( file ),
+                     std::istreambuf_iterator<char>() );
+      length = buffer.size();
+      opened = !file.bad();
+#endif
+   }
+
+   MappedFile( const MappedFile& ) = delete;
+
+   MappedFile&
+   operator=( const MappedFile& ) = delete;
+
+   ~MappedFile()
+   {
+#ifdef PAPILO_HAVE_MMAP
+      if( mapping != nullptr )
+         ::munmap( const_cast<char*>( mapping ), length );
+#endif
+   }
+
+   bool
+   isOpen() const
+   {
+      return opened;
+   }
+
+   const char*
+   data() const
+   {
+#ifdef PAPILO_HAVE_MMAP
+      return mapping;
+#else
+      return buffer.data();
+#endif
+   }
+
+   std::size_t
+   size() const
+   {
+      return length;
+   }
+
+ private:
+   bool opened = false;
+   std::size_t length = 0;
+#ifdef PAPILO_HAVE_MMAP
+   const char* mapping = nullptr;
+#else
+   Vec<char> buffer;
+#endif
+};
+
+} // namespace papilo
+
+#endif
@@ -0,0 +1,683 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_MISC_MEMORY_RESOURCE_HPP_
+#define _PAPILO_MISC_MEMORY_RESOURCE_HPP_
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace papilo
+{
+
+/// number of calls to malloc and free made by the memory resources, the
+/// counters are global for the process
+struct AllocationCounters
+{
+   uint64_t nsystemallocs = 0;
+   uint64_t nsystemfrees = 0;
+   uint64_t nsystembytes = 0;
+};
+
+enum class MemoryResourceKind : int
+{
+   /// every allocation calls malloc
+   kSystem = 0,
+   /// size class pools of the allocating thread
+   kThreadPool = 1,
+};
+
+/// Source of memory for ResourceAllocator, similar to
+/// std::pmr::memory_resource. Every block starts with a header naming the
+/// resource that owns it, hence a block can be freed through any allocator
+/// and on any thread, independent of the resource that is current there.
+/// Blocks are aligned to 16 bytes.
+class MemoryResource
+{
+ public:
+   virtual ~MemoryResource() = default;
+
+   void*
+   allocate( std::size_t bytes )
+   {
+      return do_allocate( bytes );
+   }
+
+   static void
+   deallocate( void* ptr ) noexcept
+   {
+      Header* header = static_cast<Header*>( ptr ) - 1;
+      header->owner->do_deallocate( header, header->tag );
+   }
+
+   /// the resource used by ResourceAllocator on the calling thread, set by
+   /// ResourceScope, the default resource otherwise
+   static MemoryResource*
+   current();
+
+   /// resource used by threads without a ResourceScope
+   static void
+   setDefault( MemoryResourceKind kind )
+   {
+      default_kind().store( static_cast<int>( kind ),
+                            std::memory_order_relaxed );
+   }
+
+   static MemoryResourceKind
+   getDefault()
+   {
+      return static_cast<MemoryResourceKind>(
+          default_kind().load( std::memory_order_relaxed ) );
+   }
+
+   static AllocationCounters
+   getCounters()
+   {
+      AllocationCounters counters;
+      counters.nsystemallocs =
+          counter( 0 ).load( std::memory_order_relaxed );
+      counters.nsystemfrees = counter( 1 ).load( std::memory_order_relaxed );
+      counters.nsystembytes = counter( 2 ).load( std::memory_order_relaxed );
+      return counters;
+   }
+
+ protected:
+   struct alignas( 16 ) Header
+   {
+      MemoryResource* owner;
+      uintptr_t tag;
+   };
+
+   static constexpr std::size_t HEADER_SIZE = sizeof( Header );
+
+   /// returns the memory for the user of a block of at least bytes +
+   /// HEADER_SIZE bytes
+   virtual void*
+   do_allocate( std::size_t bytes ) = 0;
+
+   /// frees the block with the given header
+   virtual void
+   do_deallocate( Header* header, uintptr_t tag ) noexcept = 0;
+
+   void*
+   finish( void* block, uintptr_t tag )
+   {
+      Header* header = static_cast<Header*>( block );
+      header->owner = this;
+      header->tag = tag;
+      return header + 1;
+   }
+
+   static void*
+   system_allocate( std::size_t bytes )
+   {
+      void* block = std::malloc( bytes );
+      if( block == nullptr )
+         throw std::bad_alloc();
+      counter( 0 ).fetch_add( 1, std::memory_order_relaxed );
+      counter( 2 ).fetch_add( bytes, std::memory_order_relaxed );
+      return block;
+   }
+
+   static void
+   system_free( void* block ) noexcept
+   {
+      counter( 1 ).fetch_add( 1, std::memory_order_relaxed );
+      std::free( block );
+   }
+
+   static std::atomic<uint64_t>&
+   counter( int i )
+   {
+      static std::atomic<uint64_t> counters[3] = {};
+      return counters[i];
+   }
+
+   static std::atomic<int>&
+   default_kind()
+   {
+      static std::atomic<int> kind{
+          static_cast<int>( MemoryResourceKind::kThreadPool ) };
+      return kind;
+   }
+
+   static MemoryResource*&
+   scoped()
+   {
+      static thread_local MemoryResource* resource = nullptr;
+      return resource;
+   }
+
+   friend class ResourceScope;
+};
+
+/// calls malloc and free for every block
+class SystemResource final : public MemoryResource
+{
+ public:
+   static SystemResource*
+   get()
+   {
+      static SystemResource resource;
+      return &resource;
+   }
+
+ protected:
+   void*
+   do_allocate( std::size_t bytes ) override
+   {
+      return finish( system_allocate( bytes + HEADER_SIZE ), 0 );
+   }
+
+   void
+   do_deallocate( Header* header, uintptr_t ) noexcept override
+   {
+      system_free( header );
+   }
+};
+
+/// Pools of free blocks with sizes of powers of two up to 64 KiB, larger
+/// blocks are taken from malloc. Every thread uses a pool of its own, which
+/// is taken over by another thread when the thread exits, so the pools never
+/// release their memory. Blocks freed by another thread are pushed onto a
+/// lock-free list that the owning thread collects when a size class runs
+/// empty.
+class PoolResource final : public MemoryResource
+{
+ public:
+   /// the pool of the calling thread, nullptr while the thread exits
+   static PoolResource*
+   local()
+   {
+      if( leased() == nullptr )
+      {
+         static thread_local Lease lease;
+      }
+      return leased();
+   }
+
+   /// memory taken from malloc by this pool for its size classes
+   std::size_t
+   getReservedBytes() const
+   {
+      return reserved;
+   }
+
+ protected:
+   void*
+   do_allocate( std::size_t bytes ) override
+   {
+      const std::size_t size = bytes + HEADER_SIZE;
+      if( size > ( std::size_t( 1 ) << MAX_CLASS_SHIFT ) )
+         return finish( system_allocate( size ), LARGE );
+
+      int sizeclass = size_class( size );
+      FreeBlock* block = freelists[sizeclass];
+      if( block == nullptr )
+      {
+         collect_remote_frees();
+         block = freelists[sizeclass];
+      }
+      if( block != nullptr )
+         freelists[sizeclass] = block->next;
+      else
+         block = carve( sizeclass );
+
+      return finish( block, static_cast<uintptr_t>( sizeclass ) );
+   }
+
+   void
+   do_deallocate( Header* header, uintptr_t tag ) noexcept override
+   {
+      if( tag == LARGE )
+      {
+         system_free( header );
+         return;
+      }
+
+      // the header stays intact while the block is free, the link is stored
+      // behind it
+      FreeBlock* block = reinterpret_cast<FreeBlock*>( header );
+      if( leased() == this )
+      {
+         block->next = freelists[tag];
+         freelists[tag] = block;
+         return;
+      }
+
+      FreeBlock* head = remote.load( std::memory_order_relaxed );
+      do
+         block->next = head;
+      while( !remote.compare_exchange_weak( head, block,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed ) );
+   }
+
+ private:
+   static constexpr int MIN_CLASS_SHIFT = 5;
+   static constexpr int MAX_CLASS_SHIFT = 16;
+   static constexpr int NUM_CLASSES = MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1;
+   static constexpr std::size_t SLAB_SIZE = std::size_t( 1 ) << 18;
+   static constexpr uintptr_t LARGE = ~uintptr_t( 0 );
+
+   struct FreeBlock
+   {
+      Header header;
+      FreeBlock* next;
+   };
+
+   /// hands out a pool for the lifetime of a thread
+   struct Lease
+   {
+      Lease()
+      {
+         std::lock_guard<std::mutex> lock( registry().mutex );
+         if( registry().idle.empty() )
+            leased() = new PoolResource();
+         else
+         {
+            leased() = registry().idle.back();
+            registry().idle.pop_back();
+         }
+      }
+
+      ~Lease()
+      {
+         std::lock_guard<std::mutex> lock( registry().mutex );
+         registry().idle.push_back( leased() );
+         leased() = nullptr;
+      }
+   };
+
+   /// trivially destructible, hence still readable while the thread exits
+   static PoolResource*&
+   leased()
+   {
+      static thread_local PoolResource* pool = nullptr;
+      return pool;
+   }
+
+   /// pools of exited threads, their blocks may still be in use and they
+   /// are never deleted
+   struct Registry
+   {
+      std::mutex mutex;
+      std::vector<PoolResource*> idle;
+   };
+
+   static Registry&
+   registry()
+   {
+      static Registry* instance = new Registry();
+      return *instance;
+   }
+
+   static int
+   size_class( std::size_t size )
+   {
+      int sizeclass = 0;
+      while( ( std::size_t( 1 ) << ( sizeclass + MIN_CLASS_SHIFT ) ) < size )
+         ++sizeclass;
+      return sizeclass;
+   }
+
+   FreeBlock*
+   carve( int sizeclass )
+   {
+      const std::size_t size = std::size_t( 1 ) << ( sizeclass + MIN_CLASS_SHIFT );
+      if( slab_end - slab_cursor < static_cast<std::ptrdiff_t>( size ) )
+      {
+         // the rest of the current slab is given to the smaller classes
+         for( int c = sizeclass - 1; c >= 0; --c )
+         {
+            const std::size_t csize = std::size_t( 1 )
+                                      << ( c + MIN_CLASS_SHIFT );
+            while( slab_end - slab_cursor >=
+                   static_cast<std::ptrdiff_t>( csize ) )
+            {
+               FreeBlock* block = reinterpret_cast<FreeBlock*>( slab_cursor );
+               block->next = freelists[c];
+               freelists[c] = block;
+               slab_cursor += csize;
+            }
+         }
+
+         slab_cursor = static_cast<char*>( system_allocate( SLAB_SIZE ) );
+         slab_end = slab_cursor + SLAB_SIZE;
+         reserved += SLAB_SIZE;
+      }
+
+      FreeBlock* block = reinterpret_cast<FreeBlock*>( slab_cursor );
+      slab_cursor += size;
+      return block;
+   }
+
+   void
+   collect_remote_frees()
+   {
+      FreeBlock* block = remote.exchange( nullptr, std::memory_order_acquire );
+      while( block != nullptr )
+      {
+         FreeBlock* next = block->next;
+         uintptr_t sizeclass = block->header.tag;
+         block->next = freelists[sizeclass];
+         freelists[sizeclass] = block;
+         block = next;
+      }
+   }
+
+   FreeBlock* freelists[NUM_CLASSES] = {};
+   std::atomic<FreeBlock*> remote{ nullptr };
+   char* slab_cursor = nullptr;
+   char* slab_end = nullptr;
+   std::size_t reserved = 0;
+};
+
+/// Bump allocator in chunks that are reused after reset() once all blocks
+/// in them were freed. Blocks may be freed on any thread and may outlive the
+/// MonotonicArena, the memory is released when the arena and all its blocks
+/// are gone. Only one thread may allocate from an arena at a time. Blocks
+/// larger than 16 KiB are taken from the pool of the allocating thread.
+class MonotonicArena
+{
+ public:
+   MonotonicArena() : resource( new Resource() ) {}
+
+   MonotonicArena( MonotonicArena&& other ) noexcept
+       : resource( other.resource )
+   {
+      other.resource = nullptr;
+   }
+
+   MonotonicArena&
+   operator=( MonotonicArena&& other ) noexcept
+   {
+      std::swap( resource, other.resource );
+      return *this;
+   }
+
+   MonotonicArena( const MonotonicArena& ) = delete;
+
+   MonotonicArena&
+   operator=( const MonotonicArena& ) = delete;
+
+   ~MonotonicArena()
+   {
+      if( resource != nullptr )
+         resource->release();
+   }
+
+   MemoryResource*
+   getResource()
+   {
+      return resource;
+   }
+
+   /// starts again at the first chunk, the chunks with blocks that are still
+   /// in use are skipped until they are freed
+   void
+   reset()
+   {
+      resource->rewind();
+   }
+
+   /// memory taken from malloc for the chunks
+   std::size_t
+   getReservedBytes() const
+   {
+      return resource->reserved;
+   }
+
+ private:
+   class Resource final : public MemoryResource
+   {
+    public:
+      void
+      release()
+      {
+         if( refs.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+            delete this;
+      }
+
+      void
+      rewind()
+      {
+         available = nullptr;
+         current = nullptr;
+         cursor = end = nullptr;
+         // keep the order of the chunks so that a rewound arena hands out
+         // the same memory again
+         Chunk** tail = &available;
+         for( Chunk* chunk = chunks; chunk != nullptr; chunk = chunk->next )
+         {
+            if( chunk->live.load( std::memory_order_acquire ) == 0 )
+            {
+               *tail = chunk;
+               tail = &chunk->next_available;
+            }
+         }
+         *tail = nullptr;
+      }
+
+      std::size_t reserved = 0;
+
+    protected:
+      void*
+      do_allocate( std::size_t bytes ) override
+      {
+         std::size_t size = ( bytes + HEADER_SIZE + 15 ) & ~std::size_t( 15 );
+         if( size > MAX_BLOCK )
+         {
+            PoolResource* pool = PoolResource::local();
+            return pool != nullptr ? pool->allocate( bytes )
+                                   : SystemResource::get()->allocate( bytes );
+         }
+
+         if( end - cursor < static_cast<std::ptrdiff_t>( size ) )
+            next_chunk();
+
+         void* block = cursor;
+         cursor += size;
+         current->live.fetch_add( 1, std::memory_order_relaxed );
+         refs.fetch_add( 1, std::memory_order_relaxed );
+         return finish( block, reinterpret_cast<uintptr_t>( current ) );
+      }
+
+      void
+      do_deallocate( Header*, uintptr_t tag ) noexcept override
+      {
+         reinterpret_cast<Chunk*>( tag )->live.fetch_sub(
+             1, std::memory_order_release );
+         release();
+      }
+
+    private:
+      static constexpr std::size_t MAX_BLOCK = std::size_t( 1 ) << 14;
+      static constexpr std::size_t MIN_CHUNK = std::size_t( 1 ) << 16;
+      static constexpr std::size_t MAX_CHUNK = std::size_t( 1 ) << 22;
+
+      struct alignas( 16 ) Chunk
+      {
+         Chunk* next;
+         Chunk* next_available;
+         std::size_t size;
+         std::atomic<long> live;
+      };
+
+      ~Resource() override
+      {
+         Chunk* chunk = chunks;
+         while( chunk != nullptr )
+         {
+            Chunk* next = chunk->next;
+            chunk->~Chunk();
+            system_free( chunk );
+            chunk = next;
+         }
+      }
+
+      void
+      next_chunk()
+      {
+         // chunks in use are skipped, they were excluded from the available
+         // list by rewind() or are the chunk that just ran full
+         while( available != nullptr && available->live.load(
+                                            std::memory_order_acquire ) != 0 )
+            available = available->next_available;
+
+         Chunk* chunk = available;
+         if( chunk != nullptr )
+            available = chunk->next_available;
+         else
+         {
+            std::size_t size = chunks == nullptr ? MIN_CHUNK : 2 * last_size;
+            if( size > MAX_CHUNK )
+               size = MAX_CHUNK;
+            last_size = size;
+
+            void* memory = system_allocate( size );
+            reserved += size;
+            chunk = new( memory ) Chunk();
+            chunk->size = size;
+            chunk->live.store( 0, std::memory_order_relaxed );
+            chunk->next_available = nullptr;
+
+            // append so that rewind() keeps the order of allocation
+            chunk->next = nullptr;
+            Chunk** tail = &chunks;
+            while( *tail != nullptr )
+               tail = &( *tail )->next;
+            *tail = chunk;
+         }
+
+         current = chunk;
+         cursor = reinterpret_cast<char*>( chunk + 1 );
+         end = reinterpret_cast<char*>( chunk ) + chunk->size;
+      }
+
+      /// one reference of the MonotonicArena and one of every live block
+      std::atomic<long> refs{ 1 };
+      Chunk* chunks = nullptr;
+      Chunk* available = nullptr;
+      Chunk* current = nullptr;
+      char* cursor = nullptr;
+      char* end = nullptr;
+      std::size_t last_size = 0;
+   };
+
+   Resource* resource;
+};
+
+/// makes the given resource current on the calling thread while the scope
+/// exists, nullptr keeps the current resource
+class ResourceScope
+{
+ public:
+   explicit ResourceScope( MemoryResource* resource )
+       : previous( MemoryResource::scoped() )
+   {
+      if( resource != nullptr )
+         MemoryResource::scoped() = resource;
+   }
+
+   ResourceScope( const ResourceScope& ) = delete;
+
+   ResourceScope&
+   operator=( const ResourceScope& ) = delete;
+
+   ~ResourceScope() { MemoryResource::scoped() = previous; }
+
+ private:
+   MemoryResource* previous;
+};
+
+inline MemoryResource*
+MemoryResource::current()
+{
+   MemoryResource* resource = scoped();
+   if( resource != nullptr )
+      return resource;
+
+   PoolResource* pool = nullptr;
+   if( getDefault() == MemoryResourceKind::kThreadPool )
+      pool = PoolResource::local();
+
+   if( pool == nullptr )
+      return SystemResource::get();
+
+   return pool;
+}
+
+/// stateless allocator that takes its memory from the current resource of
+/// the allocating thread
+template <typename T>
+class ResourceAllocator
+{
+ public:
+   using value_type = T;
+
+   ResourceAllocator() noexcept = default;
+
+   template <typename U>
+   ResourceAllocator( const ResourceAllocator<U>& ) noexcept
+   {
+   }
+
+   T*
+   allocate( std::size_t n )
+   {
+      static_assert( alignof( T ) <= 16, "blocks are aligned to 16 bytes" );
+      if( n > std::size_t( -1 ) / sizeof( T ) / 2 )
+         throw std::bad_array_new_length();
+      return static_cast<T*>(
+          MemoryResource::current()->allocate( n * sizeof( T ) ) );
+   }
+
+   void
+   deallocate( T* ptr, std::size_t ) noexcept
+   {
+      MemoryResource::deallocate( ptr );
+   }
+
+   template <typename U>
+   bool
+   operator==( const ResourceAllocator<U>& ) const noexcept
+   {
+      return true;
+   }
+
+   template <typename U>
+   bool
+   operator!=( const ResourceAllocator<U>& ) const noexcept
+   {
+      return false;
+   }
+};
+
+} // namespace papilo
+
+#endif
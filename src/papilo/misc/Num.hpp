@@ -27,6 +27,10 @@
 
 #include "papilo/misc/MultiPrecision.hpp"
 #include "papilo/misc/String.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
 namespace papilo
 {
@@ -530,6 +534,12 @@ class Num
       return hugeval;
    }
 
+   bool
+   getUseAbsFeas() const
+   {
+      return useabsfeas;
+   }
+
    template <typename R>
    bool
    isHugeVal( const R& a ) const
@@ -713,6 +723,125 @@ parse_number( const String& s )
    return { failure, number };
 }
 
+/**
+ * parses the number in [first, last) without allocating for the common case
+ * of decimal numbers, e.g. "-1.5e+3". Other formats are passed to
+ * parse_number.
+ *
+ * @return true if parsing failed, if not value contains the parsed number
+ */
+template <typename REAL>
+bool
+parse_decimal( const char* first, const char* last, REAL& value )
+{
+   std::pair<bool, REAL> result = parse_number<REAL>( String( first, last ) );
+   value = result.second;
+   return result.first;
+}
+
+/// for doubles the digits are accumulated in an integer. If the number has at
+/// most 19 significant digits and the mantissa and the power of ten are exact
+/// doubles, one multiplication or division rounds correctly. Other numbers
+/// are passed to strtod. Numbers out of the range of double are a failure.
+inline bool
+parse_decimal( const char* first, const char* last, double& value )
+{
+   static const double powers_of_ten[] = {
+       1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+   const char* it = first;
+   bool negated = false;
+   if( it != last && ( *it == '+' || *it == '-' ) )
+   {
+      negated = *it == '-';
+      ++it;
+   }
+
+   uint64_t mantissa = 0;
+   int ndigits = 0;
+   int nsignificant = 0;
+   int exponent = 0;
+
+   for( ; it != last && static_cast<unsigned>( *it - '0' ) < 10; ++it )
+   {
+      mantissa = mantissa * 10 + static_cast<unsigned>( *it - '0' );
+      nsignificant += mantissa != 0;
+      ++ndigits;
+   }
+   if( it != last && *it == '.' )
+   {
+      for( ++it; it != last && static_cast<unsigned>( *it - '0' ) < 10; ++it )
+      {
+         mantissa = mantissa * 10 + static_cast<unsigned>( *it - '0' );
+         nsignificant += mantissa != 0;
+         ++ndigits;
+         --exponent;
+      }
+   }
+   if( ndigits == 0 )
+      return true;
+
+   if( it != last && ( *it == 'e' || *it == 'E' ) )
+   {
+      ++it;
+      bool exp_negated = false;
+      if( it != last && ( *it == '+' || *it == '-' ) )
+      {
+         exp_negated = *it == '-';
+         ++it;
+      }
+      if( it == last )
+         return true;
+      int exp_value = 0;
+      for( ; it != last && static_cast<unsigned>( *it - '0' ) < 10; ++it )
+      {
+         if( exp_value < 100000 )
+            exp_value = exp_value * 10 + ( *it - '0' );
+      }
+      exponent += exp_negated ? -exp_value : exp_value;
+   }
+   if( it != last )
+      return true;
+
+   if( nsignificant == 0 )
+   {
+      value = negated ? -0.0 : 0.0;
+      return false;
+   }
+
+   if( nsignificant <= 19 && mantissa <= ( uint64_t{ 1 } << 53 ) &&
+       exponent >= -22 && exponent <= 22 )
+   {
+      value = static_cast<double>( mantissa );
+      value = exponent < 0 ? value / powers_of_ten[-exponent]
+                           : value * powers_of_ten[exponent];
+      value = negated ? -value : value;
+      return false;
+   }
+
+   // strtod needs a terminated string
+   char buffer[64];
+   String copy;
+   const char* str = buffer;
+   const std::size_t length = static_cast<std::size_t>( last - first );
+   if( length < sizeof( buffer ) )
+   {
+      std::memcpy( buffer, first, length );
+      buffer[length] = '\0';
+   }
+   else
+   {
+      copy.assign( first, last );
+      str = copy.c_str();
+   }
+
+   char* end;
+   errno = 0;
+   value = std::strtod( str, &end );
+   return errno == ERANGE || end != str + length;
+}
+
 } // namespace papilo
 
 #endif
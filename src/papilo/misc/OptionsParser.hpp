@@ -187,7 +187,8 @@ struct OptionsInfo
       {
          desc.add_options()( "reduced-problem,r",
                              value( &reduced_problem_file ),
-                             "filename for reduced problem" );
+                             "filename for reduced problem (.mps, .opb or "
+                             "binary .papilo snapshot)" );
 
          desc.add_options()( "parameter-settings,p",
                              value( &param_settings_file ),
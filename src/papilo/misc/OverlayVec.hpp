@@ -0,0 +1,221 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_MISC_OVERLAY_VEC_HPP_
+#define _PAPILO_MISC_OVERLAY_VEC_HPP_
+
+#include "papilo/misc/Vec.hpp"
+#include <cassert>
+#include <cstdint>
+#include <deque>
+
+namespace papilo
+{
+
+/// Modifiable view of a vector that must not change while the view is used.
+/// In dense mode the view holds a full copy of the vector. In sparse mode it
+/// reads through to the vector and keeps only the entries that were accessed
+/// for writing, which are found by an open addressing hash table. Hence the
+/// memory of a sparse view and the cost of restoring it by clear() are
+/// proportional to the number of written entries instead of the size of the
+/// vector. Entries are read by operator[] and written through modify(), so
+/// that reading an entry never copies it. References to entries stay valid
+/// until clear() is called.
+template <typename T>
+class OverlayVec
+{
+ public:
+   OverlayVec( const Vec<T>& base_, bool sparse_ )
+       : base( &base_ ), sparse( sparse_ )
+   {
+      if( !sparse )
+         dense = base_;
+   }
+
+   bool
+   isSparse() const
+   {
+      return sparse;
+   }
+
+   int
+   size() const
+   {
+      return static_cast<int>( base->size() );
+   }
+
+   /// the full copy in dense mode, nullptr in sparse mode
+   const T*
+   data() const
+   {
+      return sparse ? nullptr : dense.data();
+   }
+
+   /// number of entries that are stored in sparse mode
+   int
+   getNumTouched() const
+   {
+      return static_cast<int>( keys.size() );
+   }
+
+   const T&
+   operator[]( int i ) const
+   {
+      assert( i >= 0 && i < size() );
+      if( !sparse )
+         return dense[i];
+
+      int entry = find( i );
+      return entry == -1 ? ( *base )[i] : values[entry];
+   }
+
+   /// write access to an entry, in sparse mode the entry is copied from the
+   /// vector the first time
+   T&
+   modify( int i )
+   {
+      assert( i >= 0 && i < size() );
+      if( !sparse )
+         return dense[i];
+
+      int entry = find( i );
+      if( entry != -1 )
+         return values[entry];
+
+      return values[insert( i )];
+   }
+
+   /// proxy whose operator[] gives write access to the entries, for functions
+   /// that modify the entries of a vector
+   class Writer
+   {
+    public:
+      explicit Writer( OverlayVec& vec_ ) : vec( vec_ ) {}
+
+      T&
+      operator[]( int i )
+      {
+         return vec.modify( i );
+      }
+
+    private:
+      OverlayVec& vec;
+   };
+
+   Writer
+   writer()
+   {
+      return Writer( *this );
+   }
+
+   /// drops all entries written in sparse mode, in dense mode the modified
+   /// entries must be restored by the caller
+   void
+   clear()
+   {
+      if( !sparse )
+         return;
+
+      for( int slot : slots )
+         table[slot] = -1;
+
+      keys.clear();
+      slots.clear();
+      values.clear();
+   }
+
+ private:
+   uint32_t
+   home( int key ) const
+   {
+      return ( static_cast<uint32_t>( key ) * 0x9E3779B9u ) >> shift;
+   }
+
+   int
+   find( int key ) const
+   {
+      if( table.empty() )
+         return -1;
+
+      const uint32_t mask = static_cast<uint32_t>( table.size() ) - 1;
+      for( uint32_t slot = home( key );; slot = ( slot + 1 ) & mask )
+      {
+         int entry = table[slot];
+         if( entry == -1 || keys[entry] == key )
+            return entry;
+      }
+   }
+
+   int
+   place( int entry )
+   {
+      const uint32_t mask = static_cast<uint32_t>( table.size() ) - 1;
+      uint32_t slot = home( keys[entry] );
+      while( table[slot] != -1 )
+         slot = ( slot + 1 ) & mask;
+
+      table[slot] = entry;
+      return static_cast<int>( slot );
+   }
+
+   int
+   insert( int key )
+   {
+      // keep the load factor of the table at most one half
+      if( 2 * ( keys.size() + 1 ) > table.size() )
+      {
+         size_t capacity = table.empty() ? 64 : 2 * table.size();
+         shift = 32;
+         for( size_t c = capacity; c > 1; c >>= 1 )
+            --shift;
+
+         table.assign( capacity, -1 );
+         for( int e = 0; e != static_cast<int>( keys.size() ); ++e )
+            slots[e] = place( e );
+      }
+
+      int entry = static_cast<int>( keys.size() );
+      keys.push_back( key );
+      slots.push_back( -1 );
+      values.push_back( ( *base )[key] );
+      slots[entry] = place( entry );
+
+      return entry;
+   }
+
+   const Vec<T>* base;
+   bool sparse;
+
+   Vec<T> dense;
+
+   // sparse mode: table of entry indices, and the key, slot and value of
+   // each entry; the values are kept in a deque so that references to them
+   // are not invalidated by later insertions
+   Vec<int> table;
+   int shift = 32;
+   Vec<int> keys;
+   Vec<int> slots;
+   std::deque<T, Allocator<T>> values;
+};
+
+} // namespace papilo
+
+#endif
@@ -292,6 +292,22 @@ class ParameterSet
       }
    };
 
+   struct CopyParameterVisitor : public boost::static_visitor<>
+   {
+      template <typename OptionType>
+      void
+      operator()( OptionType& option, const OptionType& source ) const
+      {
+         *option.storage = *source.storage;
+      }
+
+      template <typename OptionType, typename SourceType>
+      void
+      operator()( OptionType&, const SourceType& ) const
+      {
+      }
+   };
+
    std::map<String, Parameter, std::less<>,
             Allocator<std::pair<const String, Parameter>>>
        parameters;
@@ -407,6 +423,21 @@ class ParameterSet
       boost::apply_visitor( visitor, parameters[key].value );
    }
 
+   /// sets every parameter that also exists with the same type in the given
+   /// set to the value it has there
+   void
+   copyValues( const ParameterSet& other )
+   {
+      CopyParameterVisitor visitor;
+      for( auto& param : parameters )
+      {
+         auto it = other.parameters.find( param.first );
+         if( it != other.parameters.end() )
+            boost::apply_visitor( visitor, param.second.value,
+                                  it->second.value );
+      }
+   }
+
    template <typename OutputIt>
    void
    printParams( OutputIt out )
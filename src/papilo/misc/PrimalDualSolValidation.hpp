@@ -156,9 +156,6 @@ class PrimalDualSolValidation
                          const Vec<VarBasisStatus>& basis,
                          const Problem<REAL>& problem )
    {
-      const Vec<REAL> rhs = problem.getConstraintMatrix().getRightHandSides();
-      const Vec<REAL> lhs = problem.getConstraintMatrix().getLeftHandSides();
-
       for( int variable = 0; variable < problem.getNCols(); variable++ )
       {
          if( problem.getColFlags()[variable].test( ColFlag::kInactive ) )
@@ -195,11 +192,11 @@ class PrimalDualSolValidation
 
    {
 
-      const Vec<REAL> lb = problem.getLowerBounds();
-      const Vec<REAL> ub = problem.getUpperBounds();
+      const Vec<REAL>& lb = problem.getLowerBounds();
+      const Vec<REAL>& ub = problem.getUpperBounds();
 
-      const Vec<REAL> rhs = problem.getConstraintMatrix().getRightHandSides();
-      const Vec<REAL> lhs = problem.getConstraintMatrix().getLeftHandSides();
+      const Vec<REAL>& rhs = problem.getConstraintMatrix().getRightHandSides();
+      const Vec<REAL>& lhs = problem.getConstraintMatrix().getLeftHandSides();
       for( int row = 0; row < problem.getNRows(); row++ )
       {
          if( problem.getRowFlags()[row].test( RowFlag::kRedundant ) )
@@ -442,6 +439,72 @@ class PrimalDualSolValidation
       return PostsolveStatus::kOk;
    }
 
+   /// checks the primal feasibility of nbatch solutions at once. The value of
+   /// column col in solution s is found at batch[col * stride + s], hence the
+   /// inner loops run over the solutions. The slacks are not computed.
+   void
+   verifyPrimalSolutionBatch( const REAL* batch, std::size_t stride,
+                              int nbatch, const Problem<REAL>& problem,
+                              PostsolveStatus* status )
+   {
+      std::fill_n( status, nbatch, PostsolveStatus::kOk );
+
+      const Vec<REAL>& ub = problem.getUpperBounds();
+      const Vec<REAL>& lb = problem.getLowerBounds();
+      const Vec<ColFlags>& colFlags = problem.getColFlags();
+      for( int col = 0; col < problem.getNCols(); col++ )
+      {
+         if( colFlags[col].test( ColFlag::kInactive ) )
+            continue;
+         const REAL* primal = batch + col * stride;
+         bool lb_inf = colFlags[col].test( ColFlag::kLbInf );
+         bool ub_inf = colFlags[col].test( ColFlag::kUbInf );
+         for( int s = 0; s < nbatch; ++s )
+         {
+            if( ( !lb_inf && num.isFeasLT( primal[s], lb[col] ) ) ||
+                ( !ub_inf && num.isFeasGT( primal[s], ub[col] ) ) )
+               status[s] = PostsolveStatus::kFailed;
+         }
+      }
+
+      const Vec<REAL>& rhs = problem.getConstraintMatrix().getRightHandSides();
+      const Vec<REAL>& lhs = problem.getConstraintMatrix().getLeftHandSides();
+      Vec<REAL> rowValues( nbatch );
+      for( int row = 0; row < problem.getNRows(); row++ )
+      {
+         if( problem.getRowFlags()[row].test( RowFlag::kRedundant ) )
+            continue;
+
+         std::fill( rowValues.begin(), rowValues.end(), REAL{ 0 } );
+         auto entries = problem.getConstraintMatrix().getRowCoefficients( row );
+         for( int j = 0; j < entries.getLength(); j++ )
+         {
+            int col = entries.getIndices()[j];
+            if( colFlags[col].test( ColFlag::kInactive ) )
+               continue;
+            const REAL& x = entries.getValues()[j];
+            const REAL* primal = batch + col * stride;
+            for( int s = 0; s < nbatch; ++s )
+               rowValues[s] += x * primal[s];
+         }
+
+         bool lhs_inf = problem.getRowFlags()[row].test( RowFlag::kLhsInf );
+         bool rhs_inf = problem.getRowFlags()[row].test( RowFlag::kRhsInf );
+         for( int s = 0; s < nbatch; ++s )
+         {
+            if( ( !lhs_inf && num.isFeasLT( rowValues[s], lhs[row] ) ) ||
+                ( !rhs_inf && num.isFeasGT( rowValues[s], rhs[row] ) ) )
+               status[s] = PostsolveStatus::kFailed;
+         }
+      }
+
+      for( int s = 0; s < nbatch; ++s )
+      {
+         if( status[s] == PostsolveStatus::kFailed )
+            message.info( "Primal feasibility check FAILED.\n" );
+      }
+   }
+
    REAL
    getDualityGap( const Vec<REAL>& primalSolution,
                   const Vec<REAL>& dualSolution, const Vec<REAL>& reducedCosts,
@@ -44,7 +44,7 @@ class Signature
    add( U elem )
    {
       state |=
-          1 << ( ( uint32_t( elem ) *
+          T( 1 ) << ( ( uint32_t( elem ) *
                    HashHelpers<uint32_t>::fibonacci_muliplier() ) >>
                  ( 32 - static_cast<int>( std::log2( 8 * sizeof( T ) ) ) ) );
    }
@@ -57,19 +57,19 @@ class Signature
    //}
 
    bool
-   isSubset( Signature other )
+   isSubset( Signature other ) const
    {
       return ( state & ~other.state ) == 0;
    }
 
    bool
-   isSuperset( Signature other )
+   isSuperset( Signature other ) const
    {
       return ( other.state & ~state ) == 0;
    }
 
    bool
-   isEqual( Signature other )
+   isEqual( Signature other ) const
    {
       return state == other.state;
    }
@@ -31,7 +31,10 @@
 namespace papilo
 {
 
-using String = std::basic_string<char, std::char_traits<char>, Allocator<char>>;
+// names are exchanged with std::string by the readers and writers, hence
+// strings keep the standard allocator even with PAPILO_RESOURCE_ALLOCATOR
+using String = std::basic_string<char, std::char_traits<char>,
+                                 typename AllocatorTraits<char, 1>::type>;
 }
 
 #endif
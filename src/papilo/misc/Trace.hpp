@@ -0,0 +1,252 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef _PAPILO_MISC_TRACE_HPP_
+#define _PAPILO_MISC_TRACE_HPP_
+
+#include "papilo/misc/String.hpp"
+#include "papilo/misc/Vec.hpp"
+#include "papilo/misc/fmt.hpp"
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <mutex>
+#include <thread>
+
+namespace papilo
+{
+
+/// records timed events of a presolve run and writes them in the Chrome
+/// trace event format, which can be opened in chrome://tracing or Perfetto.
+/// Events can be added concurrently from several threads.
+class Tracer
+{
+ public:
+   static constexpr int MAX_ARGS = 4;
+
+   struct Arg
+   {
+      const char* key;
+      int64_t value;
+   };
+
+   struct Event
+   {
+      String name;
+      /// string literal
+      const char* category;
+      /// 'X' for an event with a duration, 'C' for counters
+      char phase;
+      int thread;
+      /// microseconds since the creation of the tracer
+      int64_t begin;
+      int64_t duration;
+      int nargs;
+      Arg args[MAX_ARGS];
+   };
+
+   Tracer() : start( std::chrono::steady_clock::now() ) {}
+
+   int64_t
+   now() const
+   {
+      return std::chrono::duration_cast<std::chrono::microseconds>(
+                 std::chrono::steady_clock::now() - start )
+          .count();
+   }
+
+   void
+   addEvent( Event event )
+   {
+      std::lock_guard<std::mutex> lock( mutex );
+      event.thread = getThreadIndex();
+      events.push_back( std::move( event ) );
+   }
+
+   /// adds a sample of the counters with the given name, every argument is
+   /// shown as a series of its own
+   void
+   addCounter( const char* name, std::initializer_list<Arg> args )
+   {
+      Event event{ name, "counter", 'C', 0, now(), 0, 0, {} };
+      for( const Arg& arg : args )
+      {
+         if( event.nargs == MAX_ARGS )
+            break;
+         event.args[event.nargs++] = arg;
+      }
+      addEvent( std::move( event ) );
+   }
+
+   /// events in the order in which they were finished, not thread safe
+   const Vec<Event>&
+   getEvents() const
+   {
+      return events;
+   }
+
+   /// number of different threads that added events
+   int
+   getNumThreads() const
+   {
+      return static_cast<int>( threads.size() );
+   }
+
+   template <typename OutputIt>
+   void
+   write( OutputIt out ) const
+   {
+      fmt::format_to( out, "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" );
+      fmt::format_to( out, "\n{{\"name\":\"process_name\",\"ph\":\"M\","
+                           "\"pid\":1,\"tid\":0,\"args\":{{\"name\":"
+                           "\"papilo\"}}}}" );
+      for( int i = 0; i != getNumThreads(); ++i )
+         fmt::format_to( out,
+                         ",\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":"
+                         "1,\"tid\":{},\"args\":{{\"name\":\"thread {}\"}}}}",
+                         i, i );
+
+      for( const Event& event : events )
+      {
+         fmt::format_to( out, ",\n{{\"name\":\"" );
+         writeEscaped( out, event.name );
+         fmt::format_to( out,
+                         "\",\"cat\":\"{}\",\"ph\":\"{}\",\"pid\":1,\"tid\":"
+                         "{},\"ts\":{}",
+                         event.category, event.phase, event.thread,
+                         event.begin );
+         if( event.phase == 'X' )
+            fmt::format_to( out, ",\"dur\":{}", event.duration );
+         if( event.nargs != 0 )
+         {
+            fmt::format_to( out, ",\"args\":{{" );
+            for( int k = 0; k != event.nargs; ++k )
+               fmt::format_to( out, "{}\"{}\":{}", k == 0 ? "" : ",",
+                               event.args[k].key, event.args[k].value );
+            fmt::format_to( out, "}}" );
+         }
+         fmt::format_to( out, "}}" );
+      }
+      fmt::format_to( out, "\n]}}\n" );
+   }
+
+   /// returns false if the file could not be written
+   bool
+   write( const String& filename ) const
+   {
+      fmt::memory_buffer buffer;
+      write( std::back_inserter( buffer ) );
+
+      std::ofstream file( filename, std::ofstream::out );
+      file.write( buffer.data(), buffer.size() );
+      return static_cast<bool>( file );
+   }
+
+ private:
+   int
+   getThreadIndex()
+   {
+      const std::thread::id id = std::this_thread::get_id();
+      for( int i = 0; i != getNumThreads(); ++i )
+      {
+         if( threads[i] == id )
+            return i;
+      }
+      threads.push_back( id );
+      return getNumThreads() - 1;
+   }
+
+   template <typename OutputIt>
+   static void
+   writeEscaped( OutputIt out, const String& str )
+   {
+      for( char c : str )
+      {
+         if( c == '"' || c == '\\' )
+            fmt::format_to( out, "\\{}", c );
+         else if( static_cast<unsigned char>( c ) < 0x20 )
+            fmt::format_to( out, "\\u{:04x}", static_cast<int>( c ) );
+         else
+            *out++ = c;
+      }
+   }
+
+   std::chrono::steady_clock::time_point start;
+   std::mutex mutex;
+   Vec<std::thread::id> threads;
+   Vec<Event> events;
+};
+
+/// records the lifetime of the scope as an event of the tracer, does nothing
+/// if the tracer is nullptr
+class TraceScope
+{
+ public:
+   TraceScope( Tracer* tracer_, const char* category, const char* name )
+       : tracer( tracer_ )
+   {
+      if( tracer == nullptr )
+         return;
+      event.name = name;
+      event.category = category;
+      event.phase = 'X';
+      event.nargs = 0;
+      event.begin = tracer->now();
+   }
+
+   TraceScope( const TraceScope& ) = delete;
+
+   TraceScope&
+   operator=( const TraceScope& ) = delete;
+
+   bool
+   isActive() const
+   {
+      return tracer != nullptr;
+   }
+
+   /// the argument is shown in the details of the event, arguments beyond
+   /// Tracer::MAX_ARGS are dropped
+   void
+   addArg( const char* key, int64_t value )
+   {
+      if( tracer == nullptr || event.nargs == Tracer::MAX_ARGS )
+         return;
+      event.args[event.nargs++] = { key, value };
+   }
+
+   ~TraceScope()
+   {
+      if( tracer == nullptr )
+         return;
+      event.duration = tracer->now() - event.begin;
+      tracer->addEvent( std::move( event ) );
+   }
+
+ private:
+   Tracer* tracer;
+   Tracer::Event event;
+};
+
+} // namespace papilo
+
+#endif
@@ -30,6 +30,7 @@
 #include "papilo/core/postsolve/Postsolve.hpp"
 #include "papilo/io/MpsWriter.hpp"
 #include "papilo/io/OpbWriter.hpp"
+#include "papilo/io/ProblemSnapshot.hpp"
 #include "papilo/io/Parser.hpp"
 #include "papilo/io/SolParser.hpp"
 #include "papilo/io/SolWriter.hpp"
@@ -304,6 +305,16 @@ presolve_and_solve(
                                            result.postsolve.origrow_mapping,
                                            result.postsolve.origcol_mapping );
          }
+         else if( boost::algorithm::ends_with( opts.reduced_problem_file,
+                                               ".papilo" ) )
+         {
+            if( !ProblemSnapshot<REAL>::writeProb(
+                    opts.reduced_problem_file, problem,
+                    result.postsolve.origrow_mapping,
+                    result.postsolve.origcol_mapping ) )
+               fmt::print( "could not write reduced problem to {}\n",
+                           opts.reduced_problem_file );
+         }
          else
             MpsWriter<REAL>::writeProb( opts.reduced_problem_file, problem,
                                         result.postsolve.origrow_mapping,
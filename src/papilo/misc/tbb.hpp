@@ -60,6 +60,7 @@
 #include "tbb/parallel_invoke.h"
 #include "tbb/partitioner.h"
 #include "tbb/task_arena.h"
+#include "tbb/task_group.h"
 #include "tbb/tick_count.h"
 
 #ifdef _MSC_VER
@@ -32,8 +32,8 @@
 #include "papilo/core/ProblemUpdate.hpp"
 #include "papilo/external/pdqsort/pdqsort.h"
 #include <algorithm>
-#include <unordered_map>
-#include <set>
+#include <cstdint>
+#include <utility>
 #include <vector>
 #ifdef PAPILO_TBB
 #include "papilo/misc/tbb.hpp"
@@ -49,22 +49,58 @@ class CliqueMerging : public PresolveMethod<REAL>
  * implies all others in the row being zero. We then construct a graph with every binary in a clique being represented
  * by a vertex, and each implication by an edge. We then seek to enlarge the already given cliques with a greedy clique
  * algorithm, if the enlarged clique then covers other cliques, they can be marked redundant.
+ * Equations like set partitioning rows contribute their edges to the graph, but are neither enlarged nor marked
+ * redundant. The graph is stored as sorted adjacency lists, the candidates of a greedy clique as a dense bitset over
+ * the neighbourhood of the clique. The cliques are grown in parallel in blocks and are then applied in the order of
+ * the rows.
  */
 
    int maxedgesparallel = 1000000;
-   int maxedgessequential = 100000;
+   int maxedgessequential = 1000000;
    int maxcliquesize = 100;
    int maxgreedycalls = 10000;
    int maxcalls = 1;
    int ncalls = 0;
 
+   /// conflict graph with the adjacent columns of column j stored sorted in
+   /// adjacent[start[j]], ..., adjacent[start[j + 1] - 1]
+   struct ConflictGraph
+   {
+      Vec<int> start;
+      Vec<int> adjacent;
+   };
+
+   /// thread local buffers of the greedy clique search, position and counts
+   /// are kept at -1 and 0 between two searches
+   struct Scratch
+   {
+      Vec<int> position;
+      Vec<int> counts;
+      Vec<int> candidates;
+      Vec<int> hits;
+      Vec<int> touched;
+      Vec<uint64_t> remaining;
+      Vec<uint64_t> neighbours;
+
+      Scratch( int ncols, int ncliques )
+          : position( ncols, -1 ), counts( ncliques, 0 )
+      {
+      }
+   };
+
+   /// the columns added to a clique row and the cliques covered afterwards
+   struct MergedClique
+   {
+      Vec<int> newVertices;
+      Vec<int> coveredCliques;
+   };
+
  public:
    CliqueMerging() : PresolveMethod<REAL>()
    {
       this->setName( "cliquemerging" );
       this->setTiming( PresolverTiming::kMedium );
       this->setType( PresolverType::kIntegralCols );
-      this->setEnabled(false);
    }
 
    void
@@ -102,16 +138,17 @@ class CliqueMerging : public PresolveMethod<REAL>
                   int maxCliqueSize, int maxGreedyCalls, int maxCalls = 1 );
 
    private:
-   std::pair<std::set<int>, Vec<int>>
+   void
    greedyClique( const ConstraintMatrix<REAL>& matrix,
-                 const std::set<std::pair<int, int>>& edges,
-                 const std::unordered_map<int, std::set<int>>& Neighbourhoodlists,
-                 int clique );
+                 const ConflictGraph& graph, int clique, Scratch& scratch,
+                 Vec<int>& newVertices );
 
    private:
-   bool
-   isCovered( const ConstraintMatrix<REAL>& matrix, int row,
-              const std::set<int>& newClique );
+   void
+   findCoveredCliques( const ConstraintMatrix<REAL>& matrix,
+                       const Vec<int>& cliques, const Vec<int>& cliqueIndex,
+                       int clique, const Vec<int>& newVertices,
+                       Scratch& scratch, Vec<int>& coveredCliques );
 };
 
 #ifdef PAPILO_USE_EXTERN_TEMPLATES
@@ -121,75 +158,138 @@ extern template class CliqueMerging<Rational>;
 #endif
 
 template <typename REAL>
-std::pair<std::set<int>, Vec<int>>
-CliqueMerging<REAL>::greedyClique(
-    const ConstraintMatrix<REAL>& matrix,
-    const std::set<std::pair<int, int>>& edges,
-    const std::unordered_map<int, std::set<int>>& Neighbourhoodlists, int clique )
-{/*
-   std::cout << "\nStarting Greedy Clique: " ;
-   std::cout << clique ;*/
-   std::set<int> newClique;
-   Vec<int> newVertices;
-   newVertices.reserve(2* maxcliquesize );
-   assert( clique >= 0 );
-   assert( clique < matrix.getNRows() );
+void
+CliqueMerging<REAL>::greedyClique( const ConstraintMatrix<REAL>& matrix,
+                                   const ConflictGraph& graph, int clique,
+                                   Scratch& scratch, Vec<int>& newVertices )
+{
    assert( clique >= 0 );
    assert( clique < matrix.getNRows() );
    const auto rowvec = matrix.getRowCoefficients( clique );
-   const auto indices = rowvec.getIndices();
-
-   for( int vertexIndex = 0; vertexIndex < rowvec.getLength(); ++vertexIndex )
+   const int* indices = rowvec.getIndices();
+   const int length = rowvec.getLength();
+   assert( length > 0 );
+
+   Vec<int>& position = scratch.position;
+   Vec<int>& candidates = scratch.candidates;
+   Vec<int>& hits = scratch.hits;
+   const int first = *std::min_element( indices, indices + length );
+
+   // the candidates are the neighbours of the smallest column of the clique
+   // that are adjacent to all other columns of the clique
+   for( int k = 0; k < length; ++k )
+      position[indices[k]] = -2;
+   candidates.clear();
+   for( int i = graph.start[first]; i != graph.start[first + 1]; ++i )
    {
-      newClique.emplace( indices[vertexIndex] );
+      int vertex = graph.adjacent[i];
+      if( position[vertex] != -1 )
+         continue;
+      position[vertex] = static_cast<int>( candidates.size() );
+      candidates.push_back( vertex );
    }
-   std::set<int> Neighbourhood = Neighbourhoodlists.at( *newClique.begin() );
-   for( int potentialNewVertex : Neighbourhood )
+
+   hits.assign( candidates.size(), 0 );
+   for( int k = 0; k < length; ++k )
    {
-      if( newClique.find( potentialNewVertex ) != newClique.end() )
+      if( indices[k] == first )
          continue;
-      bool isIn = true;
-      for( int otherMember : newClique )
+      for( int i = graph.start[indices[k]]; i != graph.start[indices[k] + 1];
+           ++i )
       {
-         if( edges.find( std::pair<int, int>{ potentialNewVertex,
-                                              otherMember } ) == edges.end() )
-         {
-            isIn = false;
-            break;
-         }
+         if( position[graph.adjacent[i]] >= 0 )
+            ++hits[position[graph.adjacent[i]]];
       }
-      if( isIn )
+   }
+
+   int ncandidates = 0;
+   for( int i = 0; i != static_cast<int>( candidates.size() ); ++i )
+   {
+      position[candidates[i]] = -1;
+      if( hits[i] == length - 1 )
+         candidates[ncandidates++] = candidates[i];
+   }
+   candidates.resize( ncandidates );
+   for( int k = 0; k < length; ++k )
+      position[indices[k]] = -1;
+   for( int i = 0; i != ncandidates; ++i )
+      position[candidates[i]] = i;
+
+   // add the candidates greedily in the order of their columns and keep the
+   // remaining candidates as a bitset restricted to the neighbours of every
+   // added column
+   const int nwords = ( ncandidates + 63 ) / 64;
+   Vec<uint64_t>& remaining = scratch.remaining;
+   Vec<uint64_t>& neighbours = scratch.neighbours;
+   remaining.assign( nwords, ~uint64_t{ 0 } );
+   if( ncandidates % 64 != 0 )
+      remaining.back() = ( uint64_t{ 1 } << ( ncandidates % 64 ) ) - 1;
+   neighbours.resize( nwords );
+
+   for( int i = 0; i != ncandidates; ++i )
+   {
+      if( ( ( remaining[i / 64] >> ( i % 64 ) ) & 1 ) == 0 )
+         continue;
+      const int vertex = candidates[i];
+      newVertices.push_back( vertex );
+      if( static_cast<int>( newVertices.size() ) >= 2 * maxcliquesize )
+         break;
+
+      std::fill( neighbours.begin() + i / 64, neighbours.end(), 0 );
+      for( int j = graph.start[vertex]; j != graph.start[vertex + 1]; ++j )
       {
-         newClique.emplace( potentialNewVertex );
-         newVertices.emplace_back( potentialNewVertex );
-         if( newVertices.end() - newVertices.begin() >= 2*maxcliquesize )
-         {
-            break;
-         }
+         int pos = position[graph.adjacent[j]];
+         if( pos > i )
+            neighbours[pos / 64] |= uint64_t{ 1 } << ( pos % 64 );
       }
+      for( int w = i / 64; w != nwords; ++w )
+         remaining[w] &= neighbours[w];
    }
-   std::pair<std::set<int>, Vec<int>> output;
-   output.first = newClique;
-   output.second = newVertices;
-   return output;
+
+   for( int vertex : candidates )
+      position[vertex] = -1;
 }
 
 template <typename REAL>
-bool
-CliqueMerging<REAL>::isCovered( const ConstraintMatrix<REAL>& matrix,
-                                int row, const std::set<int>& newClique )
+void
+CliqueMerging<REAL>::findCoveredCliques(
+    const ConstraintMatrix<REAL>& matrix, const Vec<int>& cliques,
+    const Vec<int>& cliqueIndex, int clique, const Vec<int>& newVertices,
+    Scratch& scratch, Vec<int>& coveredCliques )
 {
-   assert( row >= 0 );
-   assert( row < matrix.getNRows() );
-   const auto rowVec = matrix.getRowCoefficients( row );
-   const auto rowInds = rowVec.getIndices();
+   Vec<int>& counts = scratch.counts;
+   Vec<int>& touched = scratch.touched;
 
-   for( int vertexIndex = 0; vertexIndex < rowVec.getLength(); ++vertexIndex )
+   // count for every other clique how many of its columns are in the clique
+   auto countColumn = [&]( int col )
    {
-      if( newClique.find( rowInds[vertexIndex] ) == newClique.end() )
-         return false;
+      const auto colvec = matrix.getColumnCoefficients( col );
+      const int* rows = colvec.getIndices();
+      for( int k = 0; k < colvec.getLength(); ++k )
+      {
+         int index = cliqueIndex[rows[k]];
+         if( index == -1 || rows[k] == clique )
+            continue;
+         if( counts[index]++ == 0 )
+            touched.push_back( index );
+      }
+   };
+
+   const auto rowvec = matrix.getRowCoefficients( clique );
+   for( int k = 0; k < rowvec.getLength(); ++k )
+      countColumn( rowvec.getIndices()[k] );
+   for( int vertex : newVertices )
+      countColumn( vertex );
+
+   for( int index : touched )
+   {
+      if( counts[index] ==
+          matrix.getRowCoefficients( cliques[index] ).getLength() )
+         coveredCliques.push_back( index );
+      counts[index] = 0;
    }
-   return true;
+   touched.clear();
+   pdqsort( coveredCliques.begin(), coveredCliques.end() );
 }
 
 template <typename REAL>
@@ -220,222 +320,221 @@ CliqueMerging<REAL>::execute( const Problem<REAL>& problem,
 
    const auto ub = problem.getUpperBounds();
 
-   std::vector<RowFlags> rowFlags = matrix.getRowFlags();
-
    const int nrows = matrix.getNRows();
 
-   Vec<int> Cliques;
-   Cliques.reserve(maxedgesparallel);
+   const int ncols = matrix.getNCols();
 
-   std::set<std::pair<int, int>> edges;
+#ifdef PAPILO_TBB
+   const std::size_t maxedges = static_cast<std::size_t>( maxedgesparallel );
+#else
+   const std::size_t maxedges = static_cast<std::size_t>( maxedgessequential );
+#endif
 
-   std::unordered_map<int, std::set<int>> neighbourLists;
+   Vec<int> Cliques;
+
+   Vec<std::pair<int, int>> edges;
 
-   std::set<int> Vertices;
+   Vec<uint8_t> isVertex( ncols, 0 );
 
+   // the edges are collected with duplicates, which are removed whenever
+   // their number doubled
+   std::size_t dedupsize = maxedges;
+   auto removeDuplicateEdges = [&edges]()
+   {
+      pdqsort( edges.begin(), edges.end() );
+      edges.erase( std::unique( edges.begin(), edges.end() ), edges.end() );
+   };
+
+   // collect the clique rows first, without a clique that is no equation
+   // there is nothing to merge
+   Vec<std::pair<int, bool>> cliqueRows;
+   bool hasInequality = false;
    for( int row = 0; row < nrows; ++row )
    {
+      bool equation = false;
+      if( matrix.isRowRedundant( row ) ||
+          matrix.getRowCoefficients( row ).getLength() >= maxcliquesize ||
+          !problem.is_clique( matrix, row, num, equation ) )
+         continue;
+      cliqueRows.emplace_back( row, equation );
+      hasInequality = hasInequality || !equation;
+   }
+   if( !hasInequality )
+   {
+      if( ++ncalls == maxcalls )
+         this->setEnabled( false );
+      return result;
+   }
+
+   for( const std::pair<int, bool>& cliqueRowInfo : cliqueRows )
+   {
+      const int row = cliqueRowInfo.first;
       assert( row >= 0 );
       assert( row < matrix.getNRows() );
       const auto cliqueRow = matrix.getRowCoefficients( row );
       const auto cliqueIndices = cliqueRow.getIndices();
 
-      bool cliqueCheck =
-          problem.is_clique( matrix, row, num );
-      if( !matrix.isRowRedundant( row ) &&
-          cliqueCheck && cliqueRow.getLength() < maxcliquesize )
-      {
+      if( !cliqueRowInfo.second )
          Cliques.push_back( row );
-         rowFlags[row].set( RowFlag::kClique );
-         for( int col = 0; col < cliqueRow.getLength(); ++col )
+      for( int col = 0; col < cliqueRow.getLength(); ++col )
+      {
+         int vertex = cliqueIndices[col];
+         isVertex[vertex] = 1;
+         for( int otherCol = 0; otherCol < col; ++otherCol )
          {
-            int vertex = cliqueIndices[col];
-            Vertices.emplace( vertex );
-            if( neighbourLists.find( vertex ) == neighbourLists.end() )
-            {
-               std::set<int> neighOfCol;
-               neighbourLists[vertex] = neighOfCol ;
-            }
-            for( int otherCol = 0; otherCol < col; ++otherCol )
-            {
-               int otherVertex = cliqueIndices[otherCol];
-               edges.emplace( std::pair<int, int>{ otherVertex, vertex } );
-               edges.emplace( std::pair<int, int>{ vertex, otherVertex } );
-               neighbourLists[vertex].emplace( otherVertex );
-               neighbourLists[otherVertex].emplace( vertex );
-            }
+            int otherVertex = cliqueIndices[otherCol];
+            edges.emplace_back( otherVertex, vertex );
+            edges.emplace_back( vertex, otherVertex );
          }
       }
-      else
+
+      if( edges.size() > dedupsize )
       {
-         rowFlags[row].unset( RowFlag::kClique );
+         removeDuplicateEdges();
+         if( edges.size() > maxedges )
+            break;
+         dedupsize = std::max( maxedges, 2 * edges.size() );
       }
-#ifdef PAPILO_TBB
-      if( edges.size() > static_cast<long unsigned int>(maxedgesparallel) )
-#else
-      if( edges.size() > static_cast<long unsigned int>(maxedgessequential) )
-#endif
-         break;
    }
 
-#ifdef PAPILO_TBB
-   tbb::combinable<Vec<int>> completedCliquesComb;
-#else   
-   Vec<int> completedCliques;
-#endif
-
-#ifdef PAPILO_TBB
-   tbb::combinable<Vec<std::pair<Vec<int>,Vec<int>>>> reductionResults;
-   tbb::parallel_for(
-       tbb::blocked_range<int>( 0, Cliques.end() - Cliques.begin() ),
-       [&]( const tbb::blocked_range<int>& r )
-       {
-          for( int cliqueInd = r.begin(); cliqueInd != r.end(); ++cliqueInd )
-#else
-   for( int cliqueInd = 0; cliqueInd < Cliques.end() - Cliques.begin() ;
-        ++cliqueInd )
-#endif
+   // add the conflicts between the columns of the cliques that are known
+   // from the implications found in earlier rounds
+   const ImplicationStore<REAL>& implications = problem.getImplications();
+   if( implications.getNumImplications() != 0 )
+   {
+      const auto& domains = problem.getVariableDomains();
+      for( int vertex = 0; vertex < ncols; ++vertex )
       {
-#ifdef PAPILO_TBB
-      Vec<int> completedCliques = completedCliquesComb.combine( [](const Vec<int>& a, const Vec<int>& b) {
-         std::vector<int> result = a;
-         result.insert(result.end(), b.begin(), b.end() );
-         return result;
-      } );
-#endif
-      int clique = Cliques[cliqueInd];
-      if( cliqueInd > maxgreedycalls )      
-         break;
-      if( std::find( completedCliques.begin(), completedCliques.end(),
-                     clique ) != completedCliques.end() )
-         continue;
+         if( !isVertex[vertex] || vertex >= implications.getNCols() ||
+             !domains.isBinary( vertex ) )
+            continue;
 
-      const std::pair<std::set<int>, Vec<int>> resultOfSearch =
-          greedyClique( matrix, edges, neighbourLists, clique );
-
-      const std::set<int> newClique = resultOfSearch.first;
-
-      const Vec<int> newVertices = resultOfSearch.second;
-
-#ifdef PAPILO_TBB
-      std::pair<Vec<int>,Vec<int>> reductionResult;
-      reductionResult.first = newVertices ;
-      reductionResult.first.push_back( clique );
-#endif
-
-      Vec<int> coveredCliques;
-      for( int cl = 0; cl < Cliques.end() - Cliques.begin(); ++cl )
-      {
-         if( cl != cliqueInd && isCovered( matrix, Cliques[cl], newClique ) )
+         ImplicationView<REAL> conflicts =
+             implications.getImplications( vertex, true );
+         for( int k = 0; k != conflicts.getLength(); ++k )
          {
-            coveredCliques.push_back( cl );
-            completedCliques.push_back( Cliques[cl] );
+            int otherVertex = conflicts.getColumns()[k];
+            if( !conflicts.getUpper()[k] || conflicts.getBounds()[k] > 0 ||
+                !isVertex[otherVertex] || !domains.isBinary( otherVertex ) )
+               continue;
+
+            edges.emplace_back( otherVertex, vertex );
+            edges.emplace_back( vertex, otherVertex );
          }
       }
+   }
+   removeDuplicateEdges();
+
+   ConflictGraph graph;
+   graph.start.resize( ncols + 1, 0 );
+   graph.adjacent.resize( edges.size() );
+   for( const std::pair<int, int>& edge : edges )
+      ++graph.start[edge.first + 1];
+   for( int col = 0; col < ncols; ++col )
+      graph.start[col + 1] += graph.start[col];
+   for( std::size_t i = 0; i != edges.size(); ++i )
+      graph.adjacent[i] = edges[i].second;
+   edges = Vec<std::pair<int, int>>();
+
+   const int ncliques = static_cast<int>( Cliques.size() );
+   Vec<int> cliqueIndex( nrows, -1 );
+   for( int cliqueInd = 0; cliqueInd < ncliques; ++cliqueInd )
+      cliqueIndex[Cliques[cliqueInd]] = cliqueInd;
+
+   // the cliques of a block are grown independently, the cliques covered by
+   // one clique are only applied if the clique itself was not covered by an
+   // earlier one, which is also skipped in the following blocks
+   const int ngreedycalls = std::min( ncliques, maxgreedycalls + 1 );
+   const int blocksize = 1024;
+   Vec<MergedClique> mergedCliques( std::min( ngreedycalls, blocksize ) );
+   Vec<uint8_t> completed( ncliques, 0 );
+   Vec<int> newClique;
 
 #ifdef PAPILO_TBB
-      reductionResult.second = coveredCliques;
+   tbb::combinable<Scratch> scratches( [ncols, ncliques]()
+                                       { return Scratch( ncols, ncliques ); } );
+#else
+   Scratch scratch( ncols, ncliques );
 #endif
 
-
-      if( coveredCliques.end() - coveredCliques.begin() > 0 )
-      {
+   for( int blockstart = 0; blockstart < ngreedycalls;
+        blockstart += blocksize )
+   {
+      const int blockend = std::min( ngreedycalls, blockstart + blocksize );
 
 #ifdef PAPILO_TBB
-         reductionResults.local().push_back( reductionResult );
+      tbb::parallel_for(
+          tbb::blocked_range<int>( blockstart, blockend ),
+          [&]( const tbb::blocked_range<int>& r )
+          {
+             Scratch& scratch = scratches.local();
+             for( int cliqueInd = r.begin(); cliqueInd != r.end();
+                  ++cliqueInd )
 #else
+      for( int cliqueInd = blockstart; cliqueInd < blockend; ++cliqueInd )
+#endif
+             {
+                MergedClique& merged = mergedCliques[cliqueInd - blockstart];
+                merged.newVertices.clear();
+                merged.coveredCliques.clear();
+                if( completed[cliqueInd] )
+                   continue;
+                greedyClique( matrix, graph, Cliques[cliqueInd], scratch,
+                              merged.newVertices );
+                findCoveredCliques( matrix, Cliques, cliqueIndex,
+                                    Cliques[cliqueInd], merged.newVertices,
+                                    scratch, merged.coveredCliques );
+             }
+#ifdef PAPILO_TBB
+          } );
+#endif
 
-         result = PresolveStatus::kReduced;
-         TransactionGuard<REAL> tg{ reductions };
-         for( std::set<int>::iterator vertexIndex = newClique.begin();
-              vertexIndex != newClique.end(); ++vertexIndex )
-         {
-            reductions.lockCol( *vertexIndex );
-            reductions.lockColBounds( *vertexIndex );
-         }
-         for( int covRow = 0;
-              covRow < coveredCliques.end() - coveredCliques.begin(); ++covRow )
-         {
-            reductions.lockRow( Cliques[coveredCliques[covRow]] );
-         }
-         reductions.lockRow( clique );
+      for( int cliqueInd = blockstart; cliqueInd < blockend; ++cliqueInd )
+      {
+         const Vec<int>& newVertices =
+             mergedCliques[cliqueInd - blockstart].newVertices;
+         const Vec<int>& coveredCliques =
+             mergedCliques[cliqueInd - blockstart].coveredCliques;
+         if( completed[cliqueInd] || coveredCliques.empty() )
+            continue;
+         for( int cl : coveredCliques )
+            completed[cl] = 1;
+
+         int clique = Cliques[cliqueInd];
          assert( clique >= 0 );
          assert( clique < matrix.getNRows() );
          auto rowVector = matrix.getRowCoefficients( clique );
          auto rowValues = rowVector.getValues();
          auto rowInds = rowVector.getIndices();
-         auto val = rowValues[0] * ( ub[rowInds[0]] - abs( lb[rowInds[0]] ) );
-         for( int vertexIndex = 0;
-              vertexIndex < newVertices.end() - newVertices.begin();
-              ++vertexIndex )
+
+         newClique.assign( rowInds, rowInds + rowVector.getLength() );
+         newClique.insert( newClique.end(), newVertices.begin(),
+                           newVertices.end() );
+         pdqsort( newClique.begin(), newClique.end() );
+
+         result = PresolveStatus::kReduced;
+         TransactionGuard<REAL> tg{ reductions };
+         for( int vertex : newClique )
          {
-            reductions.changeMatrixEntry(
-                clique, newVertices[vertexIndex],
-                val * ( ub[newVertices[vertexIndex]] -
-                        lb[newVertices[vertexIndex]] ) );
-            assert( !num.isEq( val * ( ub[newVertices[vertexIndex]] -
-                                       lb[newVertices[vertexIndex]] ),
-                               0.0 ) );
+            reductions.lockCol( vertex );
+            reductions.lockColBounds( vertex );
          }
-         for( int row = 0; row < coveredCliques.end() - coveredCliques.begin();
-              ++row )
+         for( int cl : coveredCliques )
+            reductions.lockRow( Cliques[cl] );
+         reductions.lockRow( clique );
+         auto val =
+             rowValues[0] * ( ub[rowInds[0]] - abs( lb[rowInds[0]] ) );
+         for( int vertex : newVertices )
          {
-            reductions.markRowRedundant( Cliques[coveredCliques[row]] );
+            reductions.changeMatrixEntry( clique, vertex,
+                                          val * ( ub[vertex] - lb[vertex] ) );
+            assert( !num.isEq( val * ( ub[vertex] - lb[vertex] ), 0.0 ) );
          }
-#endif
-      }
-   }
-#ifdef PAPILO_TBB
-   });
-   Vec<std::pair<Vec<int>,Vec<int>>> reductionResultsComb = reductionResults.combine( 
-      [](const Vec<std::pair<Vec<int>,Vec<int>>>& a, const Vec<std::pair<Vec<int>,Vec<int>>>& b) {
-      Vec<std::pair<Vec<int>,Vec<int>>> result = a;
-      result.insert(result.end(), b.begin(), b.end() );
-      return result;
-   } );
-   pdqsort(reductionResultsComb.begin(), reductionResultsComb.end());
-   for( int reductionindex = 0; reductionindex < reductionResultsComb.end() - reductionResultsComb.begin(); ++reductionindex )
-   {
-      result = PresolveStatus::kReduced;
-      TransactionGuard<REAL> tg{ reductions };
-      Vec<int> covCliques = reductionResultsComb[reductionindex].second;
-      int clique = reductionResultsComb[reductionindex].first.back();
-      Vec<int> newVertices = reductionResultsComb[reductionindex].first;
-      auto cliqueRow = matrix.getRowCoefficients( clique );
-      auto cliqueIndices = cliqueRow.getIndices();
-      for( int cliqueIndex = 0; cliqueIndex < cliqueRow.getLength(); ++cliqueIndex )
-      {
-         reductions.lockCol( cliqueIndices[cliqueIndex] );
-         reductions.lockColBounds( cliqueIndices[cliqueIndex] );
+         for( int cl : coveredCliques )
+            reductions.markRowRedundant( Cliques[cl] );
       }
-      for( int vertexIndex = 0; vertexIndex < newVertices.end() - newVertices.begin() - 1; ++vertexIndex )
-      {
-         reductions.lockCol( newVertices[vertexIndex] );
-         reductions.lockColBounds( newVertices[vertexIndex] );
-      }
-      for( int rowIndex = 0; rowIndex < covCliques.end() - covCliques.begin(); ++rowIndex )
-      {
-         reductions.lockRow( Cliques[covCliques[rowIndex]] );
-      }
-      reductions.lockRow( clique );
-      auto rowVector = matrix.getRowCoefficients( clique );
-      auto rowValues = rowVector.getValues();
-      auto rowInds = rowVector.getIndices();
-      auto val = rowValues[0] * ( ub[rowInds[0]] - abs( lb[rowInds[0]] ) );
-      for( int vertexIndex = 0;
-            vertexIndex < newVertices.end() - newVertices.begin() - 1;
-            ++vertexIndex )
-      { 
-         reductions.changeMatrixEntry(
-            clique, newVertices[vertexIndex],
-            val * ( ub[newVertices[vertexIndex]] -
-                    lb[newVertices[vertexIndex]] ) );
-      }
-      for( int row = 0; row < covCliques.end() - covCliques.begin();
-         ++row )
-         {reductions.markRowRedundant( Cliques[covCliques[row]] );}
    }
-#endif
+
    if (++ncalls == maxcalls)
       this->setEnabled( false );
    
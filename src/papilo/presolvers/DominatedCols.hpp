@@ -60,22 +60,38 @@ class DominatedCols : public PresolveMethod<REAL>
       return false;
    }
 
+   void
+   addPresolverParams( ParameterSet& paramSet ) override
+   {
+      paramSet.addParameter(
+          "domcol.indexed",
+          "search dominated columns by buckets of the rows they have to share "
+          "and run in every exhaustive round instead of ever fewer rounds",
+          indexed );
+   }
+
+   void
+   setIndexed( bool value )
+   {
+      indexed = value;
+   }
+
    /// stores implied bound information and signatures for a column
    struct ColInfo
    {
-      Signature32 pos;
-      Signature32 neg;
+      Signature64 pos;
+      Signature64 neg;
       int lbfree = 0;
       int ubfree = 0;
 
-      Signature32
+      Signature64
       getNegSignature( int scale ) const
       {
          assert( scale == 1 || scale == -1 );
          return scale == 1 ? neg : pos;
       }
 
-      Signature32
+      Signature64
       getPosSignature( int scale ) const
       {
          assert( scale == 1 || scale == -1 );
@@ -105,6 +121,9 @@ class DominatedCols : public PresolveMethod<REAL>
             const ProblemUpdate<REAL>& problemUpdate, const Num<REAL>& num,
             Reductions<REAL>& reductions, const Timer& timer,
             int& reason_of_infeasibility ) override;
+
+ private:
+   bool indexed = false;
 };
 
 #ifdef PAPILO_USE_EXTERN_TEMPLATES
@@ -123,8 +142,9 @@ DominatedCols<REAL>::execute( const Problem<REAL>& problem,
 
    //TODO: Reduce skips by one to rerun initially
    // do not call dominated column presolver too often, since it can be
-   // expensive
-   this->skipRounds( this->getNCalls() );
+   // expensive, unless the indexed search is used
+   if( !indexed )
+      this->skipRounds( this->getNCalls() );
 
    if( ncols <= 1 )
       return PresolveStatus::kUnchanged;
@@ -389,6 +409,386 @@ DominatedCols<REAL>::execute( const Problem<REAL>& problem,
    size_t ndomcols = 0;
    size_t start = 0;
 
+   // add a domination unless the dominated column is already dominated or the
+   // domination closes a cycle
+   auto addDomination = [&]( DomcolReduction& reduction ) {
+      int source = reduction.col2;
+      if( domcol[source] != -1 )
+         return;
+      int sink = reduction.col1;
+      int node = sink;
+      while( domcol[node] >= 0 )
+         node = domcols[domcol[node]].col1;
+      if( node == source )
+         return;
+      domcol[source] = domcols.size();
+      domcols.emplace_back( std::move( reduction ) );
+      if( nchildren[sink] >= 1 || domcol[sink] <= -1 )
+      {
+         if( nchildren[source] == 0 )
+         {
+            nchildren[source] = -leaves.size();
+            leaves.push_back( source );
+         }
+         ++nchildren[sink];
+      }
+      else
+      {
+         if( nchildren[source] == 0 )
+         {
+            nchildren[source] = nchildren[sink];
+            leaves[-nchildren[source]] = source;
+         }
+         nchildren[sink] = 1;
+      }
+   };
+
+   // select the row of the unbounded column that every column dominated by
+   // it must have an entry in, returns the position of the row in the column
+   // or -1 if there is no such row or a singleton row
+   auto selectRow = [&]( int unbounded_col, int& bestscale,
+                         int& bestrowlock ) {
+      int lbfree = colinfo[unbounded_col].lbfree;
+      int ubfree = colinfo[unbounded_col].ubfree;
+      assert( lbfree != 0 || ubfree != 0 );
+      auto colvec = consMatrix.getColumnCoefficients( unbounded_col );
+      int collen = colvec.getLength();
+      const int* colrows = colvec.getIndices();
+      const REAL* colvals = colvec.getValues();
+      int lbrowlock = lbfree > 0 ? colrows[lbfree - 1] : -1;
+      int ubrowlock = ubfree > 0 ? colrows[ubfree - 1] : -1;
+      int bestrowsize = std::numeric_limits<int>::max();
+      int bestrow = -1;
+      bestrowlock = std::numeric_limits<int>::max();
+      bestscale = 0;
+
+      for( int i = 0; i < collen; ++i )
+      {
+         int row = colrows[i];
+
+         if( bestrowsize < rowsize[row] )
+            continue;
+
+         // determine the scale of the dominating column depending on
+         // whether the upper or lower bound is free, and remember which
+         // row needs to be locked to protect the implied bound (if any)
+         int rowlock = std::numeric_limits<int>::max();
+         int scale = 0;
+
+         if( ubfree != 0 && rowlock > ubrowlock
+               && !rflags[row].test( colvals[i] < 0 ? RowFlag::kLhsInf : RowFlag::kRhsInf ) )
+         {
+            rowlock = ubrowlock;
+            scale = 1;
+         }
+
+         if( lbfree != 0 && rowlock > lbrowlock
+               && !rflags[row].test( colvals[i] < 0 ? RowFlag::kRhsInf : RowFlag::kLhsInf ) )
+         {
+            rowlock = lbrowlock;
+            scale = -1;
+         }
+
+         assert(rowsize[row] >= 1);
+
+         if( scale == 0 || ( bestrowsize == rowsize[row] && bestrowlock <= rowlock ) )
+            continue;
+
+         if( rowsize[row] == 1 )
+         {
+            bestrow = -1;
+            break;
+         }
+         else
+            bestrow = i;
+
+         bestrowsize = rowsize[row];
+         bestrowlock = rowlock;
+         bestscale = scale;
+      }
+
+      return bestrow;
+   };
+
+   // returns the scale of col for which it is dominated by the unbounded
+   // column with the scaled value and objective in a row with the given
+   // flags, or 0 if it is not dominated. The comparison of the columns is
+   // left to dominates( scale of col ).
+   auto findDomination = [&]( int col, RowFlags rowf, const REAL& scaled_val,
+                              const REAL& scaled_obj, const REAL& rowval,
+                              auto&& dominates ) {
+      if( !rowf.test( RowFlag::kLhsInf, RowFlag::kRhsInf ) )
+      {
+         if( !cflags[col].test( ColFlag::kLbInf ) &&
+             num.isEq( scaled_val, rowval ) &&
+             num.isLE( scaled_obj, obj[col] ) && dominates( 1 ) )
+            return 1;
+         if( !cflags[col].test( ColFlag::kUbInf ) &&
+             num.isEq( scaled_val, -rowval ) &&
+             num.isLE( scaled_obj, -obj[col] ) && dominates( -1 ) )
+            return -1;
+      }
+      else if( rowf.test( RowFlag::kLhsInf ) )
+      {
+         assert( scaled_val > 0 && !rowf.test( RowFlag::kRhsInf ) );
+         if( !cflags[col].test( ColFlag::kLbInf ) &&
+             num.isLE( scaled_val, rowval ) &&
+             num.isLE( scaled_obj, obj[col] ) && dominates( 1 ) )
+            return 1;
+         if( !cflags[col].test( ColFlag::kUbInf ) &&
+             num.isLE( scaled_val, -rowval ) &&
+             num.isLE( scaled_obj, -obj[col] ) && dominates( -1 ) )
+            return -1;
+      }
+      else
+      {
+         assert( scaled_val < 0 && rowf.test( RowFlag::kRhsInf ) );
+         if( !cflags[col].test( ColFlag::kLbInf ) &&
+             num.isGE( scaled_val, rowval ) &&
+             num.isLE( scaled_obj, obj[col] ) && dominates( 1 ) )
+            return 1;
+         if( !cflags[col].test( ColFlag::kUbInf ) &&
+             num.isGE( scaled_val, -rowval ) &&
+             num.isLE( scaled_obj, -obj[col] ) && dominates( -1 ) )
+            return -1;
+      }
+      return 0;
+   };
+
+   // The indexed search buckets the unbounded columns by their selected row,
+   // so that the candidates of a row are gathered only once, and processes
+   // the buckets in parallel. Each unbounded column is scattered into a dense
+   // array, a candidate is then compared in the time of its own length. The
+   // dominations are the same as the ones of the search above.
+   struct RowChoice
+   {
+      int row;
+      int k;
+      int pos;
+      int scale;
+      int rowlock;
+   };
+
+   struct Scratch
+   {
+      /// scaled values of the scattered column
+      Vec<REAL> values;
+      /// 2 * k + 1 for the rows of the scattered column k that a dominated
+      /// column must have an entry in, 2 * k for its other rows
+      Vec<int> marks;
+      Vec<std::pair<int, REAL>> candidates;
+
+      explicit Scratch( int nrows ) : values( nrows ), marks( nrows, -1 ) {}
+   };
+
+   // scatters the unbounded column k and returns the number of its rows that
+   // a dominated column must have an entry in
+   auto scatter = [&]( Scratch& scratch, int k, int col, int scale ) {
+      auto colvec = consMatrix.getColumnCoefficients( col );
+      const int* colrows = colvec.getIndices();
+      const REAL* colvals = colvec.getValues();
+      int nrequired = 0;
+
+      for( int i = 0; i != colvec.getLength(); ++i )
+      {
+         int row = colrows[i];
+         REAL val = colvals[i] * scale;
+         bool required;
+         if( !rflags[row].test( RowFlag::kLhsInf, RowFlag::kRhsInf ) )
+            required = true;
+         else if( rflags[row].test( RowFlag::kLhsInf ) )
+            required = num.isGT( val, 0 );
+         else
+            required = num.isLT( val, 0 );
+
+         scratch.values[row] = val;
+         scratch.marks[row] = 2 * k + ( required ? 1 : 0 );
+         nrequired += required ? 1 : 0;
+      }
+
+      return nrequired;
+   };
+
+   // same as checkDominance() for the scattered unbounded column k
+   auto checkScattered = [&]( const Scratch& scratch, int k, int nrequired,
+                              int col1, int col2, int scal1, int scal2 ) {
+      if( !colinfo[col1].allowsDomination( scal1, colinfo[col2], scal2 ) )
+         return false;
+
+      auto col2vec = consMatrix.getColumnCoefficients( col2 );
+      const int* col2rows = col2vec.getIndices();
+      const REAL* col2vals = col2vec.getValues();
+      int nfound = 0;
+
+      for( int j = 0; j != col2vec.getLength(); ++j )
+      {
+         int row = col2rows[j];
+         REAL val2 = col2vals[j] * scal2;
+         RowFlags rowf = rflags[row];
+
+         if( ( scratch.marks[row] >> 1 ) == k )
+         {
+            const REAL& val1 = scratch.values[row];
+            nfound += scratch.marks[row] & 1;
+
+            if( !rowf.test( RowFlag::kLhsInf, RowFlag::kRhsInf ) )
+            {
+               if( !num.isEq( val1, val2 ) )
+                  return false;
+            }
+            else if( rowf.test( RowFlag::kLhsInf ) )
+            {
+               if( num.isGT( val1, val2 ) )
+                  return false;
+            }
+            else if( num.isLT( val1, val2 ) )
+               return false;
+         }
+         else
+         {
+            if( !rowf.test( RowFlag::kLhsInf, RowFlag::kRhsInf ) )
+               return false;
+            else if( rowf.test( RowFlag::kLhsInf ) )
+            {
+               if( num.isGT( 0, val2 ) )
+                  return false;
+            }
+            else if( num.isLT( 0, val2 ) )
+               return false;
+         }
+      }
+
+      // a row of col1 without an entry of col2 that rules out domination
+      if( nfound != nrequired )
+         return false;
+
+      if(problemUpdate.getPresolveOptions().dualreds <= 1 && num.isEq( obj[col1], obj[col2] ) )
+         return false;
+      return true;
+   };
+
+   Vec<RowChoice> choices;
+   Vec<int> bucketstarts;
+#ifdef PAPILO_TBB
+   tbb::combinable<Scratch> scratches(
+       [nrows]() { return Scratch( static_cast<int>( nrows ) ); } );
+#else
+   Scratch scratch( static_cast<int>( nrows ) );
+#endif
+
+   auto findDominationsIndexed = [&]( unsigned int first, unsigned int last,
+                                      unsigned int base ) {
+      choices.resize( last - first );
+
+#ifdef PAPILO_TBB
+      tbb::parallel_for(
+          tbb::blocked_range<unsigned int>( first, last ),
+          [&]( const tbb::blocked_range<unsigned int>& r ) {
+             for( unsigned int k = r.begin(); k < r.end(); ++k )
+#else
+      for( unsigned int k = first; k < last; ++k )
+#endif
+             {
+                RowChoice& choice = choices[k - first];
+                choice.k = k;
+                choice.pos = selectRow( unboundedcols[k], choice.scale,
+                                        choice.rowlock );
+                choice.row =
+                    choice.pos == -1
+                        ? -1
+                        : consMatrix.getColumnCoefficients( unboundedcols[k] )
+                              .getIndices()[choice.pos];
+             }
+#ifdef PAPILO_TBB
+          } );
+#endif
+
+      choices.erase( std::remove_if( choices.begin(), choices.end(),
+                                     []( const RowChoice& choice ) {
+                                        return choice.row == -1;
+                                     } ),
+                     choices.end() );
+      pdqsort( choices.begin(), choices.end(),
+               []( const RowChoice& a, const RowChoice& b ) {
+                  return a.row < b.row || ( a.row == b.row && a.k < b.k );
+               } );
+
+      bucketstarts.clear();
+      for( int i = 0; i != (int)choices.size(); ++i )
+      {
+         if( i == 0 || choices[i].row != choices[i - 1].row )
+            bucketstarts.push_back( i );
+      }
+      bucketstarts.push_back( static_cast<int>( choices.size() ) );
+
+#ifdef PAPILO_TBB
+      tbb::parallel_for(
+          tbb::blocked_range<int>( 0, (int)bucketstarts.size() - 1 ),
+          [&]( const tbb::blocked_range<int>& r ) {
+             Scratch& scratch = scratches.local();
+             for( int bucket = r.begin(); bucket < r.end(); ++bucket )
+#else
+      for( int bucket = 0; bucket < (int)bucketstarts.size() - 1; ++bucket )
+#endif
+             {
+                const int row = choices[bucketstarts[bucket]].row;
+                auto rowvec = consMatrix.getRowCoefficients( row );
+                const int* rowcols = rowvec.getIndices();
+                const REAL* rowvals = rowvec.getValues();
+
+                // the candidates in the order of the search above
+                scratch.candidates.clear();
+                for( int j = rowsize[row] - 1; j >= 0; --j )
+                {
+                   if( domcol[rowcols[j]] == -1 )
+                      scratch.candidates.emplace_back( rowcols[j],
+                                                       rowvals[j] );
+                }
+
+                for( int i = bucketstarts[bucket];
+                     i != bucketstarts[bucket + 1]; ++i )
+                {
+                   const RowChoice& choice = choices[i];
+                   int unbounded_col = unboundedcols[choice.k];
+                   bool integral =
+                       cflags[unbounded_col].test( ColFlag::kIntegral );
+                   int nrequired =
+                       scatter( scratch, choice.k, unbounded_col, choice.scale );
+                   // the value in the selected row as scaled by scatter()
+                   REAL scaled_val = scratch.values[row];
+                   REAL scaled_obj = obj[unbounded_col] * choice.scale;
+
+                   for( const auto& candidate : scratch.candidates )
+                   {
+                      int col = candidate.first;
+                      if( col == unbounded_col ||
+                          ( integral &&
+                            !cflags[col].test( ColFlag::kIntegral ) ) )
+                         continue;
+
+                      int scale = findDomination(
+                          col, rflags[row], scaled_val, scaled_obj,
+                          candidate.second, [&]( int scal2 ) {
+                             return checkScattered( scratch, choice.k,
+                                                    nrequired, unbounded_col,
+                                                    col, choice.scale, scal2 );
+                          } );
+
+                      if( scale != 0 )
+                         domcolsbuffers[choice.k - base].emplace_back(
+                             DomcolReduction{ unbounded_col, col,
+                                              choice.rowlock,
+                                              scale == 1
+                                                  ? BoundChange::kUpper
+                                                  : BoundChange::kLower } );
+                   }
+                }
+             }
+#ifdef PAPILO_TBB
+          } );
+#endif
+   };
+
    // repeat finding and filtering dominations to bound memory demand
    while( ndomcols < ndomcolsbound && start < unboundedcols.size() )
    {
@@ -405,6 +805,10 @@ DominatedCols<REAL>::execute( const Problem<REAL>& problem,
          if( (int)domcolsbuffers.size() < ndomcolsbuffers )
             domcolsbuffers.resize(ndomcolsbuffers);
 
+         if( indexed )
+            findDominationsIndexed( start, stopp, base );
+         else
+         {
 #ifdef PAPILO_TBB
    // scan unbounded columns if they dominate other columns
    tbb::parallel_for(
@@ -416,72 +820,18 @@ DominatedCols<REAL>::execute( const Problem<REAL>& problem,
 #endif
           {
              int unbounded_col = unboundedcols[k];
-             int lbfree = colinfo[unbounded_col].lbfree;
-             int ubfree = colinfo[unbounded_col].ubfree;
-             assert( lbfree != 0 || ubfree != 0 );
-             auto colvec = consMatrix.getColumnCoefficients( unbounded_col );
-             int collen = colvec.getLength();
-             const int* colrows = colvec.getIndices();
-             const REAL* colvals = colvec.getValues();
-             int lbrowlock = lbfree > 0 ? colrows[lbfree - 1] : -1;
-             int ubrowlock = ubfree > 0 ? colrows[ubfree - 1] : -1;
-             int bestrowsize = std::numeric_limits<int>::max();
-             int bestrowlock = std::numeric_limits<int>::max();
-             int bestrow = -1;
-             int bestscale = 0;
-             int row;
-
-             for( int i = 0; i < collen; ++i )
-             {
-                row = colrows[i];
-
-                if( bestrowsize < rowsize[row] )
-                   continue;
-
-                // determine the scale of the dominating column depending on
-                // whether the upper or lower bound is free, and remember which
-                // row needs to be locked to protect the implied bound (if any)
-                int rowlock = std::numeric_limits<int>::max();
-                int scale = 0;
-
-                if( ubfree != 0 && rowlock > ubrowlock
-                      && !rflags[row].test( colvals[i] < 0 ? RowFlag::kLhsInf : RowFlag::kRhsInf ) )
-                {
-                   rowlock = ubrowlock;
-                   scale = 1;
-                }
-
-                if( lbfree != 0 && rowlock > lbrowlock
-                      && !rflags[row].test( colvals[i] < 0 ? RowFlag::kRhsInf : RowFlag::kLhsInf ) )
-                {
-                   rowlock = lbrowlock;
-                   scale = -1;
-                }
-
-                assert(rowsize[row] >= 1);
-
-                if( scale == 0 || ( bestrowsize == rowsize[row] && bestrowlock <= rowlock ) )
-                   continue;
-
-                if( rowsize[row] == 1 )
-                {
-                   bestrow = -1;
-                   break;
-                }
-                else
-                   bestrow = i;
-
-                bestrowsize = rowsize[row];
-                bestrowlock = rowlock;
-                bestscale = scale;
-             }
+             int bestscale;
+             int bestrowlock;
+             int bestrow = selectRow( unbounded_col, bestscale, bestrowlock );
 
              if( bestrow == -1 )
                 continue;
 
-             row = colrows[bestrow];
+             auto colvec = consMatrix.getColumnCoefficients( unbounded_col );
+             int row = colvec.getIndices()[bestrow];
+             int bestrowsize = rowsize[row];
 
-             REAL scaled_val = colvals[bestrow] * bestscale;
+             REAL scaled_val = colvec.getValues()[bestrow] * bestscale;
              REAL scaled_obj = obj[unbounded_col] * bestscale;
              auto rowvec = consMatrix.getRowCoefficients( row );
              const int* rowcols = rowvec.getIndices();
@@ -496,64 +846,24 @@ DominatedCols<REAL>::execute( const Problem<REAL>& problem,
                       && !cflags[col].test( ColFlag::kIntegral ) ) )
                    continue;
 
-                bool to_lb = false;
-                bool to_ub = false;
+                int scale = findDomination(
+                    col, rflags[row], scaled_val, scaled_obj, rowvals[j],
+                    [&]( int scal2 ) {
+                       return checkDominance( unbounded_col, col, bestscale,
+                                              scal2 );
+                    } );
 
-                if( !rflags[row].test( RowFlag::kLhsInf,
-                                           RowFlag::kRhsInf ) )
-                {
-                   if( !cflags[col].test( ColFlag::kLbInf ) &&
-                       num.isEq( scaled_val, rowvals[j] ) &&
-                       num.isLE( scaled_obj, obj[col] ) &&
-                       checkDominance( unbounded_col, col, bestscale, 1 ) )
-                      to_lb = true;
-                   else if( !cflags[col].test( ColFlag::kUbInf ) &&
-                       num.isEq( scaled_val, -rowvals[j] ) &&
-                       num.isLE( scaled_obj, -obj[col] ) &&
-                       checkDominance( unbounded_col, col, bestscale, -1 ) )
-                      to_ub = true;
-                }
-                else if( rflags[row].test( RowFlag::kLhsInf ) )
-                {
-                   assert( scaled_val > 0 &&
-                           !rflags[row].test( RowFlag::kRhsInf ) );
-                   if( !cflags[col].test( ColFlag::kLbInf ) &&
-                       num.isLE( scaled_val, rowvals[j] ) &&
-                       num.isLE( scaled_obj, obj[col] ) &&
-                       checkDominance( unbounded_col, col, bestscale, 1 ) )
-                      to_lb = true;
-                   else if( !cflags[col].test( ColFlag::kUbInf ) &&
-                       num.isLE( scaled_val, -rowvals[j] ) &&
-                       num.isLE( scaled_obj, -obj[col] ) &&
-                       checkDominance( unbounded_col, col, bestscale, -1 ) )
-                      to_ub = true;
-                }
-                else
-                {
-                   assert( scaled_val < 0 &&
-                           rflags[row].test( RowFlag::kRhsInf ) );
-                   if( !cflags[col].test( ColFlag::kLbInf ) &&
-                       num.isGE( scaled_val, rowvals[j] ) &&
-                       num.isLE( scaled_obj, obj[col] ) &&
-                       checkDominance( unbounded_col, col, bestscale, 1 ) )
-                      to_lb = true;
-                   else if( !cflags[col].test( ColFlag::kUbInf ) &&
-                       num.isGE( scaled_val, -rowvals[j] ) &&
-                       num.isLE( scaled_obj, -obj[col] ) &&
-                       checkDominance( unbounded_col, col, bestscale, -1 ) )
-                      to_ub = true;
-                }
-
-                if( to_lb || to_ub )
+                if( scale != 0 )
                 {
                    domcolsbuffers[k - base].emplace_back( DomcolReduction{ unbounded_col, col,
-                         bestrowlock, to_lb ? BoundChange::kUpper : BoundChange::kLower } );
+                         bestrowlock, scale == 1 ? BoundChange::kUpper : BoundChange::kLower } );
                 }
              }
           }
 #ifdef PAPILO_TBB
        } );
 #endif
+         }
 
          for( int i = start - base; i < ndomcolsbuffers; ++i )
             ndomcols += domcolsbuffers[i].size();
@@ -571,37 +881,7 @@ DominatedCols<REAL>::execute( const Problem<REAL>& problem,
             if( domcolsbuffers[i].empty() || ( !lock && domcolsbuffers[i][0].implrowlock != -1 ) )
                continue;
             for( int j = 0; j < (int)domcolsbuffers[i].size(); ++j )
-            {
-               int source = domcolsbuffers[i][j].col2;
-               if( domcol[source] != -1 )
-                  continue;
-               int sink = domcolsbuffers[i][j].col1;
-               int node = sink;
-               while( domcol[node] >= 0 )
-                  node = domcols[domcol[node]].col1;
-               if( node == source )
-                  continue;
-               domcol[source] = domcols.size();
-               domcols.emplace_back(std::move(domcolsbuffers[i][j]));
-               if( nchildren[sink] >= 1 || domcol[sink] <= -1 )
-               {
-                  if( nchildren[source] == 0 )
-                  {
-                     nchildren[source] = -leaves.size();
-                     leaves.push_back(source);
-                  }
-                  ++nchildren[sink];
-               }
-               else
-               {
-                  if( nchildren[source] == 0 )
-                  {
-                     nchildren[source] = nchildren[sink];
-                     leaves[-nchildren[source]] = source;
-                  }
-                  nchildren[sink] = 1;
-               }
-            }
+               addDomination( domcolsbuffers[i][j] );
             domcolsbuffers[i].clear();
          }
          lock = !lock;
@@ -611,6 +891,46 @@ DominatedCols<REAL>::execute( const Problem<REAL>& problem,
       ndomcols = domcols.size();
    }
 
+   // two binary columns that cannot both be one: if col1 dominates col2,
+   // there is an optimal solution with col1 >= col2, hence col2 is zero
+   const ImplicationStore<REAL>& implications = problem.getImplications();
+   const auto& domains = problem.getVariableDomains();
+   if( implications.getNumImplications() != 0 &&
+       !problemUpdate.getPresolveOptions().verification_with_VeriPB )
+   {
+      for( int col1 = 0; col1 < std::min( (int)ncols, implications.getNCols() );
+           ++col1 )
+      {
+         if( !domains.isBinary( col1 ) )
+            continue;
+
+         ImplicationView<REAL> conflicts =
+             implications.getImplications( col1, true );
+         for( int k = 0; k != conflicts.getLength(); ++k )
+         {
+            int col2 = conflicts.getColumns()[k];
+            if( !conflicts.getUpper()[k] || conflicts.getBounds()[k] > 0 ||
+                !domains.isBinary( col2 ) )
+               continue;
+
+            if( domcol[col2] == -1 && num.isLE( obj[col1], obj[col2] ) &&
+                checkDominance( col1, col2, 1, 1 ) )
+            {
+               DomcolReduction reduction{ col1, col2, -1,
+                                          BoundChange::kUpper };
+               addDomination( reduction );
+            }
+            else if( domcol[col1] == -1 && num.isLE( obj[col2], obj[col1] ) &&
+                     checkDominance( col2, col1, 1, 1 ) )
+            {
+               DomcolReduction reduction{ col2, col1, -1,
+                                          BoundChange::kUpper };
+               addDomination( reduction );
+            }
+         }
+      }
+   }
+
    domcolsbuffers.clear();
    domcolsbuffers.shrink_to_fit();
    domcols.shrink_to_fit();
@@ -41,59 +41,6 @@ namespace papilo
 template <typename REAL>
 class ParallelColDetection : public PresolveMethod<REAL>
 {
-   struct SupportHashCompare
-   {
-      SupportHashCompare() = default;
-
-      static size_t
-      hash( const std::pair<int, const int*>& row )
-      {
-         Hasher<size_t> hasher( row.first );
-
-         const int* support = row.second;
-
-         for( int i = 0; i != row.first; ++i )
-         {
-            hasher.addValue( support[i] );
-         }
-
-         return hasher.getHash();
-      }
-
-      static bool
-      equal( const std::pair<int, const int*>& row1,
-             const std::pair<int, const int*>& row2 )
-      {
-         int length = row1.first;
-
-         if( length != row2.first )
-            return false;
-
-         return memcmp( static_cast<const void*>( row1.second ),
-                        static_cast<const void*>( row2.second ),
-                        length * sizeof( int ) ) == 0;
-      }
-   };
-
-   struct SupportHash
-   {
-      std::size_t
-      operator()( const std::pair<int, const int*>& row ) const
-      {
-         return SupportHashCompare::hash( row );
-      }
-   };
-
-   struct SupportEqual
-   {
-      bool
-      operator()( const std::pair<int, const int*>& row1,
-                  const std::pair<int, const int*>& row2 ) const
-      {
-         return SupportHashCompare::equal( row1, row2 );
-      }
-   };
-
    void
    findParallelCols( const Num<REAL>& num, const int* bucket, int bucketSize,
                      const ConstraintMatrix<REAL>& constMatrix,
@@ -102,12 +49,8 @@ class ParallelColDetection : public PresolveMethod<REAL>
                      bool is_binary, Reductions<REAL>& reductions );
 
    void
-   computeColHashes( const ConstraintMatrix<REAL>& constMatrix,
-                     const Vec<REAL>& obj, unsigned int* columnHashes );
-
-   void
-   computeSupportId( const ConstraintMatrix<REAL>& constMatrix,
-                     unsigned int* supportHashes );
+   computeCoefficientHashes( const ConstraintMatrix<REAL>& constMatrix,
+                             const Vec<REAL>& obj );
 
    void
    addPresolverParams( ParameterSet& paramSet ) override
@@ -150,10 +93,12 @@ class ParallelColDetection : public PresolveMethod<REAL>
 
  private:
    int
-   determineBucketSize( int nColumns,
-                        std::unique_ptr<unsigned int[]>& supportid,
-                        std::unique_ptr<unsigned int[]>& coefficentHashes,
-                        std::unique_ptr<int[]>& column, int i );
+   determineBucketSize( const Vec<std::size_t>& supporthash, int nColumns,
+                        const int* column, int i ) const;
+
+   int
+   determineSupportBucketSize( const ConstraintMatrix<REAL>& constMatrix,
+                               int* bucket, int bucketSize ) const;
 
    bool
    check_parallelity( const Num<REAL>& num, const Vec<REAL>& obj, int col1,
@@ -169,6 +114,10 @@ class ParallelColDetection : public PresolveMethod<REAL>
    determineOderingForZeroObj( REAL val1, REAL val2, int colpermCol1,
             int colpermCol2 ) const;
 
+   // hashes of the scaled coefficients of the columns including the
+   // objective
+   Vec<unsigned int> coefhash;
+
    bool symmetries = false;
 };
 
@@ -418,77 +367,30 @@ ParallelColDetection<REAL>::check_parallelity( const Num<REAL>& num,
 
 template <typename REAL>
 void
-ParallelColDetection<REAL>::computeColHashes(
-    const ConstraintMatrix<REAL>& constMatrix, const Vec<REAL>& obj,
-    unsigned int* columnHashes )
+ParallelColDetection<REAL>::computeCoefficientHashes(
+    const ConstraintMatrix<REAL>& constMatrix, const Vec<REAL>& obj )
 {
-#ifdef PAPILO_TBB
-   tbb::parallel_for(
-       tbb::blocked_range<int>( 0, constMatrix.getNCols() ),
-       [&]( const tbb::blocked_range<int>& r ) {
-          for( int i = r.begin(); i < r.end(); ++i )
-#else
-   for( int i = 0; i< constMatrix.getNCols(); i++)
-#endif
-          {
-             // compute hash-value for coefficients
-             auto columnCoefficients = constMatrix.getColumnCoefficients( i );
-             const REAL* values = columnCoefficients.getValues();
-             const int len = columnCoefficients.getLength();
-
-             Hasher<unsigned int> hasher( len );
-
-             if( len > 1 )
-             {
-                // compute scale such that the first coefficient is
-                // positive 1/golden ratio. The choice of
-                // the constant is arbitrary and is used to make cases
-                // where two coefficients that are equal
-                // within epsilon get different values are
-                // more unlikely by choose some irrational number
-                REAL scale = REAL( 2.0 / ( 1.0 + sqrt( 5.0 ) ) ) / values[0];
-
-                // add scaled coefficients of other row
-                // entries to compute the hash
-                for( int j = 1; j != len; ++j )
-                {
-                   hasher.addValue( Num<REAL>::hashCode( values[j] * scale ) );
-                }
-                if( obj[i] != 0 )
-                   hasher.addValue( Num<REAL>::hashCode( obj[i] * scale ) );
-             }
-
-             columnHashes[i] = hasher.getHash();
-          }
-#ifdef PAPILO_TBB
-       } );
-#endif
-}
-
-template <typename REAL>
-void
-ParallelColDetection<REAL>::computeSupportId(
-    const ConstraintMatrix<REAL>& constMatrix, unsigned int* supportHashes )
-{
-   using SupportMap =
-       HashMap<std::pair<int, const int*>, int, SupportHash, SupportEqual>;
+   const VectorHashIndex<REAL>& hashes = constMatrix.getColHashIndex();
+   const Vec<unsigned int>& matrixhash = hashes.getCoefficientHashes();
+   const int ncols = constMatrix.getNCols();
 
-   SupportMap supportMap(
-       static_cast<std::size_t>( constMatrix.getNCols() * 1.1 ) );
+   coefhash.resize( ncols );
 
-   for( int i = 0; i < constMatrix.getNCols(); ++i )
+   // the objective is not part of the matrix, hence its coefficient is
+   // scaled like the column and added to the hash of the column here
+   for( int col = 0; col != ncols; ++col )
    {
-      auto col = constMatrix.getColumnCoefficients( i );
-      int length = col.getLength();
-      const int* support = col.getIndices();
+      auto columnCoefficients = constMatrix.getColumnCoefficients( col );
+      Hasher<unsigned int> hasher( matrixhash[col] );
 
-      auto insResult =
-          supportMap.emplace( std::make_pair( length, support ), i );
+      if( columnCoefficients.getLength() > 1 && obj[col] != 0 )
+      {
+         REAL scale = VectorHashIndex<REAL>::getScale(
+             columnCoefficients.getValues()[0] );
+         hasher.addValue( Num<REAL>::hashCode( obj[col] * scale ) );
+      }
 
-      if( insResult.second )
-         supportHashes[i] = i;
-      else // support already exists, use the previous support id
-         supportHashes[i] = insResult.first->second;
+      coefhash[col] = hasher.getHash();
    }
 }
 
@@ -513,28 +415,16 @@ ParallelColDetection<REAL>::execute( const Problem<REAL>& problem,
 
    assert( ncols > 0 );
 
-   std::unique_ptr<unsigned int[]> supportid{ new unsigned int[ncols] };
-   std::unique_ptr<unsigned int[]> coefhash{ new unsigned int[ncols] };
    std::unique_ptr<int[]> col{ new int[ncols] };
 
-#ifdef PAPILO_TBB
-   tbb::parallel_invoke(
-       [ncols, &col]() {
-          for( int i = 0; i < ncols; ++i )
-             col[i] = i;
-       },
-       [&constMatrix, &coefhash, &obj, this]() {
-          computeColHashes( constMatrix, obj, coefhash.get() );
-       },
-       [&constMatrix, &supportid, this]() {
-          computeSupportId( constMatrix, supportid.get() );
-       } );
-#else
    for( int i = 0; i < ncols; ++i )
       col[i] = i;
-   computeColHashes( constMatrix, obj, coefhash.get() );
-   computeSupportId( constMatrix, supportid.get() );
-#endif
+
+   // the hashes of the columns are kept by the matrix and only the columns
+   // that changed since the last call are rehashed
+   const Vec<std::size_t>& supporthash =
+       constMatrix.getColHashIndex().getSupportHashes();
+   computeCoefficientHashes( constMatrix, obj );
 
    pdqsort(
        col.get(), col.get() + ncols,
@@ -549,13 +439,15 @@ ParallelColDetection<REAL>::execute( const Problem<REAL>& problem,
           assert(constMatrix.getColumnCoefficients( a ).getLength() > 0);
           assert(constMatrix.getColumnCoefficients( b ).getLength() > 0);
 
-          if( supportid[a] < supportid[b] ||
-              ( supportid[a] == supportid[b] && coefhash[a] < coefhash[b] ) )
+          if( supporthash[a] < supporthash[b] ||
+              ( supporthash[a] == supporthash[b] &&
+                coefhash[a] < coefhash[b] ) )
              return true;
-          else if( !( supportid[a] == supportid[b] &&
+          else if( !( supporthash[a] == supporthash[b] &&
                         coefhash[a] == coefhash[b] ) )
              return false;
-          assert( supportid[a] == supportid[b] && coefhash[a] == coefhash[b] );
+          assert( supporthash[a] == supporthash[b] &&
+                  coefhash[a] == coefhash[b] );
 
           bool flag_a_integer = cflags[a].test( ColFlag::kIntegral );
           bool flag_b_integer = cflags[b].test( ColFlag::kIntegral );
@@ -578,13 +470,20 @@ ParallelColDetection<REAL>::execute( const Problem<REAL>& problem,
    const bool is_binary = problem.test_problem_type( ProblemFlag::kBinary );
    for( int i = 0; i < ncols; )
    {
-      int bucketSize =
-          determineBucketSize( ncols, supportid, coefhash, col, i );
+      int bucketSize = determineBucketSize( supporthash, ncols, col.get(), i );
 
-      // if more than one col is in the bucket find parallel cols
-      if( bucketSize > 1 )
-         findParallelCols( num, col.get() + i, bucketSize, constMatrix, obj,
-                           problem.getVariableDomains(), symmetries, is_binary, reductions );
+      // if more than one col is in the bucket find parallel cols among the
+      // cols with the same support
+      for( int j = i; j < i + bucketSize; )
+      {
+         int supportBucketSize = determineSupportBucketSize(
+             constMatrix, col.get() + j, i + bucketSize - j );
+         if( supportBucketSize > 1 )
+            findParallelCols( num, col.get() + j, supportBucketSize,
+                              constMatrix, obj, problem.getVariableDomains(),
+                              symmetries, is_binary, reductions );
+         j += supportBucketSize;
+      }
       i = i + bucketSize;
    }
    if( reductions.getTransactions().size() > 0 )
@@ -615,15 +514,14 @@ ParallelColDetection<REAL>::execute_symmetries( const Problem<REAL>& problem,
 template <typename REAL>
 int
 ParallelColDetection<REAL>::determineBucketSize(
-    int nColumns, std::unique_ptr<unsigned int[]>& supportid,
-    std::unique_ptr<unsigned int[]>& coefficentHashes,
-    std::unique_ptr<int[]>& column, int i )
+    const Vec<std::size_t>& supporthash, int nColumns, const int* column,
+    int i ) const
 {
    int j;
    for( j = i + 1; j < nColumns; ++j )
    {
-      if( coefficentHashes[column[i]] != coefficentHashes[column[j]] ||
-          supportid[column[i]] != supportid[column[j]] )
+      if( coefhash[column[i]] != coefhash[column[j]] ||
+          supporthash[column[i]] != supporthash[column[j]] )
       {
          break;
       }
@@ -632,6 +530,34 @@ ParallelColDetection<REAL>::determineBucketSize(
    return j - i;
 }
 
+template <typename REAL>
+int
+ParallelColDetection<REAL>::determineSupportBucketSize(
+    const ConstraintMatrix<REAL>& constMatrix, int* bucket,
+    int bucketSize ) const
+{
+   if( bucketSize == 1 )
+      return 1;
+
+   auto col1 = constMatrix.getColumnCoefficients( bucket[0] );
+   auto hasSupportOfFirstCol = [&]( int col ) {
+      auto col2 = constMatrix.getColumnCoefficients( col );
+      return VectorHashIndex<REAL>::equalSupport(
+          col1.getLength(), col1.getIndices(), col2.getLength(),
+          col2.getIndices() );
+   };
+
+   // the supports only share their hash in case of a collision, then the
+   // cols with the support of the first col are moved to the front without
+   // changing their order
+   if( std::all_of( bucket + 1, bucket + bucketSize, hasSupportOfFirstCol ) )
+      return bucketSize;
+
+   return (int)( std::stable_partition( bucket, bucket + bucketSize,
+                                        hasSupportOfFirstCol ) -
+                 bucket );
+}
+
 template <typename REAL>
 bool
 ParallelColDetection<REAL>::determineOderingForZeroObj( REAL val1, REAL val2,
@@ -41,76 +41,18 @@ template <typename REAL>
 // Identical row reduction needs to be done before
 class ParallelRowDetection : public PresolveMethod<REAL>
 {
-   struct SupportHashCompare
-   {
-      SupportHashCompare() = default;
-
-      static size_t
-      hash( const std::pair<int, const int*>& row )
-      {
-         Hasher<size_t> hasher( row.first );
-
-         const int* support = row.second;
-
-         for( int i = 0; i != row.first; ++i )
-         {
-            hasher.addValue( support[i] );
-         }
-
-         return hasher.getHash();
-      }
-
-      static bool
-      equal( const std::pair<int, const int*>& row1,
-             const std::pair<int, const int*>& row2 )
-      {
-         int length = row1.first;
-
-         if( length != row2.first )
-            return false;
-
-         return memcmp( static_cast<const void*>( row1.second ),
-                        static_cast<const void*>( row2.second ),
-                        length * sizeof( int ) ) == 0;
-      }
-   };
-
-   struct SupportHash
-   {
-      std::size_t
-      operator()( const std::pair<int, const int*>& row ) const
-      {
-         return SupportHashCompare::hash( row );
-      }
-   };
-
-   struct SupportEqual
-   {
-      bool
-      operator()( const std::pair<int, const int*>& row1,
-                  const std::pair<int, const int*>& row2 ) const
-      {
-         return SupportHashCompare::equal( row1, row2 );
-      }
-   };
-
    void
    findParallelRows( const Num<REAL>& num, const int* bucket, int bucketsize,
                      const ConstraintMatrix<REAL>& constMatrix,
                      Vec<int>& parallel_rows );
 
-   void
-   computeRowHashes( const ConstraintMatrix<REAL>& constMatrix,
-                     unsigned int* rowhashes );
-
-   void
-   computeSupportId( const ConstraintMatrix<REAL>& constMatrix,
-                     unsigned int* supporthashes );
+   int
+   determineBucketSize( const VectorHashIndex<REAL>& hashes, int nRows,
+                        const int* row, int i ) const;
 
    int
-   determineBucketSize( int nRows, std::unique_ptr<unsigned int[]>& supportid,
-                        std::unique_ptr<unsigned int[]>& coefhash,
-                        std::unique_ptr<int[]>& row, int i );
+   determineSupportBucketSize( const ConstraintMatrix<REAL>& constMatrix,
+                               int* bucket, int bucketsize ) const;
 
  public:
    ParallelRowDetection() : PresolveMethod<REAL>()
@@ -199,82 +141,6 @@ ParallelRowDetection<REAL>::findParallelRows(
       parallel_rows.clear();
 }
 
-template <typename REAL>
-void
-ParallelRowDetection<REAL>::computeRowHashes(
-    const ConstraintMatrix<REAL>& constMatrix, unsigned int* rowhashes )
-{
-#ifdef PAPILO_TBB
-   tbb::parallel_for(
-       tbb::blocked_range<int>( 0, constMatrix.getNRows() ),
-       [&]( const tbb::blocked_range<int>& r ) {
-          for( int i = r.begin(); i != r.end(); ++i )
-#else
-   for( int i = 0; i != constMatrix.getNRows(); ++i )
-#endif
-          {
-             // compute hash-value for coefficients
-
-             auto rowcoefs = constMatrix.getRowCoefficients( i );
-             const REAL* rowvals = rowcoefs.getValues();
-             const int len = rowcoefs.getLength();
-
-             Hasher<unsigned int> hasher( len );
-             // only makes sense for non-singleton rows
-             // (should not occur after redundant rows are
-             // already deleted)
-             if( len > 1 )
-             {
-                // compute scale such that the first coefficient is
-                // positive 1/golden ratio. The choice of
-                // the constant is arbitrary and is used to make cases
-                // where two coefficients that are equal
-                // within epsilon get different values are
-                // more unlikely by choosing some irrational number
-                REAL scale = REAL( 2.0 / ( 1.0 + sqrt( 5.0 ) ) ) / rowvals[0];
-
-                // add scaled coefficients of other row
-                // entries to compute the hash
-                for( int j = 1; j != len; ++j )
-                {
-                   hasher.addValue( Num<REAL>::hashCode( rowvals[j] * scale ) );
-                }
-             }
-
-             rowhashes[i] = hasher.getHash();
-          }
-#ifdef PAPILO_TBB
-       } );
-#endif
-}
-
-template <typename REAL>
-void
-ParallelRowDetection<REAL>::computeSupportId(
-    const ConstraintMatrix<REAL>& constMatrix, unsigned int* supporthashes )
-{
-   using SupportMap =
-       HashMap<std::pair<int, const int*>, int, SupportHash, SupportEqual>;
-
-   SupportMap supportMap(
-       static_cast<std::size_t>( constMatrix.getNRows() * 1.1 ) );
-
-   for( int i = 0; i < constMatrix.getNRows(); ++i )
-   {
-      auto row = constMatrix.getRowCoefficients( i );
-      int length = row.getLength();
-      const int* support = row.getIndices();
-
-      auto insResult =
-          supportMap.emplace( std::make_pair( length, support ), i );
-
-      if( insResult.second )
-         supporthashes[i] = i;
-      else // support already exists, use the previous support id
-         supporthashes[i] = insResult.first->second;
-   }
-}
-
 template <typename REAL>
 PresolveStatus
 ParallelRowDetection<REAL>::execute( const Problem<REAL>& problem,
@@ -492,52 +358,48 @@ ParallelRowDetection<REAL>::execute( const Problem<REAL>& problem,
 
    assert( nRows > 0 );
 
-   std::unique_ptr<unsigned int[]> supportid{ new unsigned int[nRows] };
-   std::unique_ptr<unsigned int[]> coefhash{ new unsigned int[nRows] };
    std::unique_ptr<int[]> row{ new int[nRows] };
 
-#ifdef PAPILO_TBB
-   tbb::parallel_invoke(
-       [nRows, &row]() {
-          for( int i = 0; i < nRows; ++i )
-             row[i] = i;
-       },
-       [&constMatrix, &coefhash, this]() {
-          computeRowHashes( constMatrix, coefhash.get() );
-       },
-       [&constMatrix, &supportid, this]() {
-          computeSupportId( constMatrix, supportid.get() );
-       } );
-#else
    for( int i = 0; i < nRows; ++i )
       row[i] = i;
-   computeRowHashes( constMatrix, coefhash.get() );
-   computeSupportId( constMatrix, supportid.get() );
-#endif
+
+   // the hashes of the rows are kept by the matrix and only the rows that
+   // changed since the last call are rehashed
+   const VectorHashIndex<REAL>& hashes = constMatrix.getRowHashIndex();
+   const Vec<std::size_t>& supporthash = hashes.getSupportHashes();
+   const Vec<unsigned int>& coefhash = hashes.getCoefficientHashes();
 
    pdqsort( row.get(), row.get() + nRows, [&]( int a, int b ) {
-      return supportid[a] < supportid[b] ||
-             ( supportid[a] == supportid[b] && coefhash[a] < coefhash[b] ) ||
-             ( supportid[a] == supportid[b] && coefhash[a] == coefhash[b] &&
-               rowperm[a] < rowperm[b] );
+      return supporthash[a] < supporthash[b] ||
+             ( supporthash[a] == supporthash[b] &&
+               coefhash[a] < coefhash[b] ) ||
+             ( supporthash[a] == supporthash[b] &&
+               coefhash[a] == coefhash[b] && rowperm[a] < rowperm[b] );
    } );
 
    Vec<Vec<int>> stored_parallel_rows;
 
    for( int i = 0; i < nRows; )
    {
-      int bucketSize =
-          determineBucketSize( nRows, supportid, coefhash, row, i );
+      int bucketSize = determineBucketSize( hashes, nRows, row.get(), i );
 
-      // if more  than one row is in the bucket try to find parallel rows
-      if( bucketSize > 1 )
+      // if more than one row is in the bucket try to find parallel rows among
+      // the rows with the same support
+      for( int j = i; j < i + bucketSize; )
       {
-         Vec<int> parallel_rows;
-         parallel_rows.reserve( bucketSize );
-         findParallelRows( num, row.get() + i, bucketSize, constMatrix,
-                           parallel_rows );
-         if( !parallel_rows.empty() )
-            stored_parallel_rows.emplace_back( parallel_rows );
+         int supportBucketSize = determineSupportBucketSize(
+             constMatrix, row.get() + j, i + bucketSize - j );
+
+         if( supportBucketSize > 1 )
+         {
+            Vec<int> parallel_rows;
+            parallel_rows.reserve( supportBucketSize );
+            findParallelRows( num, row.get() + j, supportBucketSize,
+                              constMatrix, parallel_rows );
+            if( !parallel_rows.empty() )
+               stored_parallel_rows.emplace_back( parallel_rows );
+         }
+         j += supportBucketSize;
       }
       i = bucketSize + i;
    }
@@ -563,15 +425,16 @@ ParallelRowDetection<REAL>::execute( const Problem<REAL>& problem,
 template <typename REAL>
 int
 ParallelRowDetection<REAL>::determineBucketSize(
-    int nRows, std::unique_ptr<unsigned int[]>& supportid,
-    std::unique_ptr<unsigned int[]>& coefhash, std::unique_ptr<int[]>& row,
-    int i )
+    const VectorHashIndex<REAL>& hashes, int nRows, const int* row,
+    int i ) const
 {
+   const Vec<std::size_t>& supporthash = hashes.getSupportHashes();
+   const Vec<unsigned int>& coefhash = hashes.getCoefficientHashes();
    int j;
    for( j = i + 1; j < nRows; ++j )
    {
       if( coefhash[row[i]] != coefhash[row[j]] ||
-          supportid[row[i]] != supportid[row[j]] )
+          supporthash[row[i]] != supporthash[row[j]] )
       {
          break;
       }
@@ -580,6 +443,34 @@ ParallelRowDetection<REAL>::determineBucketSize(
    return j - i;
 }
 
+template <typename REAL>
+int
+ParallelRowDetection<REAL>::determineSupportBucketSize(
+    const ConstraintMatrix<REAL>& constMatrix, int* bucket,
+    int bucketsize ) const
+{
+   if( bucketsize == 1 )
+      return 1;
+
+   auto row1 = constMatrix.getRowCoefficients( bucket[0] );
+   auto hasSupportOfFirstRow = [&]( int row ) {
+      auto row2 = constMatrix.getRowCoefficients( row );
+      return VectorHashIndex<REAL>::equalSupport(
+          row1.getLength(), row1.getIndices(), row2.getLength(),
+          row2.getIndices() );
+   };
+
+   // the supports only share their hash in case of a collision, then the
+   // rows with the support of the first row are moved to the front without
+   // changing their order
+   if( std::all_of( bucket + 1, bucket + bucketsize, hasSupportOfFirstRow ) )
+      return bucketsize;
+
+   return (int)( std::stable_partition( bucket, bucket + bucketsize,
+                                        hasSupportOfFirstRow ) -
+                 bucket );
+}
+
 } // namespace papilo
 
 #endif
@@ -55,6 +55,8 @@ class Probing : public PresolveMethod<REAL>
    int minbadgesize = 10;
    int max_badge_size = DEFAULT_MAX_BADGE_SIZE;
    double mincontdomred = 0.3;
+   int sparse_overlay = -1;
+   bool use_implications = true;
 
  public:
    Probing() : PresolveMethod<REAL>()
@@ -112,6 +114,19 @@ class Probing : public PresolveMethod<REAL>
           "minimum fraction of domain that needs to be reduced for continuous "
           "variables to accept a bound change in probing",
           mincontdomred, 0.0, 1.0 );
+
+      paramSet.addParameter(
+          "probing.sparseoverlay",
+          "should the probing views store only the changed bounds and "
+          "activities instead of copying them (-1: if the problem has at "
+          "least 100000 rows plus columns, 0: never, 1: always)",
+          sparse_overlay, -1, 1 );
+
+      paramSet.addParameter(
+          "probing.implications",
+          "should probing start from the implications stored in previous "
+          "rounds and store the implications of the probed columns",
+          use_implications );
    }
 
    PresolveStatus
@@ -357,17 +372,36 @@ Probing<REAL>::execute( const Problem<REAL>& problem,
    std::atomic_bool infeasible{ false };
    std::atomic_int infeasible_variable {-1};
 
-   // use tbb combinable so that each thread will copy the activities and
-   // bounds at most once
+   // the sparse views read through to the problem, otherwise use tbb
+   // combinable so that each thread will copy the activities and bounds at
+   // most once
+   const bool sparse =
+       sparse_overlay == 1 ||
+       ( sparse_overlay == -1 &&
+         problem.getNRows() + problem.getNCols() >= 100000 );
 #ifdef PAPILO_TBB
-   tbb::combinable<ProbingView<REAL>> probing_views( [this, &problem, &num]() {
-      ProbingView<REAL> probingView( problem, num );
-      probingView.setMinContDomRed( mincontdomred );
-      return probingView;
-   } );
+   tbb::combinable<ProbingView<REAL>> probing_views(
+       [this, &problem, &num, sparse]() {
+          ProbingView<REAL> probingView( problem, num, sparse );
+          probingView.setMinContDomRed( mincontdomred );
+          probingView.setUseImplications( use_implications );
+          return probingView;
+       } );
 #else
-   ProbingView<REAL> probingView( problem, num );
+   ProbingView<REAL> probingView( problem, num, sparse );
    probingView.setMinContDomRed( mincontdomred );
+   probingView.setUseImplications( use_implications );
+#endif
+   Vec<Implication<REAL>> implications;
+   ProbingResults<REAL> results;
+#ifdef PAPILO_TBB
+   // in deterministic mode the candidates are probed in chunks of a fixed
+   // size and the results of the chunks are merged in the order of the
+   // chunks, otherwise they are merged in the arbitrary order of the threads
+   const bool deterministic =
+       problemUpdate.getPresolveOptions().deterministic;
+   const int chunksize = 16;
+   Vec<ProbingResults<REAL>> chunkresults;
 #endif
 
    do
@@ -376,58 +410,94 @@ Probing<REAL>::execute( const Problem<REAL>& problem,
                       current_badge_start,
                       current_badge_end );
 
-      auto propagate_variables = [&]( int start, int end) {
-#ifdef PAPILO_TBB
-         tbb::parallel_for(
-             tbb::blocked_range<int>( start, end ),
-             [&]( const tbb::blocked_range<int>& r )
-             {
-                ProbingView<REAL>& probingView = probing_views.local();
+      // probes the candidate at position i and returns false if probing
+      // should stop
+      auto probe_candidate = [&]( ProbingView<REAL>& probingView, int i ) {
+         if( PresolveMethod<REAL>::is_interrupted(
+                 timer, problemUpdate.getPresolveOptions().tlim, problemUpdate.getPresolveOptions().early_exit_callback ) )
+            return false;
+         const int col = probing_cands[i];
 
-                for( int i = r.begin(); i != r.end(); ++i )
-#else
-         for( int i = start; i < end; i++ )
-#endif
-                {
-                   if( PresolveMethod<REAL>::is_interrupted(
-                           timer, problemUpdate.getPresolveOptions().tlim, problemUpdate.getPresolveOptions().early_exit_callback ) )
-                      break;
-                   const int col = probing_cands[i];
+         assert( cflags[col].test( ColFlag::kIntegral ) &&
+                     (lower_bounds[col] == 0 ||
+                 upper_bounds[col] == 1 ));
 
-                   assert( cflags[col].test( ColFlag::kIntegral ) &&
-                               (lower_bounds[col] == 0 ||
-                           upper_bounds[col] == 1 ));
+         if( infeasible.load( std::memory_order_relaxed ) )
+            return false;
 
-                   if( infeasible.load( std::memory_order_relaxed ) )
-                      break;
+         assert( !probingView.isInfeasible() );
+         probingView.setProbingColumn( col, true );
+         probingView.propagateDomains();
+         probingView.storeImplications();
+         probingView.reset();
 
-                   assert( !probingView.isInfeasible() );
-                   probingView.setProbingColumn( col, true );
-                   probingView.propagateDomains();
-                   probingView.storeImplications();
-                   probingView.reset();
+         if( infeasible.load( std::memory_order_relaxed ) )
+            return false;
 
-                   if( infeasible.load( std::memory_order_relaxed ) )
-                      break;
+         assert( !probingView.isInfeasible() );
+         probingView.setProbingColumn( col, false );
+         probingView.propagateDomains();
 
-                   assert( !probingView.isInfeasible() );
-                   probingView.setProbingColumn( col, false );
-                   probingView.propagateDomains();
+         bool globalInfeasible = probingView.analyzeImplications();
+         probingView.reset();
 
-                   bool globalInfeasible = probingView.analyzeImplications();
-                   probingView.reset();
+         ++nprobed[col];
 
-                   ++nprobed[col];
+         if( globalInfeasible )
+         {
+            infeasible.store( true, std::memory_order_relaxed );
+            infeasible_variable.store(col);
+            return false;
+         }
+         return true;
+      };
 
-                   if( globalInfeasible )
+      auto propagate_variables = [&]( int start, int end) {
+#ifdef PAPILO_TBB
+         if( deterministic )
+         {
+            const int nchunks = ( end - start + chunksize - 1 ) / chunksize;
+            chunkresults.resize( nchunks );
+            tbb::parallel_for(
+                tbb::blocked_range<int>( 0, nchunks ),
+                [&]( const tbb::blocked_range<int>& r )
+                {
+                   ProbingView<REAL>& probingView = probing_views.local();
+
+                   for( int chunk = r.begin(); chunk != r.end(); ++chunk )
                    {
-                      infeasible.store( true, std::memory_order_relaxed );
-                      infeasible_variable.store(col);
-                      break;
+                      const int chunkend =
+                          std::min( end, start + ( chunk + 1 ) * chunksize );
+                      for( int i = start + chunk * chunksize; i != chunkend;
+                           ++i )
+                      {
+                         if( !probe_candidate( probingView, i ) )
+                            break;
+                      }
+                      probingView.moveResults( chunkresults[chunk] );
                    }
+                } );
+            return;
+         }
+
+         tbb::parallel_for(
+             tbb::blocked_range<int>( start, end ),
+             [&]( const tbb::blocked_range<int>& r )
+             {
+                ProbingView<REAL>& probingView = probing_views.local();
+
+                for( int i = r.begin(); i != r.end(); ++i )
+                {
+                   if( !probe_candidate( probingView, i ) )
+                      break;
                 }
-#ifdef PAPILO_TBB
              } );
+#else
+         for( int i = start; i < end; i++ )
+         {
+            if( !probe_candidate( probingView, i ) )
+               break;
+         }
 #endif
       };
 
@@ -448,14 +518,11 @@ Probing<REAL>::execute( const Problem<REAL>& problem,
       int nboundchgs = 0;
       int nsubstitutions = -substitutions.size();
 
-#ifdef PAPILO_TBB
-      probing_views.combine_each( [&]( ProbingView<REAL>& probingView ) {
-#endif
-         const auto& probingBoundChgs = probingView.getProbingBoundChanges();
-         const auto& probingSubstitutions =
-             probingView.getProbingSubstitutions();
+      auto merge_results = [&]( const ProbingResults<REAL>& probingResults ) {
+         const auto& probingBoundChgs = probingResults.boundChanges;
+         const auto& probingSubstitutions = probingResults.substitutions;
 
-         amountofwork += probingView.getAmountOfWork();
+         amountofwork += probingResults.amountofwork;
 
          for( const ProbingSubstitution<REAL>& subst : probingSubstitutions )
          {
@@ -524,9 +591,32 @@ Probing<REAL>::execute( const Problem<REAL>& problem,
             }
          }
 
-         probingView.clearResults();
+         implications.insert( implications.end(),
+                              probingResults.implications.begin(),
+                              probingResults.implications.end() );
+      };
+
 #ifdef PAPILO_TBB
-      } );
+      if( deterministic )
+      {
+         for( ProbingResults<REAL>& chunk : chunkresults )
+         {
+            merge_results( chunk );
+            chunk.clear();
+         }
+      }
+      else
+      {
+         probing_views.combine_each( [&]( ProbingView<REAL>& probingView ) {
+            probingView.moveResults( results );
+            merge_results( results );
+            results.clear();
+         } );
+      }
+#else
+      probingView.moveResults( results );
+      merge_results( results );
+      results.clear();
 #endif
       nsubstitutions += substitutions.size();
       current_badge_start = current_badge_end;
@@ -561,6 +651,9 @@ Probing<REAL>::execute( const Problem<REAL>& problem,
               PresolveMethod<REAL>::is_interrupted(timer, problemUpdate.getPresolveOptions().tlim, problemUpdate.getPresolveOptions().early_exit_callback);
    } while( !abort );
 
+   // the implications are merged into the store after the round
+   problemUpdate.getImplications().add( implications );
+
    PresolveStatus result = PresolveStatus::kUnchanged;
 
    if( !boundChanges.empty() )
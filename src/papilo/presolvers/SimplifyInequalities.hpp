@@ -96,6 +96,20 @@ class SimplifyInequalities : public PresolveMethod<REAL>
        const Vec<REAL>& lbs, const Vec<REAL>& ubs, int row,
        Reductions<REAL>& reductions, Vec<int>& coefficientsThatCanBeDeleted,
        Vec<int>& colOrder );
+
+   void
+   updateCandidates( const ConstraintMatrix<REAL>& consMatrix,
+                     const ProblemUpdate<REAL>& problemUpdate );
+
+   // rows that need to be checked in this call: the rows that changed or
+   // contain a changed column since the last call and the rows that were not
+   // checked or produced reductions in the last call, since these reductions
+   // could have been rejected
+   Vec<int> candidates;
+   Vec<int> pending_rows;
+   ChangeLogPosition position;
+   Vec<int> changed_rows;
+   Vec<int> changed_cols;
 };
 
 #ifdef PAPILO_USE_EXTERN_TEMPLATES
@@ -303,7 +317,6 @@ SimplifyInequalities<REAL>::execute( const Problem<REAL>& problem,
    const Vec<ColFlags>& cflags = problem.getColFlags();
    const Vec<REAL>& lhs = consMatrix.getLeftHandSides();
    const Vec<REAL>& rhs = consMatrix.getRightHandSides();
-   const int nrows = consMatrix.getNRows();
    const Vec<REAL>& lbs = problem.getLowerBounds();
    const Vec<REAL>& ubs = problem.getUpperBounds();
 
@@ -313,40 +326,52 @@ SimplifyInequalities<REAL>::execute( const Problem<REAL>& problem,
    assert( problemUpdate.getPresolveOptions().runs_sequential() );
 #endif
 
+   updateCandidates( consMatrix, problemUpdate );
+   const int ncandidates = (int)candidates.size();
+   assert( ncandidates <= consMatrix.getNRows() );
+
    if( problemUpdate.getPresolveOptions().runs_sequential() ||
        !problemUpdate.getPresolveOptions().simplify_inequalities_parallel )
    {
       // allocate only once
       Vec<int> colOrder;
       Vec<int> coefficientsThatCanBeDeleted;
-      for( int row = 0; row < nrows; row++ )
+      for( int i = 0; i < ncandidates; i++ )
       {
+         int row = candidates[i];
          if( reductions.size() >= problemUpdate.getPresolveOptions().max_reduction_seq )
+         {
+            pending_rows.insert( pending_rows.end(), candidates.begin() + i,
+                                 candidates.end() );
             break;
+         }
          if( perform_simplify_ineq_task(
                  num, consMatrix, activities, rflags, cflags, lhs, rhs, lbs,
                  ubs, row, reductions, coefficientsThatCanBeDeleted,
                  colOrder ) == PresolveStatus::kReduced )
+         {
             result = PresolveStatus::kReduced;
+            pending_rows.push_back( row );
+         }
       }
    }
 #ifdef PAPILO_TBB
    else
    {
-      Vec<Reductions<REAL>> stored_reductions( nrows );
-      // iterate over all constraints and try to simplify them
+      Vec<Reductions<REAL>> stored_reductions( ncandidates );
+      // iterate over all candidate constraints and try to simplify them
       tbb::parallel_for(
-          tbb::blocked_range<int>( 0, nrows ),
+          tbb::blocked_range<int>( 0, ncandidates ),
           [&]( const tbb::blocked_range<int>& r )
           {
              // allocate only once per thread
              Vec<int> colOrder;
              Vec<int> coefficientsThatCanBeDeleted;
-             for( int row = r.begin(); row < r.end(); ++row )
+             for( int i = r.begin(); i < r.end(); ++i )
              {
                 PresolveStatus status = perform_simplify_ineq_task(
                     num, consMatrix, activities, rflags, cflags, lhs, rhs, lbs,
-                    ubs, row, stored_reductions[row],
+                    ubs, candidates[i], stored_reductions[i],
                     coefficientsThatCanBeDeleted, colOrder );
                 if( status == PresolveStatus::kReduced )
                    result = PresolveStatus::kReduced;
@@ -363,6 +388,7 @@ SimplifyInequalities<REAL>::execute( const Problem<REAL>& problem,
          Reductions<REAL> reds = stored_reductions[i];
          if( reds.size() > 0 )
          {
+            pending_rows.push_back( candidates[i] );
             for( const auto& transaction : reds.getTransactions() )
             {
                int start = transaction.start;
@@ -382,6 +408,46 @@ SimplifyInequalities<REAL>::execute( const Problem<REAL>& problem,
    return result;
 }
 
+template <typename REAL>
+void
+SimplifyInequalities<REAL>::updateCandidates(
+    const ConstraintMatrix<REAL>& consMatrix,
+    const ProblemUpdate<REAL>& problemUpdate )
+{
+   const ChangeLog& changeLog = problemUpdate.getChangeLog();
+   const int nrows = consMatrix.getNRows();
+
+   bool incremental =
+       changeLog.getChangesSince( position, changed_rows, changed_cols );
+   position = changeLog.getPosition();
+
+   candidates.clear();
+   if( !incremental )
+   {
+      candidates.resize( nrows );
+      for( int row = 0; row < nrows; ++row )
+         candidates[row] = row;
+   }
+   else
+   {
+      // the simplification of a row depends on its coefficients, sides and
+      // activity and on the bounds and integrality of its columns
+      candidates.swap( pending_rows );
+      candidates.insert( candidates.end(), changed_rows.begin(),
+                         changed_rows.end() );
+      for( int col : changed_cols )
+      {
+         auto colvec = consMatrix.getColumnCoefficients( col );
+         candidates.insert( candidates.end(), colvec.getIndices(),
+                            colvec.getIndices() + colvec.getLength() );
+      }
+      std::sort( candidates.begin(), candidates.end() );
+      candidates.erase( std::unique( candidates.begin(), candidates.end() ),
+                        candidates.end() );
+   }
+   pending_rows.clear();
+}
+
 template <typename REAL>
 PresolveStatus
 SimplifyInequalities<REAL>::perform_simplify_ineq_task(
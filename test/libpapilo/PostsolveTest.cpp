@@ -21,6 +21,40 @@
 
 #include "libpapilo.h"
 #include "papilo/external/catch/catch_amalgamated.hpp"
+#include <string>
+#include <vector>
+
+// 2x + 3y + 4z + w <= 8, 3x + 2y + z <= 5 with integers x, y, z in [0, 3] and
+// w fixed to 1, hence the presolved problem keeps x, y and z
+static libpapilo_problem_t*
+setupKnapsackProblem()
+{
+   libpapilo_problem_builder_t* builder = libpapilo_problem_builder_create();
+   libpapilo_problem_builder_set_num_cols( builder, 4 );
+   libpapilo_problem_builder_set_num_rows( builder, 2 );
+   double obj[] = { -3.0, -2.0, -4.0, 0.0 };
+   double lb[] = { 0.0, 0.0, 0.0, 1.0 };
+   double ub[] = { 3.0, 3.0, 3.0, 1.0 };
+   uint8_t integral[] = { 1, 1, 1, 0 };
+   double rhs[] = { 8.0, 5.0 };
+   uint8_t lhs_inf[] = { 1, 1 };
+   libpapilo_problem_builder_set_obj_all( builder, obj );
+   libpapilo_problem_builder_set_col_lb_all( builder, lb );
+   libpapilo_problem_builder_set_col_ub_all( builder, ub );
+   libpapilo_problem_builder_set_col_integral_all( builder, integral );
+   libpapilo_problem_builder_set_row_rhs_all( builder, rhs );
+   libpapilo_problem_builder_set_row_lhs_inf_all( builder, lhs_inf );
+   libpapilo_problem_builder_add_entry( builder, 0, 0, 2.0 );
+   libpapilo_problem_builder_add_entry( builder, 0, 1, 3.0 );
+   libpapilo_problem_builder_add_entry( builder, 0, 2, 4.0 );
+   libpapilo_problem_builder_add_entry( builder, 0, 3, 1.0 );
+   libpapilo_problem_builder_add_entry( builder, 1, 0, 3.0 );
+   libpapilo_problem_builder_add_entry( builder, 1, 1, 2.0 );
+   libpapilo_problem_builder_add_entry( builder, 1, 2, 1.0 );
+   libpapilo_problem_t* problem = libpapilo_problem_builder_build( builder );
+   libpapilo_problem_builder_free( builder );
+   return problem;
+}
 
 TEST_CASE( "finding-the-right-value-in-postsolve-for-a-column-fixed-neg-inf",
            "[libpapilo]" )
@@ -98,3 +132,424 @@ TEST_CASE( "finding-the-right-value-in-postsolve-for-a-column-fixed-pos-inf",
    libpapilo_message_free( message );
    libpapilo_num_free( num );
 }
+
+TEST_CASE( "postsolve-undo-can-be-repeated-on-the-same-storage",
+           "[libpapilo]" )
+{
+   libpapilo_num_t* num = libpapilo_num_create();
+   libpapilo_message_t* message = libpapilo_message_create();
+   const std::string gen_pos =
+       std::string( LIBPAPILO_BUILD_DIR ) + "/dual_fix_pos_inf.postsolve";
+   libpapilo_postsolve_storage_t* postsolveStorage =
+       libpapilo_postsolve_storage_load_from_file( gen_pos.c_str() );
+
+   libpapilo_solution_t* reduced_solution = libpapilo_solution_create();
+   libpapilo_solution_t* original_solution = libpapilo_solution_create();
+   libpapilo_postsolve_t* postsolve =
+       libpapilo_postsolve_create( message, num );
+
+   // the storage is only read, so repeated calls must give the same result
+   // and reuse the buffers of the output solution
+   for( int i = 0; i < 3; ++i )
+   {
+      libpapilo_postsolve_status_t status = libpapilo_postsolve_undo(
+          postsolve, reduced_solution, original_solution, postsolveStorage );
+      REQUIRE( status == LIBPAPILO_POSTSOLVE_STATUS_OK );
+
+      size_t size;
+      const double* values =
+          libpapilo_solution_get_primal( original_solution, &size );
+      REQUIRE( size == 4 );
+      REQUIRE( values[0] == 13.0 );
+      REQUIRE( values[1] == 9.0 );
+      REQUIRE( values[2] == -5.0 );
+      REQUIRE( values[3] == -2.5 );
+   }
+
+   libpapilo_postsolve_storage_free( postsolveStorage );
+   libpapilo_solution_free( reduced_solution );
+   libpapilo_solution_free( original_solution );
+   libpapilo_postsolve_free( postsolve );
+   libpapilo_message_free( message );
+   libpapilo_num_free( num );
+}
+
+TEST_CASE( "postsolve-undo-batch-postsolves-every-solution-of-the-block",
+           "[libpapilo]" )
+{
+   libpapilo_num_t* num = libpapilo_num_create();
+   libpapilo_message_t* message = libpapilo_message_create();
+   const std::string gen_pos =
+       std::string( LIBPAPILO_BUILD_DIR ) + "/dual_fix_pos_inf.postsolve";
+   libpapilo_postsolve_storage_t* postsolveStorage =
+       libpapilo_postsolve_storage_load_from_file( gen_pos.c_str() );
+   libpapilo_postsolve_t* postsolve =
+       libpapilo_postsolve_create( message, num );
+
+   // the reduced problem is empty, hence all solutions have the same values
+   const size_t num_solutions = 3;
+   std::vector<double> original( 4 * num_solutions, 42.0 );
+   std::vector<libpapilo_postsolve_status_t> statuses(
+       num_solutions, LIBPAPILO_POSTSOLVE_STATUS_ERROR );
+
+   libpapilo_postsolve_status_t status = libpapilo_postsolve_undo_batch(
+       postsolve, postsolveStorage, nullptr, num_solutions, original.data(),
+       statuses.data() );
+
+   REQUIRE( status == LIBPAPILO_POSTSOLVE_STATUS_OK );
+   for( size_t s = 0; s < num_solutions; ++s )
+   {
+      REQUIRE( statuses[s] == LIBPAPILO_POSTSOLVE_STATUS_OK );
+      REQUIRE( original[0 * num_solutions + s] == 13.0 );
+      REQUIRE( original[1 * num_solutions + s] == 9.0 );
+      REQUIRE( original[2 * num_solutions + s] == -5.0 );
+      REQUIRE( original[3 * num_solutions + s] == -2.5 );
+   }
+
+   libpapilo_postsolve_storage_free( postsolveStorage );
+   libpapilo_postsolve_free( postsolve );
+   libpapilo_message_free( message );
+   libpapilo_num_free( num );
+}
+
+TEST_CASE( "postsolve-undo-batch-matches-undo-of-single-solutions",
+           "[libpapilo]" )
+{
+   libpapilo_problem_t* problem = setupKnapsackProblem();
+
+   libpapilo_message_t* message = libpapilo_message_create();
+   libpapilo_message_set_verbosity_level( message, 0 );
+   libpapilo_presolve_t* presolve = libpapilo_presolve_create( message );
+   libpapilo_presolve_add_default_presolvers( presolve );
+   libpapilo_postsolve_storage_t* storage = nullptr;
+   libpapilo_statistics_t* statistics = nullptr;
+   libpapilo_presolve_apply_full( presolve, problem, &storage, &statistics );
+   REQUIRE( storage != nullptr );
+
+   size_t ncols_reduced;
+   libpapilo_postsolve_storage_get_orig_col_mapping( storage, &ncols_reduced );
+   size_t ncols = libpapilo_postsolve_storage_get_n_cols_original( storage );
+   REQUIRE( ncols == 4 );
+   REQUIRE( ncols_reduced > 0 );
+
+   // reduced solutions stored column-major, not all of them are feasible
+   const size_t num_solutions = 5;
+   std::vector<double> reduced( ncols_reduced * num_solutions );
+   for( size_t j = 0; j < ncols_reduced; ++j )
+      for( size_t s = 0; s < num_solutions; ++s )
+         reduced[j * num_solutions + s] = 0.5 * (double)( s + j );
+
+   libpapilo_num_t* num = libpapilo_num_create();
+   libpapilo_postsolve_t* postsolve =
+       libpapilo_postsolve_create( message, num );
+   std::vector<double> original( ncols * num_solutions );
+   std::vector<libpapilo_postsolve_status_t> statuses( num_solutions );
+   libpapilo_postsolve_undo_batch( postsolve, storage, reduced.data(),
+                                   num_solutions, original.data(),
+                                   statuses.data() );
+
+   libpapilo_solution_t* reduced_solution = libpapilo_solution_create();
+   libpapilo_solution_t* original_solution = libpapilo_solution_create();
+   std::vector<double> single( ncols_reduced );
+   for( size_t s = 0; s < num_solutions; ++s )
+   {
+      for( size_t j = 0; j < ncols_reduced; ++j )
+         single[j] = reduced[j * num_solutions + s];
+      libpapilo_solution_set_primal( reduced_solution, single.data(),
+                                     ncols_reduced );
+      libpapilo_postsolve_status_t status = libpapilo_postsolve_undo(
+          postsolve, reduced_solution, original_solution, storage );
+      REQUIRE( statuses[s] == status );
+
+      size_t size;
+      const double* values =
+          libpapilo_solution_get_primal( original_solution, &size );
+      REQUIRE( size == ncols );
+      for( size_t j = 0; j < ncols; ++j )
+         REQUIRE( original[j * num_solutions + s] == values[j] );
+   }
+
+   libpapilo_solution_free( reduced_solution );
+   libpapilo_solution_free( original_solution );
+   libpapilo_postsolve_free( postsolve );
+   libpapilo_num_free( num );
+   libpapilo_postsolve_storage_free( storage );
+   libpapilo_statistics_free( statistics );
+   libpapilo_presolve_free( presolve );
+   libpapilo_message_free( message );
+   libpapilo_problem_free( problem );
+}
+
+TEST_CASE( "postsolve-program-finds-the-values-of-columns-fixed-to-infinity",
+           "[libpapilo]" )
+{
+   libpapilo_num_t* num = libpapilo_num_create();
+   libpapilo_message_t* message = libpapilo_message_create();
+   libpapilo_postsolve_t* postsolve =
+       libpapilo_postsolve_create( message, num );
+   libpapilo_solution_t* reduced_solution = libpapilo_solution_create();
+   libpapilo_solution_t* original_solution = libpapilo_solution_create();
+
+   const std::string files[] = { "/dual_fix_neg_inf.postsolve",
+                                 "/dual_fix_pos_inf.postsolve" };
+   const std::vector<double> expected[] = { { -11.0, -5.0, -5.0 },
+                                            { 13.0, 9.0, -5.0, -2.5 } };
+   for( int i = 0; i < 2; ++i )
+   {
+      const std::string file = std::string( LIBPAPILO_BUILD_DIR ) + files[i];
+      libpapilo_postsolve_storage_t* storage =
+          libpapilo_postsolve_storage_load_from_file( file.c_str() );
+      libpapilo_postsolve_program_t* program =
+          libpapilo_postsolve_program_create( storage );
+      REQUIRE( libpapilo_postsolve_program_get_num_instructions( program ) >
+               0 );
+
+      libpapilo_postsolve_status_t status = libpapilo_postsolve_undo_program(
+          postsolve, program, reduced_solution, original_solution, storage );
+      REQUIRE( status == LIBPAPILO_POSTSOLVE_STATUS_OK );
+
+      size_t size;
+      const double* values =
+          libpapilo_solution_get_primal( original_solution, &size );
+      REQUIRE( size == expected[i].size() );
+      for( size_t j = 0; j < size; ++j )
+         REQUIRE( values[j] == expected[i][j] );
+
+      libpapilo_postsolve_program_free( program );
+      libpapilo_postsolve_storage_free( storage );
+   }
+
+   libpapilo_solution_free( reduced_solution );
+   libpapilo_solution_free( original_solution );
+   libpapilo_postsolve_free( postsolve );
+   libpapilo_message_free( message );
+   libpapilo_num_free( num );
+}
+
+TEST_CASE( "postsolve-program-matches-undo-with-the-reduction-log",
+           "[libpapilo]" )
+{
+   libpapilo_problem_t* problem = setupKnapsackProblem();
+
+   libpapilo_message_t* message = libpapilo_message_create();
+   libpapilo_message_set_verbosity_level( message, 0 );
+   libpapilo_presolve_t* presolve = libpapilo_presolve_create( message );
+   libpapilo_presolve_add_default_presolvers( presolve );
+   libpapilo_postsolve_storage_t* storage = nullptr;
+   libpapilo_statistics_t* statistics = nullptr;
+   libpapilo_presolve_apply_full( presolve, problem, &storage, &statistics );
+   REQUIRE( storage != nullptr );
+
+   size_t ncols_reduced;
+   libpapilo_postsolve_storage_get_orig_col_mapping( storage, &ncols_reduced );
+   REQUIRE( ncols_reduced > 0 );
+
+   libpapilo_num_t* num = libpapilo_num_create();
+   libpapilo_postsolve_t* postsolve =
+       libpapilo_postsolve_create( message, num );
+   libpapilo_postsolve_program_t* program =
+       libpapilo_postsolve_program_create( storage );
+   libpapilo_solution_t* reduced_solution = libpapilo_solution_create();
+   libpapilo_solution_t* from_log = libpapilo_solution_create();
+   libpapilo_solution_t* from_program = libpapilo_solution_create();
+
+   std::vector<double> reduced( ncols_reduced );
+   for( int s = 0; s < 4; ++s )
+   {
+      for( size_t j = 0; j < ncols_reduced; ++j )
+         reduced[j] = 0.5 * (double)( s + j );
+      libpapilo_solution_set_primal( reduced_solution, reduced.data(),
+                                     ncols_reduced );
+
+      libpapilo_postsolve_status_t log_status = libpapilo_postsolve_undo(
+          postsolve, reduced_solution, from_log, storage );
+      libpapilo_postsolve_status_t program_status =
+          libpapilo_postsolve_undo_program( postsolve, program,
+                                            reduced_solution, from_program,
+                                            storage );
+      REQUIRE( log_status == program_status );
+
+      size_t log_size;
+      size_t program_size;
+      const double* log_values =
+          libpapilo_solution_get_primal( from_log, &log_size );
+      const double* program_values =
+          libpapilo_solution_get_primal( from_program, &program_size );
+      REQUIRE( log_size == program_size );
+      for( size_t j = 0; j < log_size; ++j )
+         REQUIRE( log_values[j] == program_values[j] );
+   }
+
+   libpapilo_solution_free( reduced_solution );
+   libpapilo_solution_free( from_log );
+   libpapilo_solution_free( from_program );
+   libpapilo_postsolve_program_free( program );
+   libpapilo_postsolve_free( postsolve );
+   libpapilo_num_free( num );
+   libpapilo_postsolve_storage_free( storage );
+   libpapilo_statistics_free( statistics );
+   libpapilo_presolve_free( presolve );
+   libpapilo_message_free( message );
+   libpapilo_problem_free( problem );
+}
+
+TEST_CASE( "postsolve-undo-mapped-finds-the-values-of-columns-fixed-to-infinity",
+           "[libpapilo]" )
+{
+   libpapilo_num_t* num = libpapilo_num_create();
+   libpapilo_message_t* message = libpapilo_message_create();
+   libpapilo_postsolve_t* postsolve =
+       libpapilo_postsolve_create( message, num );
+   libpapilo_solution_t* reduced_solution = libpapilo_solution_create();
+   libpapilo_solution_t* original_solution = libpapilo_solution_create();
+
+   const std::string files[] = { "/dual_fix_neg_inf.postsolve",
+                                 "/dual_fix_pos_inf.postsolve" };
+   const std::vector<double> expected[] = { { -11.0, -5.0, -5.0 },
+                                            { 13.0, 9.0, -5.0, -2.5 } };
+   for( int i = 0; i < 2; ++i )
+   {
+      const std::string file = std::string( LIBPAPILO_BUILD_DIR ) + files[i];
+      const std::string mapped_file = file + ".mapped";
+      libpapilo_postsolve_storage_t* storage =
+          libpapilo_postsolve_storage_load_from_file( file.c_str() );
+      libpapilo_postsolve_storage_write_mapped( storage, mapped_file.c_str() );
+
+      // the boost archive is not a mapped storage
+      REQUIRE( libpapilo_mapped_postsolve_storage_open( file.c_str() ) ==
+               nullptr );
+
+      libpapilo_mapped_postsolve_storage_t* mapped =
+          libpapilo_mapped_postsolve_storage_open( mapped_file.c_str() );
+      REQUIRE( mapped != nullptr );
+      REQUIRE( libpapilo_mapped_postsolve_storage_get_n_cols_original(
+                   mapped ) == expected[i].size() );
+      REQUIRE( libpapilo_mapped_postsolve_storage_get_n_cols_reduced(
+                   mapped ) == 0 );
+
+      libpapilo_postsolve_status_t status = libpapilo_postsolve_undo_mapped(
+          postsolve, mapped, reduced_solution, original_solution );
+      REQUIRE( status == LIBPAPILO_POSTSOLVE_STATUS_OK );
+
+      size_t size;
+      const double* values =
+          libpapilo_solution_get_primal( original_solution, &size );
+      REQUIRE( size == expected[i].size() );
+      for( size_t j = 0; j < size; ++j )
+         REQUIRE( values[j] == expected[i][j] );
+
+      // the loaded copy holds the same reduction log as the archive
+      libpapilo_postsolve_storage_t* loaded =
+          libpapilo_mapped_postsolve_storage_load( mapped );
+      size_t ntypes;
+      size_t nloaded_types;
+      const libpapilo_postsolve_reduction_type_t* types =
+          libpapilo_postsolve_storage_get_types( storage, &ntypes );
+      const libpapilo_postsolve_reduction_type_t* loaded_types =
+          libpapilo_postsolve_storage_get_types( loaded, &nloaded_types );
+      REQUIRE( ntypes == nloaded_types );
+      for( size_t j = 0; j < ntypes; ++j )
+         REQUIRE( types[j] == loaded_types[j] );
+
+      size_t nvalues;
+      size_t nloaded_values;
+      const double* log_values =
+          libpapilo_postsolve_storage_get_values( storage, &nvalues );
+      const double* loaded_values =
+          libpapilo_postsolve_storage_get_values( loaded, &nloaded_values );
+      REQUIRE( nvalues == nloaded_values );
+      for( size_t j = 0; j < nvalues; ++j )
+         REQUIRE( log_values[j] == loaded_values[j] );
+
+      status = libpapilo_postsolve_undo( postsolve, reduced_solution,
+                                         original_solution, loaded );
+      REQUIRE( status == LIBPAPILO_POSTSOLVE_STATUS_OK );
+
+      libpapilo_postsolve_storage_free( loaded );
+      libpapilo_mapped_postsolve_storage_free( mapped );
+      libpapilo_postsolve_storage_free( storage );
+   }
+
+   REQUIRE( libpapilo_mapped_postsolve_storage_open(
+                ( std::string( LIBPAPILO_BUILD_DIR ) + "/missing.mapped" )
+                    .c_str() ) == nullptr );
+
+   libpapilo_solution_free( reduced_solution );
+   libpapilo_solution_free( original_solution );
+   libpapilo_postsolve_free( postsolve );
+   libpapilo_message_free( message );
+   libpapilo_num_free( num );
+}
+
+TEST_CASE( "postsolve-undo-mapped-matches-undo-with-the-reduction-log",
+           "[libpapilo]" )
+{
+   libpapilo_problem_t* problem = setupKnapsackProblem();
+
+   libpapilo_message_t* message = libpapilo_message_create();
+   libpapilo_message_set_verbosity_level( message, 0 );
+   libpapilo_presolve_t* presolve = libpapilo_presolve_create( message );
+   libpapilo_presolve_add_default_presolvers( presolve );
+   libpapilo_postsolve_storage_t* storage = nullptr;
+   libpapilo_statistics_t* statistics = nullptr;
+   libpapilo_presolve_apply_full( presolve, problem, &storage, &statistics );
+   REQUIRE( storage != nullptr );
+
+   size_t ncols_reduced;
+   libpapilo_postsolve_storage_get_orig_col_mapping( storage, &ncols_reduced );
+   REQUIRE( ncols_reduced > 0 );
+
+   const std::string mapped_file =
+       std::string( LIBPAPILO_BUILD_DIR ) + "/knapsack.postsolve.mapped";
+   libpapilo_postsolve_storage_write_mapped( storage, mapped_file.c_str() );
+   libpapilo_mapped_postsolve_storage_t* mapped =
+       libpapilo_mapped_postsolve_storage_open( mapped_file.c_str() );
+   REQUIRE( mapped != nullptr );
+   REQUIRE( libpapilo_mapped_postsolve_storage_get_n_cols_reduced( mapped ) ==
+            ncols_reduced );
+
+   libpapilo_num_t* num = libpapilo_num_create();
+   libpapilo_postsolve_t* postsolve =
+       libpapilo_postsolve_create( message, num );
+   libpapilo_solution_t* reduced_solution = libpapilo_solution_create();
+   libpapilo_solution_t* from_log = libpapilo_solution_create();
+   libpapilo_solution_t* from_mapping = libpapilo_solution_create();
+
+   std::vector<double> reduced( ncols_reduced );
+   for( int s = 0; s < 4; ++s )
+   {
+      for( size_t j = 0; j < ncols_reduced; ++j )
+         reduced[j] = 0.5 * (double)( s + j );
+      libpapilo_solution_set_primal( reduced_solution, reduced.data(),
+                                     ncols_reduced );
+
+      libpapilo_postsolve_status_t log_status = libpapilo_postsolve_undo(
+          postsolve, reduced_solution, from_log, storage );
+      libpapilo_postsolve_status_t mapped_status =
+          libpapilo_postsolve_undo_mapped( postsolve, mapped, reduced_solution,
+                                           from_mapping );
+      REQUIRE( log_status == mapped_status );
+
+      size_t log_size;
+      size_t mapped_size;
+      const double* log_values =
+          libpapilo_solution_get_primal( from_log, &log_size );
+      const double* mapped_values =
+          libpapilo_solution_get_primal( from_mapping, &mapped_size );
+      REQUIRE( log_size == mapped_size );
+      for( size_t j = 0; j < log_size; ++j )
+         REQUIRE( log_values[j] == mapped_values[j] );
+   }
+
+   libpapilo_solution_free( reduced_solution );
+   libpapilo_solution_free( from_log );
+   libpapilo_solution_free( from_mapping );
+   libpapilo_postsolve_free( postsolve );
+   libpapilo_num_free( num );
+   libpapilo_mapped_postsolve_storage_free( mapped );
+   libpapilo_postsolve_storage_free( storage );
+   libpapilo_statistics_free( statistics );
+   libpapilo_presolve_free( presolve );
+   libpapilo_message_free( message );
+   libpapilo_problem_free( problem );
+}
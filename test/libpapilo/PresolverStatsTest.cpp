@@ -20,7 +20,11 @@
 
 #include "libpapilo.h"
 #include "papilo/external/catch/catch_amalgamated.hpp"
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
 
 // Helper function to create a simple test problem
 static libpapilo_problem_t*
@@ -235,3 +239,145 @@ TEST_CASE( "per-presolver-statistics-match-overall-statistics",
    libpapilo_postsolve_storage_free( postsolve );
    libpapilo_statistics_free( statistics );
 }
+
+TEST_CASE( "task-graph-scheduling-reports-round-utilization",
+           "[presolve][statistics]" )
+{
+   auto* message = libpapilo_message_create();
+   libpapilo_message_set_verbosity_level( message, 0 );
+
+   libpapilo_presolve_status_t statuses[2];
+   size_t ncols[2];
+   for( int taskgraph = 0; taskgraph < 2; ++taskgraph )
+   {
+      auto* problem = create_test_problem();
+      auto* presolve = libpapilo_presolve_create( message );
+      libpapilo_presolve_add_default_presolvers( presolve );
+      REQUIRE( libpapilo_presolve_set_param_int( presolve, "presolve.threads",
+                                                 2 ) == LIBPAPILO_PARAM_OK );
+      REQUIRE( libpapilo_presolve_set_param_bool(
+                   presolve, "presolve.taskgraph", taskgraph ) ==
+               LIBPAPILO_PARAM_OK );
+
+      libpapilo_postsolve_storage_t* postsolve = nullptr;
+      libpapilo_statistics_t* statistics = nullptr;
+      statuses[taskgraph] = libpapilo_presolve_apply_full(
+          presolve, problem, &postsolve, &statistics );
+      ncols[taskgraph] = libpapilo_problem_get_ncols( problem );
+
+      size_t nutilizations =
+          libpapilo_statistics_get_num_round_utilizations( statistics );
+      REQUIRE( nutilizations > 0 );
+      for( size_t round = 0; round < nutilizations; ++round )
+      {
+         double utilization =
+             libpapilo_statistics_get_round_utilization( statistics, round );
+         REQUIRE( utilization >= 0.0 );
+         REQUIRE( utilization <= 1.0 );
+      }
+
+      libpapilo_problem_free( problem );
+      libpapilo_presolve_free( presolve );
+      libpapilo_postsolve_storage_free( postsolve );
+      libpapilo_statistics_free( statistics );
+   }
+
+   // both schedules reach the same reduced problem on this instance
+   REQUIRE( statuses[0] == statuses[1] );
+   REQUIRE( ncols[0] == ncols[1] );
+
+   libpapilo_message_free( message );
+}
+
+TEST_CASE( "presolve-writes-chrome-trace-to-trace-file",
+           "[presolve][statistics]" )
+{
+   const char* filename = "libpapilo_trace_test.json";
+   std::remove( filename );
+
+   auto* message = libpapilo_message_create();
+   libpapilo_message_set_verbosity_level( message, 0 );
+   auto* problem = create_test_problem();
+   auto* presolve = libpapilo_presolve_create( message );
+   libpapilo_presolve_add_default_presolvers( presolve );
+
+   auto* options = libpapilo_presolve_options_create();
+   REQUIRE( std::strcmp( libpapilo_presolve_options_get_trace_file( options ),
+                         "" ) == 0 );
+   libpapilo_presolve_options_set_threads( options, 2 );
+   libpapilo_presolve_options_set_trace_file( options, filename );
+   REQUIRE( std::strcmp( libpapilo_presolve_options_get_trace_file( options ),
+                         filename ) == 0 );
+   libpapilo_presolve_set_options( presolve, options );
+
+   libpapilo_postsolve_storage_t* postsolve = nullptr;
+   libpapilo_statistics_t* statistics = nullptr;
+   libpapilo_presolve_apply_full( presolve, problem, &postsolve, &statistics );
+
+   std::ifstream file( filename );
+   REQUIRE( file.good() );
+   std::string json( ( std::istreambuf_iterator<char>( file ) ),
+                     std::istreambuf_iterator<char>() );
+   file.close();
+   REQUIRE( json.find( "\"traceEvents\":[" ) != std::string::npos );
+   REQUIRE( json.find( "\"cat\":\"presolver\"" ) != std::string::npos );
+   REQUIRE( json.find( "\"cat\":\"update\"" ) != std::string::npos );
+   REQUIRE( json.find( "\"name\":\"transactions\"" ) != std::string::npos );
+   std::remove( filename );
+
+   libpapilo_presolve_options_set_trace_file( options, nullptr );
+   REQUIRE( std::strcmp( libpapilo_presolve_options_get_trace_file( options ),
+                         "" ) == 0 );
+
+   libpapilo_presolve_options_free( options );
+   libpapilo_problem_free( problem );
+   libpapilo_presolve_free( presolve );
+   libpapilo_postsolve_storage_free( postsolve );
+   libpapilo_statistics_free( statistics );
+   libpapilo_message_free( message );
+}
+
+TEST_CASE( "component-tracking-reports-round-components",
+           "[presolve][statistics]" )
+{
+   auto* message = libpapilo_message_create();
+   libpapilo_message_set_verbosity_level( message, 0 );
+   auto* problem = create_test_problem();
+
+   // column 0 links both rows, so the problem is a single component
+   int col_component[3];
+   int row_component[2];
+   REQUIRE( libpapilo_problem_get_components( problem, col_component,
+                                              row_component ) == 1 );
+   for( int i = 0; i < 3; ++i )
+      REQUIRE( col_component[i] == 0 );
+   for( int i = 0; i < 2; ++i )
+      REQUIRE( row_component[i] == 0 );
+
+   auto* presolve = libpapilo_presolve_create( message );
+   libpapilo_presolve_add_default_presolvers( presolve );
+   REQUIRE( libpapilo_presolve_set_param_bool(
+                presolve, "presolve.trackcomponents", 1 ) ==
+            LIBPAPILO_PARAM_OK );
+
+   libpapilo_postsolve_storage_t* postsolve = nullptr;
+   libpapilo_statistics_t* statistics = nullptr;
+   libpapilo_presolve_apply_full( presolve, problem, &postsolve, &statistics );
+
+   size_t nrounds =
+       libpapilo_statistics_get_num_round_components( statistics );
+   REQUIRE( nrounds > 0 );
+   for( size_t round = 0; round < nrounds; ++round )
+   {
+      int ncomponents =
+          libpapilo_statistics_get_round_components( statistics, round );
+      REQUIRE( ncomponents >= 0 );
+      REQUIRE( ncomponents <= 3 );
+   }
+
+   libpapilo_problem_free( problem );
+   libpapilo_presolve_free( presolve );
+   libpapilo_postsolve_storage_free( postsolve );
+   libpapilo_statistics_free( statistics );
+   libpapilo_message_free( message );
+}
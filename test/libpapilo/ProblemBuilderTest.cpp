@@ -22,6 +22,8 @@
 #include "catch_amalgamated.hpp"
 #include "libpapilo.h"
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <vector>
 
 TEST_CASE( "problem-builder", "[libpapilo]" )
@@ -388,4 +390,219 @@ TEST_CASE( "problem-builder", "[libpapilo]" )
       libpapilo_problem_free( problem );
       libpapilo_problem_builder_free( builder );
    }
+
+   SECTION( "compressed matrix input" )
+   {
+      // Test Purpose: Verify that problems created from compressed sparse row
+      // and column arrays contain the same matrix. The CSR input is sorted,
+      // the CSC input has unsorted rows, a duplicate and an explicit zero to
+      // exercise the sorting path.
+      // Matrix:  row 0: x + 2*y
+      //          row 1:     3*y + 4*z
+      double obj[] = { 1.0, 1.0, 1.0 };
+      double lbs[] = { 0.0, -INFINITY, 0.0 };
+      double ubs[] = { 1.0, 10.0, INFINITY };
+      double lhs[] = { 1.0, -INFINITY };
+      double rhs[] = { INFINITY, 5.0 };
+      uint8_t integral[] = { 1, 0, 0 };
+
+      int row_start[] = { 0, 2, 4 };
+      int cols[] = { 0, 1, 1, 2 };
+      double csr_vals[] = { 1.0, 2.0, 3.0, 4.0 };
+      libpapilo_problem_t* csr = libpapilo_problem_create_from_csr(
+          2, 3, row_start, cols, csr_vals, obj, lbs, ubs, lhs, rhs, integral );
+      REQUIRE( csr != nullptr );
+
+      int col_start[] = { 0, 2, 5, 6 };
+      int rows[] = { 1, 0, 1, 0, 1, 1 };
+      double csc_vals[] = { 0.0, 1.0, 1.0, 2.0, 2.0, 4.0 };
+      libpapilo_problem_t* csc = libpapilo_problem_create_from_csc(
+          2, 3, col_start, rows, csc_vals, obj, lbs, ubs, lhs, rhs, nullptr );
+      REQUIRE( csc != nullptr );
+
+      for( libpapilo_problem_t* problem : { csr, csc } )
+      {
+         REQUIRE( libpapilo_problem_get_nrows( problem ) == 2 );
+         REQUIRE( libpapilo_problem_get_ncols( problem ) == 3 );
+         REQUIRE( libpapilo_problem_get_nnz( problem ) == 4 );
+
+         const int* entry_cols;
+         const double* entry_vals;
+         REQUIRE( libpapilo_problem_get_row_entries( problem, 1, &entry_cols,
+                                                     &entry_vals ) == 2 );
+         REQUIRE( entry_cols[0] == 1 );
+         REQUIRE( entry_cols[1] == 2 );
+         REQUIRE( entry_vals[0] == 3.0 );
+         REQUIRE( entry_vals[1] == 4.0 );
+
+         const int* entry_rows;
+         REQUIRE( libpapilo_problem_get_col_entries( problem, 1, &entry_rows,
+                                                     &entry_vals ) == 2 );
+         REQUIRE( entry_rows[0] == 0 );
+         REQUIRE( entry_rows[1] == 1 );
+         REQUIRE( entry_vals[0] == 2.0 );
+         REQUIRE( entry_vals[1] == 3.0 );
+
+         uint8_t flags = libpapilo_problem_get_col_flags( problem, 1 );
+         REQUIRE( ( flags & LIBPAPILO_COLFLAG_LB_INF ) != 0 );
+         REQUIRE( libpapilo_problem_get_row_rhs( problem, nullptr )[1] == 5.0 );
+      }
+      REQUIRE( libpapilo_problem_get_num_integral_cols( csr ) == 1 );
+      REQUIRE( libpapilo_problem_get_num_integral_cols( csc ) == 0 );
+
+      libpapilo_problem_free( csr );
+      libpapilo_problem_free( csc );
+   }
+
+   SECTION( "compressed matrix with builder entries" )
+   {
+      // Test Purpose: Verify that a matrix set in CSR format is merged with
+      // entries that are added one by one.
+      libpapilo_problem_builder_t* builder = libpapilo_problem_builder_create();
+      libpapilo_problem_builder_set_num_cols( builder, 2 );
+      libpapilo_problem_builder_set_num_rows( builder, 2 );
+
+      int row_start[] = { 0, 1, 1 };
+      int cols[] = { 0 };
+      double vals[] = { 1.0 };
+      libpapilo_problem_builder_set_matrix_csr( builder, row_start, cols, vals );
+      libpapilo_problem_builder_add_entry( builder, 1, 1, 2.0 );
+
+      libpapilo_problem_t* problem = libpapilo_problem_builder_build( builder );
+      REQUIRE( libpapilo_problem_get_nnz( problem ) == 2 );
+
+      libpapilo_problem_free( problem );
+      libpapilo_problem_builder_free( builder );
+   }
+
+   SECTION( "binary snapshot" )
+   {
+      // Test Purpose: Verify that a problem read back from a binary snapshot
+      // equals the written problem and that invalid files are rejected.
+      // Matrix:  c0: x + 2*y >= 1
+      //          c1:     3*y + 4*z <= 5
+      libpapilo_problem_builder_t* builder = libpapilo_problem_builder_create();
+      libpapilo_problem_builder_set_num_cols( builder, 3 );
+      libpapilo_problem_builder_set_num_rows( builder, 2 );
+      double obj[] = { 1.0, -2.0, 0.5 };
+      libpapilo_problem_builder_set_obj_all( builder, obj );
+      libpapilo_problem_builder_set_obj_offset( builder, 3.0 );
+      libpapilo_problem_builder_set_col_ub( builder, 0, 1.0 );
+      libpapilo_problem_builder_set_col_integral( builder, 0, 1 );
+      libpapilo_problem_builder_set_col_ub( builder, 1, 10.0 );
+      libpapilo_problem_builder_set_row_lhs( builder, 0, 1.0 );
+      libpapilo_problem_builder_set_row_rhs( builder, 1, 5.0 );
+      libpapilo_problem_builder_add_entry( builder, 0, 0, 1.0 );
+      libpapilo_problem_builder_add_entry( builder, 0, 1, 2.0 );
+      libpapilo_problem_builder_add_entry( builder, 1, 1, 3.0 );
+      libpapilo_problem_builder_add_entry( builder, 1, 2, 4.0 );
+      libpapilo_problem_builder_set_problem_name( builder, "snapshot" );
+      libpapilo_problem_builder_set_col_name( builder, 1, "y" );
+      libpapilo_problem_builder_set_row_name( builder, 1, "c1" );
+      libpapilo_problem_t* problem = libpapilo_problem_builder_build( builder );
+
+      const char* filename = "libpapilo_problem_snapshot.papilo";
+      libpapilo_problem_write_snapshot( problem, filename );
+      libpapilo_problem_t* loaded = libpapilo_problem_read_snapshot( filename );
+      REQUIRE( loaded != nullptr );
+
+      REQUIRE( libpapilo_problem_get_nrows( loaded ) == 2 );
+      REQUIRE( libpapilo_problem_get_ncols( loaded ) == 3 );
+      REQUIRE( libpapilo_problem_get_nnz( loaded ) == 4 );
+      REQUIRE( libpapilo_problem_get_objective_offset( loaded ) == 3.0 );
+      REQUIRE( libpapilo_problem_get_num_integral_cols( loaded ) == 1 );
+      REQUIRE( std::strcmp( libpapilo_problem_get_name( loaded ),
+                            "snapshot" ) == 0 );
+      REQUIRE( std::strcmp( libpapilo_problem_get_variable_name( loaded, 1 ),
+                            "y" ) == 0 );
+      REQUIRE( std::strcmp( libpapilo_problem_get_constraint_name( loaded, 1 ),
+                            "c1" ) == 0 );
+      for( int col = 0; col < 3; ++col )
+      {
+         REQUIRE( libpapilo_problem_get_col_flags( loaded, col ) ==
+                  libpapilo_problem_get_col_flags( problem, col ) );
+         REQUIRE( libpapilo_problem_get_objective_coefficients(
+                      loaded, nullptr )[col] == obj[col] );
+         REQUIRE( libpapilo_problem_get_upper_bounds( loaded, nullptr )[col] ==
+                  libpapilo_problem_get_upper_bounds( problem, nullptr )[col] );
+
+         const int* rows;
+         const double* vals;
+         const int* expected_rows;
+         const double* expected_vals;
+         int length =
+             libpapilo_problem_get_col_entries( loaded, col, &rows, &vals );
+         REQUIRE( length == libpapilo_problem_get_col_entries(
+                                problem, col, &expected_rows,
+                                &expected_vals ) );
+         for( int k = 0; k < length; ++k )
+         {
+            REQUIRE( rows[k] == expected_rows[k] );
+            REQUIRE( vals[k] == expected_vals[k] );
+         }
+      }
+      for( int row = 0; row < 2; ++row )
+      {
+         REQUIRE( libpapilo_problem_get_row_flags( loaded, row ) ==
+                  libpapilo_problem_get_row_flags( problem, row ) );
+         REQUIRE( libpapilo_problem_get_row_entries( loaded, row, nullptr,
+                                                     nullptr ) == 2 );
+      }
+      REQUIRE( libpapilo_problem_get_row_lhs( loaded, nullptr )[0] == 1.0 );
+      REQUIRE( libpapilo_problem_get_row_rhs( loaded, nullptr )[1] == 5.0 );
+
+      // a file with a damaged header and a missing file are rejected
+      FILE* file = std::fopen( filename, "r+b" );
+      std::fputs( "MPS", file );
+      std::fclose( file );
+      REQUIRE( libpapilo_problem_read_snapshot( filename ) == nullptr );
+      REQUIRE( libpapilo_problem_read_snapshot( "missing.papilo" ) ==
+               nullptr );
+      std::remove( filename );
+
+      libpapilo_problem_free( loaded );
+      libpapilo_problem_free( problem );
+      libpapilo_problem_builder_free( builder );
+   }
+
+   SECTION( "implications" )
+   {
+      // Test Purpose: Verify that implications added to a problem are merged
+      // and can be queried per fixing of a binary column.
+      libpapilo_problem_builder_t* builder = libpapilo_problem_builder_create();
+      libpapilo_problem_builder_set_num_cols( builder, 3 );
+      libpapilo_problem_builder_set_num_rows( builder, 0 );
+      libpapilo_problem_builder_set_col_lb( builder, 0, 0.0 );
+      libpapilo_problem_builder_set_col_ub( builder, 0, 1.0 );
+      libpapilo_problem_builder_set_col_integral( builder, 0, 1 );
+      libpapilo_problem_builder_set_col_lb( builder, 2, 0.0 );
+      libpapilo_problem_builder_set_col_ub( builder, 2, 10.0 );
+
+      libpapilo_problem_t* problem = libpapilo_problem_builder_build( builder );
+      REQUIRE( libpapilo_problem_get_num_implications( problem ) == 0 );
+
+      libpapilo_problem_add_implication( problem, 0, 1, 2, 1, 4.0 );
+      libpapilo_problem_add_implication( problem, 0, 1, 2, 1, 3.0 );
+      libpapilo_problem_add_implication( problem, 0, 0, 1, 0, -1.0 );
+      REQUIRE( libpapilo_problem_get_num_implications( problem ) == 2 );
+
+      const int* cols;
+      const uint8_t* upper;
+      const double* bounds;
+      REQUIRE( libpapilo_problem_get_implications( problem, 0, 1, &cols, &upper,
+                                                   &bounds ) == 1 );
+      REQUIRE( cols[0] == 2 );
+      REQUIRE( upper[0] == 1 );
+      REQUIRE( bounds[0] == 3.0 );
+
+      REQUIRE( libpapilo_problem_get_implications( problem, 0, 0, &cols, &upper,
+                                                   &bounds ) == 1 );
+      REQUIRE( cols[0] == 1 );
+      REQUIRE( upper[0] == 0 );
+      REQUIRE( libpapilo_problem_get_implications( problem, 3, 0, &cols, &upper,
+                                                   &bounds ) == -1 );
+
+      libpapilo_problem_free( problem );
+      libpapilo_problem_builder_free( builder );
+   }
 }
@@ -0,0 +1,136 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#include "papilo/core/Components.hpp"
+#include "papilo/core/ProblemBuilder.hpp"
+#include "papilo/external/catch/catch_amalgamated.hpp"
+#include "papilo/misc/ConcurrentUnionFind.hpp"
+#ifdef PAPILO_TBB
+#include "papilo/misc/tbb.hpp"
+#endif
+
+using namespace papilo;
+
+Problem<double>
+setupProblemWithTwoComponents();
+
+TEST_CASE( "concurrent-union-find-roots-are-smallest-elements", "[core]" )
+{
+   // chains 0-2-4-...-998 and 1-3-5-...-999 united in reverse order
+   const int n = 1000;
+   ConcurrentUnionFind unionfind( n );
+
+#ifdef PAPILO_TBB
+   tbb::parallel_for( tbb::blocked_range<int>( 2, n ),
+                      [&]( const tbb::blocked_range<int>& r ) {
+                         for( int i = r.end() - 1; i >= r.begin(); --i )
+                            unionfind.unite( i, i - 2 );
+                      } );
+#else
+   for( int i = n - 1; i >= 2; --i )
+      unionfind.unite( i, i - 2 );
+#endif
+
+   for( int i = 0; i != n; ++i )
+      REQUIRE( unionfind.find( i ) == i % 2 );
+   REQUIRE( unionfind.inSameSet( 998, 0 ) );
+   REQUIRE( !unionfind.inSameSet( 998, 999 ) );
+}
+
+TEST_CASE( "components-are-numbered-by-their-first-column", "[core]" )
+{
+   Problem<double> problem = setupProblemWithTwoComponents();
+   Components components;
+
+   REQUIRE( components.detectComponents( problem ) == 2 );
+   REQUIRE( components.getComponentsNumCols( 0 ) == 3 );
+   REQUIRE( components.getComponentsNumCols( 1 ) == 1 );
+   REQUIRE( components.getComponentsNumRows( 0 ) == 2 );
+   REQUIRE( components.getComponentsNumRows( 1 ) == 1 );
+   REQUIRE( components.getComponentsCols( 1 )[0] == 3 );
+}
+
+TEST_CASE( "component-tracker-follows-removed-rows-and-cols", "[core]" )
+{
+   Problem<double> problem = setupProblemWithTwoComponents();
+   ComponentTracker tracker;
+   REQUIRE( tracker.needsRebuild() );
+
+   tracker.rebuild( problem );
+   REQUIRE( !tracker.needsRebuild() );
+   REQUIRE( tracker.getNumComponents() == 2 );
+   REQUIRE( tracker.getColComponent( 2 ) == 0 );
+   REQUIRE( tracker.getColComponent( 3 ) == 1 );
+   REQUIRE( tracker.getRowComponent( 1 ) == 0 );
+   REQUIRE( tracker.getRowComponent( 2 ) == 1 );
+   REQUIRE( tracker.getComponentInfo()[0].nnonz == 4 );
+   REQUIRE( tracker.getLargestComponent() == 0 );
+
+   // removing the row c1 + c2 and afterwards column c2 leaves c0 + c1
+   tracker.removeRowsAndCols( problem, Vec<int>{ 1 }, Vec<int>{} );
+   REQUIRE( tracker.getRowComponent( 1 ) == -1 );
+   REQUIRE( tracker.getComponentNumRows( 0 ) == 1 );
+   REQUIRE( tracker.getComponentInfo()[0].nnonz == 2 );
+
+   tracker.removeRowsAndCols( problem, Vec<int>{}, Vec<int>{ 2 } );
+   REQUIRE( tracker.getColComponent( 2 ) == -1 );
+   REQUIRE( tracker.getComponentInfo()[0].ncontinuous == 2 );
+   REQUIRE( tracker.getComponentInfo()[0].nnonz == 2 );
+   REQUIRE( tracker.needsRebuild() );
+
+   // removing the last column of a component removes the component
+   tracker.removeRowsAndCols( problem, Vec<int>{ 2 }, Vec<int>{ 3 } );
+   REQUIRE( tracker.getNumComponents() == 1 );
+
+   // compressing the rows and columns keeps the components
+   tracker.compress( Vec<int>{ 0, -1, -1 }, Vec<int>{ 0, 1, -1, -1 } );
+   REQUIRE( tracker.getColComponent( 1 ) == 0 );
+   REQUIRE( tracker.getRowComponent( 0 ) == 0 );
+}
+
+Problem<double>
+setupProblemWithTwoComponents()
+{
+   // c0 + c1      >= 1
+   //      c1 + c2 >= 1
+   //   c3         >= 1
+   Vec<std::tuple<int, int, double>> entries{
+       std::tuple<int, int, double>{ 0, 0, 1.0 },
+       std::tuple<int, int, double>{ 0, 1, 1.0 },
+       std::tuple<int, int, double>{ 1, 1, 1.0 },
+       std::tuple<int, int, double>{ 1, 2, 1.0 },
+       std::tuple<int, int, double>{ 2, 3, 1.0 } };
+
+   ProblemBuilder<double> pb;
+   pb.reserve( (int) entries.size(), 3, 4 );
+   pb.setNumRows( 3 );
+   pb.setNumCols( 4 );
+   pb.setColUbAll( { 1.0, 1.0, 1.0, 1.0 } );
+   pb.setColLbAll( { 0.0, 0.0, 0.0, 0.0 } );
+   pb.setObjAll( { 1.0, 1.0, 1.0, 1.0 } );
+   pb.setRowLhsAll( { 1.0, 1.0, 1.0 } );
+   pb.setRowRhsAll( { 0.0, 0.0, 0.0 } );
+   pb.setRowRhsInfAll( { 1, 1, 1 } );
+   pb.addEntryAll( entries );
+   pb.setProblemName( "two components" );
+   return pb.build();
+}
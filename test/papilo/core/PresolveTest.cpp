@@ -27,14 +27,15 @@
 #include "papilo/core/ProblemBuilder.hpp"
 #include "papilo/core/Reductions.hpp"
 #include "papilo/presolvers/ImplIntDetection.hpp"
+#include <map>
 
 // for MSVS 2022, the recognition that there is no operator<< for std::vector fails
 // instead, one gets some cryptic (well, it's C++) compiling error
 // so this adds an implementation for operator<< (currently needed in PresolveTest only)
 // need to come before include of catch
 #ifdef _MSC_VER
-template <typename T>
-std::ostream& operator<<(std::ostream& os, const std::vector<T>& v)
+template <typename T, typename A>
+std::ostream& operator<<(std::ostream& os, const std::vector<T, A>& v)
 {
    for( auto& e: v )
      os << e;
@@ -72,7 +73,7 @@ isIntegral()
    return papilo::Vec<uint8_t>{ 1, 1, 1, 1 };
 }
 
-std::vector<int>
+papilo::Vec<int>
 row_sizes()
 {
    return papilo::Vec<int>{ 3, 2 };
@@ -81,6 +82,12 @@ row_sizes()
 papilo::Problem<double>
 setupProblemWithMultiplePresolvingOptions();
 
+papilo::Problem<double>
+setupProblemWithTwoBlocks();
+
+papilo::Problem<double>
+setupProblemWithProbingCandidates( unsigned int seed, int ncols );
+
 std::pair<std::pair<papilo::Problem<double>, papilo::PostsolveStorage<double>>,
           std::pair<int, int>>
 applyReductions( const papilo::Reductions<double>& reductions,
@@ -127,9 +134,9 @@ TEST_CASE( "happy-path-replace-variable", "[core]" )
 
    papilo::Problem<double> problem = pair.first.first;
 
-   std::vector<double> expected_objective{ 0.0, -2.0, 1.0, 1.0 };
-   std::vector<int> expected_colsizes{ ELIMINATED, 1, 2, 1 };
-   std::vector<int> expected_rowsizes{ 2, 2 };
+   Vec<double> expected_objective{ 0.0, -2.0, 1.0, 1.0 };
+   Vec<int> expected_colsizes{ ELIMINATED, 1, 2, 1 };
+   Vec<int> expected_rowsizes{ 2, 2 };
 
    REQUIRE( problem.getObjective().coefficients == expected_objective );
    REQUIRE( problem.getNRows() == 2 );
@@ -171,8 +178,8 @@ TEST_CASE( "happy-path-substitute-matrix-coefficient-into-objective", "[core]" )
        pair = applyReductions( reductions, false );
    Problem<double> problem = pair.first.first;
 
-   std::vector<double> expected_objective{ 3.0, 1.0, 0.0, 0.0 };
-   std::vector<double> expected_upper_bounds{ 1.0, 1.0, 1.0, 0.0 };
+   Vec<double> expected_objective{ 3.0, 1.0, 0.0, 0.0 };
+   Vec<double> expected_upper_bounds{ 1.0, 1.0, 1.0, 0.0 };
 
    REQUIRE( problem.getObjective().coefficients == expected_objective );
    REQUIRE( problem.getNRows() == 2 );
@@ -208,8 +215,8 @@ TEST_CASE( "happy-path-aggregate-free-column", "[core]" )
    REQUIRE( result.second == 1 );
    Problem<double> problem = pair.first.first;
 
-   std::vector<double> expected_objective{ 3.0, 1.0, 0.0, 0.0 };
-   std::vector<int> expected_colsizes{ 1, 1, 1, ELIMINATED };
+   Vec<double> expected_objective{ 3.0, 1.0, 0.0, 0.0 };
+   Vec<int> expected_colsizes{ 1, 1, 1, ELIMINATED };
 
    REQUIRE( problem.getObjective().coefficients == expected_objective );
    REQUIRE( problem.getUpperBounds() == upperBounds() );
@@ -249,6 +256,170 @@ TEST_CASE( "presolve-activity-is-updated-correctly-huge-values", "[core]" )
 
 }
 
+TEST_CASE( "warm-start-replays-transactions-of-unchanged-blocks", "[core]" )
+{
+   Problem<double> problem = setupProblemWithTwoBlocks();
+   Presolve<double> presolve{};
+   presolve.addDefaultPresolvers();
+   presolve.getPresolveOptions().threads = 1;
+   presolve.getPresolveOptions().record_transactions = true;
+   presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+
+   PresolveResult<double> previous = presolve.apply( problem );
+   REQUIRE( previous.status == PresolveStatus::kReduced );
+   REQUIRE( previous.transactions.getNumTransactions() > 0 );
+
+   // without changes every recorded transaction is replayed
+   ProblemChanges<double> changes;
+   Problem<double> warm;
+   PresolveResult<double> unchanged =
+       presolve.applyWarmStart( warm, previous, changes );
+   REQUIRE( unchanged.status == PresolveStatus::kReduced );
+   REQUIRE( presolve.getStatistics().ntsxreplayed ==
+            previous.transactions.getNumTransactions() );
+   REQUIRE( presolve.getStatistics().ntsxnotreplayed == 0 );
+   REQUIRE( warm.getNRows() == problem.getNRows() );
+   REQUIRE( warm.getNCols() == problem.getNCols() );
+
+   // the second block does not see the change of the first one
+   changes.changeRowRhs( 2, 1.0 );
+   PresolveResult<double> changed =
+       presolve.applyWarmStart( warm, unchanged, changes );
+   REQUIRE( changed.status == PresolveStatus::kReduced );
+   REQUIRE( presolve.getStatistics().ntsxreplayed > 0 );
+   REQUIRE( presolve.getStatistics().ntsxnotreplayed > 0 );
+
+   Problem<double> modified = setupProblemWithTwoBlocks();
+   changes.apply( modified, Num<double>{} );
+   REQUIRE( modified.getConstraintMatrix().getRightHandSides()[2] == 1.0 );
+   PresolveResult<double> scratch = presolve.apply( modified );
+   REQUIRE( scratch.status == PresolveStatus::kReduced );
+   REQUIRE( warm.getNRows() == modified.getNRows() );
+   REQUIRE( warm.getNCols() == modified.getNCols() );
+   REQUIRE( warm.getConstraintMatrix().getNnz() ==
+            modified.getConstraintMatrix().getNnz() );
+   REQUIRE( changed.postsolve.nColsOriginal == 6 );
+}
+
+TEST_CASE( "presolve-releases-spare-space-of-lean-configuration", "[core]" )
+{
+   Problem<double> problem = setupProblemWithTwoBlocks();
+   const std::size_t memory = problem.getConstraintMatrix().getMemoryUsage();
+   Presolve<double> presolve{};
+   presolve.addDefaultPresolvers();
+   presolve.getPresolveOptions().threads = 1;
+   presolve.getPresolveOptions().spareratio = 1.0;
+   presolve.getPresolveOptions().minrowspace = 0;
+   presolve.getPresolveOptions().spareratiodecay = 0.5;
+   presolve.getPresolveOptions().compressfac = 1.0;
+   presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+
+   PresolveResult<double> result = presolve.apply( problem );
+   REQUIRE( result.status == PresolveStatus::kReduced );
+   REQUIRE( problem.getConstraintMatrix().getSpareRatio() == 1.0 );
+   REQUIRE( problem.getConstraintMatrix().getMinInterRowSpace() == 0 );
+   REQUIRE( problem.getConstraintMatrix().getMemoryUsage() < memory );
+
+   // the original problem that is kept for postsolve is compact as well
+   const ConstraintMatrix<double>& original =
+       result.postsolve.getOriginalProblem().getConstraintMatrix();
+   REQUIRE( original.getNnz() ==
+            setupProblemWithTwoBlocks().getConstraintMatrix().getNnz() );
+   REQUIRE( original.getConstraintMatrix().getNAlloc() == original.getNnz() );
+   REQUIRE( original.getMemoryUsage() < memory );
+}
+
+TEST_CASE( "presolve-splits-disconnected-components", "[core]" )
+{
+   Problem<double> problem = setupProblemWithTwoBlocks();
+   Presolve<double> presolve{};
+   presolve.addDefaultPresolvers();
+   presolve.getPresolveOptions().split_components = true;
+   presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   PresolveResult<double> result = presolve.apply( problem, false );
+
+   Problem<double> reference = setupProblemWithTwoBlocks();
+   Presolve<double> referencePresolve{};
+   referencePresolve.addDefaultPresolvers();
+   referencePresolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+   PresolveResult<double> referenceResult =
+       referencePresolve.apply( reference, false );
+
+   REQUIRE( result.status == PresolveStatus::kReduced );
+   REQUIRE( referenceResult.status == PresolveStatus::kReduced );
+   REQUIRE( problem.getNRows() == reference.getNRows() );
+   REQUIRE( problem.getNCols() == reference.getNCols() );
+   REQUIRE( problem.getConstraintMatrix().getNnz() ==
+            reference.getConstraintMatrix().getNnz() );
+   REQUIRE( presolve.getStatistics().ndeletedcols ==
+            referencePresolve.getStatistics().ndeletedcols );
+   REQUIRE( result.postsolve.nColsOriginal == 6 );
+   REQUIRE( result.postsolve.origcol_mapping.size() ==
+            (std::size_t) problem.getNCols() );
+   REQUIRE( result.postsolve.types.size() + 1 ==
+            result.postsolve.start.size() );
+
+   // the remaining covering rows are satisfied by the upper bounds, the
+   // postsolved solutions of both runs have to be feasible and equal
+   Message msg{};
+   Num<double> num{};
+   Postsolve<double> postsolve{ msg, num };
+   Solution<double> original;
+   Solution<double> referenceOriginal;
+   REQUIRE( postsolve.undo( Solution<double>{ problem.getUpperBounds() },
+                            original, result.postsolve ) ==
+            PostsolveStatus::kOk );
+   REQUIRE( postsolve.undo( Solution<double>{ reference.getUpperBounds() },
+                            referenceOriginal, referenceResult.postsolve ) ==
+            PostsolveStatus::kOk );
+   REQUIRE( original.primal == referenceOriginal.primal );
+
+   double boundviolation;
+   double rowviolation;
+   double intviolation;
+   REQUIRE( setupProblemWithTwoBlocks().computeSolViolations(
+       num, original.primal, boundviolation, rowviolation, intviolation ) );
+   REQUIRE( boundviolation == 0 );
+   REQUIRE( rowviolation == 0 );
+   REQUIRE( intviolation == 0 );
+}
+
+TEST_CASE( "deterministic-presolve-is-independent-of-thread-count",
+           "[core]" )
+{
+   // probing finds reductions on this problem and its results are merged
+   // from several probing views if more than one thread is used
+   Vec<PresolveResult<double>> results;
+   Vec<Problem<double>> reduced;
+   for( int threads = 1; threads <= 4; ++threads )
+   {
+      Problem<double> problem = setupProblemWithProbingCandidates( 5, 400 );
+      Presolve<double> presolve{};
+      presolve.addDefaultPresolvers();
+      presolve.getPresolveOptions().threads = threads;
+      presolve.getPresolveOptions().deterministic = true;
+      presolve.setVerbosityLevel( VerbosityLevel::kQuiet );
+      results.push_back( presolve.apply( problem, false ) );
+      reduced.push_back( problem );
+   }
+
+   REQUIRE( results[0].status == PresolveStatus::kReduced );
+   for( std::size_t i = 1; i != results.size(); ++i )
+   {
+      const PostsolveStorage<double>& first = results[0].postsolve;
+      const PostsolveStorage<double>& other = results[i].postsolve;
+      REQUIRE( results[i].status == results[0].status );
+      REQUIRE( other.types == first.types );
+      REQUIRE( other.indices == first.indices );
+      REQUIRE( other.values == first.values );
+      REQUIRE( other.start == first.start );
+      REQUIRE( other.origcol_mapping == first.origcol_mapping );
+      REQUIRE( other.origrow_mapping == first.origrow_mapping );
+      REQUIRE( reduced[i].getConstraintMatrix().getNnz() ==
+               reduced[0].getConstraintMatrix().getNnz() );
+   }
+}
+
 Problem<double>
 setupProblemWithMultiplePresolvingOptions()
 {
@@ -332,3 +503,137 @@ isRow( Problem<double>& problem, RowFlag rowflag, int row )
 {
    return problem.getRowFlags()[row].test( rowflag );
 }
+
+Problem<double>
+setupProblemWithTwoBlocks()
+{
+   // two copies of
+   // min x + y + z
+   //     x + y + z >= 4
+   //     x - y      = 0     substituted by doubleton equation
+   //             z <= 2
+   Vec<std::string> rowNames{ "A1", "A2", "A3", "B1", "B2", "B3" };
+   Vec<std::string> columnNames{ "x1", "y1", "z1", "x2", "y2", "z2" };
+   Vec<std::tuple<int, int, double>> entries;
+   for( int block = 0; block != 2; ++block )
+   {
+      const int row = 3 * block;
+      const int col = 3 * block;
+      entries.emplace_back( row, col, 1.0 );
+      entries.emplace_back( row, col + 1, 1.0 );
+      entries.emplace_back( row, col + 2, 1.0 );
+      entries.emplace_back( row + 1, col, 1.0 );
+      entries.emplace_back( row + 1, col + 1, -1.0 );
+      entries.emplace_back( row + 2, col + 2, 1.0 );
+   }
+
+   ProblemBuilder<double> pb;
+   pb.reserve( (int) entries.size(), (int) rowNames.size(), (int) columnNames.size() );
+   pb.setNumRows( (int) rowNames.size() );
+   pb.setNumCols( (int) columnNames.size() );
+   pb.setColUbAll( { 10.0, 10.0, 10.0, 10.0, 10.0, 10.0 } );
+   pb.setColLbAll( { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } );
+   pb.setObjAll( { 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 } );
+   pb.setObjOffset( 0.0 );
+   pb.setColIntegralAll( { 1, 1, 1, 1, 1, 1 } );
+   pb.setRowLhsAll( { 4.0, 0.0, 0.0, 4.0, 0.0, 0.0 } );
+   pb.setRowRhsAll( { 0.0, 0.0, 2.0, 0.0, 0.0, 2.0 } );
+   pb.setRowLhsInfAll( { 0, 0, 1, 0, 0, 1 } );
+   pb.setRowRhsInfAll( { 1, 0, 0, 1, 0, 0 } );
+   pb.addEntryAll( entries );
+   pb.setColNameAll( columnNames );
+   pb.setRowNameAll( rowNames );
+   pb.setProblemName( "two independent blocks" );
+   return pb.build();
+}
+
+Problem<double>
+setupProblemWithProbingCandidates( unsigned int seed, int ncols )
+{
+   // binary problem of random conflicts, implications, knapsacks and covers
+   auto random = [&seed]( int n ) {
+      seed = ( seed * 1103515245u + 12345u ) % 2147483648u;
+      return static_cast<int>( ( seed >> 16 ) % n );
+   };
+   Vec<std::map<int, double>> rows;
+   Vec<double> lhs;
+   Vec<double> rhs;
+   Vec<uint8_t> lhsinf;
+   Vec<uint8_t> rhsinf;
+   auto addRow = [&]( const std::map<int, double>& row, bool covering,
+                      double side ) {
+      rows.push_back( row );
+      lhs.push_back( covering ? side : 0.0 );
+      rhs.push_back( covering ? 0.0 : side );
+      lhsinf.push_back( covering ? 0 : 1 );
+      rhsinf.push_back( covering ? 1 : 0 );
+   };
+
+   for( int r = 0; r != ncols; ++r )
+   {
+      int a = random( ncols );
+      int b = random( ncols );
+      if( a != b )
+         addRow( { { a, 1.0 }, { b, 1.0 } }, false, 1.0 );
+   }
+   for( int r = 0; r != ncols; ++r )
+   {
+      int a = random( ncols );
+      int b = random( ncols );
+      int c = random( ncols );
+      if( a == b || a == c || b == c )
+         continue;
+      if( r % 2 )
+         addRow( { { a, 1.0 }, { b, -1.0 } }, false, 0.0 );
+      else
+         addRow( { { a, 1.0 }, { c, 1.0 }, { b, -1.0 } }, false, 1.0 );
+   }
+   for( int r = 0; r != ncols / 3; ++r )
+   {
+      std::map<int, double> row;
+      for( int k = 0; k != 6; ++k )
+      {
+         int col = random( ncols );
+         row[col] = 1 + random( 9 );
+      }
+      int sum = 0;
+      for( const auto& entry : row )
+         sum += static_cast<int>( entry.second );
+      addRow( row, false, sum / 2 );
+   }
+   for( int r = 0; r != ncols / 4; ++r )
+   {
+      std::map<int, double> row;
+      for( int k = 0; k != 3; ++k )
+         row[random( ncols )] = 1.0;
+      addRow( row, true, 1.0 );
+   }
+   Vec<double> obj( ncols );
+   for( int col = 0; col != ncols; ++col )
+      obj[col] = -( 1 + random( 10 ) );
+
+   Vec<std::tuple<int, int, double>> entries;
+   for( int row = 0; row != (int) rows.size(); ++row )
+   {
+      for( const auto& entry : rows[row] )
+         entries.emplace_back( row, entry.first, entry.second );
+   }
+
+   const int nrows = static_cast<int>( rows.size() );
+   ProblemBuilder<double> pb;
+   pb.reserve( (int) entries.size(), nrows, ncols );
+   pb.setNumRows( nrows );
+   pb.setNumCols( ncols );
+   pb.setColUbAll( Vec<double>( ncols, 1.0 ) );
+   pb.setColLbAll( Vec<double>( ncols, 0.0 ) );
+   pb.setObjAll( obj );
+   pb.setObjOffset( 0.0 );
+   pb.setColIntegralAll( Vec<uint8_t>( ncols, 1 ) );
+   pb.setRowLhsAll( lhs );
+   pb.setRowRhsAll( rhs );
+   pb.setRowLhsInfAll( lhsinf );
+   pb.setRowRhsInfAll( rhsinf );
+   pb.addEntryAll( entries );
+   pb.setProblemName( "probing candidates" );
+   return pb.build();
+}
@@ -130,6 +130,86 @@ TEST_CASE( "clique-row-flag-detection8", "[core]" )
    REQUIRE( !problem.getRowFlags()[7].test( RowFlag::kClique ) );
 }
 
+TEST_CASE( "change-log-records-rows-and-cols-of-fixed-col", "[core]" )
+{
+   Num<double> num{};
+   Message msg{};
+   Problem<double> problem = setupProblemPresolveSingletonRow();
+   Statistics statistics{};
+   PresolveOptions presolveOptions{};
+   PostsolveStorage<double> postsolve =
+       PostsolveStorage<double>( problem, num, presolveOptions );
+   ProblemUpdate<double> problemUpdate( problem, postsolve, statistics,
+                                        presolveOptions, num, msg );
+   problem.recomputeAllActivities();
+   ChangeLogPosition position = problemUpdate.getChangeLog().getPosition();
+
+   Vec<int> changed_rows;
+   Vec<int> changed_cols;
+   REQUIRE( problemUpdate.getChangeLog().getChangesSince(
+       position, changed_rows, changed_cols ) );
+   REQUIRE( changed_rows.empty() );
+   REQUIRE( changed_cols.empty() );
+
+   // x only appears in the first row
+   problemUpdate.fixCol( 0, 1.0 );
+   problemUpdate.flush( true );
+   problemUpdate.clearStates();
+
+   REQUIRE( problemUpdate.getChangeLog().getChangesSince(
+       position, changed_rows, changed_cols ) );
+   REQUIRE( changed_rows == Vec<int>{ 0 } );
+   REQUIRE( changed_cols == Vec<int>{ 0 } );
+
+   // compressing renumbers the rows and columns
+   problemUpdate.compress( true );
+   REQUIRE( !problemUpdate.getChangeLog().getChangesSince(
+       position, changed_rows, changed_cols ) );
+}
+
+TEST_CASE( "hash-index-follows-changes-of-the-matrix", "[core]" )
+{
+   Num<double> num{};
+   Message msg{};
+   Problem<double> problem = setupProblemPresolveSingletonRow();
+   Statistics statistics{};
+   PresolveOptions presolveOptions{};
+   PostsolveStorage<double> postsolve =
+       PostsolveStorage<double>( problem, num, presolveOptions );
+   ProblemUpdate<double> problemUpdate( problem, postsolve, statistics,
+                                        presolveOptions, num, msg );
+   problem.recomputeAllActivities();
+   const ConstraintMatrix<double>& matrix = problem.getConstraintMatrix();
+
+   auto requireUpToDate = [&]() {
+      VectorHashIndex<double> rows;
+      rows.update( matrix.getConstraintMatrix() );
+      REQUIRE( matrix.getRowHashIndex().getSupportHashes() ==
+               rows.getSupportHashes() );
+      REQUIRE( matrix.getRowHashIndex().getCoefficientHashes() ==
+               rows.getCoefficientHashes() );
+
+      VectorHashIndex<double> cols;
+      cols.update( matrix.getMatrixTranspose() );
+      REQUIRE( matrix.getColHashIndex().getSupportHashes() ==
+               cols.getSupportHashes() );
+      REQUIRE( matrix.getColHashIndex().getCoefficientHashes() ==
+               cols.getCoefficientHashes() );
+   };
+
+   requireUpToDate();
+
+   // removes x from the first row
+   problemUpdate.fixCol( 0, 1.0 );
+   problemUpdate.flush( true );
+   problemUpdate.clearStates();
+   requireUpToDate();
+
+   // renumbers the columns
+   problemUpdate.compress( true );
+   requireUpToDate();
+}
+
 
 Problem<double>
 setupProblemPresolveSingletonRow()
@@ -0,0 +1,220 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "papilo/core/SingleRow.hpp"
+#include "papilo/core/SingleRowSimd.hpp"
+#include "papilo/external/catch/catch_amalgamated.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <random>
+
+using namespace papilo;
+
+namespace
+{
+
+struct RandomRows
+{
+   Vec<double> lbs;
+   Vec<double> ubs;
+   Vec<ColFlags> flags;
+   Vec<Vec<int>> cols;
+   Vec<Vec<double>> vals;
+};
+
+/// rows of up to 150 nonzeros over 200 columns with infinite, huge and
+/// integral bounds
+RandomRows
+setupRandomRows()
+{
+   const int ncols = 200;
+   std::mt19937 gen( 4711 );
+   std::uniform_real_distribution<double> value( -10.0, 10.0 );
+   std::uniform_int_distribution<int> kind( 0, 9 );
+   std::uniform_int_distribution<int> rare( 0, 199 );
+   std::uniform_int_distribution<int> length( 1, 150 );
+
+   RandomRows rows;
+   rows.lbs.resize( ncols );
+   rows.ubs.resize( ncols );
+   rows.flags.resize( ncols );
+
+   for( int col = 0; col != ncols; ++col )
+   {
+      rows.lbs[col] = std::floor( value( gen ) ) - 5.0;
+      rows.ubs[col] = std::floor( value( gen ) ) + 15.0;
+
+      if( rare( gen ) == 0 )
+      {
+         rows.lbs[col] = -std::numeric_limits<double>::infinity();
+         rows.flags[col].set( ColFlag::kLbInf );
+      }
+      else if( rare( gen ) == 0 )
+         rows.flags[col].set( ColFlag::kLbHuge );
+
+      if( rare( gen ) == 0 )
+      {
+         rows.ubs[col] = std::numeric_limits<double>::infinity();
+         rows.flags[col].set( ColFlag::kUbInf );
+      }
+      else if( rare( gen ) == 0 )
+         rows.flags[col].set( ColFlag::kUbHuge );
+
+      if( kind( gen ) < 5 )
+         rows.flags[col].set( ColFlag::kIntegral );
+   }
+
+   Vec<int> perm( ncols );
+   std::iota( perm.begin(), perm.end(), 0 );
+
+   for( int row = 0; row != 200; ++row )
+   {
+      std::shuffle( perm.begin(), perm.end(), gen );
+      Vec<int> rowcols( perm.begin(), perm.begin() + length( gen ) );
+      std::sort( rowcols.begin(), rowcols.end() );
+
+      Vec<double> rowvals( rowcols.size() );
+      for( double& val : rowvals )
+      {
+         val = value( gen );
+         if( val == 0 )
+            val = 1.0;
+      }
+
+      rows.cols.push_back( std::move( rowcols ) );
+      rows.vals.push_back( std::move( rowvals ) );
+   }
+
+   return rows;
+}
+
+Vec<SimdLevel>
+supportedLevels()
+{
+   Vec<SimdLevel> levels{ SimdLevel::kScalar };
+   if( get_supported_simd_level() != SimdLevel::kScalar )
+      levels.push_back( SimdLevel::kAvx2 );
+   if( get_supported_simd_level() == SimdLevel::kAvx512 )
+      levels.push_back( SimdLevel::kAvx512 );
+   return levels;
+}
+
+} // namespace
+
+TEST_CASE( "simd-row-activity-matches-scalar", "[core]" )
+{
+   RandomRows rows = setupRandomRows();
+
+   for( std::size_t row = 0; row != rows.cols.size(); ++row )
+   {
+      const int len = (int)rows.cols[row].size();
+      simd::ActivitySums reference{ 0.0, 0.0, 0, 0 };
+      simd::row_activity_scalar( rows.vals[row].data(), rows.cols[row].data(),
+                                 0, len, rows.lbs.data(), rows.ubs.data(),
+                                 rows.flags.data(), reference );
+
+      for( SimdLevel level : supportedLevels() )
+      {
+         simd::ActivitySums sums = simd::row_activity(
+             level, rows.vals[row].data(), rows.cols[row].data(), len,
+             rows.lbs.data(), rows.ubs.data(), rows.flags.data() );
+
+         // the sums must be bitwise identical, not only close
+         REQUIRE( std::memcmp( &sums.min, &reference.min, sizeof( double ) ) ==
+                  0 );
+         REQUIRE( std::memcmp( &sums.max, &reference.max, sizeof( double ) ) ==
+                  0 );
+         REQUIRE( sums.ninfmin == reference.ninfmin );
+         REQUIRE( sums.ninfmax == reference.ninfmax );
+      }
+
+      RowActivity<double> activity = compute_row_activity(
+          rows.vals[row].data(), rows.cols[row].data(), len, rows.lbs,
+          rows.ubs, rows.flags );
+      REQUIRE( activity.min == reference.min );
+      REQUIRE( activity.max == reference.max );
+      REQUIRE( activity.ninfmin == reference.ninfmin );
+      REQUIRE( activity.ninfmax == reference.ninfmax );
+   }
+}
+
+TEST_CASE( "simd-propagation-candidates-cover-bound-changes", "[core]" )
+{
+   RandomRows rows = setupRandomRows();
+   Num<double> num{};
+
+   for( std::size_t row = 0; row != rows.cols.size(); ++row )
+   {
+      const int len = (int)rows.cols[row].size();
+      const double* vals = rows.vals[row].data();
+      const int* cols = rows.cols[row].data();
+
+      RowActivity<double> activity =
+          compute_row_activity( vals, cols, len, rows.lbs, rows.ubs, rows.flags );
+
+      // sides slightly inside the activity range, so that some bounds change
+      const double rhs = activity.min + 1.0;
+      const double lhs = activity.max - 1.0;
+
+      for( bool lhs_side : { false, true } )
+      {
+         if( ( lhs_side ? activity.ninfmax : activity.ninfmin ) != 0 )
+            continue;
+
+         // propagating the entries one by one bypasses the filter of
+         // propagate_row, since blocks shorter than a vector are not filtered
+         RowFlags rflags;
+         rflags.set( lhs_side ? RowFlag::kRhsInf : RowFlag::kLhsInf );
+         Vec<uint8_t> changed( len, 0 );
+         for( int j = 0; j != len; ++j )
+         {
+            propagate_row( num, 0, vals + j, cols + j, 1, activity, lhs, rhs,
+                           rflags, rows.lbs, rows.ubs, rows.flags,
+                           [&]( BoundChange, int, double, int ) {
+                              changed[j] = 1;
+                           } );
+         }
+
+         for( SimdLevel level : supportedLevels() )
+         {
+            for( int j = 0; j < len; j += 64 )
+            {
+               const int blocklen = std::min( 64, len - j );
+               std::uint64_t mask = simd::propagation_candidates(
+                   level, lhs_side, vals + j, cols + j, blocklen,
+                   rows.lbs.data(), rows.ubs.data(), rows.flags.data(),
+                   lhs_side ? activity.max : activity.min,
+                   lhs_side ? lhs : rhs );
+
+               for( int k = 0; k != blocklen; ++k )
+               {
+                  if( changed[j + k] )
+                     REQUIRE( ( ( mask >> k ) & 1 ) == 1 );
+               }
+            }
+         }
+      }
+   }
+}
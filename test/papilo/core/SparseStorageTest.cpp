@@ -310,6 +310,178 @@ TEST_CASE( "transposed sparse matrix can be compressed", "[core]" )
    }
 }
 
+TEST_CASE( "sparse-storage-blocked-transpose-and-compress", "[core]" )
+{
+   // large enough to be split into blocks, the deleted rows at the beginning
+   // make the rows of later blocks move into the space of earlier ones
+   const int numberRows = 20000;
+   const int numberColumns = 5000;
+   uint32_t seed = 12345;
+   auto random = [&seed]() {
+      seed = seed * 1664525u + 1013904223u;
+      return seed >> 8;
+   };
+
+   papilo::Vec<papilo::Triplet<double>> triplets;
+   for( int r = 0; r != numberRows; ++r )
+   {
+      for( int c = random() % 7; c < numberColumns; c += 1 + random() % 800 )
+         triplets.emplace_back( r, c, double( r ) * numberColumns + c + 1 );
+   }
+
+   papilo::Vec<int> rowSizes( numberRows, 0 );
+   papilo::Vec<int> columnSizes( numberColumns, 0 );
+   for( int r = 0; r != numberRows; ++r )
+   {
+      if( r < numberRows / 3 || random() % 5 == 0 )
+         rowSizes[r] = -1;
+   }
+   for( int c = 0; c != numberColumns; ++c )
+   {
+      if( random() % 4 == 0 )
+         columnSizes[c] = -1;
+   }
+
+   papilo::Vec<int> rowMapping( numberRows, -1 );
+   papilo::Vec<int> colMapping( numberColumns, -1 );
+   int nkeptrows = 0;
+   int nkeptcols = 0;
+   for( int r = 0; r != numberRows; ++r )
+      if( rowSizes[r] != -1 )
+         rowMapping[r] = nkeptrows++;
+   for( int c = 0; c != numberColumns; ++c )
+      if( columnSizes[c] != -1 )
+         colMapping[c] = nkeptcols++;
+
+   // the remaining rows (columns) must not have entries in deleted columns
+   // (rows), the deleted rows (columns) keep their entries and space
+   papilo::Vec<papilo::Triplet<double>> rowTriplets;
+   papilo::Vec<papilo::Triplet<double>> colTriplets;
+   papilo::Vec<papilo::Vec<std::pair<int, double>>> allCols( numberColumns );
+   papilo::Vec<papilo::Vec<std::pair<int, double>>> expectedRows( nkeptrows );
+   papilo::Vec<papilo::Vec<std::pair<int, double>>> expectedCols( nkeptcols );
+   for( const auto& triplet : triplets )
+   {
+      const int r = std::get<0>( triplet );
+      const int c = std::get<1>( triplet );
+      const double val = std::get<2>( triplet );
+      allCols[c].emplace_back( r, val );
+      if( rowMapping[r] == -1 || colMapping[c] != -1 )
+         rowTriplets.push_back( triplet );
+      if( colMapping[c] == -1 || rowMapping[r] != -1 )
+         colTriplets.push_back( triplet );
+      if( rowMapping[r] != -1 && colMapping[c] != -1 )
+      {
+         expectedRows[rowMapping[r]].emplace_back( colMapping[c], val );
+         expectedCols[colMapping[c]].emplace_back( rowMapping[r], val );
+      }
+   }
+
+   auto checkMatrix =
+       []( const papilo::SparseStorage<double>& matrix,
+           const papilo::Vec<papilo::Vec<std::pair<int, double>>>& expected,
+           int ncols ) {
+          REQUIRE( matrix.getNRows() == (int)expected.size() );
+          REQUIRE( matrix.getNCols() == ncols );
+          const papilo::IndexRange* ranges = matrix.getRowRanges();
+          for( int i = 0; i != matrix.getNRows(); ++i )
+          {
+             REQUIRE( ranges[i].end - ranges[i].start ==
+                      (int)expected[i].size() );
+             REQUIRE( ranges[i + 1].start >= ranges[i].end );
+             for( int k = 0; k != (int)expected[i].size(); ++k )
+             {
+                REQUIRE( matrix.getColumns()[ranges[i].start + k] ==
+                         expected[i][k].first );
+                REQUIRE( matrix.getValues()[ranges[i].start + k] ==
+                         expected[i][k].second );
+             }
+          }
+          REQUIRE( ranges[matrix.getNRows()].start == matrix.getNAlloc() );
+       };
+
+   for( bool full : { false, true } )
+   {
+#ifdef PAPILO_TBB
+      tbb::task_arena arena( 8 );
+      arena.execute( [&]() {
+#endif
+         papilo::SparseStorage<double> original{ triplets, numberRows,
+                                                 numberColumns, true };
+         checkMatrix( original.getTranspose(), allCols, numberRows );
+
+         papilo::SparseStorage<double> matrix{ rowTriplets, numberRows,
+                                               numberColumns, true };
+         papilo::SparseStorage<double> transpose =
+             papilo::SparseStorage<double>{ colTriplets, numberRows,
+                                            numberColumns, true }
+                 .getTranspose();
+
+         REQUIRE( matrix.compress( rowSizes, columnSizes, full ) ==
+                  colMapping );
+         REQUIRE( transpose.compress( columnSizes, rowSizes, full ) ==
+                  rowMapping );
+         checkMatrix( matrix, expectedRows, nkeptcols );
+         checkMatrix( transpose, expectedCols, nkeptrows );
+#ifdef PAPILO_TBB
+      } );
+#endif
+   }
+}
+
+TEST_CASE( "sparse-storage-spare-space-can-be-reduced", "[core]" )
+{
+   papilo::SparseStorage<double> matrix = setupSparseMatrix();
+   const papilo::SparseStorage<double> original = matrix;
+   papilo::Vec<int> rowSizes = { 2, 5, 1, 0, 5 };
+   papilo::Vec<int> columnSizes( 9, 0 );
+
+   REQUIRE( matrix.getSpareRatio() ==
+            papilo::SparseStorage<double>::DEFAULT_SPARE_RATIO );
+   REQUIRE( matrix.getNAlloc() ==
+            2 * 13 +
+                5 * papilo::SparseStorage<double>::DEFAULT_MIN_INTER_ROW_SPACE );
+
+   // every row keeps half of its size and one entry behind it
+   matrix.setSpareSpace( 1.5, 1 );
+   REQUIRE( matrix.compress( rowSizes, columnSizes ) ==
+            papilo::Vec<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8 } );
+   for( int i = 0; i != 4; ++i )
+      REQUIRE( matrix.getRowRanges()[i + 1].start -
+                   matrix.getRowRanges()[i].start ==
+               matrix.computeRowAlloc( rowSizes[i] ) );
+
+   // without spare space the rows are stored back to back and the excess
+   // memory is released
+   matrix.setSpareSpace( 1.0, 0 );
+   matrix.compress( rowSizes, columnSizes );
+   for( int i = 0; i != 5; ++i )
+      REQUIRE( matrix.getRowRanges()[i].end ==
+               matrix.getRowRanges()[i + 1].start );
+   REQUIRE( matrix.getValuesVec().capacity() ==
+            static_cast<std::size_t>( matrix.getNAlloc() ) );
+   REQUIRE( matrix.getMemoryUsage() < original.getMemoryUsage() );
+
+   for( int i = 0; i != 5; ++i )
+   {
+      const papilo::IndexRange& range = matrix.getRowRanges()[i];
+      const papilo::IndexRange& expected = original.getRowRanges()[i];
+      REQUIRE( range.end - range.start == rowSizes[i] );
+      for( int k = 0; k != rowSizes[i]; ++k )
+      {
+         REQUIRE( matrix.getColumns()[range.start + k] ==
+                  original.getColumns()[expected.start + k] );
+         REQUIRE( matrix.getValues()[range.start + k] ==
+                  original.getValues()[expected.start + k] );
+      }
+   }
+
+   // the transpose keeps the spare space of the matrix
+   papilo::SparseStorage<double> transpose = matrix.getTranspose();
+   REQUIRE( transpose.getNAlloc() == 13 );
+   REQUIRE( transpose.getSpareRatio() == 1.0 );
+}
+
 papilo::SparseStorage<double>
 setupSparseMatrix()
 {
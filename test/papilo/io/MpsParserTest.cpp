@@ -22,6 +22,10 @@
 /*                                                                           */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <memory>
 #include "papilo/io/MpsParser.hpp"
 #include "papilo/external/catch/catch_amalgamated.hpp"
@@ -44,3 +48,181 @@ TEST_CASE( "mps-parser-loading-simple-problem", "[io]" )
    REQUIRE(problem.getConstraintMatrix().getRowSizes() == expected_row_sizes);
    REQUIRE(problem.getConstraintMatrix().getColSizes() == expected_col_sizes);
 }
+
+static void
+requireEqualProblems( const Problem<double>& mapped,
+                      const Problem<double>& streamed )
+{
+   REQUIRE( mapped.getNRows() == streamed.getNRows() );
+   REQUIRE( mapped.getNCols() == streamed.getNCols() );
+   REQUIRE( mapped.getVariableNames() == streamed.getVariableNames() );
+   REQUIRE( mapped.getConstraintNames() == streamed.getConstraintNames() );
+   REQUIRE( mapped.is_objective_negated() == streamed.is_objective_negated() );
+   REQUIRE( mapped.getObjective().coefficients ==
+            streamed.getObjective().coefficients );
+   REQUIRE( mapped.getObjective().offset == streamed.getObjective().offset );
+   REQUIRE( mapped.getLowerBounds() == streamed.getLowerBounds() );
+   REQUIRE( mapped.getUpperBounds() == streamed.getUpperBounds() );
+
+   for( int col = 0; col < mapped.getNCols(); ++col )
+   {
+      const ColFlags a = mapped.getColFlags()[col];
+      const ColFlags b = streamed.getColFlags()[col];
+      REQUIRE( a.test( ColFlag::kLbInf ) == b.test( ColFlag::kLbInf ) );
+      REQUIRE( a.test( ColFlag::kUbInf ) == b.test( ColFlag::kUbInf ) );
+      REQUIRE( a.test( ColFlag::kIntegral ) == b.test( ColFlag::kIntegral ) );
+   }
+
+   const ConstraintMatrix<double>& a = mapped.getConstraintMatrix();
+   const ConstraintMatrix<double>& b = streamed.getConstraintMatrix();
+   REQUIRE( a.getLeftHandSides() == b.getLeftHandSides() );
+   REQUIRE( a.getRightHandSides() == b.getRightHandSides() );
+   REQUIRE( a.getNnz() == b.getNnz() );
+   for( int row = 0; row < mapped.getNRows(); ++row )
+   {
+      const RowFlags flags_a = a.getRowFlags()[row];
+      const RowFlags flags_b = b.getRowFlags()[row];
+      REQUIRE( flags_a.test( RowFlag::kLhsInf ) ==
+               flags_b.test( RowFlag::kLhsInf ) );
+      REQUIRE( flags_a.test( RowFlag::kRhsInf ) ==
+               flags_b.test( RowFlag::kRhsInf ) );
+      REQUIRE( flags_a.test( RowFlag::kEquation ) ==
+               flags_b.test( RowFlag::kEquation ) );
+
+      const SparseVectorView<double> row_a = a.getRowCoefficients( row );
+      const SparseVectorView<double> row_b = b.getRowCoefficients( row );
+      REQUIRE( row_a.getLength() == row_b.getLength() );
+      for( int k = 0; k < row_a.getLength(); ++k )
+      {
+         REQUIRE( row_a.getIndices()[k] == row_b.getIndices()[k] );
+         REQUIRE( row_a.getValues()[k] == row_b.getValues()[k] );
+      }
+   }
+}
+
+static void
+requireMappedReaderMatchesStreamReader( const std::string& filename )
+{
+   boost::optional<Problem<double>> streamed =
+       MpsParser<double>::loadStreamedProblem( filename );
+   REQUIRE( streamed.is_initialized() );
+
+   // small chunks split the columns between chunks
+   for( std::size_t chunk_size :
+        { MpsParser<double>::DEFAULT_CHUNK_SIZE, std::size_t{ 100 },
+          std::size_t{ 1 } } )
+   {
+      boost::optional<Problem<double>> mapped =
+          MpsParser<double>::loadMappedProblem( filename, chunk_size );
+      REQUIRE( mapped.is_initialized() );
+      requireEqualProblems( mapped.get(), streamed.get() );
+   }
+}
+
+TEST_CASE( "mps-parser-mapped-reader-matches-stream-reader", "[io]" )
+{
+   requireMappedReaderMatchesStreamReader( "./resources/dual_fix_neg_inf.mps" );
+   requireMappedReaderMatchesStreamReader( "./resources/test.mps" );
+   requireMappedReaderMatchesStreamReader(
+       "./resources/presolved_ns2080781.mps" );
+
+   // integrality markers within a column, unsorted rows, a free row,
+   // ranges of equations and windows line endings
+   const std::string filename = "mps_parser_mapped_test.mps";
+   {
+      std::ofstream file( filename );
+      file << "* comment\r\n"
+              "NAME          MAPPED\r\n"
+              "OBJSENSE MAX\r\n"
+              "ROWS\r\n"
+              " N  obj\r\n"
+              " E  e1\r\n"
+              " L  l1\r\n"
+              " G  g1\r\n"
+              " N  free\r\n"
+              " E  e2\r\n"
+              "COLUMNS\r\n"
+              "    x1  g1  1.5  e1  -2\r\n"
+              "    x1  obj  1e1\r\n"
+              "    MARKER  'MARKER'  'INTORG'\r\n"
+              "    x2  l1  3  e1  .25\r\n"
+              "    x2  free  1\r\n"
+              "    x3  e2  1  obj  -0.125E+2\r\n"
+              "    MARKER  'MARKER'  'INTEND'\r\n"
+              "    x4  e2  0.1  l1  1234567890123456789012\r\n"
+              "    x4  g1  7\r\n"
+              "RHS\r\n"
+              "    rhs  obj  -3  e1  4\r\n"
+              "    rhs  l1  5  g1  -6\r\n"
+              "    rhs  free  2  e2  1\r\n"
+              "RANGES\r\n"
+              "    rng  e1  2  e2  -3\r\n"
+              "    rng  l1  4  g1  -1\r\n"
+              "BOUNDS\r\n"
+              " UP bnd  x2  4\r\n"
+              " MI bnd  x1\r\n"
+              " BV bnd  x3\r\n"
+              " LI bnd  x4  -2\r\n"
+              " UI bnd  x4  9\r\n"
+              "ENDATA\r\n";
+   }
+   requireMappedReaderMatchesStreamReader( filename );
+
+   Problem<double> problem =
+       MpsParser<double>::loadMappedProblem( filename ).get();
+   REQUIRE( problem.is_objective_negated() );
+   REQUIRE( problem.getNCols() == 4 );
+   REQUIRE( problem.getNRows() == 5 );
+   REQUIRE( problem.getColFlags()[1].test( ColFlag::kIntegral ) );
+   REQUIRE( !problem.getColFlags()[0].test( ColFlag::kIntegral ) );
+   REQUIRE( problem.getColFlags()[0].test( ColFlag::kLbInf ) );
+   REQUIRE( problem.getObjective().coefficients[2] == 12.5 );
+   REQUIRE( problem.getConstraintMatrix().getColumnCoefficients( 3 )
+                .getValues()[0] ==
+            std::strtod( "1234567890123456789012", nullptr ) );
+   std::remove( filename.c_str() );
+}
+
+TEST_CASE( "mps-parser-falls-back-to-stream-reader", "[io]" )
+{
+   // the mapped reader needs section keywords at the start of the line
+   const std::string filename = "mps_parser_fallback_test.mps";
+   {
+      std::ofstream file( filename );
+      file << "NAME          FALLBACK\n"
+              "ROWS\n"
+              " N  obj\n"
+              " L  c1\n"
+              "COLUMNS\n"
+              "    x  obj  1  c1  1\n"
+              "  RHS\n"
+              "    rhs  c1  1\n"
+              "ENDATA\n";
+   }
+
+   REQUIRE( !MpsParser<double>::loadMappedProblem( filename ) );
+   boost::optional<Problem<double>> problem =
+       MpsParser<double>::loadProblem( filename );
+   REQUIRE( problem.is_initialized() );
+   REQUIRE( problem->getConstraintMatrix().getRightHandSides()[0] == 1.0 );
+   std::remove( filename.c_str() );
+}
+
+TEST_CASE( "parse-decimal-rounds-like-strtod", "[io]" )
+{
+   for( const char* str :
+        { "0", "-0", "1", "+17", "0.1", "-2.5e-3", "1E22", "3.0e-22", ".5",
+          "5.", "123456789012345678", "9007199254740993", "0.30000000000000004",
+          "1.7976931348623157e308", "123.456e+7" } )
+   {
+      double value;
+      REQUIRE( !parse_decimal( str, str + std::strlen( str ), value ) );
+      REQUIRE( value == std::strtod( str, nullptr ) );
+   }
+
+   for( const char* str : { "", "-", "e5", "1e", "1x", "inf", "1e400", "0x10" } )
+   {
+      double value;
+      REQUIRE( parse_decimal( str, str + std::strlen( str ), value ) );
+   }
+}
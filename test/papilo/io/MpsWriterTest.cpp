@@ -0,0 +1,153 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#include "papilo/io/MpsWriter.hpp"
+#include "papilo/core/Problem.hpp"
+#include "papilo/external/catch/catch_amalgamated.hpp"
+#include "papilo/io/MpsParser.hpp"
+#ifdef PAPILO_USE_BOOST_IOSTREAMS_WITH_ZLIB
+#include <boost/iostreams/filter/gzip.hpp>
+#endif
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace papilo;
+
+static std::string
+readFile( const std::string& filename )
+{
+   std::ifstream file( filename, std::ifstream::in | std::ifstream::binary );
+   return std::string( std::istreambuf_iterator<char>( file ),
+                       std::istreambuf_iterator<char>() );
+}
+
+static void
+requireBufferedWriterMatchesStreamWriter( const std::string& filename )
+{
+   Problem<double> problem = MpsParser<double>::loadProblem( filename ).get();
+   Vec<int> row_mapping( problem.getNRows() );
+   Vec<int> col_mapping( problem.getNCols() );
+   for( int i = 0; i < problem.getNRows(); ++i )
+      row_mapping[i] = i;
+   for( int i = 0; i < problem.getNCols(); ++i )
+      col_mapping[i] = i;
+
+   const std::string streamed = "mps_writer_streamed.mps";
+   const std::string buffered = "mps_writer_buffered.mps";
+   MpsWriter<double>::writeStreamedProb( streamed, problem, row_mapping,
+                                         col_mapping );
+   const std::string expected = readFile( streamed );
+   REQUIRE( !expected.empty() );
+
+   // small chunks split the columns between many tasks and batches
+   for( int chunk_size : { MpsWriter<double>::DEFAULT_CHUNK_SIZE, 7, 1 } )
+   {
+      MpsWriter<double>::writeBufferedProb( buffered, problem, row_mapping,
+                                            col_mapping, chunk_size );
+      REQUIRE( readFile( buffered ) == expected );
+   }
+   std::remove( streamed.c_str() );
+   std::remove( buffered.c_str() );
+}
+
+TEST_CASE( "mps-writer-buffered-matches-stream-writer", "[io]" )
+{
+   requireBufferedWriterMatchesStreamWriter( "./resources/test.mps" );
+   requireBufferedWriterMatchesStreamWriter(
+       "./resources/presolved_ns2080781.mps" );
+
+   // integral columns, ranged rows, a free row and all kinds of bounds
+   const std::string filename = "mps_writer_test.mps";
+   {
+      std::ofstream file( filename );
+      file << "NAME          WRITER\n"
+              "OBJSENSE MAX\n"
+              "ROWS\n"
+              " N  obj\n"
+              " E  e1\n"
+              " L  l1\n"
+              " G  g1\n"
+              " N  free\n"
+              "COLUMNS\n"
+              "    x1  g1  1.5  e1  -2\n"
+              "    x1  obj  1e1\n"
+              "    MARKER  'MARKER'  'INTORG'\n"
+              "    x2  l1  3  e1  .25\n"
+              "    x2  free  1\n"
+              "    x3  g1  1  obj  -0.125E+2\n"
+              "    MARKER  'MARKER'  'INTEND'\n"
+              "    x4  g1  0.1  l1  1e-7\n"
+              "    x5  obj  1\n"
+              "RHS\n"
+              "    rhs  obj  -3  e1  4\n"
+              "    rhs  l1  5  g1  -6\n"
+              "RANGES\n"
+              "    rng  l1  4\n"
+              "BOUNDS\n"
+              " UP bnd  x2  4\n"
+              " MI bnd  x1\n"
+              " FX bnd  x3  2\n"
+              " LO bnd  x4  -2\n"
+              " FR bnd  x5\n"
+              "ENDATA\n";
+   }
+   requireBufferedWriterMatchesStreamWriter( filename );
+   std::remove( filename.c_str() );
+}
+
+TEST_CASE( "mps-writer-compresses-gzip-files", "[io]" )
+{
+#ifndef PAPILO_USE_BOOST_IOSTREAMS_WITH_ZLIB
+   SUCCEED( "gzip compression is not available" );
+#else
+   Problem<double> problem =
+       MpsParser<double>::loadProblem( "./resources/presolved_ns2080781.mps" )
+           .get();
+   Vec<int> row_mapping( problem.getNRows() );
+   Vec<int> col_mapping( problem.getNCols() );
+   for( int i = 0; i < problem.getNRows(); ++i )
+      row_mapping[i] = i;
+   for( int i = 0; i < problem.getNCols(); ++i )
+      col_mapping[i] = i;
+
+   const std::string plain = "mps_writer_plain.mps";
+   const std::string compressed = "mps_writer_compressed.mps.gz";
+   MpsWriter<double>::writeProb( plain, problem, row_mapping, col_mapping );
+   MpsWriter<double>::writeBufferedProb( compressed, problem, row_mapping,
+                                         col_mapping, 16 );
+   const std::string expected = readFile( plain );
+   REQUIRE( readFile( compressed ).size() < expected.size() );
+
+   std::ifstream file( compressed, std::ifstream::in | std::ifstream::binary );
+   boost::iostreams::filtering_istream in;
+   in.push( boost::iostreams::gzip_decompressor() );
+   in.push( file );
+   const std::string decompressed( ( std::istreambuf_iterator<char>( in ) ),
+                                   std::istreambuf_iterator<char>() );
+   REQUIRE( decompressed == expected );
+   file.close();
+   std::remove( plain.c_str() );
+   std::remove( compressed.c_str() );
+#endif
+}
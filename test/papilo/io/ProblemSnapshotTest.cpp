@@ -0,0 +1,190 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#include "papilo/io/ProblemSnapshot.hpp"
+#include "papilo/core/Problem.hpp"
+#include "papilo/external/catch/catch_amalgamated.hpp"
+#include "papilo/io/MpsParser.hpp"
+#include "papilo/io/Parser.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using namespace papilo;
+
+static void
+requireEqualProblems( const Problem<double>& loaded,
+                      const Problem<double>& written )
+{
+   REQUIRE( loaded.getName() == written.getName() );
+   REQUIRE( loaded.getNRows() == written.getNRows() );
+   REQUIRE( loaded.getNCols() == written.getNCols() );
+   REQUIRE( loaded.getVariableNames() == written.getVariableNames() );
+   REQUIRE( loaded.getConstraintNames() == written.getConstraintNames() );
+   REQUIRE( loaded.is_objective_negated() == written.is_objective_negated() );
+   REQUIRE( loaded.getNumIntegralCols() == written.getNumIntegralCols() );
+   for( ProblemFlag flag : { ProblemFlag::kMixedInteger, ProblemFlag::kInteger,
+                             ProblemFlag::kLinear, ProblemFlag::kBinary } )
+      REQUIRE( loaded.test_problem_type( flag ) ==
+               written.test_problem_type( flag ) );
+   REQUIRE( loaded.getObjective().coefficients ==
+            written.getObjective().coefficients );
+   REQUIRE( loaded.getObjective().offset == written.getObjective().offset );
+   REQUIRE( loaded.getLowerBounds() == written.getLowerBounds() );
+   REQUIRE( loaded.getUpperBounds() == written.getUpperBounds() );
+   REQUIRE( std::memcmp( loaded.getColFlags().data(),
+                         written.getColFlags().data(),
+                         loaded.getColFlags().size() ) == 0 );
+   REQUIRE( std::memcmp( loaded.getRowFlags().data(),
+                         written.getRowFlags().data(),
+                         loaded.getRowFlags().size() ) == 0 );
+
+   const ConstraintMatrix<double>& a = loaded.getConstraintMatrix();
+   const ConstraintMatrix<double>& b = written.getConstraintMatrix();
+   REQUIRE( a.getLeftHandSides() == b.getLeftHandSides() );
+   REQUIRE( a.getRightHandSides() == b.getRightHandSides() );
+   REQUIRE( a.getNnz() == b.getNnz() );
+   REQUIRE( a.getRowSizes() == b.getRowSizes() );
+   REQUIRE( a.getColSizes() == b.getColSizes() );
+   for( int col = 0; col < loaded.getNCols(); ++col )
+   {
+      const SparseVectorView<double> col_a = a.getColumnCoefficients( col );
+      const SparseVectorView<double> col_b = b.getColumnCoefficients( col );
+      REQUIRE( col_a.getLength() == col_b.getLength() );
+      for( int k = 0; k < col_a.getLength(); ++k )
+      {
+         REQUIRE( col_a.getIndices()[k] == col_b.getIndices()[k] );
+         REQUIRE( col_a.getValues()[k] == col_b.getValues()[k] );
+      }
+   }
+}
+
+TEST_CASE( "problem-snapshot-round-trip", "[io]" )
+{
+   const std::string filename = "problem_snapshot_test.papilo";
+
+   for( const char* instance :
+        { "./resources/test.mps", "./resources/presolved_ns2080781.mps" } )
+   {
+      boost::optional<Problem<double>> problem =
+          MpsParser<double>::loadProblem( instance );
+      REQUIRE( problem.is_initialized() );
+
+      // without the transpose the reader has to transpose the matrix
+      for( bool with_transpose : { true, false } )
+      {
+         REQUIRE( ProblemSnapshot<double>::writeProb( filename, problem.get(),
+                                                      with_transpose ) );
+         boost::optional<Problem<double>> loaded =
+             Parser<double>::loadProblem( filename );
+         REQUIRE( loaded.is_initialized() );
+         requireEqualProblems( loaded.get(), problem.get() );
+      }
+   }
+
+   // the names of a reduced problem are looked up through the mappings
+   Problem<double> problem =
+       MpsParser<double>::loadProblem( "./resources/test.mps" ).get();
+   Vec<int> row_mapping( problem.getNRows() );
+   Vec<int> col_mapping( problem.getNCols() );
+   for( int i = 0; i < problem.getNRows(); ++i )
+      row_mapping[i] = problem.getNRows() - 1 - i;
+   for( int i = 0; i < problem.getNCols(); ++i )
+      col_mapping[i] = problem.getNCols() - 1 - i;
+   REQUIRE( ProblemSnapshot<double>::writeProb( filename, problem, row_mapping,
+                                                col_mapping ) );
+   Problem<double> loaded =
+       ProblemSnapshot<double>::loadProblem( filename ).get();
+   REQUIRE( loaded.getVariableNames().front() ==
+            problem.getVariableNames().back() );
+   REQUIRE( loaded.getConstraintNames().back() ==
+            problem.getConstraintNames().front() );
+   std::remove( filename.c_str() );
+}
+
+static bool
+isLoaded( const std::string& filename )
+{
+   return ProblemSnapshot<double>::loadProblem( filename ).is_initialized();
+}
+
+TEST_CASE( "problem-snapshot-rejects-invalid-files", "[io]" )
+{
+   const std::string filename = "problem_snapshot_invalid.papilo";
+   Problem<double> problem =
+       MpsParser<double>::loadProblem( "./resources/test.mps" ).get();
+   REQUIRE( problem.getConstraintMatrix().getNnz() > 1 );
+   REQUIRE( ProblemSnapshot<double>::writeProb( filename, problem ) );
+
+   ProblemSnapshotHeader header;
+   {
+      std::ifstream file( filename, std::ios_base::binary );
+      file.read( reinterpret_cast<char*>( &header ), sizeof( header ) );
+   }
+   auto overwrite = [&]( std::uint64_t offset, const void* data,
+                         std::size_t size )
+   {
+      std::fstream file( filename, std::ios_base::binary |
+                                       std::ios_base::in | std::ios_base::out );
+      file.seekp( static_cast<std::streamoff>( offset ) );
+      file.write( static_cast<const char*>( data ),
+                  static_cast<std::streamsize>( size ) );
+   };
+
+   // unsorted indices of a row are not sorted by the reader but rejected
+   const std::uint64_t row_indices =
+       header.offset[static_cast<int>( SnapshotSection::kRowIndices )];
+   int indices[2];
+   {
+      std::ifstream file( filename, std::ios_base::binary );
+      file.seekg( static_cast<std::streamoff>( row_indices ) );
+      file.read( reinterpret_cast<char*>( indices ), sizeof( indices ) );
+   }
+   const int swapped[2] = { indices[1], indices[0] };
+   overwrite( row_indices, swapped, sizeof( swapped ) );
+   REQUIRE( !isLoaded( filename ) );
+   overwrite( row_indices, indices, sizeof( indices ) );
+   REQUIRE( isLoaded( filename ) );
+
+   // snapshots of another version or floating point type
+   const std::uint32_t version = ProblemSnapshot<double>::VERSION + 1;
+   overwrite( offsetof( ProblemSnapshotHeader, version ), &version,
+              sizeof( version ) );
+   REQUIRE( !isLoaded( filename ) );
+   overwrite( offsetof( ProblemSnapshotHeader, version ), &header.version,
+              sizeof( version ) );
+   const std::uint32_t real_size = sizeof( float );
+   overwrite( offsetof( ProblemSnapshotHeader, real_size ), &real_size,
+              sizeof( real_size ) );
+   REQUIRE( !isLoaded( filename ) );
+   overwrite( offsetof( ProblemSnapshotHeader, real_size ), &header.real_size,
+              sizeof( real_size ) );
+
+   // sections that reach beyond the end of the file
+   const std::uint64_t size = header.size[0] + 1000000;
+   overwrite( offsetof( ProblemSnapshotHeader, size ), &size, sizeof( size ) );
+   REQUIRE( !isLoaded( filename ) );
+
+   REQUIRE( !isLoaded( "missing.papilo" ) );
+   std::remove( filename.c_str() );
+}
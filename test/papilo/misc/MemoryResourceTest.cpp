@@ -0,0 +1,134 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "papilo/misc/MemoryResource.hpp"
+#include "papilo/external/catch/catch_amalgamated.hpp"
+#include <thread>
+#include <vector>
+
+using namespace papilo;
+
+template <typename T>
+using ResourceVec = std::vector<T, ResourceAllocator<T>>;
+
+static uint64_t
+system_allocs()
+{
+   return MemoryResource::getCounters().nsystemallocs;
+}
+
+static void
+allocate_round( int round )
+{
+   ResourceVec<ResourceVec<int>> rows;
+   for( int i = 0; i != 200; ++i )
+   {
+      rows.emplace_back();
+      for( int k = 0; k != ( i * 37 + round ) % 500; ++k )
+         rows.back().push_back( k );
+   }
+}
+
+TEST_CASE( "thread-pool-reuses-memory-in-steady-state", "[misc]" )
+{
+   uint64_t nwarmup = 0;
+   uint64_t nsteady = 0;
+   std::thread worker(
+       [&]()
+       {
+          uint64_t nallocs = system_allocs();
+          allocate_round( 0 );
+          nwarmup = system_allocs() - nallocs;
+          nallocs = system_allocs();
+          for( int round = 1; round != 10; ++round )
+             allocate_round( round % 2 );
+          nsteady = system_allocs() - nallocs;
+       } );
+   worker.join();
+
+   // the pool of the thread serves all rounds after the first one
+   REQUIRE( nwarmup > 0 );
+   REQUIRE( nsteady == 0 );
+}
+
+TEST_CASE( "monotonic-arena-is-rewound-after-reset", "[misc]" )
+{
+   MonotonicArena arena;
+   {
+      ResourceScope scope( arena.getResource() );
+      allocate_round( 0 );
+   }
+   const std::size_t reserved = arena.getReservedBytes();
+   REQUIRE( reserved > 0 );
+
+   for( int round = 1; round != 10; ++round )
+   {
+      arena.reset();
+      ResourceScope scope( arena.getResource() );
+      allocate_round( 0 );
+   }
+   REQUIRE( arena.getReservedBytes() == reserved );
+
+   // blocks that are still in use keep their chunk from being rewound
+   ResourceVec<int> survivor;
+   {
+      arena.reset();
+      ResourceScope scope( arena.getResource() );
+      survivor.assign( 10, 7 );
+      allocate_round( 0 );
+   }
+   for( int round = 1; round != 10; ++round )
+   {
+      arena.reset();
+      ResourceScope scope( arena.getResource() );
+      allocate_round( 0 );
+   }
+   REQUIRE( survivor == ResourceVec<int>( 10, 7 ) );
+}
+
+TEST_CASE( "resource-blocks-outlive-arena-and-thread", "[misc]" )
+{
+   ResourceVec<double> from_arena;
+   {
+      MonotonicArena arena;
+      ResourceScope scope( arena.getResource() );
+      from_arena.assign( 100, 1.5 );
+   }
+   REQUIRE( from_arena.size() == 100 );
+   REQUIRE( from_arena[99] == 1.5 );
+
+   ResourceVec<double> from_thread;
+   std::thread worker( [&from_thread]() { from_thread.assign( 50, 2.5 ); } );
+   worker.join();
+   REQUIRE( from_thread[49] == 2.5 );
+
+   // both are freed on this thread, the memory goes back to its owner
+   from_arena = ResourceVec<double>();
+   from_thread = ResourceVec<double>();
+
+   MemoryResource::setDefault( MemoryResourceKind::kSystem );
+   uint64_t nallocs = system_allocs();
+   {
+      ResourceVec<int> vec( 10 );
+   }
+   MemoryResource::setDefault( MemoryResourceKind::kThreadPool );
+   REQUIRE( system_allocs() == nallocs + 1 );
+}
@@ -0,0 +1,147 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/* This file is part of the library libpapilo, a fork of PaPILO from ZIB     */
+/*                                                                           */
+/* Copyright (C) 2020-2025 Zuse Institute Berlin (ZIB)                       */
+/* Copyright (C) 2025      Jij-Inc.                                          */
+/*                                                                           */
+/* Licensed under the Apache License, Version 2.0 (the "License");           */
+/* you may not use this file except in compliance with the License.          */
+/* You may obtain a copy of the License at                                   */
+/*                                                                           */
+/*     http://www.apache.org/licenses/LICENSE-2.0                            */
+/*                                                                           */
+/* Unless required by applicable law or agreed to in writing, software       */
+/* distributed under the License is distributed on an "AS IS" BASIS,         */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  */
+/* See the License for the specific language governing permissions and       */
+/* limitations under the License.                                            */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "papilo/misc/Trace.hpp"
+#include "papilo/core/Presolve.hpp"
+#include "papilo/core/ProblemBuilder.hpp"
+#include "papilo/external/catch/catch_amalgamated.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+using namespace papilo;
+
+static Problem<double>
+setupProblemForTracing()
+{
+   // 2x + y + z = 2
+   //      z + w = 1
+   Vec<std::tuple<int, int, double>> entries{
+       std::tuple<int, int, double>{ 0, 0, 2.0 },
+       std::tuple<int, int, double>{ 0, 1, 1.0 },
+       std::tuple<int, int, double>{ 0, 2, 1.0 },
+       std::tuple<int, int, double>{ 1, 2, 1.0 },
+       std::tuple<int, int, double>{ 1, 3, 1.0 } };
+
+   ProblemBuilder<double> pb;
+   pb.reserve( (int) entries.size(), 2, 4 );
+   pb.setNumRows( 2 );
+   pb.setNumCols( 4 );
+   pb.setColUbAll( { 1.0, 1.0, 1.0, 1.0 } );
+   pb.setColLbAll( { 0.0, 0.0, 0.0, 0.0 } );
+   pb.setObjAll( { 1.0, 1.0, 1.0, 1.0 } );
+   pb.setObjOffset( 0.0 );
+   pb.setColIntegralAll( { 1, 1, 1, 1 } );
+   pb.setRowRhsAll( { 2, 1 } );
+   pb.setRowLhsAll( { 2, 1 } );
+   pb.addEntryAll( entries );
+   pb.setProblemName( "matrix for tracing" );
+   return pb.build();
+}
+
+static int
+count_events( const Tracer& tracer, const char* category )
+{
+   int count = 0;
+   for( const Tracer::Event& event : tracer.getEvents() )
+      count += std::string( event.category ) == category;
+   return count;
+}
+
+TEST_CASE( "trace-records-scopes-of-all-threads", "[misc]" )
+{
+   Tracer tracer;
+   {
+      TraceScope scope( &tracer, "test", "outer" );
+      scope.addArg( "value", 42 );
+      std::thread worker( [&tracer]()
+                          { TraceScope inner( &tracer, "test", "in\"ner" ); } );
+      worker.join();
+   }
+   tracer.addCounter( "sizes", { { "rows", 3 }, { "cols", 4 } } );
+
+   // a disabled scope does not record anything
+   {
+      TraceScope disabled( nullptr, "test", "disabled" );
+      disabled.addArg( "value", 1 );
+      REQUIRE( !disabled.isActive() );
+   }
+
+   const Vec<Tracer::Event>& events = tracer.getEvents();
+   REQUIRE( events.size() == 3 );
+   REQUIRE( tracer.getNumThreads() == 2 );
+   REQUIRE( events[0].name == "in\"ner" );
+   REQUIRE( events[1].name == "outer" );
+   REQUIRE( events[1].begin <= events[0].begin );
+   REQUIRE( events[1].begin + events[1].duration >=
+            events[0].begin + events[0].duration );
+   REQUIRE( events[0].thread != events[1].thread );
+   REQUIRE( events[1].nargs == 1 );
+   REQUIRE( events[1].args[0].value == 42 );
+   REQUIRE( events[2].phase == 'C' );
+   REQUIRE( events[2].nargs == 2 );
+
+   fmt::memory_buffer buffer;
+   tracer.write( std::back_inserter( buffer ) );
+   std::string json( buffer.data(), buffer.size() );
+   REQUIRE( json.find( "\"traceEvents\":[" ) != std::string::npos );
+   REQUIRE( json.find( "\"name\":\"in\\\"ner\"" ) != std::string::npos );
+   REQUIRE( json.find( "\"args\":{\"value\":42}" ) != std::string::npos );
+   REQUIRE( json.find( "\"args\":{\"rows\":3,\"cols\":4}" ) !=
+            std::string::npos );
+}
+
+TEST_CASE( "trace-of-presolve-is-written-to-file", "[misc]" )
+{
+   const std::string filename = "presolve_trace_test.json";
+   std::remove( filename.c_str() );
+
+   Problem<double> problem = setupProblemForTracing();
+   Presolve<double> presolve{};
+   presolve.addDefaultPresolvers();
+   presolve.getPresolveOptions().threads = 1;
+   presolve.getPresolveOptions().trace_file = filename;
+   presolve.apply( problem );
+
+   const Tracer* tracer = presolve.getTracer();
+   REQUIRE( tracer != nullptr );
+   REQUIRE( count_events( *tracer, "presolve" ) == 1 );
+   REQUIRE( count_events( *tracer, "round" ) >= 1 );
+   REQUIRE( count_events( *tracer, "presolver" ) >= 1 );
+   REQUIRE( count_events( *tracer, "update" ) >= 1 );
+   REQUIRE( count_events( *tracer, "counter" ) >= 1 );
+
+   std::ifstream file( filename );
+   REQUIRE( file.good() );
+   std::string json( ( std::istreambuf_iterator<char>( file ) ),
+                     std::istreambuf_iterator<char>() );
+   REQUIRE( json.find( "\"name\":\"presolve\"" ) != std::string::npos );
+   REQUIRE( json.back() == '\n' );
+   file.close();
+   std::remove( filename.c_str() );
+
+   // tracing is disabled by default
+   Problem<double> problem2 = setupProblemForTracing();
+   presolve.getPresolveOptions().trace_file = "";
+   presolve.apply( problem2 );
+   REQUIRE( presolve.getTracer() == nullptr );
+}
@@ -39,6 +39,9 @@ setupSmallMatrixForCliqueMerging();
 Problem<double>
 setupSmallerMatrixForCliqueMerging();
 
+Problem<double>
+setupMatrixWithEquationForCliqueMerging();
+
 TEST_CASE( "clique-merging-basic", "[presolve]" )
 {
 
@@ -69,45 +72,6 @@ TEST_CASE( "clique-merging-basic", "[presolve]" )
     }
 
    REQUIRE( status == PresolveStatus::kReduced );
-#ifdef PAPILO_TBB
-    REQUIRE( reductions.size() == 36 );
-    
-    REQUIRE( reductions.getReduction(0).row == ColReduction::LOCKED );
-    REQUIRE( reductions.getReduction(0).col == 1 );
-
-    REQUIRE( reductions.getReduction(1).row == ColReduction::BOUNDS_LOCKED );
-    REQUIRE( reductions.getReduction(1).col == 1 );
-
-    REQUIRE( reductions.getReduction(2).row == ColReduction::LOCKED );
-    REQUIRE( reductions.getReduction(2).col == 2 );
-
-    REQUIRE( reductions.getReduction(3).row == ColReduction::BOUNDS_LOCKED );
-    REQUIRE( reductions.getReduction(3).col == 2 );
-
-    REQUIRE( reductions.getReduction(4).row == ColReduction::LOCKED );
-    REQUIRE( reductions.getReduction(4).col == 0 );
-
-    REQUIRE( reductions.getReduction(5).row == ColReduction::BOUNDS_LOCKED );
-    REQUIRE( reductions.getReduction(5).col == 0 );
-
-    REQUIRE( reductions.getReduction(6).row == 0 );
-    REQUIRE( reductions.getReduction(6).col == RowReduction::LOCKED );
-
-    REQUIRE( reductions.getReduction(7).row == 1 );
-    REQUIRE( reductions.getReduction(7).col == RowReduction::LOCKED );
-
-    REQUIRE( reductions.getReduction(8).row == 2 );
-    REQUIRE( reductions.getReduction(8).col == RowReduction::LOCKED );
-
-    REQUIRE( reductions.getReduction(9).row == 2 );
-    REQUIRE( reductions.getReduction(9).col == 0 );
-
-    REQUIRE( reductions.getReduction(10).row == 0 );
-    REQUIRE( reductions.getReduction(10).col == RowReduction::REDUNDANT );
-
-    REQUIRE( reductions.getReduction(11).row == 1 );
-    REQUIRE( reductions.getReduction(11).col == RowReduction::REDUNDANT );
-#else 
     REQUIRE( reductions.size() == 12 );
     
     REQUIRE( reductions.getReduction(0).row == ColReduction::LOCKED );
@@ -145,7 +109,6 @@ TEST_CASE( "clique-merging-basic", "[presolve]" )
 
     REQUIRE( reductions.getReduction(11).row == 2 );
     REQUIRE( reductions.getReduction(11).col == RowReduction::REDUNDANT );
-#endif
 }
 
 TEST_CASE( "clique-merging-cover", "[presolve]" )
@@ -178,8 +141,7 @@ TEST_CASE( "clique-merging-cover", "[presolve]" )
     }*/
 
    REQUIRE( status == PresolveStatus::kReduced );
-#ifdef PAPILO_TBB
-    REQUIRE( reductions.size() == 19 );
+    REQUIRE( reductions.size() == 9 );
     
     REQUIRE( reductions.getReduction(0).row == ColReduction::LOCKED );
     REQUIRE( reductions.getReduction(0).col == 0 );
@@ -207,37 +169,55 @@ TEST_CASE( "clique-merging-cover", "[presolve]" )
 
     REQUIRE( reductions.getReduction(8).row == 1 );
     REQUIRE( reductions.getReduction(8).col == RowReduction::REDUNDANT );
-#else
-    REQUIRE( reductions.size() == 9 );
-    
-    REQUIRE( reductions.getReduction(0).row == ColReduction::LOCKED );
-    REQUIRE( reductions.getReduction(0).col == 0 );
 
-    REQUIRE( reductions.getReduction(1).row == ColReduction::BOUNDS_LOCKED );
-    REQUIRE( reductions.getReduction(1).col == 0 );
+}
 
-    REQUIRE( reductions.getReduction(2).row == ColReduction::LOCKED );
-    REQUIRE( reductions.getReduction(2).col == 1 );
+TEST_CASE( "clique-merging-uses-conflicts-of-equations", "[presolve]" )
+{
 
-    REQUIRE( reductions.getReduction(3).row == ColReduction::BOUNDS_LOCKED );
-    REQUIRE( reductions.getReduction(3).col == 1 );
+   CliqueMerging<double> presolvingMethod{};
 
-    REQUIRE( reductions.getReduction(4).row == ColReduction::LOCKED );
-    REQUIRE( reductions.getReduction(4).col == 2 );
+   double time = 0.0;
+   Timer t{ time };
+   Problem<double> problem = setupMatrixWithEquationForCliqueMerging();
+   Statistics statistics{};
+   PresolveOptions presolveOptions{};
+   PostsolveStorage<double> postsolve =
+       PostsolveStorage<double>( problem, {}, presolveOptions );
+   ProblemUpdate<double> problemUpdate( problem, postsolve, statistics,
+                                        presolveOptions, {}, {} );
 
-    REQUIRE( reductions.getReduction(5).row == ColReduction::BOUNDS_LOCKED );
-    REQUIRE( reductions.getReduction(5).col == 2 );
+   Reductions<double> reductions{};
+   presolvingMethod.setParameters( 1000000, 100000, 100, 10000 );
+   int cause = -1;
+   PresolveStatus status = presolvingMethod.execute(
+       problem, problemUpdate, { }, reductions, t, cause );
 
-    REQUIRE( reductions.getReduction(6).row == 1 );
-    REQUIRE( reductions.getReduction(6).col == RowReduction::LOCKED );
+   // the equation C is not merged or marked redundant, but its conflict
+   // between y and z allows to merge A and B
+   REQUIRE( status == PresolveStatus::kReduced );
+   REQUIRE( reductions.size() == 10 );
 
-    REQUIRE( reductions.getReduction(7).row == 0 );
-    REQUIRE( reductions.getReduction(7).col == RowReduction::LOCKED );
+   REQUIRE( reductions.getReduction(0).row == ColReduction::LOCKED );
+   REQUIRE( reductions.getReduction(0).col == 0 );
 
-    REQUIRE( reductions.getReduction(8).row == 1 );
-    REQUIRE( reductions.getReduction(8).col == RowReduction::REDUNDANT );
+   REQUIRE( reductions.getReduction(2).row == ColReduction::LOCKED );
+   REQUIRE( reductions.getReduction(2).col == 1 );
+
+   REQUIRE( reductions.getReduction(4).row == ColReduction::LOCKED );
+   REQUIRE( reductions.getReduction(4).col == 2 );
 
-#endif
+   REQUIRE( reductions.getReduction(6).row == 1 );
+   REQUIRE( reductions.getReduction(6).col == RowReduction::LOCKED );
+
+   REQUIRE( reductions.getReduction(7).row == 0 );
+   REQUIRE( reductions.getReduction(7).col == RowReduction::LOCKED );
+
+   REQUIRE( reductions.getReduction(8).row == 0 );
+   REQUIRE( reductions.getReduction(8).col == 2 );
+
+   REQUIRE( reductions.getReduction(9).row == 1 );
+   REQUIRE( reductions.getReduction(9).col == RowReduction::REDUNDANT );
 }
 
 Problem<double>
@@ -339,3 +319,55 @@ setupSmallerMatrixForCliqueMerging()
    Problem<double> problem = pb.build();
    return problem;
 }
+
+Problem<double>
+setupMatrixWithEquationForCliqueMerging()
+{
+   // min -x -y -z
+   // A: x + y <= 1
+   // B: x + z <= 1
+   // C: y + z  = 1
+
+   Vec<std::string> columnNames{ "x", "y", "z" };
+
+   Vec<double> coefficients{ -1.0, -1.0, -1.0 };
+   Vec<double> upperBounds{ 1.0, 1.0, 1.0 };
+   Vec<double> lowerBounds{ 0.0, 0.0, 0.0 };
+   Vec<uint8_t> isIntegral{ 1, 1, 1 };
+
+   Vec<double> rhs{ 1.0, 1.0, 1.0 };
+   Vec<double> lhs{ 0.0, 0.0, 1.0 };
+   Vec<std::string> rowNames{ "A", "B", "C" };
+   Vec<uint8_t> lhsInfinity{ 1, 1, 0 };
+   Vec<uint8_t> rhsInfinity{ 0, 0, 0 };
+   Vec<std::tuple<int, int, double>> entries{
+       std::tuple<int, int, double>{ 0, 0, 1.0 },
+       std::tuple<int, int, double>{ 0, 1, 1.0 },
+
+       std::tuple<int, int, double>{ 1, 0, 1.0 },
+       std::tuple<int, int, double>{ 1, 2, 1.0 },
+
+       std::tuple<int, int, double>{ 2, 1, 1.0 },
+       std::tuple<int, int, double>{ 2, 2, 1.0 }
+   };
+
+   ProblemBuilder<double> pb;
+   pb.reserve( (int)entries.size(), (int)rowNames.size(),
+               (int)columnNames.size() );
+   pb.setNumRows( (int)rowNames.size() );
+   pb.setNumCols( (int)columnNames.size() );
+   pb.setColUbAll( upperBounds );
+   pb.setColLbAll( lowerBounds );
+   pb.setObjAll( coefficients );
+   pb.setObjOffset( 0.0 );
+   pb.setColIntegralAll( isIntegral );
+   pb.setRowRhsAll( rhs );
+   pb.setRowLhsAll( lhs );
+   pb.setRowLhsInfAll( lhsInfinity );
+   pb.setRowRhsInfAll( rhsInfinity );
+   pb.addEntryAll( entries );
+   pb.setColNameAll( columnNames );
+   pb.setProblemName( "matrix with equation for testing Clique Merging" );
+   Problem<double> problem = pb.build();
+   return problem;
+}
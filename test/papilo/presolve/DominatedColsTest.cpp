@@ -42,6 +42,9 @@ setupMatrixForDominatedColsMultipleParallel();
 Problem<double>
 setupMatrixForMultipleDominatedCols();
 
+Problem<double>
+setupMatrixForDominatedBinaries();
+
 TEST_CASE( "domcol-happy-path", "[presolve]" )
 {
    double time = 0.0;
@@ -231,6 +234,168 @@ TEST_CASE( "domcol-multiple-columns", "[presolve]" )
    }
 }
 
+TEST_CASE( "domcol-binaries-in-conflict", "[presolve]" )
+{
+   double time = 0.0;
+   int cause = -1;
+   Timer t{time};
+   Num<double> num{};
+   Message msg{};
+   Problem<double> problem = setupMatrixForDominatedBinaries();
+   Statistics statistics{};
+   PresolveOptions presolveOptions{};
+   PostsolveStorage<double> postsolve =
+       PostsolveStorage<double>( problem, num, presolveOptions );
+   ProblemUpdate<double> problemUpdate( problem, postsolve, statistics,
+                                        presolveOptions, num, msg );
+
+   DominatedCols<double> presolvingMethod{};
+   Reductions<double> reductions{};
+   problem.recomputeAllActivities();
+
+   // no bound is implied, so x does not dominate y without the conflict
+   PresolveStatus presolveStatus =
+       presolvingMethod.execute( problem, problemUpdate, num, reductions, t, cause );
+   REQUIRE( presolveStatus == PresolveStatus::kUnchanged );
+
+   // x = 1 implies y = 0
+   problem.getImplications().add( Implication<double>( 0, true, 1, true, 0.0 ) );
+   problem.getImplications().flush( problem.getVariableDomains() );
+
+   presolveStatus =
+       presolvingMethod.execute( problem, problemUpdate, num, reductions, t, cause );
+   REQUIRE( presolveStatus == PresolveStatus::kReduced );
+   REQUIRE( reductions.getTransactions().size() == 1 );
+
+   const Reduction<double>& fixing =
+       reductions.getReduction( reductions.size() - 1 );
+   REQUIRE( fixing.row == ColReduction::FIXED );
+   REQUIRE( fixing.col == 1 );
+   REQUIRE( fixing.newval == 0 );
+}
+
+static Problem<double>
+setupMatrixWithDominatedCopies()
+{
+   // every column x_i has a copy y_i with the same entries, a larger
+   // objective and finite bounds, while x_i has an infinite upper bound
+   const int nrows = 40;
+   const int npairs = 100;
+   uint32_t seed = 4711;
+   auto random = [&seed]( int n ) {
+      seed = seed * 1664525u + 1013904223u;
+      return static_cast<int>( ( seed >> 8 ) % n );
+   };
+
+   Vec<double> coefficients( 2 * npairs );
+   Vec<double> upperBounds( 2 * npairs, 5.0 );
+   Vec<double> lowerBounds( 2 * npairs, 0.0 );
+   Vec<uint8_t> upperInfinity( 2 * npairs, 0 );
+   Vec<uint8_t> isIntegral( 2 * npairs );
+   Vec<std::tuple<int, int, double>> entries;
+   for( int i = 0; i != npairs; ++i )
+   {
+      coefficients[2 * i] = random( 5 ) - 2.0;
+      coefficients[2 * i + 1] = coefficients[2 * i] + random( 2 );
+      upperInfinity[2 * i] = 1;
+      isIntegral[2 * i] = random( 2 );
+      isIntegral[2 * i + 1] = isIntegral[2 * i] || random( 2 ) == 0;
+      for( int row = random( 5 ); row < nrows; row += 1 + random( 12 ) )
+      {
+         const double value = 1.0 + random( 3 );
+         entries.emplace_back( row, 2 * i, value );
+         entries.emplace_back( row, 2 * i + 1, value + random( 2 ) );
+      }
+   }
+
+   // rows 0-9 are equations, 10-29 are <= and 30-39 are >= rows
+   Vec<double> lhs( nrows, 1.0 );
+   Vec<double> rhs( nrows, 10.0 );
+   Vec<uint8_t> lhsInfinity( nrows, 0 );
+   Vec<uint8_t> rhsInfinity( nrows, 0 );
+   for( int row = 0; row != nrows; ++row )
+   {
+      if( row < 10 )
+         rhs[row] = lhs[row];
+      else if( row < 30 )
+         lhsInfinity[row] = 1;
+      else
+         rhsInfinity[row] = 1;
+   }
+
+   ProblemBuilder<double> pb;
+   pb.reserve( (int) entries.size(), nrows, 2 * npairs );
+   pb.setNumRows( nrows );
+   pb.setNumCols( 2 * npairs );
+   pb.setColUbAll( upperBounds );
+   pb.setColLbAll( lowerBounds );
+   pb.setColUbInfAll( upperInfinity );
+   pb.setObjAll( coefficients );
+   pb.setObjOffset( 0.0 );
+   pb.setColIntegralAll( isIntegral );
+   pb.setRowLhsAll( lhs );
+   pb.setRowRhsAll( rhs );
+   pb.setRowLhsInfAll( lhsInfinity );
+   pb.setRowRhsInfAll( rhsInfinity );
+   pb.addEntryAll( entries );
+   pb.setProblemName( "matrix with dominated copies" );
+   return pb.build();
+}
+
+static Reductions<double>
+findDominatedCols( Problem<double> problem, bool indexed )
+{
+   double time = 0.0;
+   int cause = -1;
+   Timer t{ time };
+   Num<double> num{};
+   Message msg{};
+   Statistics statistics{};
+   PresolveOptions presolveOptions{};
+   PostsolveStorage<double> postsolve =
+       PostsolveStorage<double>( problem, num, presolveOptions );
+   ProblemUpdate<double> problemUpdate( problem, postsolve, statistics,
+                                        presolveOptions, num, msg );
+
+   DominatedCols<double> presolvingMethod{};
+   presolvingMethod.setIndexed( indexed );
+   Reductions<double> reductions{};
+   problem.recomputeAllActivities();
+   presolvingMethod.execute( problem, problemUpdate, num, reductions, t,
+                             cause );
+   return reductions;
+}
+
+TEST_CASE( "domcol-indexed-search-matches-pairwise", "[presolve]" )
+{
+   Vec<Problem<double>> problems;
+   problems.push_back( setupMatrixForDominatedCols() );
+   problems.push_back( setupMatrixForDominatedColsParallel() );
+   problems.push_back( setupMatrixForDominatedColsMultipleParallel() );
+   problems.push_back( setupMatrixForMultipleDominatedCols() );
+   problems.push_back( setupMatrixWithDominatedCopies() );
+
+   for( const Problem<double>& problem : problems )
+   {
+      Reductions<double> pairwise = findDominatedCols( problem, false );
+      Reductions<double> indexed = findDominatedCols( problem, true );
+
+      REQUIRE( pairwise.size() > 0 );
+      REQUIRE( indexed.size() == pairwise.size() );
+      REQUIRE( indexed.getTransactions().size() ==
+               pairwise.getTransactions().size() );
+      for( int i = 0; i != (int) pairwise.size(); ++i )
+      {
+         REQUIRE( indexed.getReduction( i ).row ==
+                  pairwise.getReduction( i ).row );
+         REQUIRE( indexed.getReduction( i ).col ==
+                  pairwise.getReduction( i ).col );
+         REQUIRE( indexed.getReduction( i ).newval ==
+                  pairwise.getReduction( i ).newval );
+      }
+   }
+}
+
 Problem<double>
 setupMatrixForDominatedCols()
 {
@@ -417,3 +582,52 @@ setupMatrixForMultipleDominatedCols()
    Problem<double> problem = pb.build();
    return problem;
 }
+
+Problem<double>
+setupMatrixForDominatedBinaries()
+{
+   // x dominates y, both binary
+   // min x + 2y + z
+   // a: x + y +  z >= 1
+   // b:     y + 2z <= 3
+
+   Vec<std::string> columnNames{ "x", "y", "z" };
+
+   Vec<double> coefficients{ 1.0, 2.0, 1.0 };
+   Vec<double> upperBounds{ 1.0, 1.0, 1.0 };
+   Vec<double> lowerBounds{ 0.0, 0.0, 0.0 };
+   Vec<uint8_t> isIntegral{ 1, 1, 1 };
+
+   Vec<double> lhs{ 1.0, 0.0 };
+   Vec<double> rhs{ 0.0, 3.0 };
+   Vec<std::string> rowNames{ "a", "b" };
+   Vec<uint8_t> lhsInfinity{ 0, 1 };
+   Vec<uint8_t> rhsInfinity{ 1, 0 };
+   Vec<std::tuple<int, int, double>> entries{
+       std::tuple<int, int, double>{ 0, 0, 1.0 },
+       std::tuple<int, int, double>{ 0, 1, 1.0 },
+       std::tuple<int, int, double>{ 0, 2, 1.0 },
+
+       std::tuple<int, int, double>{ 1, 1, 1.0 },
+       std::tuple<int, int, double>{ 1, 2, 2.0 },
+   };
+
+   ProblemBuilder<double> pb;
+   pb.reserve( (int) entries.size(), (int) rowNames.size(), (int) columnNames.size() );
+   pb.setNumRows( (int) rowNames.size() );
+   pb.setNumCols( (int) columnNames.size() );
+   pb.setColUbAll( upperBounds );
+   pb.setColLbAll( lowerBounds );
+   pb.setObjAll( coefficients );
+   pb.setObjOffset( 0.0 );
+   pb.setColIntegralAll( isIntegral );
+   pb.setRowLhsAll( lhs );
+   pb.setRowRhsAll( rhs );
+   pb.setRowLhsInfAll( lhsInfinity );
+   pb.setRowRhsInfAll( rhsInfinity );
+   pb.addEntryAll( entries );
+   pb.setColNameAll( columnNames );
+   pb.setProblemName( "matrix binaries x dom y" );
+   Problem<double> problem = pb.build();
+   return problem;
+}
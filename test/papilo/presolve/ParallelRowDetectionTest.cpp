@@ -988,6 +988,50 @@ int cause = -1;
    }
 }
 
+TEST_CASE( "parallel-row-rehashes-rows-changed-since-last-call",
+           "[presolve]" )
+{
+   Num<double> num{};
+   double time = 0.0;
+   int cause = -1;
+   Timer t{ time };
+   Message msg{};
+   Problem<double> problem = setupProblemWithNoParallelRows();
+   Statistics statistics{};
+   PresolveOptions presolveOptions{};
+   PostsolveStorage<double> postsolve =
+       PostsolveStorage<double>( problem, num, presolveOptions );
+   ProblemUpdate<double> problemUpdate( problem, postsolve, statistics,
+                                        presolveOptions, num, msg );
+   problem.recomputeAllActivities();
+   problemUpdate.checkChangedActivities();
+   ParallelRowDetection<double> presolvingMethod{};
+   Reductions<double> reductions{};
+
+   PresolveStatus presolveStatus =
+       presolvingMethod.execute( problem, problemUpdate, num, reductions, t, cause );
+   REQUIRE( presolveStatus == PresolveStatus::kUnchanged );
+
+   // 3x + 3y + 5z -> 3x + 3y + 6z is parallel to the first row
+   Reductions<double> coefficientChange{};
+   {
+      TransactionGuard<double> tg{ coefficientChange };
+      coefficientChange.lockRow( 2 );
+      coefficientChange.changeMatrixEntry( 2, 2, 6.0 );
+   }
+   const Reduction<double>* first = &coefficientChange.getReduction( 0 );
+   REQUIRE( problemUpdate.applyTransaction( first,
+                                            first + coefficientChange.size(),
+                                            ArgumentType::kPrimal ) ==
+            ApplyResult::kApplied );
+   problemUpdate.flush( true );
+   problemUpdate.clearStates();
+
+   presolveStatus =
+       presolvingMethod.execute( problem, problemUpdate, num, reductions, t, cause );
+   REQUIRE( presolveStatus == PresolveStatus::kReduced );
+}
+
 Problem<double>
 setupProblemWithNoParallelRows()
 {
@@ -27,6 +27,7 @@
 #include "papilo/core/PresolveMethod.hpp"
 #include "papilo/core/Problem.hpp"
 #include "papilo/core/ProblemBuilder.hpp"
+#include "papilo/core/ProbingView.hpp"
 
 using namespace papilo;
 
@@ -36,6 +37,9 @@ setupProblemWithProbing();
 Problem<double>
 setupProblemWithProbingWithNoBinary();
 
+Problem<double>
+setupProblemWithImplications();
+
 TEST_CASE( "happy-path-probing", "[presolve]" )
 {
    Num<double> num{};
@@ -91,6 +95,132 @@ TEST_CASE( "failed-path-probing-on-not-binary-variables", "[presolve]" )
    REQUIRE( presolveStatus == PresolveStatus::kUnchanged );
 }
 
+TEST_CASE( "probing-sparse-view-matches-dense-view", "[presolve]" )
+{
+   Num<double> num{};
+   Problem<double> problem = setupProblemWithImplications();
+   problem.recomputeAllActivities();
+
+   ProbingView<double> dense( problem, num, false );
+   ProbingView<double> sparse( problem, num, true );
+
+   for( int col = 0; col != 4; ++col )
+   {
+      for( ProbingView<double>* view : { &dense, &sparse } )
+      {
+         view->setProbingColumn( col, true );
+         view->propagateDomains();
+         view->storeImplications();
+         view->reset();
+         view->setProbingColumn( col, false );
+         view->propagateDomains();
+         REQUIRE( !view->analyzeImplications() );
+         view->reset();
+      }
+
+      REQUIRE( sparse.getProbingLowerBounds().getNumTouched() == 0 );
+      REQUIRE( sparse.getProbingActivities().getNumTouched() == 0 );
+   }
+
+   const auto& densechgs = dense.getProbingBoundChanges();
+   const auto& sparsechgs = sparse.getProbingBoundChanges();
+   REQUIRE( !densechgs.empty() );
+   REQUIRE( densechgs.size() == sparsechgs.size() );
+   for( size_t i = 0; i != densechgs.size(); ++i )
+   {
+      REQUIRE( densechgs[i].col == sparsechgs[i].col );
+      REQUIRE( densechgs[i].upper == sparsechgs[i].upper );
+      REQUIRE( densechgs[i].bound == sparsechgs[i].bound );
+      REQUIRE( densechgs[i].probing_col == sparsechgs[i].probing_col );
+   }
+
+   const auto& densesubsts = dense.getProbingSubstitutions();
+   const auto& sparsesubsts = sparse.getProbingSubstitutions();
+   REQUIRE( densesubsts.size() == sparsesubsts.size() );
+   for( size_t i = 0; i != densesubsts.size(); ++i )
+   {
+      REQUIRE( densesubsts[i].col1 == sparsesubsts[i].col1 );
+      REQUIRE( densesubsts[i].col2 == sparsesubsts[i].col2 );
+      REQUIRE( densesubsts[i].col2scale == sparsesubsts[i].col2scale );
+      REQUIRE( densesubsts[i].col2const == sparsesubsts[i].col2const );
+   }
+   REQUIRE( dense.getAmountOfWork() == sparse.getAmountOfWork() );
+}
+
+TEST_CASE( "probing-stores-and-applies-implications", "[presolve]" )
+{
+   Num<double> num{};
+   double time = 0.0;
+   int cause = -1;
+   Timer t{ time };
+   Message msg{};
+   Problem<double> problem = setupProblemWithImplications();
+   Statistics statistics{};
+   PresolveOptions presolveOptions{};
+   presolveOptions.dualreds = 0;
+   PostsolveStorage<double> postsolve =
+       PostsolveStorage<double>( problem, num, presolveOptions );
+   ProblemUpdate<double> problemUpdate( problem, postsolve, statistics,
+                                        presolveOptions, num, msg );
+   Probing<double> presolvingMethod{};
+   Reductions<double> reductions{};
+   problem.recomputeAllActivities();
+
+   presolvingMethod.execute( problem, problemUpdate, num, reductions, t,
+                             cause );
+
+   // the implications are visible after they were merged
+   ImplicationStore<double>& implications = problem.getImplications();
+   REQUIRE( implications.getNumImplications() == 0 );
+   implications.flush( problem.getVariableDomains() );
+   REQUIRE( implications.getNumImplications() != 0 );
+
+   // x1 + x2 <= 1
+   REQUIRE( implications.isConflict( 0, true, 1, true ) );
+   REQUIRE( implications.isConflict( 1, true, 0, true ) );
+   REQUIRE( !implications.isConflict( 0, false, 1, false ) );
+   const double* bound = implications.findBound( 0, true, 1, true );
+   REQUIRE( bound != nullptr );
+   REQUIRE( *bound == 0.0 );
+
+   // the probing view starts from the stored implications
+   implications.add( Implication<double>( 3, false, 4, true, 2.0 ) );
+   implications.flush( problem.getVariableDomains() );
+
+   ProbingView<double> view( problem, num );
+   view.setUseImplications( true );
+   view.setProbingColumn( 3, false );
+   REQUIRE( view.getProbingUpperBounds()[4] == 2.0 );
+   view.reset();
+   REQUIRE( view.getProbingUpperBounds()[4] == 5.0 );
+
+   // a stored implication that contradicts the bounds renders the value
+   // infeasible
+   implications.add( Implication<double>( 3, false, 2, false, 2.0 ) );
+   implications.flush( problem.getVariableDomains() );
+   view.setProbingColumn( 3, false );
+   REQUIRE( view.isInfeasible() );
+   view.reset();
+
+   // compressing drops the implications of a deleted column
+   Vec<int> colmap{ 0, -1, 1, 2, 3 };
+   problem.getVariableDomains().compress( colmap );
+   implications.compress( colmap, problem.getVariableDomains() );
+   REQUIRE( implications.getNCols() == 4 );
+   REQUIRE( implications.getImplications( 0, true ).getLength() != 0 );
+   REQUIRE( implications.findBound( 2, false, 3, true ) != nullptr );
+   for( int col = 0; col != 4; ++col )
+   {
+      for( bool value : { false, true } )
+      {
+         ImplicationView<double> literal =
+             implications.getImplications( col, value );
+         for( int k = 0; k != literal.getLength(); ++k )
+            REQUIRE( literal.getColumns()[k] < 4 );
+      }
+   }
+}
+
 Problem<double>
 setupProblemWithProbing()
 {
@@ -161,3 +291,57 @@ setupProblemWithProbingWithNoBinary()
    Problem<double> problem = pb.build();
    return problem;
 }
+
+Problem<double>
+setupProblemWithImplications()
+{
+   // x1 + x2 <= 1
+   // x2 + x3 >= 1
+   // x3 + 2x4 <= 2
+   // x1 + x3 >= 1
+   // x4 + y >= 1
+   Vec<double> coefficients{ 1.0, 1.0, 1.0, 1.0, 1.0 };
+   Vec<double> upperBounds{ 1.0, 1.0, 1.0, 1.0, 5.0 };
+   Vec<double> lowerBounds{ 0.0, 0.0, 0.0, 0.0, 0.0 };
+   Vec<uint8_t> isIntegral{ 1, 1, 1, 1, 0 };
+
+   Vec<std::string> rowNames{ "A1", "A2", "A3", "A4", "A5" };
+   Vec<std::string> columnNames{ "c1", "c2", "c3", "c4", "y" };
+   Vec<std::tuple<int, int, double>> entries{
+       std::tuple<int, int, double>{ 0, 0, 1.0 },
+       std::tuple<int, int, double>{ 0, 1, 1.0 },
+       std::tuple<int, int, double>{ 1, 1, 1.0 },
+       std::tuple<int, int, double>{ 1, 2, 1.0 },
+       std::tuple<int, int, double>{ 2, 2, 1.0 },
+       std::tuple<int, int, double>{ 2, 3, 2.0 },
+       std::tuple<int, int, double>{ 3, 0, 1.0 },
+       std::tuple<int, int, double>{ 3, 2, 1.0 },
+       std::tuple<int, int, double>{ 4, 3, 1.0 },
+       std::tuple<int, int, double>{ 4, 4, 1.0 } };
+
+   ProblemBuilder<double> pb;
+   pb.reserve( entries.size(), rowNames.size(), columnNames.size() );
+   pb.setNumRows( rowNames.size() );
+   pb.setNumCols( columnNames.size() );
+   pb.setColUbAll( upperBounds );
+   pb.setColLbAll( lowerBounds );
+   pb.setObjAll( coefficients );
+   pb.setObjOffset( 0.0 );
+   pb.setColIntegralAll( isIntegral );
+   pb.setRowRhs( 0, 1.0 );
+   pb.setRowLhs( 1, 1.0 );
+   pb.setRowLhsInf( 1, false );
+   pb.setRowRhsInf( 1, true );
+   pb.setRowRhs( 2, 2.0 );
+   pb.setRowLhs( 3, 1.0 );
+   pb.setRowLhsInf( 3, false );
+   pb.setRowRhsInf( 3, true );
+   pb.setRowLhs( 4, 1.0 );
+   pb.setRowLhsInf( 4, false );
+   pb.setRowRhsInf( 4, true );
+   pb.addEntryAll( entries );
+   pb.setColNameAll( columnNames );
+   pb.setProblemName( "matrix for testing probing implications" );
+   Problem<double> problem = pb.build();
+   return problem;
+}